@@ -70,7 +70,7 @@ public class InfoRetriever
 			"copyCompileLibs",
 			projectRootPath,
 			initScriptPath,
-			Arrays.asList("-Psourcetrail_lib_path=" + targetPath));
+			Arrays.asList("-Psourcetrail_lib_path=" + targetPath, "--parallel"));
 	}
 
 	public static void copyTestCompileLibs(String projectRootPath, String initScriptPath, String targetPath)
@@ -79,7 +79,7 @@ public class InfoRetriever
 			"copyTestCompileLibs",
 			projectRootPath,
 			initScriptPath,
-			Arrays.asList("-Psourcetrail_lib_path=" + targetPath));
+			Arrays.asList("-Psourcetrail_lib_path=" + targetPath, "--parallel"));
 	}
 
 	private static List<String> getSrcDirs(String taskName, String projectRootPath, String initScriptPath)
@@ -1,8 +1,12 @@
 #include "includes.h"
 
+#include <chrono>
 #include <csignal>
+#include <fstream>
 #include <iostream>
 
+#include <QTimer>
+
 #include "language_packages.h"
 
 #include "Application.h"
@@ -11,19 +15,28 @@
 #include "CommandLineParser.h"
 #include "ConsoleLogger.h"
 #include "FileLogger.h"
+#include "IndexingBenchmarkReport.h"
+#include "IndexingStatistics.h"
 #include "LanguagePackageManager.h"
 #include "LogManager.h"
 #include "MessageIndexingInterrupted.h"
 #include "MessageLoadProject.h"
+#include "MessageRefresh.h"
 #include "MessageStatus.h"
+#include "PersistentStorage.h"
+#include "ProjectSettings.h"
 #include "QtApplication.h"
 #include "QtCoreApplication.h"
 #include "QtNetworkFactory.h"
+#include "QtQueryLoadTest.h"
+#include "QtQueryServer.h"
 #include "QtViewFactory.h"
 #include "ResourcePaths.h"
 #include "ScopedFunctor.h"
 #include "SourceGroupFactory.h"
 #include "SourceGroupFactoryModuleCustom.h"
+#include "SqliteIndexStorage.h"
+#include "TraceRecorder.h"
 #include "UserPaths.h"
 #include "Version.h"
 #include "logging.h"
@@ -52,6 +65,161 @@ void signalHandler(int signum)
 	MessageIndexingInterrupted().dispatch();
 }
 
+void quitSignalHandler(int signum)
+{
+	QCoreApplication::quit();
+}
+
+volatile std::sig_atomic_t benchmarkInterrupted = 0;
+
+void benchmarkSignalHandler(int signum)
+{
+	benchmarkInterrupted = 1;
+	signalHandler(signum);
+}
+
+int runIndexingBenchmark(
+	const commandline::CommandLineParser& commandLineParser, QtCoreApplication& qtApp)
+{
+	const commandline::IndexingBenchmarkOptions& options =
+		commandLineParser.getIndexingBenchmarkOptions();
+	const FilePath projectFilePath = commandLineParser.getProjectFilePath();
+	const RefreshMode refreshMode = commandLineParser.getRefreshMode();
+
+	ApplicationSettings* appSettings = ApplicationSettings::getInstance().get();
+	int indexerThreadCount = appSettings->getIndexerThreadCount();
+	if (indexerThreadCount <= 0)
+	{
+		indexerThreadCount = utility::getIdealThreadCount();
+	}
+
+	IndexingBenchmarkReport report(
+		projectFilePath,
+		refreshMode == REFRESH_ALL_FILES,
+		indexerThreadCount,
+		appSettings->getMultiProcessIndexingEnabled());
+
+	std::shared_ptr<IndexingStatistics> statistics = IndexingStatistics::getInstance();
+	statistics->setEnabled(true);
+
+	TraceRecorder* traceRecorder = TraceRecorder::getInstance();
+	traceRecorder->setEnabled(!options.traceFilePath.empty());
+
+	signal(SIGINT, benchmarkSignalHandler);
+	signal(SIGTERM, benchmarkSignalHandler);
+
+	for (size_t i = 0; i < options.runCount && !benchmarkInterrupted; i++)
+	{
+		statistics->clear();
+
+		// dispatching from within the event loop makes sure that the quit at the end of the run
+		// can't arrive before the loop is running
+		QTimer::singleShot(0, [&]() {
+			if (i == 0)
+			{
+				MessageLoadProject(projectFilePath, false, refreshMode).dispatch();
+			}
+			else if (refreshMode == REFRESH_ALL_FILES)
+			{
+				MessageRefresh().refreshAll().dispatch();
+			}
+			else
+			{
+				MessageRefresh().dispatch();
+			}
+		});
+
+		const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		qtApp.exec();
+		const std::chrono::duration<double, std::milli> duration =
+			std::chrono::steady_clock::now() - start;
+
+		statistics->addPeakMemoryUsage(0, IndexingStatistics::getPeakMemoryUsage());
+
+		// the ring buffers of the main process only keep the latest events
+		traceRecorder->addRecords(traceRecorder->collectRecords(0));
+
+		std::map<std::string, size_t> tableRowCounts;
+		const FilePath dbFilePath = ProjectSettings(projectFilePath).getDBFilePath();
+		if (dbFilePath.exists())
+		{
+			tableRowCounts = SqliteIndexStorage(dbFilePath).getTableRowCounts();
+		}
+
+		report.addRun(i == 0, duration.count(), *statistics, tableRowCounts);
+
+		std::cout << "Finished benchmark run " << i + 1 << "/" << options.runCount << " in "
+				  << duration.count() << " ms" << std::endl;
+	}
+
+	statistics->setEnabled(false);
+
+	if (traceRecorder->isEnabled())
+	{
+		traceRecorder->setEnabled(false);
+
+		std::ofstream traceFileStream(options.traceFilePath.str());
+		traceFileStream << TraceRecorder::toChromeTraceJson(traceRecorder->collectAllRecords());
+		traceFileStream.close();
+
+		if (!traceFileStream)
+		{
+			std::cout << "ERROR: The trace could not be written to "
+					  << options.traceFilePath.str() << std::endl;
+		}
+	}
+
+	std::ofstream fileStream(options.outputFilePath.str());
+	fileStream << report.toJson();
+	fileStream.close();
+
+	if (!fileStream)
+	{
+		std::cout << "ERROR: The benchmark report could not be written to "
+				  << options.outputFilePath.str() << std::endl;
+		return 1;
+	}
+
+	std::cout << "Wrote benchmark report of " << report.getRunCount() << " runs to "
+			  << options.outputFilePath.str() << std::endl;
+	return 0;
+}
+
+int runQueryServer(
+	const commandline::CommandLineParser& commandLineParser, QtCoreApplication& qtApp)
+{
+	const ProjectSettings projectSettings(commandLineParser.getProjectFilePath());
+
+	std::shared_ptr<PersistentStorage> storage = std::make_shared<PersistentStorage>(
+		projectSettings.getDBFilePath(), projectSettings.getBookmarkDBFilePath());
+
+	if (storage->isEmpty() || storage->isIncompatible())
+	{
+		std::cout << "ERROR: The project needs to be indexed by this version of Sourcetrail first."
+				  << std::endl;
+		return 1;
+	}
+
+	storage->setup();
+	storage->setMode(SqliteIndexStorage::STORAGE_MODE_READ);
+	storage->buildCaches();
+
+	const commandline::QueryServerOptions& options = commandLineParser.getQueryServerOptions();
+	QtQueryServer server(
+		options.socketName, storage, options.workerCount, options.maxPendingRequestCount);
+
+	if (!server.startListening())
+	{
+		std::cout << "ERROR: The query server could not listen on the given socket." << std::endl;
+		return 1;
+	}
+
+	signal(SIGINT, quitSignalHandler);
+	signal(SIGTERM, quitSignalHandler);
+
+	return qtApp.exec();
+}
+
 void setupLogging()
 {
 	LogManager* logManager = LogManager::getInstance().get();
@@ -164,6 +332,25 @@ int main(int argc, char* argv[])
 		{
 			std::wcout << commandLineParser.getError() << std::endl;
 		}
+		else if (commandLineParser.runQueryLoadTest())
+		{
+			const commandline::QueryLoadTestOptions& options =
+				commandLineParser.getQueryLoadTestOptions();
+			const QtQueryLoadTest loadTest(
+				options.socketName,
+				options.requestsFilePath,
+				options.connectionCount,
+				options.requestCount);
+			return loadTest.run() ? 0 : 1;
+		}
+		else if (commandLineParser.runQueryServer())
+		{
+			return runQueryServer(commandLineParser, qtApp);
+		}
+		else if (commandLineParser.runIndexingBenchmark())
+		{
+			return runIndexingBenchmark(commandLineParser, qtApp);
+		}
 		else
 		{
 			MessageLoadProject(
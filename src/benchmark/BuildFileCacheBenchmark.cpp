@@ -0,0 +1,77 @@
+#include "catch.hpp"
+
+#include "language_packages.h"
+
+#if BUILD_JAVA_LANGUAGE_PACKAGE
+
+#	include <chrono>
+#	include <fstream>
+#	include <iostream>
+
+#	include <boost/filesystem.hpp>
+
+#	include "BuildFileCache.h"
+#	include "FilePath.h"
+#	include "FileSystem.h"
+
+namespace
+{
+void writeFile(const FilePath& filePath, const std::string& content)
+{
+	FileSystem::createDirectory(filePath.getParentDirectory());
+	std::ofstream file(filePath.str(), std::ios::out | std::ios::trunc);
+	file << content;
+}
+}	 // namespace
+
+TEST_CASE("build file cache validation benchmark")
+{
+	const size_t moduleCount = 200;
+
+	const FilePath rootPath = FilePath(boost::filesystem::temp_directory_path().wstring())
+								  .getConcatenated(L"sourcetrail_build_file_cache_benchmark");
+	boost::filesystem::remove_all(rootPath.getPath());
+
+	std::string modules;
+	for (size_t i = 0; i < moduleCount; i++)
+	{
+		const std::string module = "module" + std::to_string(i);
+		modules += "\t\t<module>" + module + "</module>\n";
+		writeFile(
+			rootPath.getConcatenated(L"module" + std::to_wstring(i) + L"/pom.xml"),
+			"<project>\n\t<parent>\n\t\t<artifactId>root</artifactId>\n\t</parent>\n"
+			"\t<artifactId>" + module + "</artifactId>\n</project>\n");
+	}
+	writeFile(
+		rootPath.getConcatenated(L"pom.xml"),
+		"<project>\n\t<artifactId>root</artifactId>\n\t<modules>\n" + modules +
+			"\t</modules>\n</project>\n");
+
+	const FilePath cacheFilePath = rootPath.getConcatenated(L"dependency_paths.cache");
+	const std::wstring configuration = L"dependency:copy-dependencies";
+	BuildFileCache(
+		cacheFilePath, BuildFileCache::getMavenBuildFilePaths(rootPath, FilePath()), configuration)
+		.store({rootPath.getConcatenated(L"dependency.jar")});
+
+	const size_t runCount = 10;
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (size_t i = 0; i < runCount; i++)
+	{
+		const BuildFileCache cache(
+			cacheFilePath,
+			BuildFileCache::getMavenBuildFilePaths(rootPath, FilePath()),
+			configuration);
+		REQUIRE(cache.isValid());
+	}
+	const double duration = std::chrono::duration<double, std::milli>(
+								std::chrono::steady_clock::now() - start)
+								.count() /
+		runCount;
+
+	std::cout << "validated cache of " << moduleCount + 1 << " pom files in " << duration
+			  << " ms" << std::endl;
+
+	boost::filesystem::remove_all(rootPath.getPath());
+}
+
+#endif	  // BUILD_JAVA_LANGUAGE_PACKAGE
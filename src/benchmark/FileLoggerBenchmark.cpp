@@ -0,0 +1,72 @@
+#include "catch.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+#include "FileLogger.h"
+#include "FileSystem.h"
+#include "LogManagerImplementation.h"
+
+namespace
+{
+const FilePath s_logDirectoryPath(L"data/FileLoggerTestSuite/");
+
+void logNumberedMessages(
+	LogManagerImplementation* logManagerImplementation,
+	const unsigned int threadIndex,
+	const unsigned int messageCount)
+{
+	for (unsigned int i = 0; i < messageCount; i++)
+	{
+		logManagerImplementation->logInfo(
+			L"thread " + std::to_wstring(threadIndex) + L" message " + std::to_wstring(i),
+			__FILE__,
+			__FUNCTION__,
+			__LINE__);
+	}
+}
+
+void removeLogFiles()
+{
+	for (const FilePath& filePath: FileSystem::getFilePathsFromDirectory(s_logDirectoryPath))
+	{
+		FileSystem::remove(filePath);
+	}
+}
+}	 // namespace
+
+TEST_CASE("file logger benchmark logging from 32 threads")
+{
+	const unsigned int threadCount = 32;
+	const unsigned int messageCount = 10000;
+
+	std::chrono::duration<double> duration;
+	{
+		std::shared_ptr<FileLogger> logger = std::make_shared<FileLogger>();
+		logger->setLogDirectory(s_logDirectoryPath);
+		logger->setFileName(L"benchmark");
+
+		LogManagerImplementation logManagerImplementation;
+		logManagerImplementation.addLogger(logger);
+
+		const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+		std::vector<std::thread> threads;
+		for (unsigned int i = 0; i < threadCount; i++)
+		{
+			threads.emplace_back(logNumberedMessages, &logManagerImplementation, i, messageCount);
+		}
+		for (std::thread& thread: threads)
+		{
+			thread.join();
+		}
+
+		duration = std::chrono::steady_clock::now() - start;
+	}
+	removeLogFiles();
+
+	std::cout << "log calls per second from " << threadCount
+			  << " threads: " << static_cast<size_t>(threadCount * messageCount / duration.count())
+			  << std::endl;
+}
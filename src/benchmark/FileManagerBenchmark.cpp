@@ -0,0 +1,57 @@
+#include "catch.hpp"
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+
+#include <boost/filesystem.hpp>
+
+#include "FileManager.h"
+#include "FilePath.h"
+#include "FilePathFilter.h"
+#include "FileSystem.h"
+
+TEST_CASE("file manager benchmark collecting files of large tree")
+{
+	const size_t directoryCount = 1000;
+	const size_t filesPerDirectory = 1000;
+	const size_t excludedDirectoryCount = 200;	  // like dependencies checked into the project
+
+	const FilePath rootPath = FilePath(boost::filesystem::temp_directory_path().wstring())
+								  .getConcatenated(L"sourcetrail_file_manager_benchmark");
+	boost::filesystem::remove_all(rootPath.getPath());
+
+	for (size_t i = 0; i < directoryCount; i++)
+	{
+		const FilePath directoryPath = i < excludedDirectoryCount
+			? rootPath.getConcatenated(L"node_modules/package" + std::to_wstring(i))
+			: rootPath.getConcatenated(L"src/module" + std::to_wstring(i));
+		FileSystem::createDirectory(directoryPath);
+
+		for (size_t j = 0; j < filesPerDirectory; j++)
+		{
+			const std::wstring extension = j % 2 ? L".cpp" : L".txt";
+			std::ofstream(
+				directoryPath.getConcatenated(L"file" + std::to_wstring(j) + extension).str());
+		}
+	}
+
+	FileManager fileManager;
+	double durations[2];
+	for (double& duration: durations)
+	{
+		const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		fileManager.update({rootPath}, {FilePathFilter(L"**/node_modules/**")}, {L".cpp"});
+		duration = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	REQUIRE(
+		fileManager.getAllSourceFilePaths().size() ==
+		(directoryCount - excludedDirectoryCount) * filesPerDirectory / 2);
+
+	boost::filesystem::remove_all(rootPath.getPath());
+
+	std::cout << "collecting files of " << directoryCount * filesPerDirectory
+			  << " entries: " << durations[0] << " s, again: " << durations[1] << " s"
+			  << std::endl;
+}
@@ -0,0 +1,84 @@
+#include "catch.hpp"
+
+#include <chrono>
+#include <iostream>
+
+#include "FilePathFilter.h"
+#include "FilePathFilterMatcher.h"
+
+TEST_CASE("file path filter matcher benchmark matching many paths")
+{
+	const size_t filterCount = 500;
+	const size_t pathCount = 1000000;
+	const size_t regexPathCount = 2000;	   // matching every regex is too slow for all paths
+
+	std::vector<FilePathFilter> filters;
+	for (size_t i = 0; i < filterCount; i++)
+	{
+		const std::wstring index = std::to_wstring(i);
+		switch (i % 4)
+		{
+		case 0:
+			filters.emplace_back(L"/home/user/project/external/lib" + index + L"/**");
+			break;
+		case 1:
+			filters.emplace_back(L"/home/user/project/src/module" + index + L"/*.generated.h");
+			break;
+		case 2:
+			filters.emplace_back(L"**/build" + index + L"/**");
+			break;
+		default:
+			filters.emplace_back(L"/home/user/project/src/**/test" + index + L".cpp");
+			break;
+		}
+	}
+
+	std::vector<std::wstring> paths;
+	for (size_t i = 0; i < pathCount; i++)
+	{
+		const std::wstring index = std::to_wstring(i);
+		const std::wstring folder = i % 5 ? L"/sub" + std::to_wstring(i % 13) : L"";
+		const std::wstring extension = i % 3 ? L".h" : L".generated.h";
+		const std::wstring module = L"module" + std::to_wstring(i % 700);
+		paths.push_back(
+			L"/home/user/project/src/" + module + folder + L"/file" + index + extension);
+	}
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	const FilePathFilterMatcher matcher(filters);
+	const std::chrono::duration<double> compileDuration = std::chrono::steady_clock::now() - start;
+
+	size_t matcherMatchCount = 0;
+	start = std::chrono::steady_clock::now();
+	for (const std::wstring& path: paths)
+	{
+		matcherMatchCount += matcher.isMatching(path) ? 1 : 0;
+	}
+	const std::chrono::duration<double> matcherDuration = std::chrono::steady_clock::now() - start;
+
+	size_t regexMatchCount = 0;
+	size_t matcherRegexMatchCount = 0;
+	start = std::chrono::steady_clock::now();
+	for (size_t i = 0; i < regexPathCount; i++)
+	{
+		for (const FilePathFilter& filter: filters)
+		{
+			if (filter.isMatching(paths[i]))
+			{
+				regexMatchCount++;
+				break;
+			}
+		}
+		matcherRegexMatchCount += matcher.isMatching(paths[i]) ? 1 : 0;
+	}
+	const std::chrono::duration<double> regexDuration = std::chrono::steady_clock::now() - start;
+
+	REQUIRE(regexMatchCount == matcherRegexMatchCount);
+	REQUIRE(matcherMatchCount > 0);
+
+	std::cout << "matching " << pathCount << " paths against " << filterCount
+			  << " filters, compiled matcher: " << matcherDuration.count() << " s (compiled in "
+			  << compileDuration.count() * 1000 << " ms), regex per filter: "
+			  << regexDuration.count() * pathCount / regexPathCount << " s (extrapolated from "
+			  << regexPathCount << " paths)" << std::endl;
+}
@@ -0,0 +1,106 @@
+#include "catch.hpp"
+
+#include <chrono>
+#include <iostream>
+
+#include "Graph.h"
+
+namespace
+{
+// creates a namespace node with the given number of member children
+Node* addWideParentNode(Graph& graph, size_t childCount)
+{
+	Node* parent = graph.createNode(
+		1, NodeType(NODE_NAMESPACE), NameHierarchy(L"ns", NAME_DELIMITER_CXX), DEFINITION_EXPLICIT);
+	for (size_t i = 0; i < childCount; i++)
+	{
+		Node* child = graph.createNode(
+			i + 2,
+			NodeType(NODE_CLASS),
+			NameHierarchy(L"Type" + std::to_wstring(i), NAME_DELIMITER_CXX),
+			DEFINITION_EXPLICIT);
+		graph.createEdge(childCount + i + 2, Edge::EDGE_MEMBER, parent, child);
+	}
+	return parent;
+}
+
+double getMilliSecondsSince(const std::chrono::steady_clock::time_point& start)
+{
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+		.count();
+}
+}	 // namespace
+
+TEST_CASE("graph benchmark building large graph")
+{
+	const size_t nodeCount = 200000;
+
+	std::vector<NameHierarchy> nameHierarchies;
+	for (size_t i = 0; i < nodeCount; i++)
+	{
+		nameHierarchies.push_back(NameHierarchy(L"Type" + std::to_wstring(i), NAME_DELIMITER_CXX));
+	}
+
+	const size_t runCount = 5;
+	size_t childCount = 0;
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (size_t i = 0; i < runCount; i++)
+	{
+		Graph graph;
+		std::vector<Node*> nodes;
+		for (size_t j = 0; j < nodeCount; j++)
+		{
+			nodes.push_back(graph.createNode(
+				j + 1, NodeType(NODE_CLASS), nameHierarchies[j], DEFINITION_EXPLICIT));
+		}
+		for (size_t j = 1; j < nodeCount; j++)
+		{
+			graph.createEdge(nodeCount + j, Edge::EDGE_MEMBER, nodes[j / 8], nodes[j]);
+		}
+
+		childCount = 0;
+		graph.forEachNode([&childCount](Node* node) {
+			node->forEachChildNode([&childCount](Node* child) { childCount++; });
+		});
+	}
+	const double duration = std::chrono::duration<double, std::milli>(
+								std::chrono::steady_clock::now() - start)
+								.count() /
+		runCount;
+
+	std::cout << "built graph of " << nodeCount << " nodes in " << duration << " ms" << std::endl;
+	REQUIRE(childCount == nodeCount - 1);
+}
+
+TEST_CASE("graph benchmark destroying graph with wide parent node")
+{
+	for (size_t childCount: {10000, 50000, 200000})
+	{
+		double destroyDuration = 0.0;
+		{
+			std::unique_ptr<Graph> graph = std::make_unique<Graph>();
+			addWideParentNode(*graph, childCount);
+
+			const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			graph.reset();
+			destroyDuration = getMilliSecondsSince(start);
+		}
+
+		double removeDuration = 0.0;
+		{
+			Graph graph;
+			Node* parent = addWideParentNode(graph, childCount);
+
+			const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			graph.removeNode(parent);
+			removeDuration = getMilliSecondsSince(start);
+
+			REQUIRE(graph.getNodeCount() == 0);
+			REQUIRE(graph.getEdgeCount() == 0);
+		}
+
+		std::cout << "parent node with " << childCount << " children, destroying graph: "
+				  << destroyDuration << " ms, removing parent node: " << removeDuration << " ms"
+				  << std::endl;
+	}
+}
@@ -0,0 +1,267 @@
+#include "catch.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+#include "Component.h"
+#include "GraphController.h"
+#include "GraphView.h"
+#include "GraphViewStyle.h"
+#include "GraphViewStyleImpl.h"
+#include "IntermediateStorage.h"
+#include "MessageActivateTokenIds.h"
+#include "PersistentStorage.h"
+#include "utilityString.h"
+
+namespace
+{
+class BenchmarkStorage: public PersistentStorage
+{
+public:
+	BenchmarkStorage()
+		: PersistentStorage(FilePath(L"data/test.sqlite"), FilePath(L"data/testBookmarks.sqlite"))
+	{
+		clear();
+	}
+};
+
+class BenchmarkGraphViewStyleImpl: public GraphViewStyleImpl
+{
+public:
+	float getCharWidth(const std::string& fontName, size_t fontSize) override
+	{
+		return 7.0f;
+	}
+
+	float getCharHeight(const std::string& fontName, size_t fontSize) override
+	{
+		return 12.0f;
+	}
+
+	float getGraphViewZoomDifferenceForPlatform() override
+	{
+		return 1.0f;
+	}
+};
+
+// keeps the laid out dummy graph instead of showing it
+class BenchmarkGraphView: public GraphView
+{
+public:
+	BenchmarkGraphView(ViewLayout* viewLayout): GraphView(viewLayout) {}
+
+	void createWidgetWrapper() override {}
+	void refreshView() override {}
+
+	void rebuildGraph(
+		std::shared_ptr<Graph> graph,
+		const std::vector<std::shared_ptr<DummyNode>>& nodes,
+		const std::vector<std::shared_ptr<DummyEdge>>& edges,
+		const GraphParams params) override
+	{
+		m_nodes = nodes;
+	}
+
+	void clear() override
+	{
+		m_nodes.clear();
+	}
+
+	void coFocusTokenIds(const std::vector<Id>& focusedTokenIds) override {}
+	void deCoFocusTokenIds(const std::vector<Id>& defocusedTokenIds) override {}
+
+	void resizeView() override {}
+
+	Vec2i getViewSize() const override
+	{
+		return Vec2i(1600, 1000);
+	}
+
+	GroupType getGrouping() const override
+	{
+		return GroupType::NONE;
+	}
+
+	void scrollToValues(int xValue, int yValue) override {}
+
+	void activateEdge(Id edgeId) override {}
+
+	void setNavigationFocus(bool focus) override {}
+
+	bool hasNavigationFocus() const override
+	{
+		return false;
+	}
+
+	bool isVisible() const override
+	{
+		return true;
+	}
+
+	void findMatches(ScreenSearchSender* sender, const std::wstring& query) override {}
+	void activateMatch(size_t matchIndex) override {}
+	void deactivateMatch(size_t matchIndex) override {}
+	void clearMatches() override {}
+
+	std::vector<std::shared_ptr<DummyNode>> m_nodes;
+};
+
+NameHierarchy createNameHierarchy(const std::wstring& name)
+{
+	NameHierarchy nameHierarchy(NAME_DELIMITER_CXX);
+	for (const std::wstring& element:
+		 utility::splitToVector(name, nameDelimiterTypeToString(NAME_DELIMITER_CXX)))
+	{
+		nameHierarchy.push(element);
+	}
+	return nameHierarchy;
+}
+
+Id addSymbol(IntermediateStorage& storage, NodeKind kind, const std::wstring& name)
+{
+	const Id id = storage
+					  .addNode(StorageNodeData(
+						  nodeKindToInt(kind), NameHierarchy::serialize(createNameHierarchy(name))))
+					  .first;
+	storage.addSymbol(StorageSymbol(id, DEFINITION_EXPLICIT));
+	return id;
+}
+
+// adds a class with many fields, some of them using types that have many members as well
+void fillStorageWithLargeClass(
+	PersistentStorage& storage, size_t fieldCount, size_t usedTypeCount, size_t memberCount)
+{
+	IntermediateStorage intermediateStorage;
+
+	const Id classId = addSymbol(intermediateStorage, NODE_CLASS, L"LargeClass");
+	for (size_t i = 0; i < fieldCount; i++)
+	{
+		const Id fieldId = addSymbol(
+			intermediateStorage, NODE_FIELD, L"LargeClass::m_field" + std::to_wstring(i));
+		intermediateStorage.addEdge(
+			StorageEdgeData(Edge::typeToInt(Edge::EDGE_MEMBER), classId, fieldId));
+
+		if (i < usedTypeCount)
+		{
+			const std::wstring typeName = L"UsedType" + std::to_wstring(i);
+			const Id typeId = addSymbol(intermediateStorage, NODE_CLASS, typeName);
+			intermediateStorage.addEdge(
+				StorageEdgeData(Edge::typeToInt(Edge::EDGE_TYPE_USAGE), fieldId, typeId));
+
+			for (size_t j = 0; j < memberCount; j++)
+			{
+				const Id memberId = addSymbol(
+					intermediateStorage,
+					NODE_METHOD,
+					typeName + L"::method" + std::to_wstring(j));
+				intermediateStorage.addEdge(
+					StorageEdgeData(Edge::typeToInt(Edge::EDGE_MEMBER), typeId, memberId));
+			}
+		}
+	}
+
+	storage.inject(&intermediateStorage);
+}
+
+double getMilliSecondsSince(const std::chrono::steady_clock::time_point& start)
+{
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+		.count();
+}
+}	 // namespace
+
+TEST_CASE("graph controller benchmark expanding and hiding nodes of large class")
+{
+	// fewer used types than the bundling threshold, so they stay separate graph nodes
+	const size_t usedTypeCount = 9;
+
+	BenchmarkStorage storage;
+	fillStorageWithLargeClass(storage, 100, usedTypeCount, 300);
+	storage.buildCaches();
+
+	GraphViewStyle::setImpl(std::make_shared<BenchmarkGraphViewStyleImpl>());
+
+	std::shared_ptr<BenchmarkGraphView> view = std::make_shared<BenchmarkGraphView>(nullptr);
+	std::shared_ptr<GraphController> controller = std::make_shared<GraphController>(&storage);
+	Component component(view, controller);
+
+	MessageActivateTokenIds activateTokenIdsMessage(
+		{storage.getNodeIdForNameHierarchy(createNameHierarchy(L"LargeClass"))});
+	MessageActivateTokens activateMessage(&activateTokenIdsMessage);
+	activateMessage.tokenIds = activateTokenIdsMessage.tokenIds;
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	static_cast<MessageListener<MessageActivateTokens>*>(controller.get())
+		->handleMessageBase(&activateMessage);
+	const double activateDuration = getMilliSecondsSince(start);
+
+	const size_t activeNodeCount = view->m_nodes.size();
+	REQUIRE(activeNodeCount > usedTypeCount);
+
+	std::vector<Id> usedTypeIds;
+	for (size_t i = 0; i < usedTypeCount; i++)
+	{
+		usedTypeIds.push_back(storage.getNodeIdForNameHierarchy(
+			createNameHierarchy(L"UsedType" + std::to_wstring(i))));
+	}
+
+	// each interaction is handled like a click in the graph view
+	const auto measure = [&controller](auto message, std::vector<double>& durations) {
+		const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		static_cast<MessageListener<decltype(message)>*>(controller.get())
+			->handleMessageBase(&message);
+		durations.push_back(getMilliSecondsSince(start));
+	};
+
+	// the first expand also fetches the members from the storage
+	std::vector<double> firstExpandDurations;
+	for (Id typeId: usedTypeIds)
+	{
+		measure(MessageGraphNodeExpand(typeId, true), firstExpandDurations);
+	}
+
+	const size_t runCount = 5;
+	std::vector<double> expandDurations;
+	for (size_t i = 0; i < runCount; i++)
+	{
+		for (Id typeId: usedTypeIds)
+		{
+			measure(MessageGraphNodeExpand(typeId, false), expandDurations);
+			measure(MessageGraphNodeExpand(typeId, true), expandDurations);
+		}
+	}
+
+	std::vector<double> hideDurations;
+	for (Id typeId: usedTypeIds)
+	{
+		measure(MessageGraphNodeHide(typeId), hideDurations);
+	}
+
+	const auto printDurations = [](const std::string& name, const std::vector<double>& durations) {
+		double sum = 0.0;
+		for (double duration: durations)
+		{
+			sum += duration;
+		}
+		std::cout << name << ": " << durations.size() << " times, avg " << sum / durations.size()
+				  << " ms, max " << *std::max_element(durations.begin(), durations.end())
+				  << " ms" << std::endl;
+	};
+
+	std::cout << "activated class, " << activeNodeCount << " dummy nodes in " << activateDuration
+			  << " ms" << std::endl;
+	printDurations("first expand", firstExpandDurations);
+	printDurations("collapse and expand", expandDurations);
+	printDurations("hide", hideDurations);
+
+	size_t hiddenNodeCount = 0;
+	for (const std::shared_ptr<DummyNode>& node: view->m_nodes)
+	{
+		if (node->hidden)
+		{
+			hiddenNodeCount++;
+		}
+	}
+	REQUIRE(hiddenNodeCount == usedTypeCount);
+}
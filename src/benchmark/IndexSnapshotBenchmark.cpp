@@ -0,0 +1,68 @@
+#include "catch.hpp"
+
+#include <chrono>
+#include <iostream>
+
+#include "FileSystem.h"
+#include "IndexSnapshot.h"
+#include "SqliteIndexStorage.h"
+
+TEST_CASE("index snapshot benchmark scanning nodes repeatedly compared to database")
+{
+	const int nodeCount = 500000;
+	const std::vector<int> nodeTypes = {1, 2, 4, 8, 16, 32, 64, 128};
+
+	FilePath databasePath(L"data/SQLiteTestSuite/benchmark.sqlite");
+	{
+		SqliteIndexStorage storage(databasePath);
+		storage.setup();
+		storage.beginTransaction();
+		for (int i = 0; i < nodeCount; i++)
+		{
+			storage.addNode(StorageNodeData(
+				nodeTypes[i % nodeTypes.size()], L"node" + std::to_wstring(i)));
+		}
+		storage.commitTransaction();
+
+		// one query per node type, like selecting each type in the overview
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		std::vector<std::vector<Id>> databaseNodeIds;
+		for (int nodeType: nodeTypes)
+		{
+			databaseNodeIds.emplace_back();
+			storage.forEach<StorageNode>([&](StorageNode&& node) {
+				if (node.type == nodeType)
+				{
+					databaseNodeIds.back().push_back(node.id);
+				}
+			});
+		}
+		const std::chrono::duration<double> databaseDuration = std::chrono::steady_clock::now() -
+			start;
+
+		// the snapshot is built by the first query
+		start = std::chrono::steady_clock::now();
+		IndexSnapshot snapshot;
+		storage.forEach<StorageNode>(
+			[&snapshot](StorageNode&& node) { snapshot.addNode(node.id, node.type); });
+		const std::chrono::duration<double> buildDuration = std::chrono::steady_clock::now() -
+			start;
+
+		std::vector<std::vector<Id>> snapshotNodeIds;
+		for (int nodeType: nodeTypes)
+		{
+			snapshotNodeIds.push_back(
+				snapshot.getNodeIds([nodeType](int type) { return type == nodeType; }));
+		}
+		const std::chrono::duration<double> snapshotDuration = std::chrono::steady_clock::now() -
+			start;
+
+		REQUIRE(snapshotNodeIds == databaseNodeIds);
+
+		std::cout << nodeTypes.size() << " scans of " << nodeCount << " nodes, database: "
+				  << databaseDuration.count() << " s, snapshot including build: "
+				  << snapshotDuration.count() << " s (built in " << buildDuration.count() << " s)"
+				  << std::endl;
+	}
+	FileSystem::remove(databasePath);
+}
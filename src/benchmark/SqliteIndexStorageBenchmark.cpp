@@ -0,0 +1,282 @@
+#include "catch.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+#include "FileSystem.h"
+#include "SourceLocationFile.h"
+#include "SqliteIndexStorage.h"
+
+TEST_CASE("storage benchmark storing and querying source locations")
+{
+	const size_t fileCount = 200;
+	const size_t lineCount = 2000;
+	const size_t batchCount = 4;	// locations of each file are added by several translation units
+	const size_t queryCount = 1000;
+
+	FilePath databasePath(L"data/SQLiteTestSuite/benchmark.sqlite");
+	{
+		SqliteIndexStorage storage(databasePath);
+		storage.setup();
+		storage.setMode(SqliteIndexStorage::STORAGE_MODE_WRITE);
+		storage.beginTransaction();
+
+		std::vector<Id> fileIds;
+		for (size_t i = 0; i < fileCount; i++)
+		{
+			const std::wstring fileName = L"file" + std::to_wstring(i) + L".cpp";
+			fileIds.push_back(storage.addNode(StorageNodeData(0, fileName)));
+			storage.addFile(
+				StorageFile(fileIds.back(), fileName, L"cpp", "2000-01-01 00:00:00", false, true));
+		}
+
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		for (size_t batch = 0; batch < batchCount; batch++)
+		{
+			std::vector<StorageSourceLocation> locations;
+			for (Id fileId: fileIds)
+			{
+				// every batch adds half of the locations again, as headers are seen repeatedly
+				for (size_t line = 1 + batch % 2; line <= lineCount; line += 2)
+				{
+					locations.emplace_back(0, fileId, line, 5, line, 12, 1);
+					locations.emplace_back(0, fileId, line, 20 + batch, line, 30 + batch, 2);
+				}
+			}
+			storage.addSourceLocations(locations);
+		}
+		const std::chrono::duration<double> addDuration = std::chrono::steady_clock::now() - start;
+
+		storage.commitTransaction();
+		storage.setMode(SqliteIndexStorage::STORAGE_MODE_READ);
+
+		size_t fileLocationCount = 0;
+		start = std::chrono::steady_clock::now();
+		for (size_t i = 0; i < queryCount; i++)
+		{
+			const FilePath filePath(L"file" + std::to_wstring(i % fileCount) + L".cpp");
+			fileLocationCount +=
+				storage.getSourceLocationsForFile(filePath)->getSourceLocationCount();
+		}
+		const std::chrono::duration<double> fileDuration = std::chrono::steady_clock::now() - start;
+
+		size_t linesLocationCount = 0;
+		start = std::chrono::steady_clock::now();
+		for (size_t i = 0; i < queryCount; i++)
+		{
+			const FilePath filePath(L"file" + std::to_wstring(i % fileCount) + L".cpp");
+			const size_t startLine = (i * 37) % (lineCount - 50) + 1;
+			linesLocationCount += storage
+									  .getSourceLocationsForLinesInFile(
+										  filePath, startLine, startLine + 50)
+									  ->getSourceLocationCount();
+		}
+		const std::chrono::duration<double> linesDuration = std::chrono::steady_clock::now() - start;
+
+		REQUIRE(
+			storage.getSourceLocationCount() ==
+			int(fileCount * lineCount * (batchCount + 2) / 2));
+		REQUIRE(fileLocationCount > linesLocationCount);
+
+		std::cout << "source locations: " << storage.getSourceLocationCount()
+				  << ", added in " << addDuration.count() << " s"
+				  << ", database size: " << FileSystem::getFileByteSize(databasePath) / 1024
+				  << " KiB"
+				  << ", getSourceLocationsForFile: " << fileDuration.count() * 1000000 / queryCount
+				  << " us, getSourceLocationsForLinesInFile: "
+				  << linesDuration.count() * 1000000 / queryCount << " us" << std::endl;
+	}
+	FileSystem::remove(databasePath);
+}
+
+TEST_CASE("storage benchmark querying source locations by id")
+{
+	const size_t fileCount = 200;
+	const size_t lineCount = 2000;
+	const size_t queryCount = 1000;
+	const size_t idsPerQuery = 10;
+
+	FilePath databasePath(L"data/SQLiteTestSuite/benchmark.sqlite");
+	{
+		SqliteIndexStorage storage(databasePath);
+		storage.setup();
+		storage.setMode(SqliteIndexStorage::STORAGE_MODE_WRITE);
+		storage.beginTransaction();
+
+		std::vector<Id> locationIds;
+		for (size_t i = 0; i < fileCount; i++)
+		{
+			const std::wstring fileName = L"file" + std::to_wstring(i) + L".cpp";
+			const Id fileId = storage.addNode(StorageNodeData(0, fileName));
+			storage.addFile(
+				StorageFile(fileId, fileName, L"cpp", "2000-01-01 00:00:00", false, true));
+
+			std::vector<StorageSourceLocation> locations;
+			for (size_t line = 1; line <= lineCount; line++)
+			{
+				locations.emplace_back(0, fileId, line, 5, line, 12, 1);
+			}
+			const std::vector<Id> ids = storage.addSourceLocations(locations);
+			locationIds.insert(locationIds.end(), ids.begin(), ids.end());
+		}
+
+		storage.commitTransaction();
+		storage.setMode(SqliteIndexStorage::STORAGE_MODE_READ);
+
+		size_t foundCount = 0;
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		for (size_t i = 0; i < queryCount; i++)
+		{
+			// ids of different files, as for the locations of a symbol
+			std::vector<Id> ids;
+			for (size_t j = 0; j < idsPerQuery; j++)
+			{
+				ids.push_back(locationIds[(i * 7919 + j * 104729) % locationIds.size()]);
+			}
+			foundCount += storage.getAllByIds<StorageSourceLocation>(ids).size();
+		}
+		const std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+
+		REQUIRE(foundCount == queryCount * idsPerQuery);
+
+		std::cout << "source locations: " << locationIds.size() << ", getAllByIds of "
+				  << idsPerQuery << " ids: " << duration.count() * 1000000 / queryCount << " us"
+				  << std::endl;
+	}
+	FileSystem::remove(databasePath);
+}
+
+TEST_CASE("storage benchmark adding source locations of header included by many files")
+{
+	const size_t translationUnitCount = 2000;
+	const size_t lineCount = 5000;
+	const size_t addedLocationCount = 50;	 // e.g. template instantiations of each file
+
+	FilePath databasePath(L"data/SQLiteTestSuite/benchmark.sqlite");
+	{
+		SqliteIndexStorage storage(databasePath);
+		storage.setup();
+		storage.setMode(SqliteIndexStorage::STORAGE_MODE_WRITE);
+		storage.beginTransaction();
+
+		const Id fileId = storage.addNode(StorageNodeData(0, L"header.h"));
+		storage.addFile(
+			StorageFile(fileId, L"header.h", L"cpp", "2000-01-01 00:00:00", false, true));
+
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		for (size_t i = 0; i < translationUnitCount; i++)
+		{
+			std::vector<StorageSourceLocation> locations;
+			for (size_t line = 1; line <= lineCount; line++)
+			{
+				locations.emplace_back(0, fileId, line, 5, line, 12, 1);
+			}
+			for (size_t j = 0; j < addedLocationCount; j++)
+			{
+				const size_t line = (i * 7919 + j * 104729) % lineCount + 1;
+				locations.emplace_back(0, fileId, line, 20 + i, line, 30 + i, 2);
+			}
+			storage.addSourceLocations(locations);
+		}
+		const std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+
+		storage.commitTransaction();
+
+		REQUIRE(
+			storage.getSourceLocationCount() ==
+			int(lineCount + translationUnitCount * addedLocationCount));
+		REQUIRE(
+			storage.getSourceLocationsForFile(FilePath(L"header.h"))->getSourceLocationCount() ==
+			lineCount + translationUnitCount * addedLocationCount);
+
+		std::cout << "translation units: " << translationUnitCount
+				  << ", adding header locations: " << duration.count() * 1000 / translationUnitCount
+				  << " ms per translation unit" << std::endl;
+	}
+	FileSystem::remove(databasePath);
+}
+
+TEST_CASE("storage benchmark querying source locations from several threads")
+{
+	const size_t fileCount = 200;
+	const size_t lineCount = 2000;
+	const size_t queryCount = 4000;
+
+	FilePath databasePath(L"data/SQLiteTestSuite/benchmark.sqlite");
+	{
+		SqliteIndexStorage storage(databasePath);
+		storage.setup();
+		storage.setMode(SqliteIndexStorage::STORAGE_MODE_WRITE);
+		storage.beginTransaction();
+
+		for (size_t i = 0; i < fileCount; i++)
+		{
+			const std::wstring fileName = L"file" + std::to_wstring(i) + L".cpp";
+			const Id fileId = storage.addNode(StorageNodeData(0, fileName));
+			storage.addFile(
+				StorageFile(fileId, fileName, L"cpp", "2000-01-01 00:00:00", false, true));
+
+			std::vector<StorageSourceLocation> locations;
+			for (size_t line = 1; line <= lineCount; line++)
+			{
+				locations.emplace_back(0, fileId, line, 5, line, 12, 1);
+			}
+			storage.addSourceLocations(locations);
+		}
+
+		storage.commitTransaction();
+		storage.setMode(SqliteIndexStorage::STORAGE_MODE_READ);
+
+		for (size_t threadCount: {1, 2, 4, 8})
+		{
+			std::vector<double> maxLatencies(threadCount, 0.0);
+			std::vector<size_t> locationCounts(threadCount, 0);
+
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			std::vector<std::thread> threads;
+			for (size_t t = 0; t < threadCount; t++)
+			{
+				threads.emplace_back([&, t]() {
+					for (size_t i = t; i < queryCount; i += threadCount)
+					{
+						const FilePath filePath(L"file" + std::to_wstring(i % fileCount) + L".cpp");
+						const size_t startLine = (i * 37) % (lineCount - 50) + 1;
+
+						std::chrono::steady_clock::time_point queryStart =
+							std::chrono::steady_clock::now();
+						locationCounts[t] += storage
+												 .getSourceLocationsForLinesInFile(
+													 filePath, startLine, startLine + 50)
+												 ->getSourceLocationCount();
+						const std::chrono::duration<double> latency =
+							std::chrono::steady_clock::now() - queryStart;
+						maxLatencies[t] = std::max(maxLatencies[t], latency.count());
+					}
+				});
+			}
+			for (std::thread& thread: threads)
+			{
+				thread.join();
+			}
+			const std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+
+			size_t locationCount = 0;
+			for (size_t count: locationCounts)
+			{
+				locationCount += count;
+			}
+			REQUIRE(locationCount == queryCount * 51);
+
+			std::cout << "threads: " << threadCount << ", read connections: "
+					  << storage.getReadConnectionCount()
+					  << ", queries per second: " << queryCount / duration.count()
+					  << ", mean latency: " << duration.count() * 1000000 * threadCount / queryCount
+					  << " us, max latency: "
+					  << *std::max_element(maxLatencies.begin(), maxLatencies.end()) * 1000000
+					  << " us" << std::endl;
+		}
+	}
+	FileSystem::remove(databasePath);
+}
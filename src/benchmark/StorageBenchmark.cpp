@@ -0,0 +1,168 @@
+#include "catch.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+#include "Graph.h"
+#include "IntermediateStorage.h"
+#include "PersistentStorage.h"
+#include "utilityString.h"
+
+namespace
+{
+class BenchmarkStorage: public PersistentStorage
+{
+public:
+	BenchmarkStorage()
+		: PersistentStorage(FilePath(L"data/test.sqlite"), FilePath(L"data/testBookmarks.sqlite"))
+	{
+		clear();
+	}
+};
+
+NameHierarchy createNameHierarchy(const std::wstring& name)
+{
+	NameHierarchy nameHierarchy(NAME_DELIMITER_CXX);
+	for (const std::wstring& element:
+		 utility::splitToVector(name, nameDelimiterTypeToString(NAME_DELIMITER_CXX)))
+	{
+		nameHierarchy.push(element);
+	}
+	return nameHierarchy;
+}
+
+void fillStorageWithTypes(
+	PersistentStorage& storage,
+	size_t fileCount,
+	size_t namespaceCount,
+	size_t typeCount,
+	size_t memberCount)
+{
+	IntermediateStorage intermediateStorage;
+	for (size_t i = 0; i < fileCount; i++)
+	{
+		const std::wstring filePath = L"path/to/file" + std::to_wstring(i) + L".h";
+		const Id fileId = intermediateStorage
+							  .addNode(StorageNodeData(
+								  nodeKindToInt(NODE_FILE),
+								  NameHierarchy::serialize(
+									  NameHierarchy(filePath, NAME_DELIMITER_FILE))))
+							  .first;
+		intermediateStorage.addFile(StorageFile(fileId, filePath, L"cpp", "someTime", true, true));
+	}
+
+	std::vector<Id> namespaceIds;
+	for (size_t i = 0; i < namespaceCount; i++)
+	{
+		const Id namespaceId = intermediateStorage
+								   .addNode(StorageNodeData(
+									   nodeKindToInt(NODE_NAMESPACE),
+									   NameHierarchy::serialize(createNameHierarchy(
+										   L"namespace" + std::to_wstring(i)))))
+								   .first;
+		intermediateStorage.addSymbol(StorageSymbol(namespaceId, DEFINITION_EXPLICIT));
+		namespaceIds.push_back(namespaceId);
+	}
+
+	for (size_t i = 0; i < typeCount; i++)
+	{
+		const std::wstring typeName = L"namespace" + std::to_wstring(i % namespaceCount) +
+			L"::Type" + std::to_wstring(i);
+		const Id typeId = intermediateStorage
+							  .addNode(StorageNodeData(
+								  nodeKindToInt(NODE_CLASS),
+								  NameHierarchy::serialize(createNameHierarchy(typeName))))
+							  .first;
+		intermediateStorage.addSymbol(StorageSymbol(typeId, DEFINITION_EXPLICIT));
+		intermediateStorage.addEdge(StorageEdgeData(
+			Edge::typeToInt(Edge::EDGE_MEMBER), namespaceIds[i % namespaceCount], typeId));
+
+		for (size_t j = 0; j < memberCount; j++)
+		{
+			const Id memberId = intermediateStorage
+									.addNode(StorageNodeData(
+										nodeKindToInt(NODE_FIELD),
+										NameHierarchy::serialize(createNameHierarchy(
+											typeName + L"::m_field" + std::to_wstring(j)))))
+									.first;
+			intermediateStorage.addSymbol(StorageSymbol(memberId, DEFINITION_EXPLICIT));
+			intermediateStorage.addEdge(
+				StorageEdgeData(Edge::typeToInt(Edge::EDGE_MEMBER), typeId, memberId));
+		}
+	}
+
+	storage.inject(&intermediateStorage);
+}
+}	 // namespace
+
+TEST_CASE("storage benchmark getting graph for all nodes of large storage")
+{
+	BenchmarkStorage storage;
+	fillStorageWithTypes(storage, 20000, 200, 100000, 4);
+	storage.buildCaches();
+
+	const size_t runCount = 5;
+	size_t nodeCount = 0;
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (size_t i = 0; i < runCount; i++)
+	{
+		nodeCount = storage.getGraphForAll()->getNodeCount();
+	}
+	const double duration = std::chrono::duration<double, std::milli>(
+								std::chrono::steady_clock::now() - start)
+								.count() /
+		runCount;
+
+	std::cout << "built graph of " << nodeCount << " nodes in " << duration << " ms" << std::endl;
+	REQUIRE(nodeCount > 0);
+}
+
+TEST_CASE("storage benchmark building caches of large storage")
+{
+	BenchmarkStorage storage;
+	fillStorageWithTypes(storage, 20000, 200, 100000, 4);
+
+	const size_t runCount = 5;
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (size_t i = 0; i < runCount; i++)
+	{
+		storage.buildCaches();
+	}
+	const double duration = std::chrono::duration<double, std::milli>(
+								std::chrono::steady_clock::now() - start)
+								.count() /
+		runCount;
+
+	std::cout << "built caches in " << duration << " ms" << std::endl;
+	REQUIRE(!storage.getAutocompletionMatches(L"Type1", NodeTypeSet::all(), false).empty());
+}
+
+TEST_CASE("storage benchmark activating namespace with many types")
+{
+	BenchmarkStorage storage;
+
+	// filled on another thread like by the indexer, otherwise the freed intermediate storage leaves
+	// the heap of this thread fragmented, which slows down all allocations measured here
+	std::thread([&storage]() { fillStorageWithTypes(storage, 1000, 1, 50000, 4); }).join();
+	storage.buildCaches();
+
+	const Id namespaceId = storage.getNodeIdForNameHierarchy(createNameHierarchy(L"namespace0"));
+
+	const size_t runCount = 5;
+	size_t nodeCount = 0;
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (size_t i = 0; i < runCount; i++)
+	{
+		// the graph is destroyed as well, as when the next symbol gets activated
+		nodeCount = storage.getGraphForActiveTokenIds({namespaceId}, {})->getNodeCount();
+	}
+	const double duration = std::chrono::duration<double, std::milli>(
+								std::chrono::steady_clock::now() - start)
+								.count() /
+		runCount;
+
+	std::cout << "activated namespace, graph of " << nodeCount << " nodes in " << duration
+			  << " ms" << std::endl;
+	REQUIRE(nodeCount == 50000);
+}
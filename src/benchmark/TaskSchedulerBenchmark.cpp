@@ -0,0 +1,102 @@
+#include "catch.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+#include "Task.h"
+#include "TaskDecoratorRepeat.h"
+#include "TaskGroupParallel.h"
+#include "TaskGroupSelector.h"
+#include "TaskGroupSequence.h"
+#include "TaskLambda.h"
+#include "TaskReturnSuccessIf.h"
+#include "TaskScheduler.h"
+#include "TaskSetValue.h"
+
+TEST_CASE("task scheduler benchmark running phases of one file refresh")
+{
+	const size_t refreshCount = 20;
+	const size_t indexingDurationMS = 5;
+
+	TaskScheduler scheduler(0);
+	scheduler.startSchedulerLoopThreaded();
+
+	double totalDuration = 0.0;
+	for (size_t i = 0; i < refreshCount; i++)
+	{
+		// fails like merging or injecting storages when there is nothing left to do
+		std::function<std::shared_ptr<Task>()> createNothingLeftTask = []() {
+			return std::make_shared<TaskReturnSuccessIf<int>>(
+				"indexed_source_file_count", TaskReturnSuccessIf<int>::CONDITION_GREATER_THAN, 1);
+		};
+		std::function<std::shared_ptr<Task>(const std::string&, size_t)> createWaitWhileFalseTask =
+			[](const std::string& key, size_t delayMS) {
+				std::shared_ptr<TaskDecoratorRepeat> task = std::make_shared<TaskDecoratorRepeat>(
+					TaskDecoratorRepeat::CONDITION_WHILE_SUCCESS, Task::STATE_SUCCESS, delayMS);
+				return task->addChildTask(std::make_shared<TaskReturnSuccessIf<bool>>(
+					key, TaskReturnSuccessIf<bool>::CONDITION_EQUALS, false));
+			};
+
+		std::shared_ptr<TaskGroupParallel> taskParallelIndexing =
+			std::make_shared<TaskGroupParallel>();
+		taskParallelIndexing->addTask(std::make_shared<TaskGroupSequence>()->addChildTasks(
+			std::make_shared<TaskSetValue<bool>>("indexer_command_queue_started", true),
+			std::make_shared<TaskSetValue<bool>>("indexer_command_queue_stopped", true)));
+		std::shared_ptr<TaskGroupSequence> taskIndexing = std::make_shared<TaskGroupSequence>();
+		taskIndexing->addTask(createWaitWhileFalseTask("indexer_command_queue_started", 25));
+		taskIndexing->addTask(std::make_shared<TaskSetValue<bool>>("indexer_threads_started", true));
+		taskIndexing->addTask(std::make_shared<TaskLambda>([indexingDurationMS]() {
+			std::this_thread::sleep_for(std::chrono::milliseconds(indexingDurationMS));
+		}));
+		taskIndexing->addTask(std::make_shared<TaskSetValue<bool>>("indexer_threads_stopped", true));
+		taskParallelIndexing->addTask(taskIndexing);
+		for (size_t delayMS: {250, 25})
+		{
+			taskParallelIndexing->addTask(std::make_shared<TaskGroupSequence>()->addChildTasks(
+				createWaitWhileFalseTask("indexer_threads_started", 25),
+				std::make_shared<TaskDecoratorRepeat>(
+					TaskDecoratorRepeat::CONDITION_WHILE_SUCCESS, Task::STATE_SUCCESS, delayMS)
+					->addChildTask(std::make_shared<TaskGroupSelector>()->addChildTasks(
+						createNothingLeftTask(),
+						std::make_shared<TaskReturnSuccessIf<bool>>(
+							"indexer_threads_stopped",
+							TaskReturnSuccessIf<bool>::CONDITION_EQUALS,
+							false)))));
+		}
+
+		std::atomic<bool> finished(false);
+		std::shared_ptr<TaskGroupSequence> taskSequential = std::make_shared<TaskGroupSequence>();
+		taskSequential->addTask(std::make_shared<TaskSetValue<int>>("indexed_source_file_count", 0));
+		for (const std::string& key:
+			 {"indexer_threads_started",
+			  "indexer_threads_stopped",
+			  "indexer_command_queue_started",
+			  "indexer_command_queue_stopped"})
+		{
+			taskSequential->addTask(std::make_shared<TaskSetValue<bool>>(key, false));
+		}
+		taskSequential->addTask(taskParallelIndexing);
+		taskSequential->addTask(
+			std::make_shared<TaskDecoratorRepeat>(
+				TaskDecoratorRepeat::CONDITION_WHILE_SUCCESS, Task::STATE_SUCCESS, 25)
+				->addChildTask(createNothingLeftTask()));
+		taskSequential->addTask(std::make_shared<TaskLambda>([&finished]() { finished = true; }));
+
+		const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		scheduler.pushTask(taskSequential);
+		while (!finished)
+		{
+			std::this_thread::sleep_for(std::chrono::microseconds(100));
+		}
+		totalDuration +=
+			std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+				.count();
+	}
+
+	scheduler.stopSchedulerLoop();
+
+	std::cout << "one file refresh with " << indexingDurationMS
+			  << " ms of indexing: " << totalDuration / refreshCount << " ms" << std::endl;
+}
@@ -0,0 +1,53 @@
+#include "catch.hpp"
+
+#include <chrono>
+#include <iostream>
+
+#include "TestTextCorpus.h"
+#include "utilityString.h"
+
+namespace
+{
+void runTranscodingBenchmark(const std::string& corpusName, const std::vector<std::string>& corpus)
+{
+	const size_t repetitionCount = 10;
+
+	std::vector<std::wstring> decoded(corpus.size());
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (size_t i = 0; i < repetitionCount; i++)
+	{
+		for (size_t j = 0; j < corpus.size(); j++)
+		{
+			decoded[j] = utility::decodeFromUtf8(corpus[j]);
+		}
+	}
+	const double decodeMS =
+		std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+	size_t byteCount = 0;
+	start = std::chrono::steady_clock::now();
+	for (size_t i = 0; i < repetitionCount; i++)
+	{
+		for (size_t j = 0; j < decoded.size(); j++)
+		{
+			byteCount += utility::encodeToUtf8(decoded[j]).size();
+		}
+	}
+	const double encodeMS =
+		std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+	std::cout << corpusName << ": " << byteCount / repetitionCount << " bytes, decode "
+			  << decodeMS / repetitionCount << " ms, encode " << encodeMS / repetitionCount
+			  << " ms" << std::endl;
+}
+}	 // namespace
+
+TEST_CASE("utf8 transcoding benchmark converting source lines and symbol names")
+{
+	runTranscodingBenchmark("ascii source lines", TestTextCorpus::createSourceLines(200000, 0));
+	runTranscodingBenchmark(
+		"source lines with non-ascii comments", TestTextCorpus::createSourceLines(200000, 10));
+	runTranscodingBenchmark("ascii symbol names", TestTextCorpus::createSymbolNames(200000, 0));
+	runTranscodingBenchmark(
+		"symbol names with non-ascii names", TestTextCorpus::createSymbolNames(200000, 20));
+}
@@ -19,7 +19,7 @@
 #	include "LanguagePackageJava.h"
 #endif	  // BUILD_JAVA_LANGUAGE_PACKAGE
 
-void setupLogging(const FilePath& logFilePath)
+void setupLogging(const FilePath& logFilePath, int processId)
 {
 	LogManager* logManager = LogManager::getInstance().get();
 
@@ -29,8 +29,10 @@ void setupLogging(const FilePath& logFilePath)
 	// logManager->addLogger(consoleLogger);
 
 	std::shared_ptr<FileLogger> fileLogger = std::make_shared<FileLogger>();
-	fileLogger->setLogFilePath(logFilePath);
+	fileLogger->setLogFilePath(FileLogger::getProcessLogFilePath(logFilePath, processId));
 	fileLogger->setLogLevel(Logger::LOG_ALL);
+	// messages logged right before the indexer crashes are the interesting ones
+	fileLogger->setWriteSynchronously(true);
 	logManager->addLogger(fileLogger);
 }
 
@@ -79,7 +81,7 @@ int main(int argc, char* argv[])
 
 	if (!logFilePath.empty())
 	{
-		setupLogging(FilePath(logFilePath));
+		setupLogging(FilePath(logFilePath), processId);
 	}
 
 	suppressCrashMessage();
@@ -10,6 +10,7 @@
 #include "IDECommunicationController.h"
 #include "LogManager.h"
 #include "MainView.h"
+#include "MessageFilterActivation.h"
 #include "MessageFilterErrorCountUpdate.h"
 #include "MessageFilterFocusInOut.h"
 #include "MessageFilterSearchAutocomplete.h"
@@ -377,6 +378,7 @@ void Application::startMessagingAndScheduling()
 	queue->addMessageFilter(std::make_shared<MessageFilterErrorCountUpdate>());
 	queue->addMessageFilter(std::make_shared<MessageFilterFocusInOut>());
 	queue->addMessageFilter(std::make_shared<MessageFilterSearchAutocomplete>());
+	queue->addMessageFilter(std::make_shared<MessageFilterActivation>());
 
 	queue->setSendMessagesAsTasks(true);
 	queue->startMessageLoopThreaded();
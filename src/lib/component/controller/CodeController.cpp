@@ -1,9 +1,12 @@
 #include "CodeController.h"
 
+#include <future>
 #include <memory>
+#include <mutex>
 
 #include "Application.h"
 #include "ApplicationSettings.h"
+#include "CancellationToken.h"
 #include "FileInfo.h"
 #include "MessageFocusView.h"
 #include "MessageMoveIDECursor.h"
@@ -12,13 +15,15 @@
 #include "SourceLocation.h"
 #include "SourceLocationCollection.h"
 #include "SourceLocationFile.h"
-#include "StorageAccess.h"
+#include "StorageAccessProxy.h"
 #include "TextAccess.h"
 #include "logging.h"
 #include "tracing.h"
 #include "utility.h"
 #include "utilityString.h"
 
+const size_t CodeController::s_fullTextSearchPageResultCount = 1000;
+
 CodeController::CodeController(StorageAccess* storageAccess): m_storageAccess(storageAccess) {}
 
 Id CodeController::getSchedulerId() const
@@ -65,17 +70,14 @@ void CodeController::handleMessage(MessageActivateFullTextSearch* message)
 
 	saveOrRestoreViewMode(message);
 
-	m_collection = m_storageAccess->getFullTextSearchLocations(
-		message->searchTerm, message->caseSensitive);
+	m_collection = std::make_shared<SourceLocationCollection>();
+	m_files.clear();
 
-	CodeView::CodeParams params;
-	params.clearSnippets = true;
-	params.useSingleFileCache = false;
+	m_fullTextSearchTerm = message->searchTerm;
+	m_fullTextSearchCaseSensitive = message->caseSensitive;
+	m_fullTextSearchFileOffset = 0;
 
-	m_files = getFilesForCollection(m_collection);
-	createReferences();
-	expandVisibleFiles(params.useSingleFileCache);
-	showFiles(params, firstReferenceScrollParams(), !message->isReplayed());
+	showNextFullTextSearchPage(message->getCancellationToken(), !message->isReplayed());
 }
 
 void CodeController::handleMessage(MessageActivateLegend* message)
@@ -454,6 +456,18 @@ void CodeController::handleMessage(MessageFocusOut* message)
 	getView()->deCoFocusTokenIds();
 }
 
+void CodeController::handleMessage(MessageLoadMoreFullTextSearchResults* message)
+{
+	TRACE("code fulltext load more");
+
+	if (!m_codeParams.hasMoreFullTextSearchResults)
+	{
+		return;
+	}
+
+	showNextFullTextSearchPage(CancellationToken(getSchedulerId()), true);
+}
+
 void CodeController::handleMessage(MessageScrollToLine* message)
 {
 	getView()->scrollTo(
@@ -841,12 +855,9 @@ std::vector<CodeSnippetParams> CodeController::getSnippetsForFile(
 			params.footer = activeSourceLocations->getFilePath().wstr();
 		}
 
-		for (const std::string& line: textAccess->getLines(
-				 static_cast<unsigned int>(params.startLineNumber),
-				 static_cast<unsigned int>(params.endLineNumber)))
-		{
-			params.code += line;
-		}
+		params.code = std::string(textAccess->getTextView(
+			static_cast<unsigned int>(params.startLineNumber),
+			static_cast<unsigned int>(params.endLineNumber)));
 
 		snippets.push_back(params);
 	}
@@ -1659,6 +1670,106 @@ void CodeController::showFirstActiveReference(Id tokenId, bool updateView)
 	showFiles(m_codeParams, scrollParams, updateView);
 }
 
+void CodeController::showNextFullTextSearchPage(
+	const CancellationToken& cancellationToken, bool updateView)
+{
+	const bool isFirstPage = m_fullTextSearchFileOffset == 0;
+	const bool showBatches = updateView && getView()->isInListMode();
+	size_t shownLocationCount = m_collection->getSourceLocationCount();
+	bool hasShownBatches = false;
+
+	// batches are found on the threads of the query and shown by this thread while it waits
+	struct FoundLocations
+	{
+		std::mutex mutex;
+		std::vector<std::shared_ptr<SourceLocationCollection>> batches;
+	};
+	std::shared_ptr<FoundLocations> foundLocations = std::make_shared<FoundLocations>();
+
+	std::future<FullTextSearchPage> query = StorageAccessProxy::queryAsync<FullTextSearchPage>(
+		m_storageAccess,
+		"fulltext search",
+		cancellationToken,
+		[searchTerm = m_fullTextSearchTerm,
+		 caseSensitive = m_fullTextSearchCaseSensitive,
+		 fileOffset = m_fullTextSearchFileOffset,
+		 foundLocations](const StorageAccess* storageAccess) {
+			return storageAccess->getFullTextSearchLocations(
+				searchTerm,
+				caseSensitive,
+				fileOffset,
+				s_fullTextSearchPageResultCount,
+				[foundLocations](std::shared_ptr<SourceLocationCollection> locations) {
+					std::lock_guard<std::mutex> lock(foundLocations->mutex);
+					foundLocations->batches.push_back(locations);
+				});
+		});
+
+	auto showFoundLocations = [&]() {
+		std::vector<std::shared_ptr<SourceLocationCollection>> batches;
+		{
+			std::lock_guard<std::mutex> lock(foundLocations->mutex);
+			batches.swap(foundLocations->batches);
+		}
+
+		for (const std::shared_ptr<SourceLocationCollection>& locations: batches)
+		{
+			// files are appended in the order they are found, their snippets get added once the
+			// page is complete
+			std::vector<CodeFileParams> files;
+			locations->forEachSourceLocationFile([&](std::shared_ptr<SourceLocationFile> file) {
+				m_collection->addSourceLocationCopies(file.get());
+
+				CodeFileParams params;
+				params.locationFile = m_collection->getSourceLocationFileByPath(
+					file->getFilePath());
+				params.referenceCount = file->getSourceLocationCount();
+				files.push_back(params);
+			});
+			utility::append(m_files, files);
+
+			if (showBatches)
+			{
+				shownLocationCount += locations->getSourceLocationCount();
+
+				CodeView::CodeParams params;
+				params.clearSnippets = isFirstPage && !hasShownBatches;
+				params.useSingleFileCache = false;
+				params.referenceCount = shownLocationCount;
+				params.referenceIndex = shownLocationCount;
+				getView()->showSnippets(files, params, CodeScrollParams());
+
+				hasShownBatches = true;
+			}
+		}
+	};
+
+	FullTextSearchPage page;
+	if (!StorageAccessProxy::waitForQuery(query, cancellationToken, page, showFoundLocations))
+	{
+		return;
+	}
+
+	m_fullTextSearchFileOffset = page.nextFileOffset;
+
+	CodeView::CodeParams params;
+	params.clearSnippets = isFirstPage && !hasShownBatches;
+	params.useSingleFileCache = false;
+	params.hasMoreFullTextSearchResults = page.hasNextPage();
+
+	createReferences();
+
+	if (isFirstPage)
+	{
+		expandVisibleFiles(params.useSingleFileCache);
+		showFiles(params, firstReferenceScrollParams(), updateView);
+	}
+	else
+	{
+		showFiles(params, CodeScrollParams(), updateView);
+	}
+}
+
 void CodeController::showFiles(CodeView::CodeParams params, CodeScrollParams scrollParams, bool updateView)
 {
 	if (updateView)
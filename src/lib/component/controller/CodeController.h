@@ -24,6 +24,7 @@
 #include "MessageFocusIn.h"
 #include "MessageFocusOut.h"
 #include "MessageListener.h"
+#include "MessageLoadMoreFullTextSearchResults.h"
 #include "MessageScrollCode.h"
 #include "MessageScrollToLine.h"
 #include "MessageShowError.h"
@@ -36,6 +37,7 @@
 #include "Controller.h"
 #include "SnippetMerger.h"
 
+class CancellationToken;
 class StorageAccess;
 class SourceLocation;
 class SourceLocationCollection;
@@ -60,6 +62,7 @@ class CodeController
 	, public MessageListener<MessageFlushUpdates>
 	, public MessageListener<MessageFocusIn>
 	, public MessageListener<MessageFocusOut>
+	, public MessageListener<MessageLoadMoreFullTextSearchResults>
 	, public MessageListener<MessageScrollCode>
 	, public MessageListener<MessageScrollToLine>
 	, public MessageListener<MessageShowError>
@@ -102,6 +105,7 @@ private:
 	void handleMessage(MessageFlushUpdates* message) override;
 	void handleMessage(MessageFocusIn* message) override;
 	void handleMessage(MessageFocusOut* message) override;
+	void handleMessage(MessageLoadMoreFullTextSearchResults* message) override;
 	void handleMessage(MessageScrollCode* message) override;
 	void handleMessage(MessageScrollToLine* message) override;
 	void handleMessage(MessageShowError* message) override;
@@ -169,6 +173,10 @@ private:
 	void showFirstActiveReference(Id tokenId, bool updateView);
 	void showFiles(CodeView::CodeParams params, CodeScrollParams scrollParams, bool updateView);
 
+	void showNextFullTextSearchPage(const CancellationToken& cancellationToken, bool updateView);
+
+	static const size_t s_fullTextSearchPageResultCount;
+
 	StorageAccess* m_storageAccess;
 
 	std::shared_ptr<SourceLocationCollection> m_collection;
@@ -186,6 +194,10 @@ private:
 
 	std::vector<Reference> m_localReferences;
 	int m_localReferenceIndex = -1;
+
+	std::wstring m_fullTextSearchTerm;
+	bool m_fullTextSearchCaseSensitive = false;
+	size_t m_fullTextSearchFileOffset = 0;
 };
 
 #endif	  // CODE_CONTROLLER_H
@@ -1,5 +1,6 @@
 #include "GraphController.h"
 
+#include <future>
 #include <set>
 
 #include "AccessKind.h"
@@ -12,7 +13,7 @@
 #include "ListLayouter.h"
 #include "MessageActivateNodes.h"
 #include "MessageStatus.h"
-#include "StorageAccess.h"
+#include "StorageAccessProxy.h"
 #include "TokenComponentAccess.h"
 #include "TokenComponentFilePath.h"
 #include "TokenComponentInheritanceChain.h"
@@ -138,9 +139,27 @@ void GraphController::handleMessage(MessageActivateTokens* message)
 
 	std::vector<Id> tokenIds = utility::concat(m_activeNodeIds, m_activeEdgeIds);
 
-	bool isNamespace = false;
-	std::shared_ptr<Graph> graph = m_storageAccess->getGraphForActiveTokenIds(
-		tokenIds, getExpandedNodeIds(), &isNamespace);
+	const std::vector<Id> expandedNodeIds = getExpandedNodeIds();
+	std::future<std::pair<std::shared_ptr<Graph>, bool>> query =
+		StorageAccessProxy::queryAsync<std::pair<std::shared_ptr<Graph>, bool>>(
+			m_storageAccess,
+			"active token graph",
+			message->getCancellationToken(),
+			[tokenIds, expandedNodeIds](const StorageAccess* storageAccess) {
+				bool isNamespace = false;
+				std::shared_ptr<Graph> graph = storageAccess->getGraphForActiveTokenIds(
+					tokenIds, expandedNodeIds, &isNamespace);
+				return std::make_pair(graph, isNamespace);
+			});
+
+	std::pair<std::shared_ptr<Graph>, bool> result;
+	if (!StorageAccessProxy::waitForQuery(query, message->getCancellationToken(), result))
+	{
+		return;
+	}
+
+	std::shared_ptr<Graph> graph = result.first;
+	const bool isNamespace = result.second;
 
 	createDummyGraphAndSetActiveAndVisibility(tokenIds, graph, !message->isFromSearch);
 
@@ -215,14 +234,33 @@ void GraphController::handleMessage(MessageActivateTrail* message)
 
 	m_activeEdgeIds.clear();
 
-	std::shared_ptr<Graph> graph = m_storageAccess->getGraphForTrail(
-		message->originId,
-		message->targetId,
-		message->nodeTypes,
-		message->edgeTypes,
-		message->nodeNonIndexed,
-		message->depth,
-		true /* !message->custom || (message->originId && message->targetId) */);
+	std::future<std::shared_ptr<Graph>> query =
+		StorageAccessProxy::queryAsync<std::shared_ptr<Graph>>(
+			m_storageAccess,
+			"trail graph",
+			message->getCancellationToken(),
+			[originId = message->originId,
+			 targetId = message->targetId,
+			 nodeTypes = message->nodeTypes,
+			 edgeTypes = message->edgeTypes,
+			 nodeNonIndexed = message->nodeNonIndexed,
+			 depth = message->depth](const StorageAccess* storageAccess) {
+				return storageAccess->getGraphForTrail(
+					originId,
+					targetId,
+					nodeTypes,
+					edgeTypes,
+					nodeNonIndexed,
+					depth,
+					true /* !message->custom || (message->originId && message->targetId) */);
+			});
+
+	// a newer activation cancels the token, then the graph of this one is not needed anymore
+	std::shared_ptr<Graph> graph;
+	if (!StorageAccessProxy::waitForQuery(query, message->getCancellationToken(), graph))
+	{
+		return;
+	}
 
 	// remove non-indexed files from include graph if indexed file is origin
 	if (!message->custom && message->edgeTypes & Edge::EDGE_INCLUDE)
@@ -438,6 +476,8 @@ void GraphController::handleMessage(MessageGraphNodeBundleSplit* message)
 
 void GraphController::handleMessage(MessageGraphNodeExpand* message)
 {
+	TRACE("graph expand");
+
 	if (message->ignoreIfNotReplayed && !message->isReplayed())
 	{
 		return;
@@ -1911,6 +1951,14 @@ Vec4i GraphController::layoutNestingRecursive(DummyNode* node, int relayoutAcces
 		return Vec4i(0, 0, 0, 0);
 	}
 
+	// Graph nodes that did not change since their last layout keep their sizes and the positions
+	// of their sub nodes, so expanding or hiding a single node does not relayout the whole graph.
+	const bool cacheLayout = node->isGraphNode() && relayoutAccessMaxWidth == -1;
+	if (cacheLayout && node->layoutHash && node->layoutHash == node->getLayoutHash())
+	{
+		return ListLayouter::boundingRect(node->subNodes);
+	}
+
 	GraphViewStyle::NodeMargins margins;
 
 	if (node->isGraphNode())
@@ -2099,6 +2147,11 @@ Vec4i GraphController::layoutNestingRecursive(DummyNode* node, int relayoutAcces
 		}
 	}
 
+	if (cacheLayout)
+	{
+		node->layoutHash = node->getLayoutHash();
+	}
+
 	return ListLayouter::boundingRect(node->subNodes);
 }
 
@@ -2310,6 +2363,8 @@ void GraphController::relayoutGraph(
 	bool withCharacterIndex,
 	const std::wstring& groupName)
 {
+	TRACE();
+
 	bool showsTrail = m_graph->getTrailMode() != Graph::TRAIL_NONE;
 
 	setVisibility(setActive(utility::concat(m_activeNodeIds, m_activeEdgeIds), showsTrail));
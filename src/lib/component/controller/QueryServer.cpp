@@ -0,0 +1,289 @@
+#include "QueryServer.h"
+
+#include <algorithm>
+
+#include "Edge.h"
+#include "Graph.h"
+#include "NodeTypeSet.h"
+#include "PersistentStorage.h"
+#include "QueryProtocolHelper.h"
+#include "SearchMatch.h"
+#include "SourceLocation.h"
+#include "SourceLocationCollection.h"
+#include "logging.h"
+#include "utilityString.h"
+
+namespace
+{
+bool parseNumber(const std::wstring& text, size_t& number)
+{
+	if (text.empty() || text.size() > 18 ||
+		text.find_first_not_of(L"0123456789") != std::wstring::npos)
+	{
+		return false;
+	}
+
+	number = std::stoull(text);
+	return true;
+}
+
+const size_t s_defaultSearchResultCount = 20;
+}	 // namespace
+
+QueryServer::QueryServer(
+	std::shared_ptr<const PersistentStorage> storage,
+	size_t workerCount,
+	size_t maxPendingRequestCount)
+	: m_storage(storage), m_maxPendingRequestCount(maxPendingRequestCount)
+{
+	for (size_t i = 0; i < std::max<size_t>(workerCount, 1); i++)
+	{
+		m_workers.emplace_back(&QueryServer::runWorker, this);
+	}
+}
+
+QueryServer::~QueryServer()
+{
+	stopWorkers();
+}
+
+std::string QueryServer::processRequest(const std::string& requestLine) const
+{
+	QueryProtocolHelper::Request request = QueryProtocolHelper::parseRequest(requestLine);
+	if (!request.valid)
+	{
+		return QueryProtocolHelper::buildErrorResponse("0", L"Invalid request");
+	}
+
+	Rows rows;
+	std::wstring error;
+	bool success = false;
+
+	if (request.command == "ping")
+	{
+		success = true;
+	}
+	else if (!m_storage)
+	{
+		error = L"No index loaded";
+	}
+	else if (request.command == "search")
+	{
+		success = search(request.arguments, rows, error);
+	}
+	else if (request.command == "references")
+	{
+		success = references(request.arguments, rows, error);
+	}
+	else if (request.command == "callers" || request.command == "callees")
+	{
+		success = calls(request.arguments, request.command == "callers", rows, error);
+	}
+	else if (request.command == "dependencies" || request.command == "dependents")
+	{
+		success = fileDependencies(request.arguments, request.command == "dependents", rows, error);
+	}
+	else
+	{
+		error = L"Unknown command: " + utility::decodeFromUtf8(request.command);
+	}
+
+	if (!success)
+	{
+		return QueryProtocolHelper::buildErrorResponse(request.id, error);
+	}
+
+	return QueryProtocolHelper::buildResponse(request.id, rows);
+}
+
+void QueryServer::handleRequest(Id clientId, const std::string& requestLine)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_pendingRequestsMutex);
+
+		if (!m_stopped && m_pendingRequests.size() < m_maxPendingRequestCount)
+		{
+			m_pendingRequests.push_back({clientId, requestLine});
+			m_pendingRequestsCondition.notify_one();
+			return;
+		}
+	}
+
+	QueryProtocolHelper::Request request = QueryProtocolHelper::parseRequest(requestLine);
+	sendResponse(
+		clientId,
+		QueryProtocolHelper::buildErrorResponse(
+			request.valid ? request.id : "0", L"Server is busy, try again later"));
+}
+
+void QueryServer::stopWorkers()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_pendingRequestsMutex);
+		m_stopped = true;
+		m_pendingRequests.clear();
+	}
+	m_pendingRequestsCondition.notify_all();
+
+	for (std::thread& worker: m_workers)
+	{
+		if (worker.joinable())
+		{
+			worker.join();
+		}
+	}
+	m_workers.clear();
+}
+
+void QueryServer::runWorker()
+{
+	while (true)
+	{
+		PendingRequest request;
+		{
+			std::unique_lock<std::mutex> lock(m_pendingRequestsMutex);
+			m_pendingRequestsCondition.wait(
+				lock, [this]() { return m_stopped || !m_pendingRequests.empty(); });
+
+			if (m_stopped)
+			{
+				return;
+			}
+
+			request = std::move(m_pendingRequests.front());
+			m_pendingRequests.pop_front();
+		}
+
+		std::string response;
+		try
+		{
+			response = processRequest(request.requestLine);
+		}
+		catch (std::exception& e)
+		{
+			LOG_ERROR(std::string("Failed to process query: ") + e.what());
+			response = QueryProtocolHelper::buildErrorResponse(
+				QueryProtocolHelper::parseRequest(request.requestLine).id, L"Internal error");
+		}
+
+		sendResponse(request.clientId, response);
+	}
+}
+
+bool QueryServer::search(
+	const std::vector<std::wstring>& arguments, Rows& rows, std::wstring& error) const
+{
+	size_t maxResultCount = s_defaultSearchResultCount;
+	if (arguments.empty() || arguments.size() > 2 ||
+		(arguments.size() == 2 && !parseNumber(arguments[1], maxResultCount)))
+	{
+		error = L"Usage: search <query> [<max result count>]";
+		return false;
+	}
+
+	for (const SearchMatch& match:
+		 m_storage->getAutocompletionMatches(arguments[0], NodeTypeSet::all(), false))
+	{
+		for (Id tokenId: match.tokenIds)
+		{
+			if (rows.size() >= maxResultCount)
+			{
+				return true;
+			}
+
+			rows.push_back(
+				{std::to_wstring(tokenId),
+				 match.nodeType.getReadableTypeWString(),
+				 match.getFullName()});
+		}
+	}
+
+	return true;
+}
+
+bool QueryServer::references(
+	const std::vector<std::wstring>& arguments, Rows& rows, std::wstring& error) const
+{
+	size_t nodeId = 0;
+	if (arguments.size() != 1 || !parseNumber(arguments[0], nodeId))
+	{
+		error = L"Usage: references <node id>";
+		return false;
+	}
+
+	m_storage->getSourceLocationsForTokenIds({nodeId})->forEachSourceLocation(
+		[&rows](SourceLocation* location) {
+			if (!location->isStartLocation())
+			{
+				return;
+			}
+
+			const SourceLocation* endLocation = location->getEndLocation();
+			if (!endLocation)
+			{
+				endLocation = location;
+			}
+
+			rows.push_back(
+				{location->getFilePath().wstr(),
+				 std::to_wstring(location->getLineNumber()),
+				 std::to_wstring(location->getColumnNumber()),
+				 std::to_wstring(endLocation->getLineNumber()),
+				 std::to_wstring(endLocation->getColumnNumber())});
+		});
+
+	return true;
+}
+
+bool QueryServer::calls(
+	const std::vector<std::wstring>& arguments, bool callers, Rows& rows, std::wstring& error) const
+{
+	size_t nodeId = 0;
+	size_t depth = 1;
+	if (arguments.empty() || arguments.size() > 2 || !parseNumber(arguments[0], nodeId) ||
+		(arguments.size() == 2 && !parseNumber(arguments[1], depth)))
+	{
+		error = std::wstring(L"Usage: ") + (callers ? L"callers" : L"callees") +
+			L" <node id> [<depth>, 0 for unlimited]";
+		return false;
+	}
+
+	std::shared_ptr<Graph> graph = m_storage->getGraphForTrail(
+		callers ? 0 : nodeId, callers ? nodeId : 0, 0, Edge::EDGE_CALL, true, depth, true);
+
+	graph->forEachEdge([&rows](Edge* edge) {
+		if (edge->getType() == Edge::EDGE_CALL)
+		{
+			rows.push_back(
+				{std::to_wstring(edge->getFrom()->getId()),
+				 edge->getFrom()->getFullName(),
+				 std::to_wstring(edge->getTo()->getId()),
+				 edge->getTo()->getFullName()});
+		}
+	});
+
+	return true;
+}
+
+bool QueryServer::fileDependencies(
+	const std::vector<std::wstring>& arguments,
+	bool dependents,
+	Rows& rows,
+	std::wstring& error) const
+{
+	if (arguments.size() != 1 || arguments[0].empty())
+	{
+		error = std::wstring(L"Usage: ") + (dependents ? L"dependents" : L"dependencies") +
+			L" <file path>";
+		return false;
+	}
+
+	const std::set<FilePath> filePaths = {FilePath(arguments[0])};
+	for (const FilePath& filePath:
+		 dependents ? m_storage->getReferencing(filePaths) : m_storage->getReferenced(filePaths))
+	{
+		rows.push_back({filePath.wstr()});
+	}
+
+	return true;
+}
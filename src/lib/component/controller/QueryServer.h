@@ -0,0 +1,82 @@
+#ifndef QUERY_SERVER_H
+#define QUERY_SERVER_H
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "types.h"
+
+class PersistentStorage;
+
+// Answers code intelligence queries of headless clients, see QueryProtocolHelper for the format.
+// Requests are handed in by the socket implementation and answered by a fixed number of worker
+// threads. If too many requests are waiting, new ones are rejected right away instead of queueing
+// up without limit. Responses to one client may arrive in a different order than its requests.
+class QueryServer
+{
+public:
+	QueryServer(
+		std::shared_ptr<const PersistentStorage> storage,
+		size_t workerCount,
+		size_t maxPendingRequestCount);
+	virtual ~QueryServer();
+
+	virtual bool startListening() = 0;
+	virtual void stopListening() = 0;
+	virtual bool isListening() const = 0;
+
+	// answers a single request on the calling thread
+	std::string processRequest(const std::string& requestLine) const;
+
+protected:
+	void handleRequest(Id clientId, const std::string& requestLine);
+
+	// called from the worker threads, the client may have disconnected in the meantime
+	virtual void sendResponse(Id clientId, const std::string& response) = 0;
+
+	// needs to be called in the destructor of implementations, so that no worker calls
+	// sendResponse on an object that is already destroyed
+	void stopWorkers();
+
+private:
+	struct PendingRequest
+	{
+		Id clientId;
+		std::string requestLine;
+	};
+
+	typedef std::vector<std::vector<std::wstring>> Rows;
+
+	void runWorker();
+
+	bool search(const std::vector<std::wstring>& arguments, Rows& rows, std::wstring& error) const;
+	bool references(
+		const std::vector<std::wstring>& arguments, Rows& rows, std::wstring& error) const;
+	bool calls(
+		const std::vector<std::wstring>& arguments,
+		bool callers,
+		Rows& rows,
+		std::wstring& error) const;
+	bool fileDependencies(
+		const std::vector<std::wstring>& arguments,
+		bool dependents,
+		Rows& rows,
+		std::wstring& error) const;
+
+	std::shared_ptr<const PersistentStorage> m_storage;
+
+	const size_t m_maxPendingRequestCount;
+	std::vector<std::thread> m_workers;
+
+	std::mutex m_pendingRequestsMutex;
+	std::condition_variable m_pendingRequestsCondition;
+	std::deque<PendingRequest> m_pendingRequests;
+	bool m_stopped = false;
+};
+
+#endif	  // QUERY_SERVER_H
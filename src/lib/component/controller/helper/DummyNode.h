@@ -122,6 +122,7 @@ public:
 		, groupLayout(GroupLayout::LIST)
 		, interactive(true)
 		, fontSizeDiff(5)
+		, layoutHash(0)
 	{
 	}
 
@@ -443,6 +444,34 @@ public:
 		return nullptr;
 	}
 
+	// hashes all state that is read when computing the nesting layout, but none of its results
+	size_t getLayoutHash() const
+	{
+		size_t hash = std::hash<std::wstring>()(name);
+		auto combine = [&hash](size_t value) {
+			hash ^= value + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+		};
+
+		combine(type);
+		combine(static_cast<size_t>(tokenId));
+		combine(visible);
+		combine(hidden);
+		combine(childVisible);
+		combine(active);
+		combine(connected);
+		combine(expanded);
+		combine(accessKind);
+		combine(invisibleSubNodeCount);
+		combine(static_cast<size_t>(fontSizeDiff));
+
+		for (const std::shared_ptr<DummyNode>& subNode: subNodes)
+		{
+			combine(subNode->getLayoutHash());
+		}
+
+		return hash;
+	}
+
 	std::vector<BundleInfo> getBundleInfos() const
 	{
 		std::vector<BundleInfo> bundleInfos;
@@ -505,6 +534,9 @@ public:
 
 	// TextNode
 	int fontSizeDiff;
+
+	// hash of the state this node was last layouted with, 0 if not layouted yet
+	size_t layoutHash;
 };
 
 #endif	  // DUMMY_NODE_H
@@ -0,0 +1,193 @@
+#include "QueryProtocolHelper.h"
+
+#include "utilityString.h"
+
+const std::string QueryProtocolHelper::s_okStatus = "ok";
+const std::string QueryProtocolHelper::s_errorStatus = "error";
+
+QueryProtocolHelper::Request QueryProtocolHelper::parseRequest(const std::string& line)
+{
+	std::vector<std::string> fields = splitLine(line);
+
+	Request request;
+	if (fields.size() < 2 || fields[0].empty() || fields[1].empty())
+	{
+		return request;
+	}
+
+	request.id = fields[0];
+	request.command = fields[1];
+	for (size_t i = 2; i < fields.size(); i++)
+	{
+		request.arguments.push_back(unescapeField(fields[i]));
+	}
+	request.valid = true;
+
+	return request;
+}
+
+std::string QueryProtocolHelper::buildRequest(
+	const std::string& id, const std::string& command, const std::vector<std::wstring>& arguments)
+{
+	std::string request = id + '\t' + command;
+	for (const std::wstring& argument: arguments)
+	{
+		request += '\t' + escapeField(argument);
+	}
+	return request + '\n';
+}
+
+QueryProtocolHelper::ResponseHeader QueryProtocolHelper::parseResponseHeader(
+	const std::string& line)
+{
+	std::vector<std::string> fields = splitLine(line);
+
+	ResponseHeader header;
+	if (fields.size() != 3 || fields[0].empty())
+	{
+		return header;
+	}
+
+	header.id = fields[0];
+
+	if (fields[1] == s_okStatus)
+	{
+		if (fields[2].empty() || fields[2].find_first_not_of("0123456789") != std::string::npos)
+		{
+			return header;
+		}
+
+		header.ok = true;
+		header.rowCount = std::stoul(fields[2]);
+	}
+	else if (fields[1] == s_errorStatus)
+	{
+		header.errorMessage = unescapeField(fields[2]);
+	}
+	else
+	{
+		return header;
+	}
+
+	header.valid = true;
+	return header;
+}
+
+std::vector<std::wstring> QueryProtocolHelper::parseResponseRow(const std::string& line)
+{
+	std::vector<std::wstring> row;
+	for (const std::string& field: splitLine(line))
+	{
+		row.push_back(unescapeField(field));
+	}
+	return row;
+}
+
+std::string QueryProtocolHelper::buildResponse(
+	const std::string& id, const std::vector<std::vector<std::wstring>>& rows)
+{
+	std::string response = id + '\t' + s_okStatus + '\t' + std::to_string(rows.size()) + '\n';
+	for (const std::vector<std::wstring>& row: rows)
+	{
+		for (size_t i = 0; i < row.size(); i++)
+		{
+			if (i > 0)
+			{
+				response += '\t';
+			}
+			response += escapeField(row[i]);
+		}
+		response += '\n';
+	}
+	return response;
+}
+
+std::string QueryProtocolHelper::buildErrorResponse(
+	const std::string& id, const std::wstring& message)
+{
+	return id + '\t' + s_errorStatus + '\t' + escapeField(message) + '\n';
+}
+
+std::vector<std::string> QueryProtocolHelper::splitLine(const std::string& line)
+{
+	size_t end = line.size();
+	while (end > 0 && (line[end - 1] == '\n' || line[end - 1] == '\r'))
+	{
+		end--;
+	}
+
+	std::vector<std::string> fields;
+	size_t start = 0;
+	while (true)
+	{
+		const size_t pos = line.find('\t', start);
+		if (pos == std::string::npos || pos >= end)
+		{
+			fields.push_back(line.substr(start, end - start));
+			break;
+		}
+
+		fields.push_back(line.substr(start, pos - start));
+		start = pos + 1;
+	}
+	return fields;
+}
+
+std::string QueryProtocolHelper::escapeField(const std::wstring& field)
+{
+	const std::string text = utility::encodeToUtf8(field);
+
+	std::string escaped;
+	escaped.reserve(text.size());
+	for (char c: text)
+	{
+		switch (c)
+		{
+		case '\\':
+			escaped += "\\\\";
+			break;
+		case '\t':
+			escaped += "\\t";
+			break;
+		case '\n':
+			escaped += "\\n";
+			break;
+		case '\r':
+			escaped += "\\r";
+			break;
+		default:
+			escaped += c;
+		}
+	}
+	return escaped;
+}
+
+std::wstring QueryProtocolHelper::unescapeField(const std::string& field)
+{
+	std::string text;
+	text.reserve(field.size());
+	for (size_t i = 0; i < field.size(); i++)
+	{
+		if (field[i] != '\\' || i + 1 == field.size())
+		{
+			text += field[i];
+			continue;
+		}
+
+		switch (field[++i])
+		{
+		case 't':
+			text += '\t';
+			break;
+		case 'n':
+			text += '\n';
+			break;
+		case 'r':
+			text += '\r';
+			break;
+		default:
+			text += field[i];
+		}
+	}
+	return utility::decodeFromUtf8(text);
+}
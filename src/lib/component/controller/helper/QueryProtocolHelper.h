@@ -0,0 +1,56 @@
+#ifndef QUERY_PROTOCOL_HELPER_H
+#define QUERY_PROTOCOL_HELPER_H
+
+#include <string>
+#include <vector>
+
+// Line based protocol of the headless query server. All text is UTF-8, fields are separated by
+// tabs and tabs, newlines and backslashes inside of fields are escaped. The ">>" divider of the IDE
+// plugin protocol is not used, because it is part of many template names.
+//
+// request:  <id> \t <command> \t <argument>... \n
+// response: <id> \t ok \t <row count> \n followed by one line per row with tab separated fields
+//           <id> \t error \t <message> \n
+class QueryProtocolHelper
+{
+public:
+	struct Request
+	{
+		std::string id;
+		std::string command;
+		std::vector<std::wstring> arguments;
+		bool valid = false;
+	};
+
+	struct ResponseHeader
+	{
+		std::string id;
+		bool ok = false;
+		size_t rowCount = 0;
+		std::wstring errorMessage;
+		bool valid = false;
+	};
+
+	static Request parseRequest(const std::string& line);
+	static std::string buildRequest(
+		const std::string& id,
+		const std::string& command,
+		const std::vector<std::wstring>& arguments);
+
+	static ResponseHeader parseResponseHeader(const std::string& line);
+	static std::vector<std::wstring> parseResponseRow(const std::string& line);
+
+	static std::string buildResponse(
+		const std::string& id, const std::vector<std::vector<std::wstring>>& rows);
+	static std::string buildErrorResponse(const std::string& id, const std::wstring& message);
+
+	static const std::string s_okStatus;
+	static const std::string s_errorStatus;
+
+private:
+	static std::vector<std::string> splitLine(const std::string& line);
+	static std::string escapeField(const std::wstring& field);
+	static std::wstring unescapeField(const std::string& field);
+};
+
+#endif	  // QUERY_PROTOCOL_HELPER_H
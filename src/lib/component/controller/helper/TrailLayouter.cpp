@@ -1,7 +1,16 @@
 #include "TrailLayouter.h"
 
+#include <algorithm>
 #include <iostream>
 
+#include "TimeStamp.h"
+
+namespace
+{
+const size_t s_maxCrossingReductionSweeps = 24;
+const size_t s_crossingReductionTimeBudgetMS = 200;
+}	 // namespace
+
 TrailLayouter::TrailLayouter(LayoutDirection dir): m_direction(dir), m_rootNode(nullptr) {}
 
 void TrailLayouter::layoutGraph(
@@ -17,7 +26,10 @@ void TrailLayouter::layoutGraph(
 	}
 
 	removeDeadEnds();
-	makeAcyclicRecursive(m_rootNode, std::set<TrailNode*>());
+
+	std::set<TrailNode*> predecessors;
+	std::set<TrailNode*> visitedNodes;
+	makeAcyclicRecursive(m_rootNode, predecessors, visitedNodes);
 
 	assignLongestPathLevels();
 	assignRemainingLevels();
@@ -138,20 +150,25 @@ void TrailLayouter::removeDeadEnds()
 	}
 }
 
-void TrailLayouter::makeAcyclicRecursive(TrailNode* node, std::set<TrailNode*> predecessors)
+void TrailLayouter::makeAcyclicRecursive(
+	TrailNode* node, std::set<TrailNode*>& predecessors, std::set<TrailNode*>& visitedNodes)
 {
+	// depth first search that switches all edges pointing back onto the current path, each node
+	// is only visited once to avoid walking every path of the graph
+	visitedNodes.insert(node);
 	predecessors.insert(node);
 
-	std::set<TrailEdge*> edgesToSwitch;
-	for (TrailEdge* edge: node->outgoingEdges)
+	std::vector<TrailEdge*> edgesToSwitch;
+	const std::vector<TrailEdge*> outgoingEdges = node->outgoingEdges;
+	for (TrailEdge* edge: outgoingEdges)
 	{
 		if (predecessors.find(edge->target) != predecessors.end())
 		{
-			edgesToSwitch.insert(edge);
+			edgesToSwitch.push_back(edge);
 		}
-		else
+		else if (visitedNodes.find(edge->target) == visitedNodes.end())
 		{
-			makeAcyclicRecursive(edge->target, predecessors);
+			makeAcyclicRecursive(edge->target, predecessors, visitedNodes);
 		}
 	}
 
@@ -159,6 +176,8 @@ void TrailLayouter::makeAcyclicRecursive(TrailNode* node, std::set<TrailNode*> p
 	{
 		switchEdge(edge);
 	}
+
+	predecessors.erase(node);
 }
 
 void TrailLayouter::assignLongestPathLevels()
@@ -276,6 +295,7 @@ void TrailLayouter::addVirtualNodes()
 		{
 			std::shared_ptr<TrailNode> virtualNode = std::make_shared<TrailNode>();
 			virtualNode->id = 0;
+			virtualNode->index = 0;
 			virtualNode->name = L"<virtual>";
 			virtualNode->dummyNode = nullptr;
 			virtualNode->level = i;
@@ -290,12 +310,12 @@ void TrailLayouter::addVirtualNodes()
 			virtualEdge->id = 0;
 
 			virtualEdge->origin = edge->origin;
-			virtualEdge->origin->outgoingEdges.erase(edge.get());
-			virtualEdge->origin->outgoingEdges.insert(virtualEdge.get());
+			removeEdge(virtualEdge->origin->outgoingEdges, edge.get());
+			virtualEdge->origin->outgoingEdges.push_back(virtualEdge.get());
 
 			virtualEdge->target = virtualNode.get();
-			virtualEdge->target->incomingEdges.insert(virtualEdge.get());
-			virtualEdge->target->outgoingEdges.insert(edge.get());
+			virtualEdge->target->incomingEdges.push_back(virtualEdge.get());
+			virtualEdge->target->outgoingEdges.push_back(edge.get());
 
 			edge->origin = virtualNode.get();
 			newEdges.push_back(virtualEdge);
@@ -321,65 +341,159 @@ void TrailLayouter::buildColumns()
 
 void TrailLayouter::reduceEdgeCrossings()
 {
+	updateColumnIndices();
+
+	// initial ordering, columns following a column with a single node are ordered by successors
 	for (size_t i = 1; i < m_nodesPerCol.size(); i++)
 	{
-		std::vector<TrailNode*> nodes = m_nodesPerCol[i];
-
 		bool usePredecessors = true;
-		std::vector<TrailNode*> neighbors = m_nodesPerCol[i - 1];
-		if (neighbors.size() == 1 && i + 1 < m_nodesPerCol.size() && m_nodesPerCol[i + 1].size() > 0)
+		if (m_nodesPerCol[i - 1].size() == 1 && i + 1 < m_nodesPerCol.size() &&
+			m_nodesPerCol[i + 1].size() > 0)
 		{
-			neighbors = m_nodesPerCol[i + 1];
 			usePredecessors = false;
 		}
 
-		std::map<TrailNode*, size_t> neighborIndices;
-		for (size_t j = 0; j < neighbors.size(); j++)
+		orderColumnByBarycenters(i, usePredecessors);
+	}
+
+	// alternating barycenter sweeps, keep the ordering with the fewest crossings
+	size_t bestCrossingCount = countEdgeCrossings();
+	std::vector<std::vector<TrailNode*>> bestNodesPerCol = m_nodesPerCol;
+
+	const TimeStamp startTime = TimeStamp::now();
+	for (size_t sweep = 0; sweep < s_maxCrossingReductionSweeps && bestCrossingCount > 0; sweep++)
+	{
+		if (TimeStamp::now().deltaMS(startTime) > s_crossingReductionTimeBudgetMS)
 		{
-			neighborIndices.emplace(neighbors[j], j);
+			break;
 		}
 
-		std::multimap<float, TrailNode*> newOrder;
+		const bool forward = sweep % 2 == 0;
+		for (size_t i = 1; i < m_nodesPerCol.size(); i++)
+		{
+			size_t col = forward ? i : m_nodesPerCol.size() - i;
+			if (!forward && col + 1 >= m_nodesPerCol.size())
+			{
+				continue;
+			}
+
+			orderColumnByBarycenters(col, forward);
+		}
 
-		for (size_t j = 0; j < nodes.size(); j++)
+		const size_t crossingCount = countEdgeCrossings();
+		if (crossingCount < bestCrossingCount)
 		{
-			TrailNode* node = nodes[j];
+			bestCrossingCount = crossingCount;
+			bestNodesPerCol = m_nodesPerCol;
+		}
+		else if (!forward)
+		{
+			break;
+		}
+	}
 
-			size_t sum = 0;
-			size_t count = 0;
+	m_nodesPerCol = bestNodesPerCol;
+	updateColumnIndices();
+}
+
+void TrailLayouter::orderColumnByBarycenters(size_t col, bool usePredecessors)
+{
+	std::vector<TrailNode*>& nodes = m_nodesPerCol[col];
+	const size_t neighborCol = usePredecessors ? col - 1 : col + 1;
 
-			if (usePredecessors)
+	std::vector<std::pair<float, TrailNode*>> newOrder;
+	newOrder.reserve(nodes.size());
+
+	for (size_t j = 0; j < nodes.size(); j++)
+	{
+		TrailNode* node = nodes[j];
+
+		size_t sum = 0;
+		size_t count = 0;
+
+		for (TrailEdge* edge: usePredecessors ? node->incomingEdges : node->outgoingEdges)
+		{
+			TrailNode* neighbor = usePredecessors ? edge->origin : edge->target;
+			if (static_cast<size_t>(neighbor->level + 1) == neighborCol)
 			{
-				for (TrailEdge* edge: node->incomingEdges)
-				{
-					sum += neighborIndices[edge->origin];
-					count++;
-				}
+				sum += neighbor->index;
+				count++;
 			}
-			else
+		}
+
+		float value = float(j);
+		if (count)
+		{
+			value = float(sum) / count;
+		}
+		newOrder.emplace_back(value, node);
+	}
+
+	std::stable_sort(
+		newOrder.begin(),
+		newOrder.end(),
+		[](const std::pair<float, TrailNode*>& a, const std::pair<float, TrailNode*>& b) {
+			return a.first < b.first;
+		});
+
+	for (size_t j = 0; j < newOrder.size(); j++)
+	{
+		nodes[j] = newOrder[j].second;
+		nodes[j]->index = j;
+	}
+}
+
+void TrailLayouter::updateColumnIndices()
+{
+	for (std::vector<TrailNode*>& nodes: m_nodesPerCol)
+	{
+		for (size_t j = 0; j < nodes.size(); j++)
+		{
+			nodes[j]->index = j;
+		}
+	}
+}
+
+size_t TrailLayouter::countEdgeCrossings() const
+{
+	size_t crossingCount = 0;
+
+	for (size_t i = 1; i + 1 < m_nodesPerCol.size(); i++)
+	{
+		std::vector<std::pair<size_t, size_t>> edgeIndices;
+		for (TrailNode* node: m_nodesPerCol[i])
+		{
+			for (TrailEdge* edge: node->outgoingEdges)
 			{
-				for (TrailEdge* edge: node->outgoingEdges)
+				if (edge->target->level == node->level + 1)
 				{
-					sum += neighborIndices[edge->target];
-					count++;
+					edgeIndices.emplace_back(node->index, edge->target->index);
 				}
 			}
+		}
 
-			float value = float(j);
-			if (count)
+		std::sort(edgeIndices.begin(), edgeIndices.end());
+
+		// count inversions of target indices with a fenwick tree
+		std::vector<size_t> tree(m_nodesPerCol[i + 1].size() + 1, 0);
+		for (size_t j = 0; j < edgeIndices.size(); j++)
+		{
+			size_t smallerOrEqualCount = 0;
+			for (size_t k = edgeIndices[j].second + 1; k > 0; k -= k & (~k + 1))
 			{
-				value = float(sum) / count;
+				smallerOrEqualCount += tree[k];
 			}
-			newOrder.emplace(value, node);
-		}
 
-		nodes.clear();
-		for (std::pair<float, TrailNode*> p: newOrder)
-		{
-			nodes.push_back(p.second);
+			crossingCount += j - smallerOrEqualCount;
+
+			for (size_t k = edgeIndices[j].second + 1; k < tree.size(); k += k & (~k + 1))
+			{
+				tree[k]++;
+			}
 		}
-		m_nodesPerCol[i] = nodes;
 	}
+
+	return crossingCount;
 }
 
 void TrailLayouter::layout()
@@ -657,6 +771,7 @@ void TrailLayouter::addNode(const std::shared_ptr<DummyNode>& dummyNode)
 	node->name = dummyNode->name;
 	node->dummyNode = dummyNode.get();
 	node->level = -1;
+	node->index = 0;
 
 	node->size = dummyNode->size;
 
@@ -703,35 +818,38 @@ void TrailLayouter::addEdge(
 	edge->origin = origin->second;
 	edge->target = target->second;
 
-	for (std::shared_ptr<TrailEdge>& e: m_allEdges)
+	auto it = m_edgesByNodes.find(std::minmax(edge->origin, edge->target));
+	if (it != m_edgesByNodes.end())
 	{
-		if ((e->origin == edge->origin && e->target == edge->target) ||
-			(e->origin == edge->target && e->target == edge->origin))
-		{
-			e->dummyEdges.push_back(dummyEdge.get());
-			return;
-		}
+		it->second->dummyEdges.push_back(dummyEdge.get());
+		return;
 	}
 
 	edge->dummyEdges.push_back(dummyEdge.get());
 
-	edge->origin->outgoingEdges.insert(edge.get());
-	edge->target->incomingEdges.insert(edge.get());
+	edge->origin->outgoingEdges.push_back(edge.get());
+	edge->target->incomingEdges.push_back(edge.get());
 
+	m_edgesByNodes.emplace(std::minmax(edge->origin, edge->target), edge.get());
 	m_allEdges.push_back(edge);
 }
 
 void TrailLayouter::switchEdge(TrailEdge* edge)
 {
-	edge->origin->outgoingEdges.erase(edge);
-	edge->origin->incomingEdges.insert(edge);
+	removeEdge(edge->origin->outgoingEdges, edge);
+	edge->origin->incomingEdges.push_back(edge);
 
-	edge->target->incomingEdges.erase(edge);
-	edge->target->outgoingEdges.insert(edge);
+	removeEdge(edge->target->incomingEdges, edge);
+	edge->target->outgoingEdges.push_back(edge);
 
 	std::swap(edge->origin, edge->target);
 }
 
+void TrailLayouter::removeEdge(std::vector<TrailEdge*>& edges, TrailEdge* edge)
+{
+	edges.erase(std::remove(edges.begin(), edges.end(), edge), edges.end());
+}
+
 bool TrailLayouter::horizontalLayout() const
 {
 	return m_direction == LAYOUT_LEFT_RIGHT || m_direction == LAYOUT_RIGHT_LEFT;
@@ -35,13 +35,14 @@ private:
 	{
 		Id id;
 		int level;
+		size_t index;
 		std::wstring name;
 
 		Vec2i pos;
 		Vec2i size;
 
-		std::set<TrailEdge*> incomingEdges;
-		std::set<TrailEdge*> outgoingEdges;
+		std::vector<TrailEdge*> incomingEdges;
+		std::vector<TrailEdge*> outgoingEdges;
 
 		DummyNode* dummyNode;
 	};
@@ -63,7 +64,8 @@ private:
 		const std::map<Id, Id>& topLevelAncestorIds);
 
 	void removeDeadEnds();
-	void makeAcyclicRecursive(TrailNode* node, std::set<TrailNode*> predecessors);
+	void makeAcyclicRecursive(
+		TrailNode* node, std::set<TrailNode*>& predecessors, std::set<TrailNode*>& visitedNodes);
 
 	void assignLongestPathLevels();
 	void assignRemainingLevels();
@@ -71,6 +73,9 @@ private:
 	void addVirtualNodes();
 	void buildColumns();
 	void reduceEdgeCrossings();
+	void orderColumnByBarycenters(size_t col, bool usePredecessors);
+	void updateColumnIndices();
+	size_t countEdgeCrossings() const;
 
 	void layout();
 	void moveNodesToAveragePosition(std::vector<TrailNode*> nodes, bool forward);
@@ -82,6 +87,8 @@ private:
 	void addEdge(const std::shared_ptr<DummyEdge> dummyEdge, const std::map<Id, Id>& topLevelAncestorIds);
 	void switchEdge(TrailEdge* edge);
 
+	static void removeEdge(std::vector<TrailEdge*>& edges, TrailEdge* edge);
+
 	bool horizontalLayout() const;
 	bool invertedLayout() const;
 
@@ -91,6 +98,7 @@ private:
 	std::vector<std::shared_ptr<TrailEdge>> m_allEdges;
 
 	std::map<Id, TrailNode*> m_nodesById;
+	std::map<std::pair<TrailNode*, TrailNode*>, TrailEdge*> m_edgesByNodes;
 	TrailNode* m_rootNode;
 
 	std::vector<std::vector<TrailNode*>> m_nodesPerCol;
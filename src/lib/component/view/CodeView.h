@@ -46,6 +46,8 @@ public:
 		std::vector<Id> currentActiveLocalLocationIds;
 
 		std::vector<ErrorInfo> errorInfos;
+
+		bool hasMoreFullTextSearchResults = false;
 	};
 
 	CodeView(ViewLayout* viewLayout);
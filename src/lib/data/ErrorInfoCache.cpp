@@ -0,0 +1,162 @@
+#include "ErrorInfoCache.h"
+
+#include <algorithm>
+
+void ErrorInfoCache::clear()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	doClear();
+}
+
+bool ErrorInfoCache::isLoaded() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_isLoaded;
+}
+
+void ErrorInfoCache::load(const std::vector<ErrorInfo>& errors)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	doLoad(errors);
+}
+
+void ErrorInfoCache::loadIfNotLoaded(const std::function<std::vector<ErrorInfo>()>& getErrors)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	if (!m_isLoaded)
+	{
+		doLoad(getErrors());
+	}
+}
+
+std::vector<ErrorInfo> ErrorInfoCache::append(const std::vector<ErrorInfo>& errors)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	if (!m_isLoaded)
+	{
+		return std::vector<ErrorInfo>();
+	}
+
+	return doAppend(errors);
+}
+
+void ErrorInfoCache::appendOrLoad(
+	const std::function<std::vector<ErrorInfo>()>& getNewErrors,
+	const std::function<std::vector<ErrorInfo>()>& getAllErrors)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	if (m_isLoaded)
+	{
+		doAppend(getNewErrors());
+	}
+	else
+	{
+		doLoad(getAllErrors());
+	}
+}
+
+size_t ErrorInfoCache::getErrorCount() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_errors.size();
+}
+
+ErrorCountInfo ErrorInfoCache::getErrorCountInfo() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return ErrorCountInfo(m_errors.size(), m_fatalErrorCount);
+}
+
+std::vector<ErrorInfo> ErrorInfoCache::getErrors(size_t firstIndex) const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	if (firstIndex >= m_errors.size())
+	{
+		return std::vector<ErrorInfo>();
+	}
+
+	return std::vector<ErrorInfo>(m_errors.begin() + firstIndex, m_errors.end());
+}
+
+std::vector<ErrorInfo> ErrorInfoCache::getErrors(const ErrorFilter& filter) const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return filter.filterErrors(m_errors);
+}
+
+std::vector<ErrorInfo> ErrorInfoCache::getErrorsInFiles(
+	const std::set<std::wstring>& filePaths, const ErrorFilter& filter, bool fatalOnly) const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	std::vector<size_t> indices;
+	for (const std::wstring& filePath: filePaths)
+	{
+		auto it = m_errorIndicesByFilePath.find(filePath);
+		if (it != m_errorIndicesByFilePath.end())
+		{
+			indices.insert(indices.end(), it->second.begin(), it->second.end());
+		}
+	}
+
+	// keep the order in which the errors were recorded
+	std::sort(indices.begin(), indices.end());
+
+	std::vector<ErrorInfo> errors;
+	for (size_t index: indices)
+	{
+		const ErrorInfo& error = m_errors[index];
+		if ((!fatalOnly || error.fatal) && filter.filter(error))
+		{
+			errors.push_back(error);
+		}
+	}
+	return errors;
+}
+
+void ErrorInfoCache::doClear()
+{
+	m_isLoaded = false;
+	m_errors.clear();
+	m_fatalErrorCount = 0;
+	m_errorIndicesByFilePath.clear();
+	m_occurrenceCountsByErrorId.clear();
+}
+
+void ErrorInfoCache::doLoad(const std::vector<ErrorInfo>& errors)
+{
+	doClear();
+	doAppend(errors);
+	m_isLoaded = true;
+}
+
+std::vector<ErrorInfo> ErrorInfoCache::doAppend(const std::vector<ErrorInfo>& errors)
+{
+	std::vector<ErrorInfo> appendedErrors;
+	appendedErrors.reserve(errors.size());
+
+	for (const ErrorInfo& error: errors)
+	{
+		// There can be multiple errors with the same id, so a count is added to the id
+		size_t& occurrenceCount = m_occurrenceCountsByErrorId[error.id];
+
+		ErrorInfo appendedError = error;
+		appendedError.id = error.id * 10000 + occurrenceCount;
+		occurrenceCount++;
+
+		if (appendedError.fatal)
+		{
+			m_fatalErrorCount++;
+		}
+
+		m_errorIndicesByFilePath[appendedError.filePath].push_back(m_errors.size());
+		m_errors.push_back(appendedError);
+		appendedErrors.push_back(appendedError);
+	}
+
+	return appendedErrors;
+}
@@ -0,0 +1,58 @@
+#ifndef ERROR_INFO_CACHE_H
+#define ERROR_INFO_CACHE_H
+
+#include <functional>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "ErrorCountInfo.h"
+#include "ErrorFilter.h"
+#include "ErrorInfo.h"
+
+// Keeps all recorded errors in memory, so that errors of an injection can be appended without
+// reloading the whole error table. Errors passed in carry the id of their error element, which
+// gets turned into a unique id for each occurrence of that error.
+class ErrorInfoCache
+{
+public:
+	void clear();
+	bool isLoaded() const;
+
+	void load(const std::vector<ErrorInfo>& errors);
+	// the errors are only requested if the cache is not loaded, checking and loading is atomic
+	void loadIfNotLoaded(const std::function<std::vector<ErrorInfo>()>& getErrors);
+
+	// returns the appended errors with their unique ids, nothing if the cache is not loaded
+	std::vector<ErrorInfo> append(const std::vector<ErrorInfo>& errors);
+	// appends the new errors if the cache is loaded and loads all errors otherwise
+	void appendOrLoad(
+		const std::function<std::vector<ErrorInfo>()>& getNewErrors,
+		const std::function<std::vector<ErrorInfo>()>& getAllErrors);
+
+	size_t getErrorCount() const;
+	ErrorCountInfo getErrorCountInfo() const;
+
+	std::vector<ErrorInfo> getErrors(size_t firstIndex = 0) const;
+	std::vector<ErrorInfo> getErrors(const ErrorFilter& filter) const;
+	std::vector<ErrorInfo> getErrorsInFiles(
+		const std::set<std::wstring>& filePaths, const ErrorFilter& filter, bool fatalOnly) const;
+
+private:
+	void doClear();
+	void doLoad(const std::vector<ErrorInfo>& errors);
+	std::vector<ErrorInfo> doAppend(const std::vector<ErrorInfo>& errors);
+
+	mutable std::mutex m_mutex;
+
+	bool m_isLoaded = false;
+	std::vector<ErrorInfo> m_errors;
+	size_t m_fatalErrorCount = 0;
+
+	std::map<std::wstring, std::vector<size_t>> m_errorIndicesByFilePath;
+	std::map<Id, size_t> m_occurrenceCountsByErrorId;
+};
+
+#endif	  // ERROR_INFO_CACHE_H
@@ -0,0 +1,127 @@
+#include "FileDependencyGraph.h"
+
+#include <algorithm>
+
+FileDependencyGraph::FileDependencyGraph(const std::vector<std::pair<Id, Id>>& dependencies)
+{
+	m_fileIds.reserve(dependencies.size() * 2);
+	for (const std::pair<Id, Id>& dependency: dependencies)
+	{
+		m_fileIds.push_back(dependency.first);
+		m_fileIds.push_back(dependency.second);
+	}
+	std::sort(m_fileIds.begin(), m_fileIds.end());
+	m_fileIds.erase(std::unique(m_fileIds.begin(), m_fileIds.end()), m_fileIds.end());
+
+	std::vector<std::pair<size_t, size_t>> edges;
+	edges.reserve(dependencies.size());
+	for (const std::pair<Id, Id>& dependency: dependencies)
+	{
+		edges.emplace_back(getIndex(dependency.first), getIndex(dependency.second));
+	}
+	std::sort(edges.begin(), edges.end());
+	edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+	m_dependencies = buildAdjacency(edges, m_fileIds.size());
+
+	for (std::pair<size_t, size_t>& edge: edges)
+	{
+		std::swap(edge.first, edge.second);
+	}
+	std::sort(edges.begin(), edges.end());
+
+	m_dependents = buildAdjacency(edges, m_fileIds.size());
+}
+
+size_t FileDependencyGraph::getFileCount() const
+{
+	return m_fileIds.size();
+}
+
+std::set<Id> FileDependencyGraph::getDependencies(const std::set<Id>& fileIds) const
+{
+	return getReachable(fileIds, m_dependencies);
+}
+
+std::set<Id> FileDependencyGraph::getDependents(const std::set<Id>& fileIds) const
+{
+	return getReachable(fileIds, m_dependents);
+}
+
+FileDependencyGraph::Adjacency FileDependencyGraph::buildAdjacency(
+	const std::vector<std::pair<size_t, size_t>>& edges, size_t nodeCount)
+{
+	Adjacency adjacency;
+	adjacency.offsets.resize(nodeCount + 1, 0);
+	adjacency.targets.reserve(edges.size());
+
+	for (const std::pair<size_t, size_t>& edge: edges)
+	{
+		adjacency.offsets[edge.first + 1]++;
+		adjacency.targets.push_back(edge.second);
+	}
+
+	for (size_t i = 0; i < nodeCount; i++)
+	{
+		adjacency.offsets[i + 1] += adjacency.offsets[i];
+	}
+
+	return adjacency;
+}
+
+size_t FileDependencyGraph::getIndex(Id fileId) const
+{
+	auto it = std::lower_bound(m_fileIds.begin(), m_fileIds.end(), fileId);
+	if (it == m_fileIds.end() || *it != fileId)
+	{
+		return m_fileIds.size();
+	}
+	return it - m_fileIds.begin();
+}
+
+std::set<Id> FileDependencyGraph::getReachable(
+	const std::set<Id>& fileIds, const Adjacency& adjacency) const
+{
+	std::vector<bool> visited(m_fileIds.size(), false);
+	std::vector<bool> reached(m_fileIds.size(), false);
+	std::vector<size_t> stack;
+
+	for (Id fileId: fileIds)
+	{
+		const size_t index = getIndex(fileId);
+		if (index < m_fileIds.size() && !visited[index])
+		{
+			visited[index] = true;
+			stack.push_back(index);
+		}
+	}
+
+	// the given files are only part of the result if they are reachable from one of them
+	while (!stack.empty())
+	{
+		const size_t index = stack.back();
+		stack.pop_back();
+
+		for (size_t i = adjacency.offsets[index]; i < adjacency.offsets[index + 1]; i++)
+		{
+			const size_t target = adjacency.targets[i];
+			reached[target] = true;
+
+			if (!visited[target])
+			{
+				visited[target] = true;
+				stack.push_back(target);
+			}
+		}
+	}
+
+	std::set<Id> reachedIds;
+	for (size_t i = 0; i < reached.size(); i++)
+	{
+		if (reached[i])
+		{
+			reachedIds.insert(reachedIds.end(), m_fileIds[i]);
+		}
+	}
+	return reachedIds;
+}
@@ -0,0 +1,46 @@
+#ifndef FILE_DEPENDENCY_GRAPH_H
+#define FILE_DEPENDENCY_GRAPH_H
+
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "types.h"
+
+// Dependencies between files, like includes or imports. The edges are stored in compressed sparse
+// row format in both directions, so transitive queries don't need to build any maps.
+class FileDependencyGraph
+{
+public:
+	FileDependencyGraph() = default;
+
+	// each pair goes from the depending file to the file it depends on
+	explicit FileDependencyGraph(const std::vector<std::pair<Id, Id>>& dependencies);
+
+	size_t getFileCount() const;
+
+	// all files that the given files depend on, directly or indirectly
+	std::set<Id> getDependencies(const std::set<Id>& fileIds) const;
+
+	// all files that depend on the given files, directly or indirectly
+	std::set<Id> getDependents(const std::set<Id>& fileIds) const;
+
+private:
+	struct Adjacency
+	{
+		std::vector<size_t> offsets;
+		std::vector<size_t> targets;
+	};
+
+	static Adjacency buildAdjacency(
+		const std::vector<std::pair<size_t, size_t>>& edges, size_t nodeCount);
+
+	size_t getIndex(Id fileId) const;
+	std::set<Id> getReachable(const std::set<Id>& fileIds, const Adjacency& adjacency) const;
+
+	std::vector<Id> m_fileIds;	  // sorted, the position is used as node index
+	Adjacency m_dependencies;
+	Adjacency m_dependents;
+};
+
+#endif	  // FILE_DEPENDENCY_GRAPH_H
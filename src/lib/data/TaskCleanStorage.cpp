@@ -4,6 +4,7 @@
 #include "Blackboard.h"
 #include "DialogView.h"
 #include "FilePath.h"
+#include "IndexingStatistics.h"
 #include "PersistentStorage.h"
 
 TaskCleanStorage::TaskCleanStorage(
@@ -38,6 +39,8 @@ Task::TaskState TaskCleanStorage::doUpdate(std::shared_ptr<Blackboard> blackboar
 {
 	if (std::shared_ptr<PersistentStorage> storage = m_storage.lock())
 	{
+		IndexingStatistics::ScopedPhase phase(IndexingStatistics::s_cleanPhaseName);
+
 		if (m_clearAllErrors)
 		{
 			storage->clearAllErrors();
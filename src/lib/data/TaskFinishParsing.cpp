@@ -2,11 +2,13 @@
 
 #include "Blackboard.h"
 #include "DialogView.h"
+#include "IndexingStatistics.h"
 #include "MessageIndexingFinished.h"
 #include "MessageIndexingStatus.h"
 #include "MessageStatus.h"
 #include "PersistentStorage.h"
 #include "TimeStamp.h"
+#include "tracing.h"
 #include "utilityString.h"
 
 TaskFinishParsing::TaskFinishParsing(
@@ -33,7 +35,11 @@ Task::TaskState TaskFinishParsing::doUpdate(std::shared_ptr<Blackboard> blackboa
 	TimeStamp start = TimeStamp::now();
 
 	m_dialogView->showUnknownProgressDialog(L"Finish Indexing", L"Optimizing database");
-	m_storage->optimizeMemory();
+	{
+		TRACE("optimize database");
+		IndexingStatistics::ScopedPhase phase(IndexingStatistics::s_finishPhaseName);
+		m_storage->optimizeMemory();
+	}
 	m_dialogView->hideUnknownProgressDialog();
 
 	double time = TimeStamp::durationSeconds(start);
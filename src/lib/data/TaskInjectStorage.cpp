@@ -1,7 +1,9 @@
 #include "TaskInjectStorage.h"
 
+#include "IndexingStatistics.h"
 #include "Storage.h"
 #include "StorageProvider.h"
+#include "tracing.h"
 
 TaskInjectStorage::TaskInjectStorage(
 	std::shared_ptr<StorageProvider> storageProvider, std::weak_ptr<Storage> target)
@@ -20,6 +22,8 @@ Task::TaskState TaskInjectStorage::doUpdate(std::shared_ptr<Blackboard> blackboa
 		{
 			if (std::shared_ptr<Storage> target = m_target.lock())
 			{
+				TRACE("inject intermediate storage");
+				IndexingStatistics::ScopedPhase phase(IndexingStatistics::s_injectPhaseName);
 				target->inject(source.get());
 				return STATE_SUCCESS;
 			}
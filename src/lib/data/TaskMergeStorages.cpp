@@ -1,6 +1,8 @@
 #include "TaskMergeStorages.h"
 
+#include "IndexingStatistics.h"
 #include "StorageProvider.h"
+#include "tracing.h"
 
 TaskMergeStorages::TaskMergeStorages(std::shared_ptr<StorageProvider> storageProvider)
 	: m_storageProvider(storageProvider)
@@ -17,6 +19,8 @@ Task::TaskState TaskMergeStorages::doUpdate(std::shared_ptr<Blackboard> blackboa
 		std::shared_ptr<IntermediateStorage> source = m_storageProvider->consumeSecondLargestStorage();
 		if (target && source)
 		{
+			TRACE("merge intermediate storages");
+			IndexingStatistics::ScopedPhase phase(IndexingStatistics::s_mergePhaseName);
 			target->inject(source.get());
 			m_storageProvider->insert(target);
 			return STATE_SUCCESS;
@@ -1,9 +1,22 @@
 #include "FullTextSearchIndex.h"
+#include <algorithm>
 #include <limits>
 
 #include "logging.h"
 #include "tracing.h"
 
+int FullTextSearchResult::getLineNumber(int position) const
+{
+	return static_cast<int>(
+		std::upper_bound(lineOffsets->begin(), lineOffsets->end(), position) -
+		lineOffsets->begin());
+}
+
+int FullTextSearchResult::getColumnNumber(int position) const
+{
+	return position - (*lineOffsets)[getLineNumber(position) - 1] + 1;
+}
+
 void FullTextSearchIndex::addFile(Id fileId, const std::wstring& fileContent)
 {
 	if (fileContent.empty())
@@ -16,7 +29,16 @@ void FullTextSearchIndex::addFile(Id fileId, const std::wstring& fileContent)
 		LOG_ERROR("file too big not added to fulltextsearch index");
 	}
 
-	FullTextSearchFile fts_file(fileId, SuffixArray(fileContent));
+	std::shared_ptr<std::vector<int>> lineOffsets = std::make_shared<std::vector<int>>(1, 0);
+	for (size_t i = 0; i < fileContent.size(); i++)
+	{
+		if (fileContent[i] == L'\n')
+		{
+			lineOffsets->push_back(static_cast<int>(i + 1));
+		}
+	}
+
+	FullTextSearchFile fts_file(fileId, SuffixArray(fileContent), lineOffsets);
 
 	{
 		std::lock_guard<std::mutex> lock(m_filesMutex);
@@ -35,6 +57,7 @@ std::vector<FullTextSearchResult> FullTextSearchIndex::searchForTerm(const std::
 		{
 			FullTextSearchResult hit;
 			hit.fileId = f.fileId;
+			hit.lineOffsets = f.lineOffsets;
 			hit.positions = f.array.searchForTerm(term);
 			std::sort(hit.positions.begin(), hit.positions.end());
 			if (!hit.positions.empty())
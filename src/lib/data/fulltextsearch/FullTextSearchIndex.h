@@ -1,6 +1,7 @@
 #ifndef FULLTEXTSEARCH_INDEX_H
 #define FULLTEXTSEARCH_INDEX_H
 
+#include <memory>
 #include <mutex>
 #include <unordered_map>
 #include <vector>
@@ -13,15 +14,22 @@ class StorageAccess;
 // contains all fulltextsearch results of one file
 struct FullTextSearchResult
 {
+	// 1-based line and column numbers of a character position within the file
+	int getLineNumber(int position) const;
+	int getColumnNumber(int position) const;
+
 	Id fileId;
 	std::vector<int> positions;
+	std::shared_ptr<const std::vector<int>> lineOffsets;
 };
 
 struct FullTextSearchFile
 {
-	FullTextSearchFile(Id fileId, SuffixArray array): fileId(fileId), array(array) {};
+	FullTextSearchFile(Id fileId, SuffixArray array, std::shared_ptr<const std::vector<int>> lineOffsets)
+		: fileId(fileId), array(array), lineOffsets(lineOffsets) {};
 	Id fileId;
 	SuffixArray array;
+	std::shared_ptr<const std::vector<int>> lineOffsets;	// character positions of all line starts
 };
 
 class FullTextSearchIndex
@@ -0,0 +1,24 @@
+#ifndef FULLTEXTSEARCH_PAGE_H
+#define FULLTEXTSEARCH_PAGE_H
+
+#include <memory>
+
+#include "SourceLocationCollection.h"
+
+// results of one page of a fulltext search, pages are split between files
+struct FullTextSearchPage
+{
+	FullTextSearchPage(): locations(std::make_shared<SourceLocationCollection>()) {}
+
+	bool hasNextPage() const
+	{
+		return nextFileOffset < fileCount;
+	}
+
+	std::shared_ptr<SourceLocationCollection> locations;
+
+	size_t fileCount = 0;	  // all files containing the search term
+	size_t nextFileOffset = 0;	  // first file of the next page
+};
+
+#endif	  // FULLTEXTSEARCH_PAGE_H
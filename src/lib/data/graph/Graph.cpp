@@ -1,34 +1,59 @@
 #include "Graph.h"
 
+#include <algorithm>
+
 #include "logging.h"
 
-Graph::Graph(): m_trailMode(TRAIL_NONE) {}
+namespace
+{
+template <typename TokenType>
+void sortTokensById(std::vector<TokenType*>& tokens)
+{
+	std::sort(tokens.begin(), tokens.end(), [](const TokenType* a, const TokenType* b) {
+		return a->getId() < b->getId();
+	});
+}
+}	 // namespace
+
+Graph::Graph(): m_orderedNodesValid(true), m_orderedEdgesValid(true), m_trailMode(TRAIL_NONE) {}
 
 Graph::~Graph()
 {
-	m_edges.clear();
-	m_nodes.clear();
+	clear();
 }
 
 void Graph::clear()
 {
+	// all nodes are destroyed as well, so edges don't need to unregister from their nodes one by one
+	for (const std::pair<const Id, Node*>& p: m_nodes)
+	{
+		p.second->clearEdges();
+	}
+
 	m_edges.clear();
+	m_edgeArena.clear();
 	m_nodes.clear();
+	m_nodeArena.clear();
+
+	m_orderedNodes.clear();
+	m_orderedEdges.clear();
+	m_orderedNodesValid = true;
+	m_orderedEdgesValid = true;
 }
 
 void Graph::forEachNode(std::function<void(Node*)> func) const
 {
-	for (const std::pair<Id, std::shared_ptr<Node>>& node: m_nodes)
+	for (Node* node: getOrderedNodes())
 	{
-		func(node.second.get());
+		func(node);
 	}
 }
 
 void Graph::forEachEdge(std::function<void(Edge*)> func) const
 {
-	for (const std::pair<Id, std::shared_ptr<Edge>>& edge: m_edges)
+	for (Edge* edge: getOrderedEdges())
 	{
-		func(edge.second.get());
+		func(edge);
 	}
 }
 
@@ -46,10 +71,10 @@ Node* Graph::createNode(Id id, NodeType type, NameHierarchy nameHierarchy, Defin
 		return n;
 	}
 
-	std::shared_ptr<Node> node = std::make_shared<Node>(
-		id, type, std::move(nameHierarchy), definitionKind);
-	m_nodes.emplace(node->getId(), node);
-	return node.get();
+	Node* node = m_nodeArena.create(id, type, std::move(nameHierarchy), definitionKind);
+	m_nodes.emplace(id, node);
+	m_orderedNodesValid = false;
+	return node;
 }
 
 Edge* Graph::createEdge(Id id, Edge::EdgeType type, Node* from, Node* to)
@@ -66,9 +91,10 @@ Edge* Graph::createEdge(Id id, Edge::EdgeType type, Node* from, Node* to)
 		return nullptr;
 	}
 
-	std::shared_ptr<Edge> edge = std::make_shared<Edge>(id, type, from, to);
-	m_edges.emplace(edge->getId(), edge);
-	return edge.get();
+	Edge* edge = m_edgeArena.create(id, type, from, to);
+	m_edges.emplace(id, edge);
+	m_orderedEdgesValid = false;
+	return edge;
 }
 
 size_t Graph::getNodeCount() const
@@ -83,38 +109,28 @@ size_t Graph::getEdgeCount() const
 
 Node* Graph::getNodeById(Id id) const
 {
-	std::map<Id, std::shared_ptr<Node>>::const_iterator it = m_nodes.find(id);
+	std::unordered_map<Id, Node*>::const_iterator it = m_nodes.find(id);
 	if (it != m_nodes.end())
 	{
-		return it->second.get();
+		return it->second;
 	}
 	return nullptr;
 }
 
 Edge* Graph::getEdgeById(Id id) const
 {
-	std::map<Id, std::shared_ptr<Edge>>::const_iterator it = m_edges.find(id);
+	std::unordered_map<Id, Edge*>::const_iterator it = m_edges.find(id);
 	if (it != m_edges.end())
 	{
-		return it->second.get();
+		return it->second;
 	}
 	return nullptr;
 }
 
-const std::map<Id, std::shared_ptr<Node>>& Graph::getNodes() const
-{
-	return m_nodes;
-}
-
-const std::map<Id, std::shared_ptr<Edge>>& Graph::getEdges() const
-{
-	return m_edges;
-}
-
 void Graph::removeNode(Node* node)
 {
-	std::map<Id, std::shared_ptr<Node>>::const_iterator it = m_nodes.find(node->getId());
-	if (it == m_nodes.end())
+	std::unordered_map<Id, Node*>::const_iterator it = m_nodes.find(node->getId());
+	if (it == m_nodes.end() || it->second != node)
 	{
 		LOG_WARNING("Node was not found in the graph.");
 		return;
@@ -146,15 +162,18 @@ void Graph::removeNode(Node* node)
 		LOG_ERROR("Node still has edges.");
 	}
 
-	m_nodes.erase(it);
+	m_nodes.erase(node->getId());
+	m_nodeArena.destroy(node);
+	m_orderedNodesValid = false;
 }
 
 void Graph::removeEdge(Edge* edge)
 {
-	std::map<Id, std::shared_ptr<Edge>>::const_iterator it = m_edges.find(edge->getId());
-	if (it == m_edges.end())
+	std::unordered_map<Id, Edge*>::const_iterator it = m_edges.find(edge->getId());
+	if (it == m_edges.end() || it->second != edge)
 	{
 		LOG_WARNING("Edge was not found in the graph.");
+		return;
 	}
 
 	if (edge->getType() == Edge::EDGE_MEMBER)
@@ -163,19 +182,17 @@ void Graph::removeEdge(Edge* edge)
 		return;
 	}
 
-	m_edges.erase(it);
+	removeEdgeInternal(edge);
 }
 
 Node* Graph::findNode(std::function<bool(Node*)> func) const
 {
-	std::map<Id, std::shared_ptr<Node>>::const_iterator it = find_if(
-		m_nodes.begin(), m_nodes.end(), [&func](const std::pair<Id, std::shared_ptr<Node>>& n) {
-			return func(n.second.get());
-		});
+	const std::vector<Node*>& nodes = getOrderedNodes();
+	std::vector<Node*>::const_iterator it = find_if(nodes.begin(), nodes.end(), func);
 
-	if (it != m_nodes.end())
+	if (it != nodes.end())
 	{
-		return it->second.get();
+		return *it;
 	}
 
 	return nullptr;
@@ -183,14 +200,12 @@ Node* Graph::findNode(std::function<bool(Node*)> func) const
 
 Edge* Graph::findEdge(std::function<bool(Edge*)> func) const
 {
-	std::map<Id, std::shared_ptr<Edge>>::const_iterator it = find_if(
-		m_edges.begin(), m_edges.end(), [func](const std::pair<Id, std::shared_ptr<Edge>>& e) {
-			return func(e.second.get());
-		});
+	const std::vector<Edge*>& edges = getOrderedEdges();
+	std::vector<Edge*>::const_iterator it = find_if(edges.begin(), edges.end(), func);
 
-	if (it != m_edges.end())
+	if (it != edges.end())
 	{
-		return it->second.get();
+		return *it;
 	}
 
 	return nullptr;
@@ -221,9 +236,10 @@ Node* Graph::addNodeAsPlainCopy(Node* node)
 		return n;
 	}
 
-	std::shared_ptr<Node> copy = std::make_shared<Node>(*node);
+	Node* copy = m_nodeArena.create(*node);
 	m_nodes.emplace(copy->getId(), copy);
-	return copy.get();
+	m_orderedNodesValid = false;
+	return copy;
 }
 
 Edge* Graph::addEdgeAsPlainCopy(Edge* edge)
@@ -237,9 +253,10 @@ Edge* Graph::addEdgeAsPlainCopy(Edge* edge)
 	Node* from = addNodeAsPlainCopy(edge->getFrom());
 	Node* to = addNodeAsPlainCopy(edge->getTo());
 
-	std::shared_ptr<Edge> copy = std::make_shared<Edge>(*edge, from, to);
+	Edge* copy = m_edgeArena.create(*edge, from, to);
 	m_edges.emplace(copy->getId(), copy);
-	return copy.get();
+	m_orderedEdgesValid = false;
+	return copy;
 }
 
 Node* Graph::addNodeAndAllChildrenAsPlainCopy(Node* node)
@@ -325,11 +342,45 @@ void Graph::printBasic(std::wostream& ostream) const
 
 void Graph::removeEdgeInternal(Edge* edge)
 {
-	std::map<Id, std::shared_ptr<Edge>>::const_iterator it = m_edges.find(edge->getId());
-	if (it != m_edges.end() && it->second.get() == edge)
+	std::unordered_map<Id, Edge*>::const_iterator it = m_edges.find(edge->getId());
+	if (it != m_edges.end() && it->second == edge)
 	{
 		m_edges.erase(it);
+		m_edgeArena.destroy(edge);
+		m_orderedEdgesValid = false;
+	}
+}
+
+const std::vector<Node*>& Graph::getOrderedNodes() const
+{
+	if (!m_orderedNodesValid)
+	{
+		m_orderedNodes.clear();
+		m_orderedNodes.reserve(m_nodes.size());
+		for (const std::pair<const Id, Node*>& node: m_nodes)
+		{
+			m_orderedNodes.push_back(node.second);
+		}
+		sortTokensById(m_orderedNodes);
+		m_orderedNodesValid = true;
+	}
+	return m_orderedNodes;
+}
+
+const std::vector<Edge*>& Graph::getOrderedEdges() const
+{
+	if (!m_orderedEdgesValid)
+	{
+		m_orderedEdges.clear();
+		m_orderedEdges.reserve(m_edges.size());
+		for (const std::pair<const Id, Edge*>& edge: m_edges)
+		{
+			m_orderedEdges.push_back(edge.second);
+		}
+		sortTokensById(m_orderedEdges);
+		m_orderedEdgesValid = true;
 	}
+	return m_orderedEdges;
 }
 
 std::wostream& operator<<(std::wostream& ostream, const Graph& graph)
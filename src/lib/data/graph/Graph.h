@@ -1,13 +1,17 @@
 #ifndef GRAPH_H
 #define GRAPH_H
 
-#include <deque>
-#include <map>
 #include <memory>
+#include <unordered_map>
+#include <vector>
 
 #include "Edge.h"
 #include "Node.h"
+#include "ObjectArena.h"
 
+// Nodes and edges are created in arenas and found by id with a hash index, so large graphs don't
+// need separate allocations for each token. Tokens keep their address while they are part of the
+// graph and are visited in order of their ids.
 class Graph
 {
 public:
@@ -36,9 +40,6 @@ public:
 	Node* getNodeById(Id id) const;
 	Edge* getEdgeById(Id id) const;
 
-	const std::map<Id, std::shared_ptr<Node>>& getNodes() const;
-	const std::map<Id, std::shared_ptr<Edge>>& getEdges() const;
-
 	void removeNode(Node* node);
 	void removeEdge(Edge* edge);
 
@@ -71,8 +72,20 @@ private:
 
 	void removeEdgeInternal(Edge* edge);
 
-	std::map<Id, std::shared_ptr<Node>> m_nodes;
-	std::map<Id, std::shared_ptr<Edge>> m_edges;
+	const std::vector<Node*>& getOrderedNodes() const;
+	const std::vector<Edge*>& getOrderedEdges() const;
+
+	ObjectArena<Node> m_nodeArena;
+	ObjectArena<Edge> m_edgeArena;
+
+	std::unordered_map<Id, Node*> m_nodes;
+	std::unordered_map<Id, Edge*> m_edges;
+
+	// sorted by id, rebuilt on first use after the tokens changed
+	mutable std::vector<Node*> m_orderedNodes;
+	mutable std::vector<Edge*> m_orderedEdges;
+	mutable bool m_orderedNodesValid;
+	mutable bool m_orderedEdgesValid;
 
 	TrailMode m_trailMode;
 	bool m_hasTrailOrigin;
@@ -11,6 +11,7 @@
 
 Node::Node(Id id, NodeType type, NameHierarchy nameHierarchy, DefinitionKind definitionKind)
 	: Token(id)
+	, m_removedEdgeCount(0)
 	, m_type(type)
 	, m_nameHierarchy(std::move(nameHierarchy))
 	, m_definitionKind(definitionKind)
@@ -20,6 +21,7 @@ Node::Node(Id id, NodeType type, NameHierarchy nameHierarchy, DefinitionKind def
 
 Node::Node(const Node& other)
 	: Token(other)
+	, m_removedEdgeCount(0)
 	, m_type(other.m_type)
 	, m_nameHierarchy(other.m_nameHierarchy)
 	, m_definitionKind(other.m_definitionKind)
@@ -93,23 +95,53 @@ void Node::setChildCount(size_t childCount)
 
 size_t Node::getEdgeCount() const
 {
-	return m_edges.size();
+	return m_edges.size() - m_removedEdgeCount;
 }
 
 void Node::addEdge(Edge* edge)
 {
-	m_edges.emplace(edge->getId(), edge);
+	if (m_removedEdgeCount > m_edges.size() / 2)
+	{
+		removeRemovedEdges();
+	}
+
+	// edges are mostly added in order of their ids
+	const Id edgeId = edge->getId();
+	if (m_edges.empty() || m_edges.back().first < edgeId)
+	{
+		m_edges.emplace_back(edgeId, edge);
+		return;
+	}
+
+	auto it = findEdgeById(edgeId);
+	if (it == m_edges.end() || it->first != edgeId)
+	{
+		m_edges.emplace(it, edgeId, edge);
+	}
+	else if (!it->second)
+	{
+		it->second = edge;
+		m_removedEdgeCount--;
+	}
 }
 
 void Node::removeEdge(Edge* edge)
 {
-	auto it = m_edges.find(edge->getId());
-	if (it != m_edges.end())
+	// the slot is only cleared, so removing all edges of a node with many edges stays cheap
+	auto it = findEdgeById(edge->getId());
+	if (it != m_edges.end() && it->second == edge)
 	{
-		m_edges.erase(it);
+		it->second = nullptr;
+		m_removedEdgeCount++;
 	}
 }
 
+void Node::clearEdges()
+{
+	m_edges.clear();
+	m_removedEdgeCount = 0;
+}
+
 Node* Node::getParentNode() const
 {
 	Edge* edge = getMemberEdge();
@@ -149,8 +181,9 @@ bool Node::isParentOf(const Node* node) const
 
 Edge* Node::findEdge(std::function<bool(Edge*)> func) const
 {
-	auto it = find_if(
-		m_edges.begin(), m_edges.end(), [func](std::pair<Id, Edge*> p) { return func(p.second); });
+	auto it = find_if(m_edges.begin(), m_edges.end(), [&func](const std::pair<Id, Edge*>& p) {
+		return p.second && func(p.second);
+	});
 
 	if (it != m_edges.end())
 	{
@@ -167,13 +200,14 @@ Edge* Node::findEdgeOfType(Edge::TypeMask mask) const
 
 Edge* Node::findEdgeOfType(Edge::TypeMask mask, std::function<bool(Edge*)> func) const
 {
-	auto it = find_if(m_edges.begin(), m_edges.end(), [mask, func](std::pair<Id, Edge*> p) {
-		if (p.second->isType(mask))
-		{
-			return func(p.second);
-		}
-		return false;
-	});
+	auto it = find_if(
+		m_edges.begin(), m_edges.end(), [mask, &func](const std::pair<Id, Edge*>& p) {
+			if (p.second && p.second->isType(mask))
+			{
+				return func(p.second);
+			}
+			return false;
+		});
 
 	if (it != m_edges.end())
 	{
@@ -185,8 +219,8 @@ Edge* Node::findEdgeOfType(Edge::TypeMask mask, std::function<bool(Edge*)> func)
 
 Node* Node::findChildNode(std::function<bool(Node*)> func) const
 {
-	auto it = find_if(m_edges.begin(), m_edges.end(), [&func](std::pair<Id, Edge*> p) {
-		if (p.second->getType() == Edge::EDGE_MEMBER)
+	auto it = find_if(m_edges.begin(), m_edges.end(), [&func](const std::pair<Id, Edge*>& p) {
+		if (p.second && p.second->getType() == Edge::EDGE_MEMBER)
 		{
 			return func(p.second->getTo());
 		}
@@ -203,19 +237,25 @@ Node* Node::findChildNode(std::function<bool(Node*)> func) const
 
 void Node::forEachEdge(std::function<void(Edge*)> func) const
 {
-	for_each(m_edges.begin(), m_edges.end(), [func](std::pair<Id, Edge*> p) { func(p.second); });
-}
-
-void Node::forEachEdgeOfType(Edge::TypeMask mask, std::function<void(Edge*)> func) const
-{
-	for_each(m_edges.begin(), m_edges.end(), [mask, func](std::pair<Id, Edge*> p) {
-		if (p.second->isType(mask))
+	for_each(m_edges.begin(), m_edges.end(), [&func](const std::pair<Id, Edge*>& p) {
+		if (p.second)
 		{
 			func(p.second);
 		}
 	});
 }
 
+void Node::forEachEdgeOfType(Edge::TypeMask mask, std::function<void(Edge*)> func) const
+{
+	for_each(
+		m_edges.begin(), m_edges.end(), [mask, &func](const std::pair<Id, Edge*>& p) {
+			if (p.second && p.second->isType(mask))
+			{
+				func(p.second);
+			}
+		});
+}
+
 void Node::forEachChildNode(std::function<void(Node*)> func) const
 {
 	forEachEdgeOfType(Edge::EDGE_MEMBER, [func, this](Edge* e) {
@@ -278,6 +318,25 @@ std::wstring Node::getAsString() const
 	return str.str();
 }
 
+std::vector<std::pair<Id, Edge*>>::iterator Node::findEdgeById(Id edgeId)
+{
+	return std::lower_bound(
+		m_edges.begin(), m_edges.end(), edgeId, [](const std::pair<Id, Edge*>& p, Id id) {
+			return p.first < id;
+		});
+}
+
+void Node::removeRemovedEdges()
+{
+	m_edges.erase(
+		std::remove_if(
+			m_edges.begin(),
+			m_edges.end(),
+			[](const std::pair<Id, Edge*>& p) { return !p.second; }),
+		m_edges.end());
+	m_removedEdgeCount = 0;
+}
+
 std::wostream& operator<<(std::wostream& ostream, const Node& node)
 {
 	ostream << node.getAsString();
@@ -3,8 +3,8 @@
 
 #include <algorithm>
 #include <functional>
-#include <map>
 #include <string>
+#include <vector>
 
 #include "DefinitionKind.h"
 #include "Edge.h"
@@ -38,6 +38,8 @@ public:
 
 	void addEdge(Edge* edge);
 	void removeEdge(Edge* edge);
+	// forgets all edges without unregistering them, used when the whole graph is destroyed
+	void clearEdges();
 
 	Node* getParentNode() const;
 	Node* getLastParentNode();
@@ -65,7 +67,12 @@ public:
 private:
 	void operator=(const Node&);
 
-	std::map<Id, Edge*> m_edges;
+	std::vector<std::pair<Id, Edge*>>::iterator findEdgeById(Id edgeId);
+	void removeRemovedEdges();
+
+	// sorted by id, removed edges keep their id with a null edge until the next insertion
+	std::vector<std::pair<Id, Edge*>> m_edges;
+	size_t m_removedEdgeCount;
 
 	NodeType m_type;
 	const NameHierarchy m_nameHierarchy;
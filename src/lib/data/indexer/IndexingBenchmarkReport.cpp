@@ -0,0 +1,156 @@
+#include "IndexingBenchmarkReport.h"
+
+#include <iomanip>
+#include <locale>
+#include <sstream>
+
+#include "utilityString.h"
+
+namespace
+{
+std::string toJsonString(const std::string& str)
+{
+	std::ostringstream ss;
+	ss << '"';
+	for (const char c: str)
+	{
+		switch (c)
+		{
+		case '"':
+			ss << "\\\"";
+			break;
+		case '\\':
+			ss << "\\\\";
+			break;
+		case '\n':
+			ss << "\\n";
+			break;
+		case '\r':
+			ss << "\\r";
+			break;
+		case '\t':
+			ss << "\\t";
+			break;
+		default:
+			if (static_cast<unsigned char>(c) < 0x20)
+			{
+				ss << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+				   << static_cast<int>(c) << std::dec;
+			}
+			else
+			{
+				ss << c;
+			}
+		}
+	}
+	ss << '"';
+	return ss.str();
+}
+
+std::string toJsonString(const FilePath& filePath)
+{
+	return toJsonString(utility::encodeToUtf8(filePath.wstr()));
+}
+}	 // namespace
+
+IndexingBenchmarkReport::IndexingBenchmarkReport(
+	const FilePath& projectFilePath,
+	bool fullRefresh,
+	int indexerThreadCount,
+	bool multiProcessIndexing)
+	: m_projectFilePath(projectFilePath)
+	, m_fullRefresh(fullRefresh)
+	, m_indexerThreadCount(indexerThreadCount)
+	, m_multiProcessIndexing(multiProcessIndexing)
+{
+}
+
+void IndexingBenchmarkReport::addRun(
+	bool cold,
+	double durationMS,
+	const IndexingStatistics& statistics,
+	const std::map<std::string, size_t>& tableRowCounts)
+{
+	Run run;
+	run.cold = cold;
+	run.durationMS = durationMS;
+	run.phaseTimes = statistics.getPhaseTimes();
+	run.sourceFileTimes = statistics.getSourceFileTimes();
+	run.peakMemoryUsages = statistics.getPeakMemoryUsages();
+	run.tableRowCounts = tableRowCounts;
+	m_runs.push_back(run);
+}
+
+size_t IndexingBenchmarkReport::getRunCount() const
+{
+	return m_runs.size();
+}
+
+std::string IndexingBenchmarkReport::toJson() const
+{
+	std::ostringstream ss;
+	ss.imbue(std::locale::classic());
+	ss << std::fixed << std::setprecision(3);
+
+	ss << "{\n";
+	ss << "\t\"project\": " << toJsonString(m_projectFilePath) << ",\n";
+	ss << "\t\"refresh_mode\": \"" << (m_fullRefresh ? "full" : "incremental") << "\",\n";
+	ss << "\t\"indexer_thread_count\": " << m_indexerThreadCount << ",\n";
+	ss << "\t\"multi_process_indexing\": " << (m_multiProcessIndexing ? "true" : "false") << ",\n";
+	ss << "\t\"runs\": [";
+
+	for (size_t i = 0; i < m_runs.size(); i++)
+	{
+		const Run& run = m_runs[i];
+
+		ss << (i ? "," : "") << "\n\t\t{\n";
+		ss << "\t\t\t\"run\": " << i + 1 << ",\n";
+		ss << "\t\t\t\"cache\": \"" << (run.cold ? "cold" : "warm") << "\",\n";
+		ss << "\t\t\t\"duration_ms\": " << run.durationMS << ",\n";
+
+		ss << "\t\t\t\"phases\": {";
+		for (auto it = run.phaseTimes.begin(); it != run.phaseTimes.end(); it++)
+		{
+			ss << (it != run.phaseTimes.begin() ? "," : "") << "\n\t\t\t\t"
+			   << toJsonString(it->first) << ": {\"count\": " << it->second.count
+			   << ", \"total_ms\": " << it->second.totalMS << ", \"max_ms\": " << it->second.maxMS
+			   << "}";
+		}
+		ss << "\n\t\t\t},\n";
+
+		ss << "\t\t\t\"peak_memory_bytes\": {";
+		for (auto it = run.peakMemoryUsages.begin(); it != run.peakMemoryUsages.end(); it++)
+		{
+			// process 0 is the main process, the others are the indexers
+			ss << (it != run.peakMemoryUsages.begin() ? "," : "") << "\n\t\t\t\t\""
+			   << it->first << "\": " << it->second;
+		}
+		ss << "\n\t\t\t},\n";
+
+		ss << "\t\t\t\"table_row_counts\": {";
+		for (auto it = run.tableRowCounts.begin(); it != run.tableRowCounts.end(); it++)
+		{
+			ss << (it != run.tableRowCounts.begin() ? "," : "") << "\n\t\t\t\t"
+			   << toJsonString(it->first) << ": " << it->second;
+		}
+		ss << "\n\t\t\t},\n";
+
+		ss << "\t\t\t\"source_files\": [";
+		for (size_t j = 0; j < run.sourceFileTimes.size(); j++)
+		{
+			const IndexingStatistics::SourceFileTime& sourceFileTime = run.sourceFileTimes[j];
+			ss << (j ? "," : "") << "\n\t\t\t\t{\"path\": " << toJsonString(sourceFileTime.filePath)
+			   << ", \"process\": " << sourceFileTime.processId
+			   << ", \"parse_ms\": " << sourceFileTime.parseMS
+			   << ", \"transfer_ms\": " << sourceFileTime.transferMS << "}";
+		}
+		ss << "\n\t\t\t]\n";
+
+		ss << "\t\t}";
+	}
+
+	ss << "\n\t]\n";
+	ss << "}\n";
+
+	return ss.str();
+}
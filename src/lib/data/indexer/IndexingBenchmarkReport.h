@@ -0,0 +1,51 @@
+#ifndef INDEXING_BENCHMARK_REPORT_H
+#define INDEXING_BENCHMARK_REPORT_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "FilePath.h"
+#include "IndexingStatistics.h"
+
+// Results of repeatedly indexing one project, written as JSON so that runs of different releases
+// can be compared by scripts.
+class IndexingBenchmarkReport
+{
+public:
+	IndexingBenchmarkReport(
+		const FilePath& projectFilePath,
+		bool fullRefresh,
+		int indexerThreadCount,
+		bool multiProcessIndexing);
+
+	void addRun(
+		bool cold,
+		double durationMS,
+		const IndexingStatistics& statistics,
+		const std::map<std::string, size_t>& tableRowCounts);
+
+	size_t getRunCount() const;
+
+	std::string toJson() const;
+
+private:
+	struct Run
+	{
+		bool cold = false;
+		double durationMS = 0.0;
+		std::map<std::string, IndexingStatistics::PhaseTime> phaseTimes;
+		std::vector<IndexingStatistics::SourceFileTime> sourceFileTimes;
+		std::map<Id, size_t> peakMemoryUsages;
+		std::map<std::string, size_t> tableRowCounts;
+	};
+
+	const FilePath m_projectFilePath;
+	const bool m_fullRefresh;
+	const int m_indexerThreadCount;
+	const bool m_multiProcessIndexing;
+
+	std::vector<Run> m_runs;
+};
+
+#endif	  // INDEXING_BENCHMARK_REPORT_H
@@ -0,0 +1,137 @@
+#include "IndexingStatistics.h"
+
+#include <algorithm>
+
+#ifdef _WIN32
+#	include <Windows.h>
+#	include <psapi.h>
+#else
+#	include <sys/resource.h>
+#endif
+
+const char* IndexingStatistics::s_commandQueueFillPhaseName = "command_queue_fill";
+const char* IndexingStatistics::s_parsePhaseName = "parse";
+const char* IndexingStatistics::s_sharedMemoryTransferPhaseName = "shared_memory_transfer";
+const char* IndexingStatistics::s_customCommandPhaseName = "custom_command";
+const char* IndexingStatistics::s_storageLoadPhaseName = "storage_load";
+const char* IndexingStatistics::s_mergePhaseName = "merge";
+const char* IndexingStatistics::s_injectPhaseName = "inject";
+const char* IndexingStatistics::s_cleanPhaseName = "clean";
+const char* IndexingStatistics::s_postProcessingPhaseName = "post_processing";
+const char* IndexingStatistics::s_finishPhaseName = "finish";
+
+IndexingStatistics::ScopedPhase::ScopedPhase(const char* phaseName)
+	: m_phaseName(phaseName)
+	, m_enabled(IndexingStatistics::getInstance()->isEnabled())
+	, m_start(std::chrono::steady_clock::now())
+{
+}
+
+IndexingStatistics::ScopedPhase::~ScopedPhase()
+{
+	if (m_enabled)
+	{
+		const std::chrono::duration<double, std::milli> duration =
+			std::chrono::steady_clock::now() - m_start;
+		IndexingStatistics::getInstance()->addPhaseTime(m_phaseName, duration.count());
+	}
+}
+
+std::shared_ptr<IndexingStatistics> IndexingStatistics::getInstance()
+{
+	// phases are recorded from several task threads, so the instance must not be created lazily
+	// by the first of them
+	static std::shared_ptr<IndexingStatistics> s_instance(new IndexingStatistics());
+	return s_instance;
+}
+
+size_t IndexingStatistics::getPeakMemoryUsage()
+{
+#ifdef _WIN32
+	PROCESS_MEMORY_COUNTERS counters;
+	if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+	{
+		return counters.PeakWorkingSetSize;
+	}
+	return 0;
+#else
+	struct rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) != 0)
+	{
+		return 0;
+	}
+#	ifdef __APPLE__
+	return static_cast<size_t>(usage.ru_maxrss);
+#	else
+	return static_cast<size_t>(usage.ru_maxrss) * 1024;	   // reported in kilobytes on Linux
+#	endif
+#endif
+}
+
+void IndexingStatistics::setEnabled(bool enabled)
+{
+	m_enabled = enabled;
+}
+
+bool IndexingStatistics::isEnabled() const
+{
+	return m_enabled;
+}
+
+void IndexingStatistics::clear()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_phaseTimes.clear();
+	m_sourceFileTimes.clear();
+	m_peakMemoryUsages.clear();
+}
+
+void IndexingStatistics::addPhaseTime(const std::string& phaseName, double milliseconds)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	addPhaseTimeUnlocked(phaseName, milliseconds);
+}
+
+void IndexingStatistics::addSourceFileTime(const SourceFileTime& sourceFileTime)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_sourceFileTimes.push_back(sourceFileTime);
+
+	addPhaseTimeUnlocked(s_parsePhaseName, sourceFileTime.parseMS);
+	addPhaseTimeUnlocked(s_sharedMemoryTransferPhaseName, sourceFileTime.transferMS);
+}
+
+void IndexingStatistics::addPeakMemoryUsage(Id processId, size_t bytes)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	size_t& peak = m_peakMemoryUsages[processId];
+	peak = std::max(peak, bytes);
+}
+
+std::map<std::string, IndexingStatistics::PhaseTime> IndexingStatistics::getPhaseTimes() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_phaseTimes;
+}
+
+std::vector<IndexingStatistics::SourceFileTime> IndexingStatistics::getSourceFileTimes() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_sourceFileTimes;
+}
+
+std::map<Id, size_t> IndexingStatistics::getPeakMemoryUsages() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_peakMemoryUsages;
+}
+
+IndexingStatistics::IndexingStatistics(): m_enabled(false) {}
+
+void IndexingStatistics::addPhaseTimeUnlocked(const std::string& phaseName, double milliseconds)
+{
+	PhaseTime& phaseTime = m_phaseTimes[phaseName];
+	phaseTime.count++;
+	phaseTime.totalMS += milliseconds;
+	phaseTime.maxMS = std::max(phaseTime.maxMS, milliseconds);
+}
@@ -0,0 +1,91 @@
+#ifndef INDEXING_STATISTICS_H
+#define INDEXING_STATISTICS_H
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "FilePath.h"
+#include "types.h"
+
+// Collects the timings of the indexing phases for the benchmark command. Recording is disabled by
+// default, so a regular refresh only pays for checking a flag once per phase.
+class IndexingStatistics
+{
+public:
+	static const char* s_commandQueueFillPhaseName;
+	static const char* s_parsePhaseName;
+	static const char* s_sharedMemoryTransferPhaseName;
+	static const char* s_customCommandPhaseName;
+	static const char* s_storageLoadPhaseName;
+	static const char* s_mergePhaseName;
+	static const char* s_injectPhaseName;
+	static const char* s_cleanPhaseName;
+	static const char* s_postProcessingPhaseName;
+	static const char* s_finishPhaseName;
+
+	struct PhaseTime
+	{
+		size_t count = 0;
+		double totalMS = 0.0;
+		double maxMS = 0.0;
+	};
+
+	struct SourceFileTime
+	{
+		FilePath filePath;
+		Id processId = 0;
+		double parseMS = 0.0;
+		double transferMS = 0.0;
+	};
+
+	class ScopedPhase
+	{
+	public:
+		ScopedPhase(const char* phaseName);
+		~ScopedPhase();
+
+	private:
+		const char* m_phaseName;
+		const bool m_enabled;
+		const std::chrono::steady_clock::time_point m_start;
+	};
+
+	static std::shared_ptr<IndexingStatistics> getInstance();
+
+	// peak resident memory of the calling process in bytes, 0 if the platform doesn't tell
+	static size_t getPeakMemoryUsage();
+
+	void setEnabled(bool enabled);
+	bool isEnabled() const;
+
+	void clear();
+
+	void addPhaseTime(const std::string& phaseName, double milliseconds);
+	void addSourceFileTime(const SourceFileTime& sourceFileTime);
+	void addPeakMemoryUsage(Id processId, size_t bytes);
+
+	std::map<std::string, PhaseTime> getPhaseTimes() const;
+	std::vector<SourceFileTime> getSourceFileTimes() const;
+	std::map<Id, size_t> getPeakMemoryUsages() const;
+
+private:
+	IndexingStatistics();
+	IndexingStatistics(const IndexingStatistics&) = delete;
+	void operator=(const IndexingStatistics&) = delete;
+
+	void addPhaseTimeUnlocked(const std::string& phaseName, double milliseconds);
+
+	std::atomic<bool> m_enabled;
+
+	mutable std::mutex m_mutex;
+	std::map<std::string, PhaseTime> m_phaseTimes;
+	std::vector<SourceFileTime> m_sourceFileTimes;
+	std::map<Id, size_t> m_peakMemoryUsages;
+};
+
+#endif	  // INDEXING_STATISTICS_H
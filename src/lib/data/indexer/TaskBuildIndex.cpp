@@ -4,13 +4,18 @@
 #include "Blackboard.h"
 #include "DialogView.h"
 #include "FileLogger.h"
+#include "FilePathCanonicalizer.h"
+#include "FileRegister.h"
+#include "IndexingStatistics.h"
 #include "InterprocessIndexer.h"
 #include "MessageIndexingStatus.h"
 #include "MessageStatus.h"
 #include "ParserClientImpl.h"
 #include "StorageProvider.h"
 #include "TimeStamp.h"
+#include "TraceRecorder.h"
 #include "UserPaths.h"
+#include "tracing.h"
 #include "utilityApp.h"
 
 TaskBuildIndex::TaskBuildIndex(
@@ -35,6 +40,10 @@ TaskBuildIndex::TaskBuildIndex(
 void TaskBuildIndex::doEnter(std::shared_ptr<Blackboard> blackboard)
 {
 	m_interprocessIndexingStatusManager.setIndexingInterrupted(false);
+	m_interprocessIndexingStatusManager.setStatisticsEnabled(
+		IndexingStatistics::getInstance()->isEnabled());
+	m_interprocessIndexingStatusManager.setTracingEnabled(
+		TraceRecorder::getInstance()->isEnabled());
 
 	m_indexingFileCount = 0;
 	updateIndexingDialog(blackboard, std::vector<FilePath>());
@@ -46,6 +55,26 @@ void TaskBuildIndex::doEnter(std::shared_ptr<Blackboard> blackboard)
 		logFilePath = dynamic_cast<FileLogger*>(logger)->getLogFilePath().wstr();
 	}
 
+	// the log file of the app may rotate while indexing, so the paths of the indexer log files are
+	// kept for merging them afterwards
+	m_indexerLogFilePaths.clear();
+	if (m_multiProcessIndexing && !logFilePath.empty())
+	{
+		for (unsigned int i = 0; i < m_processCount; i++)
+		{
+			m_indexerLogFilePaths.push_back(
+				FileLogger::getProcessLogFilePath(FilePath(logFilePath), i + 1));
+		}
+	}
+
+	if (!m_multiProcessIndexing)
+	{
+		// indexer threads share the caches of this process, which may still hold paths resolved
+		// during a previous indexing run
+		FilePathCanonicalizer::getInstance()->clear();
+		FileRegister::clearSharedState();
+	}
+
 	// start indexer processes
 	for (unsigned int i = 0; i < m_processCount; i++)
 	{
@@ -76,14 +105,20 @@ void TaskBuildIndex::doEnter(std::shared_ptr<Blackboard> blackboard)
 
 Task::TaskState TaskBuildIndex::doUpdate(std::shared_ptr<Blackboard> blackboard)
 {
+	bool indexerCommandQueueStopped = isIndexerCommandQueueStopped();
+	blackboard->get<bool>("indexer_command_queue_stopped", indexerCommandQueueStopped);
+
 	size_t runningThreadCount = 0;
 	{
 		std::lock_guard<std::mutex> lock(m_runningThreadCountMutex);
 		runningThreadCount = m_runningThreadCount;
+		if (indexerCommandQueueStopped && !m_indexerCommandQueueStopped)
+		{
+			m_indexerCommandQueueStopped = true;
+			m_runningThreadCountCondition.notify_all();
+		}
 	}
 
-	blackboard->get<bool>("indexer_command_queue_stopped", m_indexerCommandQueueStopped);
-
 	const std::vector<FilePath> indexingFiles =
 		m_interprocessIndexingStatusManager.getCurrentlyIndexedSourceFilePaths();
 	if (!indexingFiles.empty())
@@ -91,7 +126,7 @@ Task::TaskState TaskBuildIndex::doUpdate(std::shared_ptr<Blackboard> blackboard)
 		updateIndexingDialog(blackboard, indexingFiles);
 	}
 
-	if (m_indexerCommandQueueStopped && runningThreadCount == 0)
+	if (indexerCommandQueueStopped && runningThreadCount == 0)
 	{
 		LOG_INFO_STREAM(<< "command queue stopped and no running threads. done.");
 		return STATE_SUCCESS;
@@ -108,7 +143,16 @@ Task::TaskState TaskBuildIndex::doUpdate(std::shared_ptr<Blackboard> blackboard)
 		updateIndexingDialog(blackboard, std::vector<FilePath>());
 	}
 
-	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+	fetchIndexingStatistics();
+	fetchTraceRecords();
+
+	{
+		// storages are not announced, so the timeout is still needed to fetch them
+		std::unique_lock<std::mutex> lock(m_runningThreadCountMutex);
+		m_runningThreadCountCondition.wait_for(lock, std::chrono::milliseconds(50), [&]() {
+			return m_runningThreadCount != runningThreadCount || m_interrupted;
+		});
+	}
 
 	return STATE_RUNNING;
 }
@@ -122,12 +166,17 @@ void TaskBuildIndex::doExit(std::shared_ptr<Blackboard> blackboard)
 	}
 	m_processThreads.clear();
 
+	mergeIndexerLogFiles();
+
 	if (!m_interrupted)
 	{
 		while (fetchIntermediateStorages(blackboard))
 			;
 	}
 
+	fetchIndexingStatistics();
+	fetchTraceRecords();
+
 	std::vector<FilePath> crashedFiles =
 		m_interprocessIndexingStatusManager.getCrashedSourceFilePaths();
 	if (!crashedFiles.empty())
@@ -162,6 +211,7 @@ void TaskBuildIndex::doReset(std::shared_ptr<Blackboard> blackboard) {}
 void TaskBuildIndex::terminate()
 {
 	m_interrupted = true;
+	notifyIndexerThreads();
 	utility::killRunningProcesses();
 }
 
@@ -171,11 +221,24 @@ void TaskBuildIndex::handleMessage(MessageIndexingInterrupted* message)
 
 	m_interprocessIndexingStatusManager.setIndexingInterrupted(true);
 	m_interrupted = true;
+	notifyIndexerThreads();
 
 	m_dialogView->showUnknownProgressDialog(
 		L"Interrupting Indexing", L"Waiting for indexer\nthreads to finish");
 }
 
+void TaskBuildIndex::mergeIndexerLogFiles()
+{
+	Logger* logger = LogManager::getInstance()->getLoggerByType("FileLogger");
+	if (!logger || m_indexerLogFilePaths.empty())
+	{
+		return;
+	}
+
+	dynamic_cast<FileLogger*>(logger)->mergeLogFiles(m_indexerLogFilePaths);
+	m_indexerLogFilePaths.clear();
+}
+
 void TaskBuildIndex::runIndexerProcess(int processId, const std::wstring& logFilePath)
 {
 	const FilePath indexerProcessPath = AppPath::getCxxIndexerFilePath();
@@ -200,7 +263,7 @@ void TaskBuildIndex::runIndexerProcess(int processId, const std::wstring& logFil
 	}
 
 	int result = 1;
-	while ((!m_indexerCommandQueueStopped || result != 0) && !m_interrupted)
+	while ((!isIndexerCommandQueueStopped() || result != 0) && !m_interrupted)
 	{
 		result = utility::executeProcess(
 					 indexerProcessPath.wstr(), commandArguments, FilePath(), false, -1)
@@ -212,26 +275,39 @@ void TaskBuildIndex::runIndexerProcess(int processId, const std::wstring& logFil
 	{
 		std::lock_guard<std::mutex> lock(m_runningThreadCountMutex);
 		m_runningThreadCount--;
+		m_runningThreadCountCondition.notify_all();
 	}
 }
 
 void TaskBuildIndex::runIndexerThread(int processId)
 {
-	do
+	while (true)
 	{
 		InterprocessIndexer indexer(m_appUUID, processId);
 		indexer.work();	   // this will only return if there are no indexer commands left in the queue
-		if (!m_interrupted)
+
+		// waiting if interrupted may result in a crash due to objects that are already
+		// destroyed after waking up again
+		if (m_interrupted)
+		{
+			break;
+		}
+
+		// the queue may be refilled, so wait a bit unless the queue was stopped meanwhile
+		std::unique_lock<std::mutex> lock(m_runningThreadCountMutex);
+		m_runningThreadCountCondition.wait_for(lock, std::chrono::milliseconds(200), [this]() {
+			return m_indexerCommandQueueStopped || m_interrupted;
+		});
+		if (m_indexerCommandQueueStopped || m_interrupted)
 		{
-			// sleeping if interrupted may result in a crash due to objects that are already
-			// destroyed after waking up again
-			std::this_thread::sleep_for(std::chrono::milliseconds(200));
+			break;
 		}
-	} while (!m_indexerCommandQueueStopped && !m_interrupted);
+	}
 
 	{
 		std::lock_guard<std::mutex> lock(m_runningThreadCountMutex);
 		m_runningThreadCount--;
+		m_runningThreadCountCondition.notify_all();
 	}
 }
 
@@ -269,7 +345,12 @@ bool TaskBuildIndex::fetchIntermediateStorages(std::shared_ptr<Blackboard> black
 		}
 
 		LOG_INFO_STREAM(<< storageManager->getProcessId() << " - storage count: " << storageCount);
-		m_storageProvider->insert(storageManager->popIntermediateStorage());
+		{
+			TRACE("pop intermediate storage");
+			IndexingStatistics::ScopedPhase phase(
+				IndexingStatistics::s_sharedMemoryTransferPhaseName);
+			m_storageProvider->insert(storageManager->popIntermediateStorage());
+		}
 		poppedStorageCount++;
 	} while (TimeStamp::now().deltaMS(t) <
 			 500);	  // don't process all storages at once to allow for status updates in-between
@@ -284,6 +365,47 @@ bool TaskBuildIndex::fetchIntermediateStorages(std::shared_ptr<Blackboard> black
 	return false;
 }
 
+void TaskBuildIndex::fetchIndexingStatistics()
+{
+	std::shared_ptr<IndexingStatistics> statistics = IndexingStatistics::getInstance();
+	if (!statistics->isEnabled())
+	{
+		return;
+	}
+
+	for (const IndexingStatistics::SourceFileTime& sourceFileTime:
+		 m_interprocessIndexingStatusManager.popSourceFileTimes())
+	{
+		statistics->addSourceFileTime(sourceFileTime);
+	}
+
+	for (const auto& p: m_interprocessIndexingStatusManager.getPeakMemoryUsages())
+	{
+		statistics->addPeakMemoryUsage(p.first, p.second);
+	}
+}
+
+void TaskBuildIndex::fetchTraceRecords()
+{
+	TraceRecorder* traceRecorder = TraceRecorder::getInstance();
+	if (traceRecorder->isEnabled())
+	{
+		traceRecorder->addRecords(m_interprocessIndexingStatusManager.popTraceRecords());
+	}
+}
+
+bool TaskBuildIndex::isIndexerCommandQueueStopped()
+{
+	std::lock_guard<std::mutex> lock(m_runningThreadCountMutex);
+	return m_indexerCommandQueueStopped;
+}
+
+void TaskBuildIndex::notifyIndexerThreads()
+{
+	std::lock_guard<std::mutex> lock(m_runningThreadCountMutex);
+	m_runningThreadCountCondition.notify_all();
+}
+
 void TaskBuildIndex::updateIndexingDialog(
 	std::shared_ptr<Blackboard> blackboard, const std::vector<FilePath>& sourcePaths)
 {
@@ -1,8 +1,12 @@
 #ifndef TASK_BUILD_INDEX_H
 #define TASK_BUILD_INDEX_H
 
+#include <condition_variable>
+#include <mutex>
 #include <thread>
+#include <vector>
 
+#include "FilePath.h"
 #include "MessageIndexingInterrupted.h"
 #include "MessageListener.h"
 #include "Task.h"
@@ -36,11 +40,16 @@ protected:
 
 	void handleMessage(MessageIndexingInterrupted* message) override;
 
+	void mergeIndexerLogFiles();
 	void runIndexerProcess(int processId, const std::wstring& logFilePath);
 	void runIndexerThread(int processId);
 	bool fetchIntermediateStorages(std::shared_ptr<Blackboard> blackboard);
+	void fetchIndexingStatistics();
+	void fetchTraceRecords();
 	void updateIndexingDialog(
 		std::shared_ptr<Blackboard> blackboard, const std::vector<FilePath>& sourcePaths);
+	bool isIndexerCommandQueueStopped();
+	void notifyIndexerThreads();
 
 	static const std::wstring s_processName;
 
@@ -55,14 +64,18 @@ protected:
 	size_t m_processCount;
 	bool m_interrupted;
 	size_t m_indexingFileCount;
+	std::vector<FilePath> m_indexerLogFilePaths;
 
 	// store as plain pointers to avoid deallocation issues when closing app during indexing
 	std::vector<std::thread*> m_processThreads;
 	std::vector<std::shared_ptr<InterprocessIntermediateStorageManager>>
 		m_interprocessIntermediateStorageManagers;
 
+	// also guards the command queue stopped flag, the condition is notified when that flag is set,
+	// on interruption and when an indexer thread finished
 	size_t m_runningThreadCount;
 	std::mutex m_runningThreadCountMutex;
+	std::condition_variable m_runningThreadCountCondition;
 };
 
 #endif	  // TASK_PARSE_H
@@ -7,14 +7,15 @@
 #include "FileSystem.h"
 #include "IndexerCommandCustom.h"
 #include "IndexerCommandProvider.h"
-#include "MessageErrorCountClear.h"
-#include "MessageErrorCountUpdate.h"
+#include "IndexingStatistics.h"
+#include "IntermediateStorage.h"
 #include "MessageIndexingStatus.h"
 #include "MessageShowStatus.h"
 #include "MessageStatus.h"
 #include "PersistentStorage.h"
 #include "SourceLocationCollection.h"
 #include "SourceLocationFile.h"
+#include "StorageProvider.h"
 #include "TextAccess.h"
 #include "utility.h"
 #include "utilityApp.h"
@@ -255,6 +256,8 @@ TaskExecuteCustomCommands::TaskExecuteCustomCommands(
 	, m_projectDirectory(projectDirectory)
 	, m_indexerCommandCount(m_indexerCommandProvider->size())
 	, m_hasPythonCommands(false)
+	, m_storageProvider(std::make_shared<StorageProvider>())
+	, m_runningThreadCount(0)
 {
 }
 
@@ -272,10 +275,6 @@ void TaskExecuteCustomCommands::doEnter(std::shared_ptr<Blackboard> blackboard)
 					std::dynamic_pointer_cast<IndexerCommandCustom>(
 						m_indexerCommandProvider->consumeCommandForSourceFilePath(sourceFilePath)))
 			{
-				if (m_targetDatabaseFilePath.empty())
-				{
-					m_targetDatabaseFilePath = indexerCommand->getDatabaseFilePath();
-				}
 #if BUILD_PYTHON_LANGUAGE_PACKAGE
 				if (indexerCommand->getIndexerCommandType() == INDEXER_COMMAND_PYTHON)
 				{
@@ -308,24 +307,43 @@ Task::TaskState TaskExecuteCustomCommands::doUpdate(std::shared_ptr<Blackboard>
 
 	m_dialogView->updateCustomIndexingDialog(0, 0, m_indexerCommandProvider->size(), {});
 
+	m_storage->setMode(SqliteIndexStorage::STORAGE_MODE_WRITE);
+
+	{
+		std::lock_guard<std::mutex> lock(m_storagesMutex);
+		m_runningThreadCount = m_indexerThreadCount;
+	}
+
 	std::vector<std::shared_ptr<std::thread>> indexerThreads;
-	for (size_t i = 1 /*this method is counting as the first thread*/; i < m_indexerThreadCount; i++)
+	for (size_t i = 0; i < m_indexerThreadCount; i++)
 	{
 		indexerThreads.push_back(std::make_shared<std::thread>(
-			&TaskExecuteCustomCommands::executeParallelIndexerCommands,
+			&TaskExecuteCustomCommands::executeIndexerCommands,
 			this,
 			static_cast<int>(i),
 			blackboard));
 	}
 
-	while (!m_interrupted && !m_serialCommands.empty())
+	// inject the data of finished commands while the other commands are still running
+	while (true)
 	{
-		std::shared_ptr<IndexerCommandCustom> indexerCommand = m_serialCommands.back();
-		m_serialCommands.pop_back();
-		runIndexerCommand(indexerCommand, blackboard, m_storage);
-	}
+		if (std::shared_ptr<IntermediateStorage> storage =
+				m_storageProvider->consumeLargestStorage())
+		{
+			IndexingStatistics::ScopedPhase phase(IndexingStatistics::s_injectPhaseName);
+			m_storage->inject(storage.get());
+			continue;
+		}
 
-	executeParallelIndexerCommands(0, blackboard);
+		std::unique_lock<std::mutex> lock(m_storagesMutex);
+		if (m_runningThreadCount == 0 && m_storageProvider->getStorageCount() == 0)
+		{
+			break;
+		}
+		m_storagesCondition.wait(lock, [this]() {
+			return m_runningThreadCount == 0 || m_storageProvider->getStorageCount() > 0;
+		});
+	}
 
 	for (std::shared_ptr<std::thread> indexerThread: indexerThreads)
 	{
@@ -333,36 +351,15 @@ Task::TaskState TaskExecuteCustomCommands::doUpdate(std::shared_ptr<Blackboard>
 	}
 	indexerThreads.clear();
 
-	// clear errors here, because otherwise injecting into the main storage will show them twice
-	MessageErrorCountClear().dispatch();
-
+	if (m_hasPythonCommands && ApplicationSettings::getInstance()->getPythonPostProcessingEnabled())
 	{
-		PersistentStorage targetStorage(m_targetDatabaseFilePath, FilePath());
-		targetStorage.setup();
-		targetStorage.setMode(SqliteIndexStorage::STORAGE_MODE_WRITE);
-		targetStorage.buildCaches();
-		for (const FilePath& sourceDatabaseFilePath: m_sourceDatabaseFilePaths)
-		{
-			{
-				PersistentStorage sourceStorage(sourceDatabaseFilePath, FilePath());
-				sourceStorage.setMode(SqliteIndexStorage::STORAGE_MODE_READ);
-				sourceStorage.buildCaches();
-				targetStorage.inject(&sourceStorage);
-			}
-			FileSystem::remove(sourceDatabaseFilePath);
-		}
-
-		if (m_hasPythonCommands &&
-			ApplicationSettings::getInstance()->getPythonPostProcessingEnabled())
-		{
-			LOG_INFO("Starting Python post processing.");
-			m_dialogView->showUnknownProgressDialog(
-				L"Finish Indexing", L"Run Python Post Processing");
+		LOG_INFO("Starting Python post processing.");
+		m_dialogView->showUnknownProgressDialog(L"Finish Indexing", L"Run Python Post Processing");
 
-			targetStorage.clearCaches();
-			targetStorage.buildCaches();
-			runPythonPostProcessing(targetStorage);
-		}
+		IndexingStatistics::ScopedPhase phase(IndexingStatistics::s_postProcessingPhaseName);
+		m_storage->clearCaches();
+		m_storage->buildCaches();
+		runPythonPostProcessing(*m_storage);
 	}
 
 	return STATE_SUCCESS;
@@ -388,71 +385,91 @@ void TaskExecuteCustomCommands::handleMessage(MessageIndexingInterrupted* messag
 		L"Interrupting Indexing", L"Waiting for running\ncommand to finish");
 }
 
-void TaskExecuteCustomCommands::executeParallelIndexerCommands(
+void TaskExecuteCustomCommands::executeIndexerCommands(
 	int threadId, std::shared_ptr<Blackboard> blackboard)
 {
-	std::shared_ptr<PersistentStorage> storage;
 	while (!m_interrupted)
 	{
 		std::shared_ptr<IndexerCommandCustom> indexerCommand;
+		if (threadId == 0 && !m_serialCommands.empty())
+		{
+			// only the first thread runs the serial commands, so they never overlap
+			indexerCommand = m_serialCommands.back();
+			m_serialCommands.pop_back();
+		}
+		else
 		{
 			std::lock_guard<std::mutex> lock(m_parallelCommandsMutex);
 			if (m_parallelCommands.empty())
 			{
-				return;
+				break;
 			}
 			indexerCommand = m_parallelCommands.back();
 			m_parallelCommands.pop_back();
 		}
 
-		if (threadId == 0)
-		{
-			storage = m_storage;
-		}
-		else
-		{
-			FilePath databaseFilePath = indexerCommand->getDatabaseFilePath();
-			databaseFilePath = databaseFilePath.getParentDirectory().concatenate(
-				databaseFilePath.fileName() + L"_thread" + std::to_wstring(threadId));
+		executeIndexerCommand(threadId, indexerCommand, blackboard);
+	}
 
-			bool databaseFilePathKnown = true;
-			{
-				std::lock_guard<std::mutex> lock(m_sourceDatabaseFilePathsMutex);
-				if (m_sourceDatabaseFilePaths.find(databaseFilePath) ==
-					m_sourceDatabaseFilePaths.end())
-				{
-					m_sourceDatabaseFilePaths.insert(databaseFilePath);
-					databaseFilePathKnown = false;
-				}
-			}
+	std::lock_guard<std::mutex> lock(m_storagesMutex);
+	m_runningThreadCount--;
+	m_storagesCondition.notify_all();
+}
 
-			if (!databaseFilePathKnown)
-			{
-				if (databaseFilePath.exists())
-				{
-					LOG_WARNING(
-						L"Temporary storage \"" + databaseFilePath.wstr() +
-						L"\" already exists on file system. File will be removed to avoid "
-						L"conflicts.");
-					FileSystem::remove(databaseFilePath);
-				}
-				storage = std::make_shared<PersistentStorage>(databaseFilePath, FilePath());
-				storage->setup();
-				storage->setMode(SqliteIndexStorage::STORAGE_MODE_WRITE);
-				storage->buildCaches();
-			}
+void TaskExecuteCustomCommands::executeIndexerCommand(
+	int threadId,
+	std::shared_ptr<IndexerCommandCustom> indexerCommand,
+	std::shared_ptr<Blackboard> blackboard)
+{
+	// each command writes to a database of its own, so the target database is only written by
+	// this process and can be injected into while other commands are running
+	FilePath databaseFilePath = indexerCommand->getDatabaseFilePath();
+	databaseFilePath = databaseFilePath.getParentDirectory().concatenate(
+		databaseFilePath.fileName() + L"_thread" + std::to_wstring(threadId));
 
-			indexerCommand->setDatabaseFilePath(databaseFilePath);
-		}
+	if (databaseFilePath.exists())
+	{
+		LOG_WARNING(
+			L"Temporary storage \"" + databaseFilePath.wstr() +
+			L"\" already exists on file system. File will be removed to avoid conflicts.");
+		FileSystem::remove(databaseFilePath);
+	}
+
+	{
+		PersistentStorage storage(databaseFilePath, FilePath());
+		storage.setup();
+		storage.setMode(SqliteIndexStorage::STORAGE_MODE_WRITE);
+	}
 
-		runIndexerCommand(indexerCommand, blackboard, storage);
+	indexerCommand->setDatabaseFilePath(databaseFilePath);
+	runIndexerCommand(indexerCommand, blackboard);
+
+	std::shared_ptr<IntermediateStorage> intermediateStorage =
+		std::make_shared<IntermediateStorage>();
+	{
+		IndexingStatistics::ScopedPhase phase(IndexingStatistics::s_storageLoadPhaseName);
+		PersistentStorage storage(databaseFilePath, FilePath());
+		intermediateStorage->inject(&storage);
 	}
+	FileSystem::remove(databaseFilePath);
+
+	// merge into a waiting storage, so the target storage isn't written once per command. The
+	// largest one is left for the injection.
+	if (std::shared_ptr<IntermediateStorage> waitingStorage =
+			m_storageProvider->consumeSecondLargestStorage())
+	{
+		IndexingStatistics::ScopedPhase phase(IndexingStatistics::s_mergePhaseName);
+		waitingStorage->inject(intermediateStorage.get());
+		intermediateStorage = waitingStorage;
+	}
+	m_storageProvider->insert(intermediateStorage);
+
+	std::lock_guard<std::mutex> lock(m_storagesMutex);
+	m_storagesCondition.notify_all();
 }
 
 void TaskExecuteCustomCommands::runIndexerCommand(
-	std::shared_ptr<IndexerCommandCustom> indexerCommand,
-	std::shared_ptr<Blackboard> blackboard,
-	std::shared_ptr<PersistentStorage> storage)
+	std::shared_ptr<IndexerCommandCustom> indexerCommand, std::shared_ptr<Blackboard> blackboard)
 {
 	if (indexerCommand)
 	{
@@ -472,36 +489,13 @@ void TaskExecuteCustomCommands::runIndexerCommand(
 			"Start processing command \"" +
 			utility::encodeToUtf8(command + L" " + utility::join(arguments, L" ")) + "\"");
 
-		const ErrorCountInfo previousErrorCount = storage ? storage->getErrorCount()
-														  : ErrorCountInfo();
-
 		LOG_INFO("Starting to index");
-		const utility::ProcessOutput out = utility::executeProcess(
-			command, arguments, m_projectDirectory, false, -1, true);
-		LOG_INFO("Finished indexing");
-
-		if (storage)
+		utility::ProcessOutput out;
 		{
-			std::vector<ErrorInfo> errors = storage->getErrorInfos();
-			const ErrorCountInfo currentErrorCount(errors);
-			if (currentErrorCount.total > previousErrorCount.total)
-			{
-				const ErrorCountInfo diff(
-					currentErrorCount.total - previousErrorCount.total,
-					currentErrorCount.fatal - previousErrorCount.fatal);
-
-				ErrorCountInfo errorCount;	  // local copy to release lock early
-				{
-					std::lock_guard<std::mutex> lock(m_errorCountMutex);
-					m_errorCount.total += diff.total;
-					m_errorCount.fatal += diff.fatal;
-					errorCount = m_errorCount;
-				}
-
-				errors.erase(errors.begin(), errors.begin() + previousErrorCount.total);
-				MessageErrorCountUpdate(errorCount, errors).dispatch();
-			}
+			IndexingStatistics::ScopedPhase phase(IndexingStatistics::s_customCommandPhaseName);
+			out = utility::executeProcess(command, arguments, m_projectDirectory, false, -1, true);
 		}
+		LOG_INFO("Finished indexing");
 
 		if (out.exitCode == 0 && out.error.empty())
 		{
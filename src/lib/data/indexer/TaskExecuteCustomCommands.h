@@ -1,10 +1,10 @@
 #ifndef TASK_EXECUTE_CUSTOM_COMMANDS_H
 #define TASK_EXECUTE_CUSTOM_COMMANDS_H
 
-#include <set>
+#include <condition_variable>
+#include <mutex>
 #include <vector>
 
-#include "ErrorCountInfo.h"
 #include "FilePath.h"
 #include "MessageIndexingInterrupted.h"
 #include "MessageListener.h"
@@ -15,6 +15,7 @@ class DialogView;
 class IndexerCommandCustom;
 class IndexerCommandProvider;
 class PersistentStorage;
+class StorageProvider;
 
 class TaskExecuteCustomCommands
 	: public Task
@@ -38,11 +39,14 @@ private:
 
 	void handleMessage(MessageIndexingInterrupted* message) override;
 
-	void executeParallelIndexerCommands(int threadId, std::shared_ptr<Blackboard> blackboard);
+	void executeIndexerCommands(int threadId, std::shared_ptr<Blackboard> blackboard);
+	void executeIndexerCommand(
+		int threadId,
+		std::shared_ptr<IndexerCommandCustom> indexerCommand,
+		std::shared_ptr<Blackboard> blackboard);
 	void runIndexerCommand(
 		std::shared_ptr<IndexerCommandCustom> indexerCommand,
-		std::shared_ptr<Blackboard> blackboard,
-		std::shared_ptr<PersistentStorage> storage);
+		std::shared_ptr<Blackboard> blackboard);
 
 	std::unique_ptr<IndexerCommandProvider> m_indexerCommandProvider;
 	std::shared_ptr<PersistentStorage> m_storage;
@@ -56,12 +60,13 @@ private:
 	std::vector<std::shared_ptr<IndexerCommandCustom>> m_serialCommands;
 	std::vector<std::shared_ptr<IndexerCommandCustom>> m_parallelCommands;
 	std::mutex m_parallelCommandsMutex;
-	ErrorCountInfo m_errorCount;
-	std::mutex m_errorCountMutex;
-	FilePath m_targetDatabaseFilePath;
 	bool m_hasPythonCommands;
-	std::set<FilePath> m_sourceDatabaseFilePaths;
-	std::mutex m_sourceDatabaseFilePathsMutex;
+
+	// the data of finished commands, waiting to be injected into the target storage
+	std::shared_ptr<StorageProvider> m_storageProvider;
+	std::mutex m_storagesMutex;
+	std::condition_variable m_storagesCondition;
+	size_t m_runningThreadCount;
 };
 
 #endif	  // TASK_EXECUTE_CUSTOM_COMMANDS_H
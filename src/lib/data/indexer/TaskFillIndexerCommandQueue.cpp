@@ -3,7 +3,9 @@
 #include "Blackboard.h"
 #include "FileSystem.h"
 #include "IndexerCommandProvider.h"
+#include "IndexingStatistics.h"
 #include "logging.h"
+#include "tracing.h"
 #include "utilityFile.h"
 
 TaskFillIndexerCommandsQueue::TaskFillIndexerCommandsQueue(
@@ -19,6 +21,7 @@ TaskFillIndexerCommandsQueue::TaskFillIndexerCommandsQueue(
 void TaskFillIndexerCommandsQueue::doEnter(std::shared_ptr<Blackboard> blackboard)
 {
 	{
+		IndexingStatistics::ScopedPhase phase(IndexingStatistics::s_commandQueueFillPhaseName);
 		std::lock_guard<std::mutex> lock(m_commandsMutex);
 		for (const FilePath& filePath:
 			 utility::partitionFilePathsBySize(m_indexerCommandProvider->getAllSourceFilePaths(), 2))
@@ -100,6 +103,8 @@ bool TaskFillIndexerCommandsQueue::fillCommandQueue()
 		return false;
 	}
 
+	TRACE("fill indexer command queue");
+	IndexingStatistics::ScopedPhase phase(IndexingStatistics::s_commandQueueFillPhaseName);
 	std::lock_guard<std::mutex> lock(m_commandsMutex);
 	std::vector<std::shared_ptr<IndexerCommand>> commands;
 
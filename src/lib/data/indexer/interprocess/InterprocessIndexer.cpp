@@ -1,11 +1,19 @@
 #include "InterprocessIndexer.h"
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
 #include "FileRegister.h"
 #include "IndexerCommand.h"
 #include "IndexerComposite.h"
+#include "IndexingStatistics.h"
 #include "LanguagePackageManager.h"
 #include "ScopedFunctor.h"
+#include "TraceRecorder.h"
 #include "logging.h"
+#include "tracing.h"
 
 InterprocessIndexer::InterprocessIndexer(const std::string& uuid, Id processId)
 	: m_interprocessIndexerCommandManager(uuid, processId, false)
@@ -18,7 +26,9 @@ InterprocessIndexer::InterprocessIndexer(const std::string& uuid, Id processId)
 
 void InterprocessIndexer::work()
 {
-	bool updaterThreadRunning = true;
+	std::atomic<bool> updaterThreadRunning(true);
+	std::mutex updaterThreadMutex;
+	std::condition_variable updaterThreadCondition;
 	std::shared_ptr<std::thread> updaterThread;
 	std::shared_ptr<IndexerBase> indexer;
 
@@ -30,7 +40,17 @@ void InterprocessIndexer::work()
 		updaterThread = std::make_shared<std::thread>([&]() {
 			while (updaterThreadRunning)
 			{
-				std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+				{
+					// woken up when stopping, so shutting down the indexer doesn't wait a second
+					std::unique_lock<std::mutex> lock(updaterThreadMutex);
+					if (updaterThreadCondition.wait_for(
+							lock, std::chrono::milliseconds(1000), [&]() {
+								return !updaterThreadRunning;
+							}))
+					{
+						break;
+					}
+				}
 
 				if (m_interprocessIndexingStatusManager.getIndexingInterrupted())
 				{
@@ -44,8 +64,20 @@ void InterprocessIndexer::work()
 			}
 		});
 
+		const bool statisticsEnabled = m_interprocessIndexingStatusManager.getStatisticsEnabled();
+		const bool tracingEnabled = m_interprocessIndexingStatusManager.getTracingEnabled();
+		if (tracingEnabled)
+		{
+			TraceRecorder::getInstance()->setEnabled(true);
+		}
+
 		ScopedFunctor threadStopper([&]() {
-			updaterThreadRunning = false;
+			{
+				std::lock_guard<std::mutex> lock(updaterThreadMutex);
+				updaterThreadRunning = false;
+			}
+			updaterThreadCondition.notify_all();
+
 			if (updaterThread)
 			{
 				updaterThread->join();
@@ -87,14 +119,44 @@ void InterprocessIndexer::work()
 				indexerCommand->getSourceFilePath());
 
 			LOG_INFO_STREAM(<< m_processId << " starting to index current file");
-			std::shared_ptr<IntermediateStorage> result = indexer->index(indexerCommand);
+			const std::chrono::steady_clock::time_point parseStart =
+				std::chrono::steady_clock::now();
+			std::shared_ptr<IntermediateStorage> result;
+			{
+				TRACE("index source file");
+				result = indexer->index(indexerCommand);
+			}
+			const std::chrono::steady_clock::time_point transferStart =
+				std::chrono::steady_clock::now();
 
 			if (result)
 			{
+				TRACE("push intermediate storage");
 				LOG_INFO_STREAM(<< m_processId << " pushing index to shared memory");
 				m_interprocessIntermediateStorageManager.pushIntermediateStorage(result);
 			}
 
+			if (statisticsEnabled)
+			{
+				IndexingStatistics::SourceFileTime sourceFileTime;
+				sourceFileTime.filePath = indexerCommand->getSourceFilePath();
+				sourceFileTime.processId = m_processId;
+				sourceFileTime.parseMS =
+					std::chrono::duration<double, std::milli>(transferStart - parseStart).count();
+				sourceFileTime.transferMS = std::chrono::duration<double, std::milli>(
+												std::chrono::steady_clock::now() - transferStart)
+												.count();
+				m_interprocessIndexingStatusManager.pushSourceFileTime(sourceFileTime);
+				m_interprocessIndexingStatusManager.updatePeakMemoryUsage(
+					IndexingStatistics::getPeakMemoryUsage());
+			}
+
+			if (tracingEnabled)
+			{
+				m_interprocessIndexingStatusManager.pushTraceRecords(
+					TraceRecorder::getInstance()->collectThreadRecords(m_processId));
+			}
+
 			LOG_INFO_STREAM(<< m_processId << " finalizing indexer status for current file");
 			m_interprocessIndexingStatusManager.finishIndexingSourceFile();
 
@@ -1,5 +1,7 @@
 #include "InterprocessIndexingStatusManager.h"
 
+#include <algorithm>
+
 #include "logging.h"
 #include "utilityString.h"
 
@@ -11,6 +13,12 @@ const char* InterprocessIndexingStatusManager::s_crashedFilesKeyName = "crashed_
 const char* InterprocessIndexingStatusManager::s_finishedProcessIdsKeyName = "finished_process_ids";
 const char* InterprocessIndexingStatusManager::s_indexingInterruptedKeyName =
 	"indexing_interrupted_flag";
+const char* InterprocessIndexingStatusManager::s_statisticsEnabledKeyName =
+	"statistics_enabled_flag";
+const char* InterprocessIndexingStatusManager::s_sourceFileTimesKeyName = "source_file_times";
+const char* InterprocessIndexingStatusManager::s_peakMemoryUsagesKeyName = "peak_memory_usages";
+const char* InterprocessIndexingStatusManager::s_tracingEnabledKeyName = "tracing_enabled_flag";
+const char* InterprocessIndexingStatusManager::s_traceRecordsKeyName = "trace_records";
 
 InterprocessIndexingStatusManager::InterprocessIndexingStatusManager(
 	const std::string& instanceUuid, Id processId, bool isOwner)
@@ -147,6 +155,233 @@ Id InterprocessIndexingStatusManager::getNextFinishedProcessId()
 	return 0;
 }
 
+void InterprocessIndexingStatusManager::setStatisticsEnabled(bool enabled)
+{
+	SharedMemory::ScopedAccess access(&m_sharedMemory);
+
+	bool* statisticsEnabledPtr = access.accessValue<bool>(s_statisticsEnabledKeyName);
+	if (statisticsEnabledPtr)
+	{
+		*statisticsEnabledPtr = enabled;
+	}
+}
+
+bool InterprocessIndexingStatusManager::getStatisticsEnabled()
+{
+	SharedMemory::ScopedAccess access(&m_sharedMemory);
+
+	bool* statisticsEnabledPtr = access.accessValue<bool>(s_statisticsEnabledKeyName);
+	if (statisticsEnabledPtr)
+	{
+		return *statisticsEnabledPtr;
+	}
+
+	return false;
+}
+
+void InterprocessIndexingStatusManager::pushSourceFileTime(
+	const IndexingStatistics::SourceFileTime& sourceFileTime)
+{
+	// the path goes last, so it may contain any character
+	const std::string line = std::to_string(sourceFileTime.processId) + '\t' +
+		std::to_string(sourceFileTime.parseMS) + '\t' + std::to_string(sourceFileTime.transferMS) +
+		'\t' + utility::encodeToUtf8(sourceFileTime.filePath.wstr());
+
+	SharedMemory::ScopedAccess access(&m_sharedMemory);
+
+	const size_t estimatedSize = 3 * (sizeof(SharedMemory::String) + line.size());
+	while (access.getFreeMemorySize() < estimatedSize)
+	{
+		access.growMemory(access.getMemorySize());
+	}
+
+	SharedMemory::Queue<SharedMemory::String>* sourceFileTimesPtr =
+		access.accessValueWithAllocator<SharedMemory::Queue<SharedMemory::String>>(
+			s_sourceFileTimesKeyName);
+	if (sourceFileTimesPtr)
+	{
+		SharedMemory::String str(access.getAllocator());
+		str = line.c_str();
+		sourceFileTimesPtr->push_back(str);
+	}
+}
+
+std::vector<IndexingStatistics::SourceFileTime> InterprocessIndexingStatusManager::
+	popSourceFileTimes()
+{
+	std::vector<IndexingStatistics::SourceFileTime> sourceFileTimes;
+
+	SharedMemory::ScopedAccess access(&m_sharedMemory);
+
+	SharedMemory::Queue<SharedMemory::String>* sourceFileTimesPtr =
+		access.accessValueWithAllocator<SharedMemory::Queue<SharedMemory::String>>(
+			s_sourceFileTimesKeyName);
+	if (sourceFileTimesPtr)
+	{
+		while (sourceFileTimesPtr->size())
+		{
+			const std::vector<std::string> parts = utility::splitToVector(
+				sourceFileTimesPtr->front().c_str(), '\t');
+			sourceFileTimesPtr->pop_front();
+
+			if (parts.size() < 4)
+			{
+				continue;
+			}
+
+			std::string path = parts[3];
+			for (size_t i = 4; i < parts.size(); i++)
+			{
+				path += '\t' + parts[i];
+			}
+
+			IndexingStatistics::SourceFileTime sourceFileTime;
+			sourceFileTime.processId = std::stoull(parts[0]);
+			sourceFileTime.parseMS = std::stod(parts[1]);
+			sourceFileTime.transferMS = std::stod(parts[2]);
+			sourceFileTime.filePath = FilePath(utility::decodeFromUtf8(path));
+			sourceFileTimes.push_back(sourceFileTime);
+		}
+	}
+
+	return sourceFileTimes;
+}
+
+void InterprocessIndexingStatusManager::updatePeakMemoryUsage(size_t bytes)
+{
+	SharedMemory::ScopedAccess access(&m_sharedMemory);
+
+	SharedMemory::Map<Id, size_t>* peakMemoryUsagesPtr =
+		access.accessValueWithAllocator<SharedMemory::Map<Id, size_t>>(s_peakMemoryUsagesKeyName);
+	if (peakMemoryUsagesPtr)
+	{
+		SharedMemory::Map<Id, size_t>::iterator it =
+			peakMemoryUsagesPtr->insert(std::pair<Id, size_t>(getProcessId(), bytes)).first;
+		it->second = std::max(it->second, bytes);
+	}
+}
+
+std::map<Id, size_t> InterprocessIndexingStatusManager::getPeakMemoryUsages()
+{
+	std::map<Id, size_t> peakMemoryUsages;
+
+	SharedMemory::ScopedAccess access(&m_sharedMemory);
+
+	SharedMemory::Map<Id, size_t>* peakMemoryUsagesPtr =
+		access.accessValueWithAllocator<SharedMemory::Map<Id, size_t>>(s_peakMemoryUsagesKeyName);
+	if (peakMemoryUsagesPtr)
+	{
+		for (const auto& p: *peakMemoryUsagesPtr)
+		{
+			peakMemoryUsages.emplace(p.first, p.second);
+		}
+	}
+
+	return peakMemoryUsages;
+}
+
+void InterprocessIndexingStatusManager::setTracingEnabled(bool enabled)
+{
+	SharedMemory::ScopedAccess access(&m_sharedMemory);
+
+	bool* tracingEnabledPtr = access.accessValue<bool>(s_tracingEnabledKeyName);
+	if (tracingEnabledPtr)
+	{
+		*tracingEnabledPtr = enabled;
+	}
+}
+
+bool InterprocessIndexingStatusManager::getTracingEnabled()
+{
+	SharedMemory::ScopedAccess access(&m_sharedMemory);
+
+	bool* tracingEnabledPtr = access.accessValue<bool>(s_tracingEnabledKeyName);
+	if (tracingEnabledPtr)
+	{
+		return *tracingEnabledPtr;
+	}
+
+	return false;
+}
+
+void InterprocessIndexingStatusManager::pushTraceRecords(const std::vector<TraceRecord>& records)
+{
+	if (records.empty())
+	{
+		return;
+	}
+
+	// all records of one push share a single string, one line per record with the name last
+	std::string lines;
+	for (const TraceRecord& record: records)
+	{
+		lines += std::to_string(getProcessId()) + '\t' + std::to_string(record.threadIndex) + '\t' +
+			std::to_string(record.startNS) + '\t' + std::to_string(record.durationNS) + '\t' +
+			record.eventName + '\n';
+	}
+
+	SharedMemory::ScopedAccess access(&m_sharedMemory);
+
+	const size_t estimatedSize = 3 * (sizeof(SharedMemory::String) + lines.size());
+	while (access.getFreeMemorySize() < estimatedSize)
+	{
+		access.growMemory(access.getMemorySize());
+	}
+
+	SharedMemory::Queue<SharedMemory::String>* traceRecordsPtr =
+		access.accessValueWithAllocator<SharedMemory::Queue<SharedMemory::String>>(
+			s_traceRecordsKeyName);
+	if (traceRecordsPtr)
+	{
+		SharedMemory::String str(access.getAllocator());
+		str = lines.c_str();
+		traceRecordsPtr->push_back(str);
+	}
+}
+
+std::vector<TraceRecord> InterprocessIndexingStatusManager::popTraceRecords()
+{
+	std::vector<std::string> pushedLines;
+	{
+		SharedMemory::ScopedAccess access(&m_sharedMemory);
+
+		SharedMemory::Queue<SharedMemory::String>* traceRecordsPtr =
+			access.accessValueWithAllocator<SharedMemory::Queue<SharedMemory::String>>(
+				s_traceRecordsKeyName);
+		if (traceRecordsPtr)
+		{
+			while (traceRecordsPtr->size())
+			{
+				pushedLines.push_back(traceRecordsPtr->front().c_str());
+				traceRecordsPtr->pop_front();
+			}
+		}
+	}
+
+	std::vector<TraceRecord> records;
+	for (const std::string& lines: pushedLines)
+	{
+		for (const std::string& line: utility::splitToVector(lines, '\n'))
+		{
+			const std::vector<std::string> parts = utility::splitToVector(line, '\t');
+			if (parts.size() != 5)
+			{
+				continue;
+			}
+
+			TraceRecord record;
+			record.processId = std::stoull(parts[0]);
+			record.threadIndex = std::stoull(parts[1]);
+			record.startNS = std::stoull(parts[2]);
+			record.durationNS = std::stoull(parts[3]);
+			record.eventName = parts[4];
+			records.push_back(record);
+		}
+	}
+
+	return records;
+}
+
 std::vector<FilePath> InterprocessIndexingStatusManager::getCurrentlyIndexedSourceFilePaths()
 {
 	SharedMemory::ScopedAccess access(&m_sharedMemory);
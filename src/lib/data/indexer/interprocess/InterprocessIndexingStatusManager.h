@@ -1,10 +1,13 @@
 #ifndef INTERPROCESS_INDEXING_STATUS_MANAGER_H
 #define INTERPROCESS_INDEXING_STATUS_MANAGER_H
 
+#include <map>
 #include <set>
 
 #include "BaseInterprocessDataManager.h"
 #include "FilePath.h"
+#include "IndexingStatistics.h"
+#include "TraceRecorder.h"
 
 class InterprocessIndexingStatusManager: public BaseInterprocessDataManager
 {
@@ -20,6 +23,19 @@ public:
 
 	Id getNextFinishedProcessId();
 
+	// only used while a benchmark records indexing statistics
+	void setStatisticsEnabled(bool enabled);
+	bool getStatisticsEnabled();
+	void pushSourceFileTime(const IndexingStatistics::SourceFileTime& sourceFileTime);
+	std::vector<IndexingStatistics::SourceFileTime> popSourceFileTimes();
+	void updatePeakMemoryUsage(size_t bytes);
+	std::map<Id, size_t> getPeakMemoryUsages();
+
+	void setTracingEnabled(bool enabled);
+	bool getTracingEnabled();
+	void pushTraceRecords(const std::vector<TraceRecord>& records);
+	std::vector<TraceRecord> popTraceRecords();
+
 	std::vector<FilePath> getCurrentlyIndexedSourceFilePaths();
 	std::vector<FilePath> getCrashedSourceFilePaths();
 
@@ -31,6 +47,11 @@ private:
 	static const char* s_crashedFilesKeyName;
 	static const char* s_finishedProcessIdsKeyName;
 	static const char* s_indexingInterruptedKeyName;
+	static const char* s_statisticsEnabledKeyName;
+	static const char* s_sourceFileTimesKeyName;
+	static const char* s_peakMemoryUsagesKeyName;
+	static const char* s_tracingEnabledKeyName;
+	static const char* s_traceRecordsKeyName;
 };
 
 #endif	  // INTERPROCESS_INDEXING_STATUS_MANAGER_H
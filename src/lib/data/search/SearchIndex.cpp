@@ -3,7 +3,9 @@
 #include <algorithm>
 #include <ctype.h>
 #include <iterator>
+#include <memory>
 
+#include "TimeStamp.h"
 #include "utility.h"
 #include "utilityString.h"
 
@@ -16,6 +18,8 @@ SearchIndex::~SearchIndex() {}
 
 void SearchIndex::addNode(Id id, std::wstring name, NodeType type)
 {
+	std::atomic_store(&m_lastSearch, std::shared_ptr<const LastSearch>());
+
 	SearchNode* currentNode = m_root;
 
 	while (name.size() > 0)
@@ -85,6 +89,8 @@ void SearchIndex::finishSetup()
 
 void SearchIndex::clear()
 {
+	std::atomic_store(&m_lastSearch, std::shared_ptr<const LastSearch>());
+
 	m_nodes.clear();
 	m_edges.clear();
 
@@ -93,16 +99,44 @@ void SearchIndex::clear()
 	m_root = m_nodes.back().get();
 }
 
+void SearchIndex::merge(SearchIndex& other)
+{
+	std::atomic_store(&m_lastSearch, std::shared_ptr<const LastSearch>());
+
+	m_root->containedTypes.add(other.m_root->containedTypes);
+	for (const std::pair<const Id, NodeType>& elementId: other.m_root->elementIds)
+	{
+		m_root->elementIds.emplace(elementId);
+	}
+
+	for (const std::pair<const wchar_t, SearchEdge*>& p: other.m_root->edges)
+	{
+		auto it = m_root->edges.find(p.first);
+		if (it == m_root->edges.end())
+		{
+			m_root->edges.emplace(p.first, p.second);
+		}
+		else
+		{
+			addNodesRecursive(p.second->target, p.second->s);
+			populateEdgeGate(it->second);
+		}
+	}
+
+	std::move(other.m_nodes.begin(), other.m_nodes.end(), std::back_inserter(m_nodes));
+	std::move(other.m_edges.begin(), other.m_edges.end(), std::back_inserter(m_edges));
+	other.clear();
+}
+
 std::vector<SearchResult> SearchIndex::search(
 	const std::wstring& query,
 	NodeTypeSet acceptedNodeTypes,
 	size_t maxResultCount,
-	size_t maxBestScoredResultsLength) const
+	size_t maxBestScoredResultsLength,
+	size_t maxBestScoringMilliseconds) const
 {
 	// find paths containing query
-	std::vector<SearchPath> paths;
-	searchRecursive(
-		SearchPath(L"", {}, m_root), utility::toLowerCase(query), acceptedNodeTypes, &paths);
+	const std::vector<SearchPath> paths = findPaths(utility::toLowerCase(query), acceptedNodeTypes);
 
 	// create scored search results
 	std::multiset<SearchResult> searchResults = createScoredResults(
@@ -123,13 +157,28 @@ std::vector<SearchResult> SearchIndex::search(
 	}
 
 	// find best scores
+	const TimeStamp startTime = TimeStamp::now();
+	bool timeExceeded = false;
 	std::map<std::wstring, SearchResult> scoresCache;
 	std::multiset<SearchResult> bestResults;
 	for (const SearchResult& result: searchResults)
 	{
 		if (!maxResultLength || result.text.size() <= maxResultLength)
 		{
-			bestResults.insert(bestScoredResult(result, &scoresCache, maxBestScoredResultsLength));
+			if (!timeExceeded && maxBestScoringMilliseconds &&
+				TimeStamp::now().deltaMS(startTime) > maxBestScoringMilliseconds)
+			{
+				timeExceeded = true;
+			}
+
+			if (timeExceeded)
+			{
+				bestResults.insert(result);
+			}
+			else
+			{
+				bestResults.insert(bestScoredResult(result, &scoresCache, maxBestScoredResultsLength));
+			}
 		}
 	}
 
@@ -159,6 +208,86 @@ void SearchIndex::populateEdgeGate(SearchEdge* e)
 	}
 }
 
+void SearchIndex::addNodesRecursive(const SearchNode* node, const std::wstring& text)
+{
+	for (const std::pair<const Id, NodeType>& elementId: node->elementIds)
+	{
+		addNode(elementId.first, text, elementId.second);
+	}
+
+	for (const std::pair<const wchar_t, SearchEdge*>& p: node->edges)
+	{
+		addNodesRecursive(p.second->target, text + p.second->s);
+	}
+}
+
+std::vector<SearchIndex::SearchPath> SearchIndex::findPaths(
+	const std::wstring& lowerQuery, NodeTypeSet acceptedNodeTypes) const
+{
+	std::vector<SearchPath> paths;
+
+	// all paths matching an extended query pass through the paths of the shorter query, because
+	// characters are always matched at the first possible position
+	const std::shared_ptr<const LastSearch> lastSearch = std::atomic_load(&m_lastSearch);
+	if (lastSearch && lastSearch->nodeTypes == acceptedNodeTypes &&
+		utility::isPrefix(lastSearch->query, lowerQuery))
+	{
+		const std::wstring remainingQuery = lowerQuery.substr(lastSearch->query.size());
+		if (remainingQuery.empty())
+		{
+			return lastSearch->paths;
+		}
+
+		for (const SearchPath& path: lastSearch->paths)
+		{
+			continuePath(path, remainingQuery, acceptedNodeTypes, &paths);
+		}
+	}
+	else
+	{
+		searchRecursive(SearchPath(L"", {}, m_root), lowerQuery, acceptedNodeTypes, &paths);
+	}
+
+	std::shared_ptr<LastSearch> search = std::make_shared<LastSearch>();
+	search->query = lowerQuery;
+	search->nodeTypes = acceptedNodeTypes;
+	search->paths = paths;
+	std::atomic_store(&m_lastSearch, std::shared_ptr<const LastSearch>(std::move(search)));
+
+	return paths;
+}
+
+void SearchIndex::continuePath(
+	const SearchPath& path,
+	const std::wstring& remainingQuery,
+	NodeTypeSet acceptedNodeTypes,
+	std::vector<SearchIndex::SearchPath>* results) const
+{
+	// consume characters left on the last edge of the path
+	SearchPath currentPath = path;
+
+	size_t j = 0;
+	for (size_t i = path.indices.empty() ? 0 : path.indices.back() + 1;
+		 i < path.text.size() && j < remainingQuery.size();
+		 i++)
+	{
+		if (towlower(path.text[i]) == remainingQuery[j])
+		{
+			currentPath.indices.push_back(i);
+			j++;
+		}
+	}
+
+	if (j == remainingQuery.size())
+	{
+		results->push_back(std::move(currentPath));
+	}
+	else
+	{
+		searchRecursive(currentPath, remainingQuery.substr(j), acceptedNodeTypes, results);
+	}
+}
+
 void SearchIndex::searchRecursive(
 	const SearchPath& path,
 	const std::wstring& remainingQuery,
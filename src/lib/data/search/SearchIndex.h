@@ -43,12 +43,21 @@ public:
 	void finishSetup();
 	void clear();
 
+	// Moves all nodes of the other index into this one and clears the other index. Names starting
+	// with a character not used by this index are moved without adding them again, so indices
+	// built in parallel for disjoint first characters are merged quickly. Both indices need to be
+	// set up already.
+	void merge(SearchIndex& other);
+
 	// maxResultCount == 0 means "no restriction".
+	// maxBestScoringMilliseconds == 0 means "no restriction", otherwise results that don't get
+	// rescored in time keep the score of their first match.
 	std::vector<SearchResult> search(
 		const std::wstring& query,
 		NodeTypeSet acceptedNodeTypes,
 		size_t maxResultCount,
-		size_t maxBestScoredResultsLength = 0) const;
+		size_t maxBestScoredResultsLength = 0,
+		size_t maxBestScoringMilliseconds = 0) const;
 
 private:
 	struct SearchEdge;
@@ -84,6 +93,13 @@ private:
 	};
 
 	void populateEdgeGate(SearchEdge* e);
+	void addNodesRecursive(const SearchNode* node, const std::wstring& text);
+	std::vector<SearchPath> findPaths(const std::wstring& lowerQuery, NodeTypeSet acceptedNodeTypes) const;
+	void continuePath(
+		const SearchPath& path,
+		const std::wstring& remainingQuery,
+		NodeTypeSet acceptedNodeTypes,
+		std::vector<SearchIndex::SearchPath>* results) const;
 	void searchRecursive(
 		const SearchPath& path,
 		const std::wstring& remainingQuery,
@@ -122,6 +138,17 @@ private:
 	std::vector<std::unique_ptr<SearchNode>> m_nodes;
 	std::vector<std::unique_ptr<SearchEdge>> m_edges;
 	SearchNode* m_root;
+
+	struct LastSearch
+	{
+		std::wstring query;
+		NodeTypeSet nodeTypes;
+		std::vector<SearchPath> paths;
+	};
+
+	// paths of the last search, reused when the next query extends it. Only replaced as a whole
+	// through atomic_load and atomic_store, so concurrent searches don't wait for each other.
+	mutable std::shared_ptr<const LastSearch> m_lastSearch;
 };
 
 #endif	  // SEARCH_INDEX_H
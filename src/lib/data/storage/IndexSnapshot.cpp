@@ -0,0 +1,69 @@
+#include "IndexSnapshot.h"
+
+#include <algorithm>
+
+const size_t IndexSnapshot::s_maxTypeCount = 256;
+
+bool IndexSnapshot::addNode(Id id, int type)
+{
+	uint8_t typeCode = 0;
+	if (!encodeType(type, m_nodeTypeDictionary, typeCode))
+	{
+		return false;
+	}
+
+	m_nodeIds.push_back(id);
+	m_nodeTypeCodes.push_back(typeCode);
+	return true;
+}
+
+size_t IndexSnapshot::getNodeCount() const
+{
+	return m_nodeIds.size();
+}
+
+std::vector<Id> IndexSnapshot::getNodeIds(const std::function<bool(int)>& typeFilter) const
+{
+	uint8_t codeMatches[s_maxTypeCount] = {0};
+	for (size_t i = 0; i < m_nodeTypeDictionary.size(); i++)
+	{
+		codeMatches[i] = typeFilter(m_nodeTypeDictionary[i]) ? 1 : 0;
+	}
+
+	// the matches are counted first, so the scans don't branch and the result is allocated once
+	const size_t nodeCount = m_nodeTypeCodes.size();
+	size_t matchCount = 0;
+	for (size_t i = 0; i < nodeCount; i++)
+	{
+		matchCount += codeMatches[m_nodeTypeCodes[i]];
+	}
+
+	std::vector<Id> nodeIds(matchCount);
+	size_t matchIndex = 0;
+	for (size_t i = 0; i < nodeCount && matchIndex < matchCount; i++)
+	{
+		nodeIds[matchIndex] = m_nodeIds[i];
+		matchIndex += codeMatches[m_nodeTypeCodes[i]];
+	}
+
+	return nodeIds;
+}
+
+bool IndexSnapshot::encodeType(int type, std::vector<int>& dictionary, uint8_t& code)
+{
+	std::vector<int>::const_iterator it = std::find(dictionary.begin(), dictionary.end(), type);
+	if (it != dictionary.end())
+	{
+		code = static_cast<uint8_t>(it - dictionary.begin());
+		return true;
+	}
+
+	if (dictionary.size() >= s_maxTypeCount)
+	{
+		return false;
+	}
+
+	dictionary.push_back(type);
+	code = static_cast<uint8_t>(dictionary.size() - 1);
+	return true;
+}
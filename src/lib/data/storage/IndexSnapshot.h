@@ -0,0 +1,34 @@
+#ifndef INDEX_SNAPSHOT_H
+#define INDEX_SNAPSHOT_H
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "types.h"
+
+// Copy of the id and type columns of the node table, so repeated queries over all node types scan
+// plain arrays instead of stepping through database rows. Types are dictionary encoded to one byte
+// per row, there are less than 256 node kinds.
+class IndexSnapshot
+{
+public:
+	// returns false without adding the node if its type doesn't fit into the type dictionary
+	bool addNode(Id id, int type);
+
+	size_t getNodeCount() const;
+
+	// the filter is called once per distinct type, not once per node
+	std::vector<Id> getNodeIds(const std::function<bool(int)>& typeFilter) const;
+
+private:
+	static const size_t s_maxTypeCount;
+
+	static bool encodeType(int type, std::vector<int>& dictionary, uint8_t& code);
+
+	std::vector<int> m_nodeTypeDictionary;
+	std::vector<Id> m_nodeIds;
+	std::vector<uint8_t> m_nodeTypeCodes;
+};
+
+#endif	  // INDEX_SNAPSHOT_H
@@ -1,10 +1,18 @@
 #include "PersistentStorage.h"
 
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
 #include <queue>
 #include <sstream>
+#include <thread>
+#include <unordered_set>
 
 #include "AccessKind.h"
 #include "ApplicationSettings.h"
+#include "CancellationToken.h"
 #include "ElementComponentKind.h"
 #include "FileInfo.h"
 #include "FilePath.h"
@@ -17,6 +25,7 @@
 #include "SourceLocationFile.h"
 #include "TextAccess.h"
 #include "TextCodec.h"
+#include "ThreadPool.h"
 #include "TimeStamp.h"
 #include "TokenComponentAccess.h"
 #include "TokenComponentBundledEdges.h"
@@ -29,6 +38,108 @@
 #include "utility.h"
 #include "utilityApp.h"
 
+namespace
+{
+// time after which autocompletion results keep the score of their first match
+const size_t s_maxAutocompletionScoringMilliseconds = 100;
+
+// number of fulltext search results that are passed on together while the search is still running
+const size_t s_fullTextSearchBatchLocationCount = 100;
+
+// interval in which a thread waiting for parallel functions calls its whileWaiting function
+const size_t s_parallelWaitIntervalMilliseconds = 50;
+
+// runs the functions on ThreadPool threads and rethrows exceptions after all of them finished,
+// whileWaiting is called on the calling thread in intervals and once more after they finished
+void runInParallel(
+	const std::vector<std::function<void()>>& functions,
+	std::function<void()> whileWaiting = nullptr)
+{
+	std::vector<std::exception_ptr> exceptions(functions.size());
+	std::mutex runningCountMutex;
+	std::condition_variable runningCountCondition;
+	size_t runningCount = functions.size();
+
+	for (size_t i = 0; i < functions.size(); i++)
+	{
+		ThreadPool::getInstance()->run([&, i]() {
+			try
+			{
+				functions[i]();
+			}
+			catch (...)
+			{
+				exceptions[i] = std::current_exception();
+			}
+
+			// notifying while locked, because the waiting thread returns once the count reaches 0
+			std::lock_guard<std::mutex> lock(runningCountMutex);
+			runningCount--;
+			runningCountCondition.notify_all();
+		});
+	}
+
+	{
+		std::unique_lock<std::mutex> lock(runningCountMutex);
+		if (!whileWaiting)
+		{
+			runningCountCondition.wait(lock, [&runningCount]() { return runningCount == 0; });
+		}
+		else
+		{
+			bool finished = false;
+			while (!finished)
+			{
+				finished = runningCountCondition.wait_for(
+					lock,
+					std::chrono::milliseconds(s_parallelWaitIntervalMilliseconds),
+					[&runningCount]() { return runningCount == 0; });
+
+				lock.unlock();
+				whileWaiting();
+				lock.lock();
+			}
+		}
+	}
+
+	for (const std::exception_ptr& exception: exceptions)
+	{
+		if (exception)
+		{
+			std::rethrow_exception(exception);
+		}
+	}
+}
+
+struct CacheStage
+{
+	std::wstring name;
+	std::function<void()> build;
+	double duration = 0;
+};
+
+void runCacheStagesInParallel(std::vector<CacheStage>& stages)
+{
+	std::vector<std::function<void()>> functions;
+	for (CacheStage& stage: stages)
+	{
+		functions.push_back([&stage]() {
+			const TimeStamp start = TimeStamp::now();
+			stage.build();
+			stage.duration = TimeStamp::durationSeconds(start);
+		});
+	}
+	runInParallel(functions);
+}
+
+struct SearchIndexEntry
+{
+	Id id;
+	std::wstring name;
+	NodeType type;
+};
+}	 // namespace
+
 PersistentStorage::PersistentStorage(const FilePath& dbPath, const FilePath& bookmarkPath)
 	: m_sqliteIndexStorage(dbPath), m_sqliteBookmarkStorage(bookmarkPath)
 {
@@ -158,26 +269,41 @@ Id PersistentStorage::addError(const StorageErrorData& data)
 void PersistentStorage::removeElement(const Id id)
 {
 	m_sqliteIndexStorage.removeElement(id);
+	m_errorInfoCache.clear();
+	clearIndexSnapshot();
+	clearFileDependencyGraphs();
 }
 
 void PersistentStorage::removeElements(const std::vector<Id>& ids)
 {
 	m_sqliteIndexStorage.removeElements(ids);
+	m_errorInfoCache.clear();
+	clearIndexSnapshot();
+	clearFileDependencyGraphs();
 }
 
 void PersistentStorage::removeOccurrence(const StorageOccurrence& occurrence)
 {
 	m_sqliteIndexStorage.removeOccurrence(occurrence);
+	m_errorInfoCache.clear();
+	clearIndexSnapshot();
+	clearFileDependencyGraphs();
 }
 
 void PersistentStorage::removeOccurrences(const std::vector<StorageOccurrence>& occurrences)
 {
 	m_sqliteIndexStorage.removeOccurrences(occurrences);
+	m_errorInfoCache.clear();
+	clearIndexSnapshot();
+	clearFileDependencyGraphs();
 }
 
 void PersistentStorage::removeElementsWithoutOccurrences(const std::vector<Id>& elementIds)
 {
 	m_sqliteIndexStorage.removeElementsWithoutOccurrences(elementIds);
+	m_errorInfoCache.clear();
+	clearIndexSnapshot();
+	clearFileDependencyGraphs();
 }
 
 const std::vector<StorageNode>& PersistentStorage::getStorageNodes() const
@@ -250,6 +376,9 @@ void PersistentStorage::finishInjection()
 {
 	m_sqliteIndexStorage.commitTransaction();
 
+	clearIndexSnapshot();
+	clearFileDependencyGraphs();
+
 	afterErrorRecording();
 }
 
@@ -257,17 +386,25 @@ void PersistentStorage::rollbackInjection()
 {
 	m_sqliteIndexStorage.rollbackTransaction();
 
+	// errors loaded during the injection may be gone now
+	m_errorInfoCache.clear();
+	clearIndexSnapshot();
+	clearFileDependencyGraphs();
+
 	afterErrorRecording();
 }
 
 const std::vector<ErrorInfo> PersistentStorage::getErrorInfos() const
 {
-	return m_sqliteIndexStorage.getAllErrorInfos();
+	loadErrorInfoCache();
+	return m_errorInfoCache.getErrors();
 }
 
 void PersistentStorage::beforeErrorRecording()
 {
-	m_preInjectionErrorCount = m_sqliteIndexStorage.getErrorCount();
+	loadErrorInfoCache();
+	m_preInjectionErrorCount = m_errorInfoCache.getErrorCount();
+	m_preInjectionOccurrenceRowId = m_sqliteIndexStorage.getLastOccurrenceRowId();
 
 	if (!m_preIndexingErrorCountSet)
 	{
@@ -278,13 +415,22 @@ void PersistentStorage::beforeErrorRecording()
 
 void PersistentStorage::afterErrorRecording()
 {
-	std::vector<ErrorInfo> errors = getErrorInfos();
-	if (m_preInjectionErrorCount < errors.size())
-	{
-		ErrorCountInfo errorCount(errors);
-		errors.erase(
-			errors.begin(), errors.begin() + m_preInjectionErrorCount - m_preIndexingErrorCount);
-		MessageErrorCountUpdate(errorCount, errors).dispatch();
+	// only the errors recorded by this injection are read, the other ones are already cached,
+	// unless the cache got cleared because elements were removed during the injection
+	m_errorInfoCache.appendOrLoad(
+		[this]() {
+			return m_sqliteIndexStorage.getErrorInfosAfterOccurrence(m_preInjectionOccurrenceRowId);
+		},
+		[this]() { return m_sqliteIndexStorage.getErrorInfosAfterOccurrence(0); });
+
+	const ErrorCountInfo errorCount = m_errorInfoCache.getErrorCountInfo();
+	if (m_preInjectionErrorCount < errorCount.total)
+	{
+		// the first update after indexing started also contains the errors recorded before
+		const size_t firstErrorIndex = m_preInjectionErrorCount > m_preIndexingErrorCount
+			? m_preInjectionErrorCount - m_preIndexingErrorCount
+			: 0;
+		MessageErrorCountUpdate(errorCount, m_errorInfoCache.getErrors(firstErrorIndex)).dispatch();
 		m_preIndexingErrorCount = 0;
 	}
 }
@@ -364,6 +510,9 @@ void PersistentStorage::clearCaches()
 	m_hierarchyCache.clear();
 	m_fullTextSearchIndex.clear();
 	m_fullTextSearchCodec = "";
+	m_errorInfoCache.clear();
+	clearIndexSnapshot();
+	clearFileDependencyGraphs();
 }
 
 std::set<FilePath> PersistentStorage::getReferenced(const std::set<FilePath>& filePaths) const
@@ -393,6 +542,7 @@ void PersistentStorage::clearAllErrors()
 	TRACE();
 
 	m_sqliteIndexStorage.removeAllErrors();
+	m_errorInfoCache.clear();
 }
 
 void PersistentStorage::clearFileElements(
@@ -412,6 +562,9 @@ void PersistentStorage::clearFileElements(
 		m_sqliteIndexStorage.removeElementsWithLocationInFiles(fileNodeIds, updateStatusCallback);
 		m_sqliteIndexStorage.removeElements(fileNodeIds);
 		m_sqliteIndexStorage.commitTransaction();
+		m_errorInfoCache.clear();
+		clearIndexSnapshot();
+		clearFileDependencyGraphs();
 		updateStatusCallback(100);
 	}
 }
@@ -468,10 +621,48 @@ void PersistentStorage::buildCaches()
 
 	clearCaches();
 
-	buildFilePathMaps();
-	buildSearchIndex();
-	buildMemberEdgeIdOrderMap();
-	buildHierarchyCache();
+	const TimeStamp start = TimeStamp::now();
+
+	// tables used by several caches are only read once
+	std::vector<StorageNode> nodes;
+	std::vector<StorageEdge> memberEdges;
+
+	std::vector<CacheStage> readStages = {
+		{L"file paths", [this]() { buildFilePathMaps(); }},
+		{L"definition kinds", [this]() { buildSymbolDefinitionKinds(); }},
+		{L"nodes", [this, &nodes]() { nodes = m_sqliteIndexStorage.getAll<StorageNode>(); }},
+		{L"member edges", [this, &memberEdges]() {
+			 m_sqliteIndexStorage.forEachOfType<StorageEdge>(
+				 Edge::typeToInt(Edge::EDGE_MEMBER),
+				 [&memberEdges](StorageEdge&& edge) { memberEdges.emplace_back(edge); });
+		 }}};
+	runCacheStagesInParallel(readStages);
+
+	std::vector<CacheStage> buildStages = {
+		{L"search index", [this, &nodes]() { buildSearchIndex(nodes); }},
+		{L"member edge order",
+		 [this, &memberEdges]() { buildMemberEdgeIdOrderMap(memberEdges); }},
+		{L"hierarchy cache",
+		 [this, &memberEdges, &nodes]() { buildHierarchyCache(memberEdges, nodes); }}};
+	runCacheStagesInParallel(buildStages);
+
+	std::wstring stageDurations;
+	for (const std::vector<CacheStage>* stages: {&readStages, &buildStages})
+	{
+		for (const CacheStage& stage: *stages)
+		{
+			const std::wstring duration = utility::decodeFromUtf8(
+				TimeStamp::secondsToString(stage.duration));
+			LOG_INFO(L"Built " + stage.name + L" cache stage in " + duration);
+			stageDurations += (stageDurations.empty() ? L"" : L", ") + stage.name + L" " + duration;
+		}
+	}
+
+	MessageStatus(
+		L"Built caches in " +
+		utility::decodeFromUtf8(TimeStamp::secondsToString(TimeStamp::durationSeconds(start))) +
+		L" (" + stageDurations + L")")
+		.dispatch();
 }
 
 void PersistentStorage::optimizeMemory()
@@ -586,16 +777,19 @@ StorageEdge PersistentStorage::getEdgeById(Id edgeId) const
 	return m_sqliteIndexStorage.getEdgeById(edgeId);
 }
 
-std::shared_ptr<SourceLocationCollection> PersistentStorage::getFullTextSearchLocations(
-	const std::wstring& searchTerm, bool caseSensitive) const
+FullTextSearchPage PersistentStorage::getFullTextSearchLocations(
+	const std::wstring& searchTerm,
+	bool caseSensitive,
+	size_t fileOffset,
+	size_t maxResultCount,
+	std::function<void(std::shared_ptr<SourceLocationCollection>)> onLocations) const
 {
 	TRACE();
 
-	std::shared_ptr<SourceLocationCollection> collection =
-		std::make_shared<SourceLocationCollection>();
+	FullTextSearchPage page;
 	if (searchTerm.empty())
 	{
-		return collection;
+		return page;
 	}
 
 	const TextCodec codec(ApplicationSettings::getInstance()->getTextEncoding());
@@ -609,6 +803,8 @@ std::shared_ptr<SourceLocationCollection> PersistentStorage::getFullTextSearchLo
 		}
 	}
 
+	const CancellationToken cancellationToken = CancellationToken::getCurrent();
+
 	MessageStatus(
 		std::wstring(L"Searching fulltext (case-") +
 			(caseSensitive ? L"sensitive" : L"insensitive") + L"): " + searchTerm,
@@ -616,96 +812,137 @@ std::shared_ptr<SourceLocationCollection> PersistentStorage::getFullTextSearchLo
 		true)
 		.dispatch();
 
+	// sorted to keep the files of each page stable when the index gets rebuilt in between
+	std::vector<FullTextSearchResult> fileResults = m_fullTextSearchIndex.searchForTerm(searchTerm);
+	std::sort(
+		fileResults.begin(),
+		fileResults.end(),
+		[](const FullTextSearchResult& a, const FullTextSearchResult& b) {
+			return a.fileId < b.fileId;
+		});
+	page.fileCount = fileResults.size();
+
+	// Location ids are derived from the position of the hit among all hits of the search, so they
+	// do not collide between pages. The first bit is set to avoid collisions with indexed locations.
+	std::vector<Id> firstLocationIds;
+	std::vector<size_t> pageFileIndices;
 	{
-		std::vector<std::shared_ptr<std::thread>> threads;
-		std::mutex collectionMutex;
-		for (std::vector<FullTextSearchResult> fileResults: utility::splitToEquallySizedParts(
-				 m_fullTextSearchIndex.searchForTerm(searchTerm), utility::getIdealThreadCount()))
+		Id locationId = ~(~Id(0) >> 1) + 1;
+		size_t resultCount = 0;
+		for (size_t i = 0; i < fileResults.size(); i++)
 		{
-			std::shared_ptr<std::thread> thread = std::make_shared<std::thread>(
-				[this,
-				 &searchTerm,
-				 &caseSensitive,
-				 &codec,
-				 /*no ref here!*/ fileResults,
-				 &collection,
-				 &collectionMutex]() {
-					const int termLength = static_cast<int>(searchTerm.length());
-					for (const FullTextSearchResult& fileResult: fileResults)
-					{
-						const FilePath filePath = getFileNodePath(fileResult.fileId);
-						std::shared_ptr<TextAccess> fileContent = getFileContent(filePath, false);
+			firstLocationIds.push_back(locationId);
+			locationId += fileResults[i].positions.size();
 
-						int charsTotal = 0;
-						int lineNumber = 1;
-						std::wstring line = codec.decode(fileContent->getLine(lineNumber));
+			if (i >= fileOffset && (!maxResultCount || resultCount < maxResultCount))
+			{
+				pageFileIndices.push_back(i);
+				resultCount += fileResults[i].positions.size();
+			}
+		}
+	}
+	page.nextFileOffset = fileOffset + pageFileIndices.size();
 
-						for (int pos: fileResult.positions)
-						{
-							while (charsTotal + (int)line.length() <= pos)
-							{
-								charsTotal += static_cast<int>(line.length());
-								lineNumber++;
-								line = codec.decode(fileContent->getLine(lineNumber));
-							}
+	// batches are collected by the search threads and passed on by this thread while it waits
+	std::mutex pageMutex;
+	std::vector<std::shared_ptr<SourceLocationCollection>> foundBatches;
+	std::vector<std::function<void()>> functions;
+	for (const std::vector<size_t>& fileIndices:
+		 utility::splitToEquallySizedParts(pageFileIndices, utility::getIdealThreadCount()))
+	{
+		functions.push_back([&, fileIndices]() {
+			const int termLength = static_cast<int>(searchTerm.length());
 
-							ParseLocation location;
-							location.startLineNumber = lineNumber;
-							location.startColumnNumber = pos - charsTotal + 1;
+			std::shared_ptr<SourceLocationCollection> batch =
+				std::make_shared<SourceLocationCollection>();
+			size_t batchLocationCount = 0;
 
-							if (caseSensitive &&
-								line.substr(location.startColumnNumber - 1, termLength) != searchTerm)
-							{
-								continue;
-							}
-							while ((charsTotal + (int)line.length()) < pos + termLength)
-							{
-								charsTotal += static_cast<int>(line.length());
-								lineNumber++;
-								line = codec.decode(fileContent->getLine(lineNumber));
-							}
-							location.endLineNumber = lineNumber;
-							location.endColumnNumber = pos + termLength - charsTotal;
+			for (size_t i = 0; i < fileIndices.size(); i++)
+			{
+				if (cancellationToken.isCanceled())
+				{
+					return;
+				}
 
-							{
-								std::lock_guard<std::mutex> lock(collectionMutex);
-								// Set first bit to 1 to avoid collisions
-								const Id locationId = ~(~Id(0) >> 1) +
-									collection->getSourceLocationCount() + 1;
-								collection->addSourceLocation(
-									LOCATION_FULLTEXT_SEARCH,
-									locationId,
-									std::vector<Id>(),
-									filePath,
-									location.startLineNumber,
-									location.startColumnNumber,
-									location.endLineNumber,
-									location.endColumnNumber);
-							}
-						}
+				const FullTextSearchResult& fileResult = fileResults[fileIndices[i]];
+				const FilePath filePath = getFileNodePath(fileResult.fileId);
+
+				// the index only knows lowercase text, so the original content is required for
+				// case-sensitive matching
+				std::wstring text;
+				if (caseSensitive)
+				{
+					text = codec.decode(getFileContent(filePath, false)->getText());
+				}
+
+				Id locationId = firstLocationIds[fileIndices[i]];
+				for (int pos: fileResult.positions)
+				{
+					locationId++;
+					if (caseSensitive && text.compare(pos, termLength, searchTerm) != 0)
+					{
+						continue;
 					}
-				});
-			threads.push_back(thread);
+
+					batch->addSourceLocation(
+						LOCATION_FULLTEXT_SEARCH,
+						locationId - 1,
+						std::vector<Id>(),
+						filePath,
+						fileResult.getLineNumber(pos),
+						fileResult.getColumnNumber(pos),
+						fileResult.getLineNumber(pos + termLength - 1),
+						fileResult.getColumnNumber(pos + termLength - 1));
+					batchLocationCount++;
+				}
+
+				if (batchLocationCount >= s_fullTextSearchBatchLocationCount ||
+					(i + 1 == fileIndices.size() && batchLocationCount))
+				{
+					addCompleteFlagsToSourceLocationCollection(batch.get());
+
+					std::lock_guard<std::mutex> lock(pageMutex);
+					page.locations->addSourceLocationCopies(batch.get());
+					foundBatches.push_back(batch);
+
+					batch = std::make_shared<SourceLocationCollection>();
+					batchLocationCount = 0;
+				}
+			}
+		});
+	}
+	runInParallel(functions, [&]() {
+		std::vector<std::shared_ptr<SourceLocationCollection>> batches;
+		{
+			std::lock_guard<std::mutex> lock(pageMutex);
+			batches.swap(foundBatches);
 		}
 
-		for (std::shared_ptr<std::thread> thread: threads)
+		for (const std::shared_ptr<SourceLocationCollection>& batch: batches)
 		{
-			thread->join();
+			if (onLocations && !cancellationToken.isCanceled())
+			{
+				onLocations(batch);
+			}
 		}
-	}
+	});
 
-	addCompleteFlagsToSourceLocationCollection(collection.get());
+	if (cancellationToken.isCanceled())
+	{
+		LOG_INFO(L"Canceled fulltext search: " + searchTerm);
+		return FullTextSearchPage();
+	}
 
 	MessageStatus(
-		std::to_wstring(collection->getSourceLocationCount()) + L" results in " +
-			std::to_wstring(collection->getSourceLocationFileCount()) +
-			L" files for fulltext search (case-" + (caseSensitive ? L"sensitive" : L"insensitive") +
-			L"): " + searchTerm,
+		std::to_wstring(page.locations->getSourceLocationCount()) + L" results in " +
+			std::to_wstring(page.locations->getSourceLocationFileCount()) + L" of " +
+			std::to_wstring(page.fileCount) + L" files for fulltext search (case-" +
+			(caseSensitive ? L"sensitive" : L"insensitive") + L"): " + searchTerm,
 		false,
 		false)
 		.dispatch();
 
-	return collection;
+	return page;
 }
 
 std::vector<SearchMatch> PersistentStorage::getAutocompletionMatches(
@@ -721,18 +958,26 @@ std::vector<SearchMatch> PersistentStorage::getAutocompletionMatches(
 	// create SearchMatches
 	std::vector<SearchMatch> matches;
 
+	// symbols and files are searched in parallel
+	std::vector<SearchMatch> fileMatches;
+	std::vector<std::function<void()>> functions;
 	if (!acceptedNodeTypes
 			 .getWithMatchingRemoved([](const NodeType& type) { return type.isFile(); })
 			 .isEmpty())
 	{
-		matches = getAutocompletionSymbolMatches(
-			query, acceptedNodeTypes, maxResultsCount, maxBestScoredResultsLength);
+		functions.push_back([&]() {
+			matches = getAutocompletionSymbolMatches(
+				query, acceptedNodeTypes, maxResultsCount, maxBestScoredResultsLength);
+		});
 	}
-
 	if (acceptedNodeTypes.containsMatching([](const NodeType& type) { return type.isFile(); }))
 	{
-		utility::append(matches, getAutocompletionFileMatches(query, maxResultsCount));
+		functions.push_back([&]() {
+			fileMatches = getAutocompletionFileMatches(query, maxResultsCount);
+		});
 	}
+	runInParallel(functions);
+	utility::append(matches, fileMatches);
 
 	if (acceptCommands)
 	{
@@ -811,7 +1056,11 @@ std::vector<SearchMatch> PersistentStorage::getAutocompletionSymbolMatches(
 {
 	// search in indices
 	const std::vector<SearchResult> results = m_symbolIndex.search(
-		query, acceptedNodeTypes, maxResultsCount, maxBestScoredResultsLength);
+		query,
+		acceptedNodeTypes,
+		maxResultsCount,
+		maxBestScoredResultsLength,
+		s_maxAutocompletionScoringMilliseconds);
 
 	// fetch StorageNodes for node ids
 	std::map<Id, StorageNode> storageNodeMap;
@@ -902,7 +1151,8 @@ std::vector<SearchMatch> PersistentStorage::getAutocompletionFileMatches(
 		query,
 		NodeTypeSet::all().getWithMatchingKept([](const NodeType& type) { return type.isFile(); }),
 		maxResultsCount,
-		100);
+		100,
+		s_maxAutocompletionScoringMilliseconds);
 
 	// create SearchMatches
 	std::vector<SearchMatch> matches;
@@ -1065,17 +1315,32 @@ std::shared_ptr<Graph> PersistentStorage::getGraphForNodeTypes(NodeTypeSet nodeT
 	TRACE();
 
 	std::vector<Id> tokenIds;
+	auto addExplicitNodeId = [&](Id nodeId) {
+		auto it = m_symbolDefinitionKinds.find(nodeId);
+		if (it != m_symbolDefinitionKinds.end() && it->second == DEFINITION_EXPLICIT)
+		{
+			tokenIds.push_back(nodeId);
+		}
+	};
 
-	m_sqliteIndexStorage.forEach<StorageNode>([&](StorageNode&& node) {
-		if (nodeTypes.contains(NodeType(intToNodeKind(node.type))))
+	if (std::shared_ptr<const IndexSnapshot> indexSnapshot = getIndexSnapshot())
+	{
+		for (Id nodeId: indexSnapshot->getNodeIds([&nodeTypes](int type) {
+				 return nodeTypes.contains(NodeType(intToNodeKind(type)));
+			 }))
 		{
-			auto it = m_symbolDefinitionKinds.find(node.id);
-			if (it != m_symbolDefinitionKinds.end() && it->second == DEFINITION_EXPLICIT)
+			addExplicitNodeId(nodeId);
+		}
+	}
+	else
+	{
+		m_sqliteIndexStorage.forEach<StorageNode>([&](StorageNode&& node) {
+			if (nodeTypes.contains(NodeType(intToNodeKind(node.type))))
 			{
-				tokenIds.push_back(node.id);
+				addExplicitNodeId(node.id);
 			}
-		}
-	});
+		});
+	}
 
 	if (nodeTypes.containsMatching([](const NodeType& type) { return type.isFile(); }))
 	{
@@ -1293,6 +1558,8 @@ std::shared_ptr<Graph> PersistentStorage::getGraphForTrail(
 {
 	TRACE();
 
+	const CancellationToken cancellationToken = CancellationToken::getCurrent();
+
 	std::set<Id> nodeIds;
 	std::set<Id> edgeIds;
 
@@ -1321,6 +1588,12 @@ std::shared_ptr<Graph> PersistentStorage::getGraphForTrail(
 
 	while (nodeIdsToProcess.size() && (!depth || currentDepth < depth))
 	{
+		if (cancellationToken.isCanceled())
+		{
+			LOG_INFO("Canceled trail query at depth " + std::to_string(currentDepth));
+			return std::make_shared<Graph>();
+		}
+
 		std::vector<StorageEdge> edges = forward
 			? m_sqliteIndexStorage.getEdgesBySourceIds(nodeIdsToProcess)
 			: m_sqliteIndexStorage.getEdgesByTargetIds(nodeIdsToProcess);
@@ -1843,76 +2116,46 @@ StorageStats PersistentStorage::getStorageStats() const
 
 ErrorCountInfo PersistentStorage::getErrorCount() const
 {
-	return ErrorCountInfo(m_sqliteIndexStorage.getAllErrorInfos());
+	loadErrorInfoCache();
+	return m_errorInfoCache.getErrorCountInfo();
 }
 
 std::vector<ErrorInfo> PersistentStorage::getErrorsLimited(const ErrorFilter& filter) const
 {
-	return filter.filterErrors(m_sqliteIndexStorage.getAllErrorInfos());
+	loadErrorInfoCache();
+	return m_errorInfoCache.getErrors(filter);
 }
 
 std::vector<ErrorInfo> PersistentStorage::getErrorsForFileLimited(
 	const ErrorFilter& filter, const FilePath& filePath) const
 {
-	Id fileId = getFileNodeId(filePath);
-	std::set<Id> fileIds = {fileId};
-
-	std::unordered_map<Id, std::set<Id>> includedMap = getFileIdToIncludedFileIdMap();
-	std::set<Id> fileIdsToProcess = includedMap[getFileNodeId(filePath)];
-	std::set<Id> processedFileIds;
-
-	while (fileIdsToProcess.size())
-	{
-		std::set<Id> nextFileIdsToProcess;
-		for (Id id: fileIdsToProcess)
+	auto getFilePathStrings = [this](const std::set<Id>& fileIds) {
+		std::set<std::wstring> filePaths;
+		for (Id id: fileIds)
 		{
-			if (fileIds.insert(id).second)
+			if (id)
 			{
-				utility::append(nextFileIdsToProcess, includedMap[id]);
+				filePaths.insert(getFileNodePath(id).wstr());
 			}
 		}
-		fileIdsToProcess = nextFileIdsToProcess;
-	}
+		return filePaths;
+	};
 
-	std::vector<ErrorInfo> res;
+	const Id fileId = getFileNodeId(filePath);
+	std::shared_ptr<const FileDependencyGraph> includeGraph = getIncludeGraph();
 
-	std::vector<ErrorInfo> errors = m_sqliteIndexStorage.getAllErrorInfos();
-	for (const ErrorInfo& error: errors)
-	{
-		if (filter.filter(error) &&
-			fileIds.find(getFileNodeId(FilePath(error.filePath))) != fileIds.end())
-		{
-			res.push_back(error);
-		}
-	}
+	std::set<Id> fileIds = includeGraph->getDependencies({fileId});
+	fileIds.insert(fileId);
 
-	if (res.empty())
-	{
-		std::unordered_map<Id, std::set<Id>> includingMap = getFileIdToIncludingFileIdMap();
-		fileIds.clear();
+	loadErrorInfoCache();
 
-		fileIdsToProcess = includingMap[fileId];
-		while (fileIdsToProcess.size())
-		{
-			std::set<Id> nextFileIdsToProcess;
-			for (Id id: fileIdsToProcess)
-			{
-				if (fileIds.insert(id).second)
-				{
-					utility::append(nextFileIdsToProcess, includingMap[id]);
-				}
-			}
-			fileIdsToProcess = nextFileIdsToProcess;
-		}
+	std::vector<ErrorInfo> res = m_errorInfoCache.getErrorsInFiles(
+		getFilePathStrings(fileIds), filter, false);
 
-		for (const ErrorInfo& error: errors)
-		{
-			if (error.fatal && filter.filter(error) &&
-				fileIds.find(getFileNodeId(FilePath(error.filePath))) != fileIds.end())
-			{
-				res.push_back(error);
-			}
-		}
+	if (res.empty())
+	{
+		res = m_errorInfoCache.getErrorsInFiles(
+			getFilePathStrings(includeGraph->getDependents({fileId})), filter, true);
 	}
 
 	return res;
@@ -2645,34 +2888,72 @@ std::wstring PersistentStorage::getFileNodeLanguage(Id fileId) const
 	return L"";
 }
 
-std::unordered_map<Id, std::set<Id>> PersistentStorage::getFileIdToIncludingFileIdMap() const
+std::shared_ptr<const IndexSnapshot> PersistentStorage::getIndexSnapshot() const
 {
-	std::unordered_map<Id, std::set<Id>> fileIdToIncludingFileIdMap;
+	if (!ApplicationSettings::getInstance()->getIndexSnapshotEnabled())
+	{
+		return nullptr;
+	}
 
-	m_sqliteIndexStorage.forEachOfType<StorageEdge>(
-		Edge::typeToInt(Edge::EDGE_INCLUDE), [&fileIdToIncludingFileIdMap](StorageEdge&& edge) {
-			fileIdToIncludingFileIdMap[edge.targetNodeId].insert(edge.sourceNodeId);
+	std::lock_guard<std::mutex> lock(m_indexSnapshotMutex);
+
+	if (!m_indexSnapshot)
+	{
+		TRACE();
+
+		std::shared_ptr<IndexSnapshot> indexSnapshot = std::make_shared<IndexSnapshot>();
+		bool complete = true;
+		m_sqliteIndexStorage.forEach<StorageNode>([&indexSnapshot, &complete](StorageNode&& node) {
+			complete = complete && indexSnapshot->addNode(node.id, node.type);
 		});
 
-	return fileIdToIncludingFileIdMap;
+		if (!complete)
+		{
+			LOG_WARNING("Index snapshot not used, the index has too many distinct node types.");
+			return nullptr;
+		}
+
+		m_indexSnapshot = indexSnapshot;
+	}
+
+	return m_indexSnapshot;
 }
 
-std::unordered_map<Id, std::set<Id>> PersistentStorage::getFileIdToIncludedFileIdMap() const
+void PersistentStorage::clearIndexSnapshot()
 {
-	std::unordered_map<Id, std::set<Id>> fileIdToIncludingFileIdMap;
+	std::lock_guard<std::mutex> lock(m_indexSnapshotMutex);
 
-	m_sqliteIndexStorage.forEachOfType<StorageEdge>(
-		Edge::typeToInt(Edge::EDGE_INCLUDE), [&fileIdToIncludingFileIdMap](StorageEdge&& edge) {
-			fileIdToIncludingFileIdMap[edge.sourceNodeId].insert(edge.targetNodeId);
-		});
+	m_indexSnapshot.reset();
+}
+
+std::shared_ptr<const FileDependencyGraph> PersistentStorage::getIncludeGraph() const
+{
+	std::lock_guard<std::mutex> lock(m_fileDependencyGraphMutex);
+
+	if (!m_includeGraph)
+	{
+		TRACE();
+
+		std::vector<std::pair<Id, Id>> includes;
+		m_sqliteIndexStorage.forEachOfType<StorageEdge>(
+			Edge::typeToInt(Edge::EDGE_INCLUDE), [&includes](StorageEdge&& edge) {
+				includes.emplace_back(edge.sourceNodeId, edge.targetNodeId);
+			});
+
+		m_includeGraph = std::make_shared<FileDependencyGraph>(includes);
+	}
 
-	return fileIdToIncludingFileIdMap;
+	return m_includeGraph;
 }
 
-std::unordered_map<Id, std::set<Id>> PersistentStorage::getFileIdToImportingFileIdMap() const
+std::shared_ptr<const FileDependencyGraph> PersistentStorage::getImportGraph() const
 {
-	std::unordered_map<Id, std::set<Id>> fileIdToImportingFileIdMap;
+	std::lock_guard<std::mutex> lock(m_fileDependencyGraphMutex);
+
+	if (!m_importGraph)
 	{
+		TRACE();
+
 		std::vector<Id> importedElementIds;
 		std::map<Id, std::set<Id>> elementIdToImportingFileIds;
 
@@ -2705,118 +2986,62 @@ std::unordered_map<Id, std::set<Id>> PersistentStorage::getFileIdToImportingFile
 			}
 		}
 
+		std::vector<std::pair<Id, Id>> imports;
 		for (const auto& it: elementIdToImportingFileIds)
 		{
 			auto importedFileIt = importedElementIdToFileNodeId.find(it.first);
 			if (importedFileIt != importedElementIdToFileNodeId.end())
 			{
-				fileIdToImportingFileIdMap[importedFileIt->second].insert(
-					it.second.begin(), it.second.end());
+				for (Id importingFileId: it.second)
+				{
+					imports.emplace_back(importingFileId, importedFileIt->second);
+				}
 			}
 		}
-	}
-	return fileIdToImportingFileIdMap;
-}
 
-std::set<Id> PersistentStorage::getReferenced(
-	const std::set<Id>& ids, std::unordered_map<Id, std::set<Id>> idToReferencingIdMap) const
-{
-	std::unordered_map<Id, std::set<Id>> idToReferencedIdMap;
-	for (const auto& it: idToReferencingIdMap)
-	{
-		for (Id referencingId: it.second)
-		{
-			idToReferencedIdMap[referencingId].insert(it.first);
-		}
+		m_importGraph = std::make_shared<FileDependencyGraph>(imports);
 	}
 
-	return getReferencing(ids, idToReferencedIdMap);
+	return m_importGraph;
 }
 
-std::set<Id> PersistentStorage::getReferencing(
-	const std::set<Id>& ids, std::unordered_map<Id, std::set<Id>> idToReferencingIdMap) const
+void PersistentStorage::clearFileDependencyGraphs()
 {
-	std::set<Id> referencingIds;
-
-	std::set<Id> processingIds = ids;
-	std::set<Id> processedIds;
-
-	while (!processingIds.empty())
-	{
-		std::set<Id> tempIds = processingIds;
-		utility::append(processedIds, processingIds);
-		processingIds.clear();
+	std::lock_guard<std::mutex> lock(m_fileDependencyGraphMutex);
 
-		for (Id id: tempIds)
-		{
-			utility::append(referencingIds, idToReferencingIdMap[id]);
-			for (Id referencingId: idToReferencingIdMap[id])
-			{
-				if (processedIds.find(referencingId) == processedIds.end())
-				{
-					processingIds.insert(referencingId);
-				}
-			}
-		}
-	}
-
-	return referencingIds;
+	m_includeGraph.reset();
+	m_importGraph.reset();
 }
 
-std::set<FilePath> PersistentStorage::getReferencedByIncludes(const std::set<FilePath>& filePaths) const
+std::set<FilePath> PersistentStorage::getFileNodePaths(const std::set<Id>& fileIds) const
 {
-	const std::set<Id> ids = getReferenced(
-		getFileNodeIds(filePaths), getFileIdToIncludingFileIdMap());
-
 	std::set<FilePath> paths;
-	for (Id id: ids)
-	{	 // TODO: performance optimize: use just one request for all ids!
+	for (Id id: fileIds)
+	{
 		paths.insert(getFileNodePath(id));
 	}
 
 	return paths;
 }
 
-std::set<FilePath> PersistentStorage::getReferencedByImports(const std::set<FilePath>& filePaths) const
+std::set<FilePath> PersistentStorage::getReferencedByIncludes(const std::set<FilePath>& filePaths) const
 {
-	const std::set<Id> ids = getReferenced(
-		getFileNodeIds(filePaths), getFileIdToImportingFileIdMap());
-
-	std::set<FilePath> paths;
-	for (Id id: ids)
-	{
-		paths.insert(getFileNodePath(id));
-	}
+	return getFileNodePaths(getIncludeGraph()->getDependencies(getFileNodeIds(filePaths)));
+}
 
-	return paths;
+std::set<FilePath> PersistentStorage::getReferencedByImports(const std::set<FilePath>& filePaths) const
+{
+	return getFileNodePaths(getImportGraph()->getDependencies(getFileNodeIds(filePaths)));
 }
 
 std::set<FilePath> PersistentStorage::getReferencingByIncludes(const std::set<FilePath>& filePaths) const
 {
-	const std::set<Id> ids = getReferencing(
-		getFileNodeIds(filePaths), getFileIdToIncludingFileIdMap());
-
-	std::set<FilePath> paths;
-	for (Id id: ids)
-	{
-		paths.insert(getFileNodePath(id));
-	}
-
-	return paths;
+	return getFileNodePaths(getIncludeGraph()->getDependents(getFileNodeIds(filePaths)));
 }
 
 std::set<FilePath> PersistentStorage::getReferencingByImports(const std::set<FilePath>& filePaths) const
 {
-	const std::set<Id> ids = getReferencing(
-		getFileNodeIds(filePaths), getFileIdToImportingFileIdMap());
-
-	std::set<FilePath> paths;
-	for (Id id: ids)
-	{
-		paths.insert(getFileNodePath(id));
-	}
-
-	return paths;
+	return getFileNodePaths(getImportGraph()->getDependents(getFileNodeIds(filePaths)));
 }
 
 void PersistentStorage::addNodesToGraph(
@@ -3261,69 +3486,127 @@ void PersistentStorage::buildFilePathMaps()
 			m_hasJavaFiles = true;
 		}
 	});
+}
+
+void PersistentStorage::buildSymbolDefinitionKinds()
+{
+	TRACE();
 
 	m_sqliteIndexStorage.forEach<StorageSymbol>([&](StorageSymbol&& symbol) {
 		m_symbolDefinitionKinds.emplace(symbol.id, intToDefinitionKind(symbol.definitionKind));
 	});
 }
 
-void PersistentStorage::buildSearchIndex()
+void PersistentStorage::buildSearchIndex(const std::vector<StorageNode>& nodes)
 {
 	TRACE();
 
 	const FilePath dbPath = getIndexDbFilePath();
 
-	m_sqliteIndexStorage.forEach<StorageNode>([&](StorageNode&& node) {
-		const NodeType type(intToNodeKind(node.type));
-		if (type.isFile())
-		{
-			bool indexed = getFileNodeIndexed(node.id);
-			if (!indexed)
-			{
-				return;
-			}
+	// The names are computed for equally sized parts of the nodes at the same time. Symbols are
+	// sorted into shards by the first character of their name, each shard is a separate subtree of
+	// the index and can be built by a thread of its own and merged at the end.
+	const size_t threadCount = std::max(1, utility::getIdealThreadCount());
+	const size_t partSize = (nodes.size() + threadCount - 1) / threadCount;
 
-			auto it = m_fileNodePaths.find(node.id);
-			if (it != m_fileNodePaths.end())
-			{
-				FilePath filePath(it->second);
+	std::vector<std::vector<std::vector<SearchIndexEntry>>> symbolEntries(
+		threadCount, std::vector<std::vector<SearchIndexEntry>>(threadCount));
+	std::vector<std::vector<SearchIndexEntry>> fileEntries(threadCount);
 
-				if (filePath.exists())
+	std::vector<std::function<void()>> nameFunctions;
+	for (size_t part = 0; part < threadCount; part++)
+	{
+		nameFunctions.push_back([&, part]() {
+			const size_t partEnd = std::min(nodes.size(), (part + 1) * partSize);
+			for (size_t i = part * partSize; i < partEnd; i++)
+			{
+				const StorageNode& node = nodes[i];
+				const NodeType type(intToNodeKind(node.type));
+				if (type.isFile())
 				{
-					filePath.makeRelativeTo(dbPath);
-				}
+					bool indexed = getFileNodeIndexed(node.id);
+					if (!indexed)
+					{
+						continue;
+					}
 
-				m_fileIndex.addNode(node.id, filePath.wstr(), type);
-			}
-		}
-		else
-		{
-			auto it = m_symbolDefinitionKinds.find(node.id);
-			const DefinitionKind defKind =
-				(it != m_symbolDefinitionKinds.end() ? it->second : DEFINITION_NONE);
-			if (defKind != DEFINITION_IMPLICIT)
-			{
-				const NameHierarchy nameHierarchy = NameHierarchy::deserialize(node.serializedName);
+					auto it = m_fileNodePaths.find(node.id);
+					if (it != m_fileNodePaths.end())
+					{
+						FilePath filePath(it->second);
 
-				// we don't use the signature here, so elements with the same signature share the
-				// same node.
-				std::wstring name = nameHierarchy.getQualifiedName();
+						if (filePath.exists())
+						{
+							filePath.makeRelativeTo(dbPath);
+						}
 
-				// replace template arguments with .. to avoid clutter in search results and have
-				// different template specializations share the same node.
-				if (defKind == DEFINITION_NONE &&
-					nameHierarchy.getDelimiter() == nameDelimiterTypeToString(NAME_DELIMITER_CXX))
+						fileEntries[part].push_back({node.id, filePath.wstr(), type});
+					}
+				}
+				else
 				{
-					name = utility::replaceBetween(name, L'<', L'>', L"..");
+					auto it = m_symbolDefinitionKinds.find(node.id);
+					const DefinitionKind defKind =
+						(it != m_symbolDefinitionKinds.end() ? it->second : DEFINITION_NONE);
+					if (defKind != DEFINITION_IMPLICIT)
+					{
+						const NameHierarchy nameHierarchy = NameHierarchy::deserialize(
+							node.serializedName);
+
+						// we don't use the signature here, so elements with the same signature
+						// share the same node.
+						std::wstring name = nameHierarchy.getQualifiedName();
+
+						// replace template arguments with .. to avoid clutter in search results
+						// and have different template specializations share the same node.
+						if (defKind == DEFINITION_NONE &&
+							nameHierarchy.getDelimiter() ==
+								nameDelimiterTypeToString(NAME_DELIMITER_CXX))
+						{
+							name = utility::replaceBetween(name, L'<', L'>', L"..");
+						}
+
+						const size_t shard = name.empty() ? 0 : size_t(name[0]) % threadCount;
+						symbolEntries[part][shard].push_back({node.id, std::move(name), type});
+					}
 				}
+			}
+		});
+	}
+	runInParallel(nameFunctions);
 
-				m_symbolIndex.addNode(node.id, std::move(name), type);
+	// entries are added in order of the nodes, like they would be by a single thread
+	std::vector<SearchIndex> shardIndices(threadCount);
+	std::vector<std::function<void()>> shardFunctions;
+	for (size_t shard = 0; shard < threadCount; shard++)
+	{
+		shardFunctions.push_back([&, shard]() {
+			for (size_t part = 0; part < threadCount; part++)
+			{
+				for (SearchIndexEntry& entry: symbolEntries[part][shard])
+				{
+					shardIndices[shard].addNode(entry.id, std::move(entry.name), entry.type);
+				}
+			}
+			shardIndices[shard].finishSetup();
+		});
+	}
+	shardFunctions.push_back([&]() {
+		for (std::vector<SearchIndexEntry>& entries: fileEntries)
+		{
+			for (SearchIndexEntry& entry: entries)
+			{
+				m_fileIndex.addNode(entry.id, std::move(entry.name), entry.type);
 			}
 		}
+		m_fileIndex.finishSetup();
 	});
+	runInParallel(shardFunctions);
 
-	m_symbolIndex.finishSetup();
-	m_fileIndex.finishSetup();
+	for (SearchIndex& shardIndex: shardIndices)
+	{
+		m_symbolIndex.merge(shardIndex);
+	}
 }
 
 void PersistentStorage::buildFullTextSearchIndex() const
@@ -3368,7 +3651,7 @@ void PersistentStorage::buildFullTextSearchIndex() const
 	}
 }
 
-void PersistentStorage::buildMemberEdgeIdOrderMap()
+void PersistentStorage::buildMemberEdgeIdOrderMap(const std::vector<StorageEdge>& memberEdges)
 {
 	TRACE();
 
@@ -3380,12 +3663,11 @@ void PersistentStorage::buildMemberEdgeIdOrderMap()
 	std::vector<Id> childNodeIds;
 	std::unordered_map<Id, Id> childIdToMemberEdgeIdMap;
 
-	m_sqliteIndexStorage.forEachOfType<StorageEdge>(
-		Edge::typeToInt(Edge::EDGE_MEMBER),
-		[&childNodeIds, &childIdToMemberEdgeIdMap](StorageEdge&& edge) {
-			childNodeIds.push_back(edge.targetNodeId);
-			childIdToMemberEdgeIdMap.emplace(edge.targetNodeId, edge.id);
-		});
+	for (const StorageEdge& edge: memberEdges)
+	{
+		childNodeIds.push_back(edge.targetNodeId);
+		childIdToMemberEdgeIdMap.emplace(edge.targetNodeId, edge.id);
+	}
 
 	std::vector<Id> locationIds;
 	std::unordered_map<Id, Id> locationIdToElementIdMap;
@@ -3440,28 +3722,26 @@ void PersistentStorage::buildMemberEdgeIdOrderMap()
 	});
 }
 
-void PersistentStorage::buildHierarchyCache()
+void PersistentStorage::buildHierarchyCache(
+	const std::vector<StorageEdge>& memberEdges, const std::vector<StorageNode>& nodes)
 {
 	TRACE();
 
-	std::vector<Id> sourceNodeIds;
-	std::vector<StorageEdge> memberEdges;
-
-	m_sqliteIndexStorage.forEachOfType<StorageEdge>(
-		Edge::typeToInt(Edge::EDGE_MEMBER), [&sourceNodeIds, &memberEdges](StorageEdge&& edge) {
-			sourceNodeIds.push_back(edge.sourceNodeId);
-			memberEdges.emplace_back(edge);
-		});
+	std::unordered_set<Id> sourceNodeIds;
+	for (const StorageEdge& edge: memberEdges)
+	{
+		sourceNodeIds.insert(edge.sourceNodeId);
+	}
 
 	std::set<Id> invisibleParentSourceNodeIds;
-
-	m_sqliteIndexStorage.forEachByIds<StorageNode>(
-		sourceNodeIds, [&invisibleParentSourceNodeIds](StorageNode&& node) {
-			if (!NodeType(intToNodeKind(node.type)).isVisibleAsParentInGraph())
-			{
-				invisibleParentSourceNodeIds.insert(node.id);
-			}
-		});
+	for (const StorageNode& node: nodes)
+	{
+		if (sourceNodeIds.find(node.id) != sourceNodeIds.end() &&
+			!NodeType(intToNodeKind(node.type)).isVisibleAsParentInGraph())
+		{
+			invisibleParentSourceNodeIds.insert(node.id);
+		}
+	}
 
 	for (const StorageEdge& edge: memberEdges)
 	{
@@ -3499,3 +3779,12 @@ void PersistentStorage::buildHierarchyCache()
 			m_hierarchyCache.createInheritance(edge.id, edge.sourceNodeId, edge.targetNodeId);
 		});
 }
+
+void PersistentStorage::loadErrorInfoCache() const
+{
+	m_errorInfoCache.loadIfNotLoaded([this]() {
+		TRACE();
+
+		return m_sqliteIndexStorage.getErrorInfosAfterOccurrence(0);
+	});
+}
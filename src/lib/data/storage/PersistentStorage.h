@@ -4,8 +4,11 @@
 #include <memory>
 #include <vector>
 
+#include "ErrorInfoCache.h"
+#include "FileDependencyGraph.h"
 #include "FullTextSearchIndex.h"
 #include "HierarchyCache.h"
+#include "IndexSnapshot.h"
 #include "SearchIndex.h"
 #include "SqliteBookmarkStorage.h"
 #include "SqliteIndexStorage.h"
@@ -109,8 +112,12 @@ public:
 
 	StorageEdge getEdgeById(Id edgeId) const override;
 
-	std::shared_ptr<SourceLocationCollection> getFullTextSearchLocations(
-		const std::wstring& searchTerm, bool caseSensitive) const override;
+	FullTextSearchPage getFullTextSearchLocations(
+		const std::wstring& searchTerm,
+		bool caseSensitive,
+		size_t fileOffset,
+		size_t maxResultCount,
+		std::function<void(std::shared_ptr<SourceLocationCollection>)> onLocations) const override;
 
 	std::vector<SearchMatch> getAutocompletionMatches(
 		const std::wstring& query, NodeTypeSet acceptedNodeTypes, bool acceptCommands) const override;
@@ -220,15 +227,15 @@ private:
 	bool getFileNodeIndexed(Id fileId) const;
 	std::wstring getFileNodeLanguage(Id fileId) const;
 
-	std::unordered_map<Id, std::set<Id>> getFileIdToIncludingFileIdMap() const;
-	std::unordered_map<Id, std::set<Id>> getFileIdToIncludedFileIdMap() const;
-	std::unordered_map<Id, std::set<Id>> getFileIdToImportingFileIdMap() const;
-	std::set<Id> getReferenced(
-		const std::set<Id>& filePaths,
-		std::unordered_map<Id, std::set<Id>> idToReferencingIdMap) const;
-	std::set<Id> getReferencing(
-		const std::set<Id>& filePaths,
-		std::unordered_map<Id, std::set<Id>> idToReferencingIdMap) const;
+	// only built for queries that scan all nodes repeatedly, returns nullptr if the snapshot is
+	// disabled in the application settings or can't encode the node types
+	std::shared_ptr<const IndexSnapshot> getIndexSnapshot() const;
+	void clearIndexSnapshot();
+
+	std::shared_ptr<const FileDependencyGraph> getIncludeGraph() const;
+	std::shared_ptr<const FileDependencyGraph> getImportGraph() const;
+	void clearFileDependencyGraphs();
+	std::set<FilePath> getFileNodePaths(const std::set<Id>& fileIds) const;
 
 	std::set<FilePath> getReferencedByIncludes(const std::set<FilePath>& filePaths) const;
 	std::set<FilePath> getReferencedByImports(const std::set<FilePath>& filePaths) const;
@@ -256,14 +263,27 @@ private:
 	void addInheritanceChainsToGraph(const std::vector<Id>& nodeIds, Graph* graph) const;
 
 	void buildFilePathMaps();
-	void buildSearchIndex();
+	void buildSymbolDefinitionKinds();
+	void buildSearchIndex(const std::vector<StorageNode>& nodes);
 	void buildFullTextSearchIndex() const;
-	void buildMemberEdgeIdOrderMap();
-	void buildHierarchyCache();
+	void buildMemberEdgeIdOrderMap(const std::vector<StorageEdge>& memberEdges);
+	void buildHierarchyCache(
+		const std::vector<StorageEdge>& memberEdges, const std::vector<StorageNode>& nodes);
+	void loadErrorInfoCache() const;
 
 	bool m_preIndexingErrorCountSet = false;
 	size_t m_preIndexingErrorCount = 0;
 	size_t m_preInjectionErrorCount = 0;
+	int m_preInjectionOccurrenceRowId = 0;
+
+	mutable ErrorInfoCache m_errorInfoCache;
+
+	mutable std::shared_ptr<const IndexSnapshot> m_indexSnapshot;
+	mutable std::mutex m_indexSnapshotMutex;
+
+	mutable std::shared_ptr<const FileDependencyGraph> m_includeGraph;
+	mutable std::shared_ptr<const FileDependencyGraph> m_importGraph;
+	mutable std::mutex m_fileDependencyGraphMutex;
 
 	SearchIndex m_commandIndex;
 	SearchIndex m_symbolIndex;
@@ -1,6 +1,7 @@
 #ifndef STORAGE_ACCESS_H
 #define STORAGE_ACCESS_H
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -12,6 +13,7 @@
 #include "ErrorCountInfo.h"
 #include "ErrorFilter.h"
 #include "ErrorInfo.h"
+#include "FullTextSearchPage.h"
 #include "LocationType.h"
 #include "Node.h"
 #include "NodeBookmark.h"
@@ -50,8 +52,16 @@ public:
 
 	virtual StorageEdge getEdgeById(Id edgeId) const = 0;
 
-	virtual std::shared_ptr<SourceLocationCollection> getFullTextSearchLocations(
-		const std::wstring& searchTerm, bool caseSensitive) const = 0;
+	// Searches the files containing the term beginning with the file at fileOffset, until the page
+	// holds maxResultCount hits of the case-insensitive index (0 for no limit). Pages always contain
+	// whole files. Found locations are passed to onLocations in batches while the search is running,
+	// always on the calling thread.
+	virtual FullTextSearchPage getFullTextSearchLocations(
+		const std::wstring& searchTerm,
+		bool caseSensitive,
+		size_t fileOffset,
+		size_t maxResultCount,
+		std::function<void(std::shared_ptr<SourceLocationCollection>)> onLocations) const = 0;
 	virtual std::vector<SearchMatch> getAutocompletionMatches(
 		const std::wstring& query, NodeTypeSet acceptedNodeTypes, bool acceptCommands) const = 0;
 	virtual std::vector<SearchMatch> getSearchMatchesForTokenIds(
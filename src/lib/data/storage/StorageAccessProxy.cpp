@@ -1,5 +1,7 @@
 #include "StorageAccessProxy.h"
 
+#include <algorithm>
+
 #include "Graph.h"
 #include "NodeTypeSet.h"
 #include "SourceLocationCollection.h"
@@ -9,6 +11,54 @@
 #include "FilePath.h"
 #include "logging.h"
 
+const size_t StorageAccessProxy::s_queryWaitIntervalMS = 50;
+
+namespace
+{
+struct QueryLatencies
+{
+	std::mutex mutex;
+	std::map<std::string, StorageAccessProxy::QueryLatency> latencies;
+};
+
+QueryLatencies& getQueryLatencyStore()
+{
+	// never destroyed, so queries that nobody waits for anymore can still finish during shutdown
+	static QueryLatencies* s_queryLatencies = new QueryLatencies();
+	return *s_queryLatencies;
+}
+}	 // namespace
+
+std::map<std::string, StorageAccessProxy::QueryLatency> StorageAccessProxy::getQueryLatencies()
+{
+	QueryLatencies& queryLatencies = getQueryLatencyStore();
+	std::lock_guard<std::mutex> lock(queryLatencies.mutex);
+	return queryLatencies.latencies;
+}
+
+void StorageAccessProxy::addQueryLatency(
+	const std::string& queryName, double seconds, bool canceled)
+{
+	QueryLatency latency;
+	{
+		QueryLatencies& queryLatencies = getQueryLatencyStore();
+		std::lock_guard<std::mutex> lock(queryLatencies.mutex);
+		QueryLatency& queryLatency = queryLatencies.latencies[queryName];
+		queryLatency.queryCount++;
+		queryLatency.canceledCount += canceled ? 1 : 0;
+		queryLatency.totalSeconds += seconds;
+		queryLatency.maxSeconds = std::max(queryLatency.maxSeconds, seconds);
+		latency = queryLatency;
+	}
+
+	LOG_INFO(
+		"Storage query \"" + queryName + "\" " + (canceled ? "canceled after " : "took ") +
+		TimeStamp::secondsToString(seconds) + ", average " +
+		TimeStamp::secondsToString(latency.totalSeconds / latency.queryCount) + " and maximum " +
+		TimeStamp::secondsToString(latency.maxSeconds) + " of " +
+		std::to_string(latency.queryCount) + " queries");
+}
+
 void StorageAccessProxy::setSubject(std::weak_ptr<StorageAccess> subject)
 {
 	m_subject = subject;
@@ -164,12 +214,15 @@ DEF_GETTER_1(getNodeIdToParentFileMap, const std::vector<Id>&, NodeIdToParentFil
 
 DEF_GETTER_1(getNodeTypeForNodeWithId, Id, NodeType, NodeType(NODE_SYMBOL))
 DEF_GETTER_1(getEdgeById, Id, StorageEdge, StorageEdge())
-DEF_GETTER_2(
+DEF_GETTER_5(
 	getFullTextSearchLocations,
 	const std::wstring&,
 	bool,
-	std::shared_ptr<SourceLocationCollection>,
-	std::make_shared<SourceLocationCollection>())
+	size_t,
+	size_t,
+	std::function<void(std::shared_ptr<SourceLocationCollection>)>,
+	FullTextSearchPage,
+	FullTextSearchPage())
 DEF_GETTER_3(
 	getAutocompletionMatches,
 	const std::wstring&,
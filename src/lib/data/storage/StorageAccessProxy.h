@@ -1,16 +1,55 @@
 #ifndef STORAGE_ACCESS_PROXY_H
 #define STORAGE_ACCESS_PROXY_H
 
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <future>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <string>
 
+#include "CancellationToken.h"
 #include "StorageAccess.h"
+#include "ThreadPool.h"
+#include "TimeStamp.h"
 
 class StorageAccessProxy: public StorageAccess
 {
 public:
+	struct QueryLatency
+	{
+		size_t queryCount = 0;
+		size_t canceledCount = 0;
+		double totalSeconds = 0.0;
+		double maxSeconds = 0.0;
+	};
+
+	// Runs a query on a thread of the ThreadPool with the token as current cancellation token, so
+	// long running loops of the storage can stop early. The subject of a proxy stays alive until
+	// the query returns, even if nobody waits for the result anymore.
+	template <typename ResultType>
+	static std::future<ResultType> queryAsync(
+		const StorageAccess* storageAccess,
+		const std::string& queryName,
+		const CancellationToken& cancellationToken,
+		std::function<ResultType(const StorageAccess*)> query);
+
+	// Waits for a query and calls whileWaiting in between. Returns false as soon as the token is
+	// canceled, so the results of outdated activations are dropped.
+	template <typename ResultType>
+	static bool waitForQuery(
+		std::future<ResultType>& future,
+		const CancellationToken& cancellationToken,
+		ResultType& result,
+		std::function<void()> whileWaiting = nullptr);
+
+	static std::map<std::string, QueryLatency> getQueryLatencies();
+
 	StorageAccessProxy() = default;
 
-	void setSubject(std::weak_ptr<StorageAccess> subject);
+	virtual void setSubject(std::weak_ptr<StorageAccess> subject);
 
 	// StorageAccess implementation
 	Id getNodeIdForFileNode(const FilePath& filePath) const override;
@@ -27,8 +66,12 @@ public:
 
 	StorageEdge getEdgeById(Id edgeId) const override;
 
-	std::shared_ptr<SourceLocationCollection> getFullTextSearchLocations(
-		const std::wstring& searchTerm, bool caseSensitive) const override;
+	FullTextSearchPage getFullTextSearchLocations(
+		const std::wstring& searchTerm,
+		bool caseSensitive,
+		size_t fileOffset,
+		size_t maxResultCount,
+		std::function<void(std::shared_ptr<SourceLocationCollection>)> onLocations) const override;
 	std::vector<SearchMatch> getAutocompletionMatches(
 		const std::wstring& query, NodeTypeSet acceptedNodeTypes, bool acceptCommands) const override;
 	std::vector<SearchMatch> getSearchMatchesForTokenIds(const std::vector<Id>& tokenIds) const override;
@@ -106,7 +149,75 @@ public:
 		const std::vector<Id>& locationIds, const std::vector<Id>& localSymbolIds) const override;
 
 private:
+	static void addQueryLatency(const std::string& queryName, double seconds, bool canceled);
+
+	static const size_t s_queryWaitIntervalMS;
+
 	std::weak_ptr<StorageAccess> m_subject;
 };
 
+template <typename ResultType>
+std::future<ResultType> StorageAccessProxy::queryAsync(
+	const StorageAccess* storageAccess,
+	const std::string& queryName,
+	const CancellationToken& cancellationToken,
+	std::function<ResultType(const StorageAccess*)> query)
+{
+	std::shared_ptr<StorageAccess> subject;
+	if (const StorageAccessProxy* proxy = dynamic_cast<const StorageAccessProxy*>(storageAccess))
+	{
+		subject = proxy->m_subject.lock();
+	}
+
+	std::shared_ptr<std::promise<ResultType>> promise = std::make_shared<std::promise<ResultType>>();
+	std::future<ResultType> future = promise->get_future();
+
+	ThreadPool::getInstance()->run(
+		[storageAccess, subject, queryName, cancellationToken, query, promise]() {
+			CancellationToken::Scope cancellationScope(cancellationToken);
+			const TimeStamp start = TimeStamp::now();
+			try
+			{
+				ResultType result = query(storageAccess);
+				addQueryLatency(
+					queryName, TimeStamp::durationSeconds(start), cancellationToken.isCanceled());
+				promise->set_value(std::move(result));
+			}
+			catch (...)
+			{
+				promise->set_exception(std::current_exception());
+			}
+		});
+
+	return future;
+}
+
+template <typename ResultType>
+bool StorageAccessProxy::waitForQuery(
+	std::future<ResultType>& future,
+	const CancellationToken& cancellationToken,
+	ResultType& result,
+	std::function<void()> whileWaiting)
+{
+	bool isReady = false;
+	while (!isReady)
+	{
+		isReady = future.wait_for(std::chrono::milliseconds(s_queryWaitIntervalMS)) ==
+			std::future_status::ready;
+
+		if (whileWaiting)
+		{
+			whileWaiting();
+		}
+
+		if (cancellationToken.isCanceled())
+		{
+			return false;
+		}
+	}
+
+	result = future.get();
+	return true;
+}
+
 #endif	  // STORAGE_ACCESS_PROXY_H
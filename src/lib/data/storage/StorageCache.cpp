@@ -1,10 +1,62 @@
 #include "StorageCache.h"
 
+#include "SourceLocation.h"
 #include "SourceLocationCollection.h"
 #include "SourceLocationFile.h"
 #include "TextAccess.h"
+#include "logging.h"
 #include "utility.h"
 
+namespace
+{
+size_t getMemorySize(const TextAccess& textAccess)
+{
+	return textAccess.getText().size() + textAccess.getLineCount() * sizeof(size_t);
+}
+
+size_t getMemorySize(const SourceLocationFile& file)
+{
+	// a start and an end location per id, each with its token ids and entries in the indices
+	return file.getSourceLocationCount() * 2 * (sizeof(SourceLocation) + 128);
+}
+
+// the cached file is copied, because callers add and change locations of the returned file
+std::shared_ptr<SourceLocationFile> getCopy(std::shared_ptr<SourceLocationFile> file)
+{
+	std::shared_ptr<SourceLocationFile> copy = std::make_shared<SourceLocationFile>(
+		file->getFilePath(),
+		file->getLanguage(),
+		file->isWhole(),
+		file->isComplete(),
+		file->isIndexed());
+	copy->copySourceLocations(file);
+	return copy;
+}
+
+template <typename ValType>
+void logCacheStats(const std::wstring& name, const LruCache<FilePath, ValType>& cache)
+{
+	const size_t requestCount = cache.getHitCount() + cache.getMissCount();
+	if (!requestCount)
+	{
+		return;
+	}
+
+	LOG_INFO(
+		L"Cleared " + name + L" cache with " + std::to_wstring(cache.getValueCount()) +
+		L" files using " + std::to_wstring(cache.getSize() / 1024) + L" of " +
+		std::to_wstring(cache.getMaxSize() / 1024) + L" KB, hit rate " +
+		std::to_wstring(cache.getHitCount() * 100 / requestCount) + L"% of " +
+		std::to_wstring(requestCount) + L" requests");
+}
+}	 // namespace
+
+StorageCache::StorageCache()
+	: m_fileContentCache(64 * 1048576 /* 64 MB */)
+	, m_sourceLocationCache(32 * 1048576 /* 32 MB */)
+{
+}
+
 void StorageCache::clear()
 {
 	m_graphForAll.reset();
@@ -12,6 +64,16 @@ void StorageCache::clear()
 	m_storageStats = StorageStats();
 
 	setUseErrorCache(false);
+
+	clearFileCaches();
+}
+
+void StorageCache::setSubject(std::weak_ptr<StorageAccess> subject)
+{
+	// a new subject is set after indexing, so the cached files may be outdated
+	clearFileCaches();
+
+	StorageAccessProxy::setSubject(subject);
 }
 
 std::shared_ptr<Graph> StorageCache::getGraphForAll() const
@@ -34,6 +96,30 @@ StorageStats StorageCache::getStorageStats() const
 	return m_storageStats;
 }
 
+std::shared_ptr<SourceLocationFile> StorageCache::getSourceLocationsForFile(
+	const FilePath& filePath) const
+{
+	std::shared_ptr<SourceLocationFile> file;
+	size_t generation = 0;
+	{
+		std::lock_guard<std::mutex> lock(m_fileCacheMutex);
+		if (m_sourceLocationCache.getValue(filePath, file))
+		{
+			return getCopy(file);
+		}
+		generation = m_fileCacheGeneration;
+	}
+
+	file = StorageAccessProxy::getSourceLocationsForFile(filePath);
+
+	std::lock_guard<std::mutex> lock(m_fileCacheMutex);
+	if (generation == m_fileCacheGeneration)
+	{
+		m_sourceLocationCache.setValue(filePath, file, getMemorySize(*file));
+	}
+	return getCopy(file);
+}
+
 std::shared_ptr<TextAccess> StorageCache::getFileContent(const FilePath& filePath, bool showsErrors) const
 {
 	if (m_useErrorCache && showsErrors)
@@ -41,7 +127,32 @@ std::shared_ptr<TextAccess> StorageCache::getFileContent(const FilePath& filePat
 		return TextAccess::createFromFile(filePath);
 	}
 
-	return StorageAccessProxy::getFileContent(filePath, showsErrors);
+	std::shared_ptr<TextAccess> textAccess;
+	size_t generation = 0;
+	{
+		std::lock_guard<std::mutex> lock(m_fileCacheMutex);
+		if (m_fileContentCache.getValue(filePath, textAccess))
+		{
+			return textAccess;
+		}
+		generation = m_fileCacheGeneration;
+	}
+
+	textAccess = StorageAccessProxy::getFileContent(filePath, showsErrors);
+
+	// content without a stored copy is read from disk and keeps its file path, it may change on disk
+	// at any time and is not cached
+	if (!textAccess || !textAccess->getFilePath().empty())
+	{
+		return textAccess;
+	}
+
+	std::lock_guard<std::mutex> lock(m_fileCacheMutex);
+	if (generation == m_fileCacheGeneration)
+	{
+		m_fileContentCache.setValue(filePath, textAccess, getMemorySize(*textAccess));
+	}
+	return textAccess;
 }
 
 ErrorCountInfo StorageCache::getErrorCount() const
@@ -121,3 +232,15 @@ void StorageCache::addErrorsToCache(
 	utility::append(m_cachedErrors, newErrors);
 	m_errorCount = errorCount;
 }
+
+void StorageCache::clearFileCaches()
+{
+	std::lock_guard<std::mutex> lock(m_fileCacheMutex);
+
+	logCacheStats(L"file content", m_fileContentCache);
+	logCacheStats(L"source location", m_sourceLocationCache);
+
+	m_fileContentCache.clear();
+	m_sourceLocationCache.clear();
+	m_fileCacheGeneration++;
+}
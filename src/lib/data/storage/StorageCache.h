@@ -2,18 +2,28 @@
 #define STORAGE_CACHE_H
 
 #include <map>
+#include <mutex>
 
+#include "FilePath.h"
+#include "LruCache.h"
 #include "StorageAccessProxy.h"
 
 class StorageCache: public StorageAccessProxy
 {
 public:
+	StorageCache();
+
 	void clear();
 
+	void setSubject(std::weak_ptr<StorageAccess> subject) override;
+
 	std::shared_ptr<Graph> getGraphForAll() const override;
 
 	StorageStats getStorageStats() const override;
 
+	std::shared_ptr<SourceLocationFile> getSourceLocationsForFile(
+		const FilePath& filePath) const override;
+
 	std::shared_ptr<TextAccess> getFileContent(const FilePath& filePath, bool showsErrors) const override;
 
 	ErrorCountInfo getErrorCount() const override;
@@ -28,12 +38,20 @@ public:
 		const std::vector<ErrorInfo>& newErrors, const ErrorCountInfo& errorCount) override;
 
 private:
+	void clearFileCaches();
+
 	mutable std::shared_ptr<Graph> m_graphForAll;
 	mutable StorageStats m_storageStats;
 
 	bool m_useErrorCache = false;
 	ErrorCountInfo m_errorCount;
 	std::vector<ErrorInfo> m_cachedErrors;
+
+	// file contents and source locations of recently viewed files, limited by their memory in bytes
+	mutable std::mutex m_fileCacheMutex;
+	size_t m_fileCacheGeneration = 0;	 // incremented on clear, so outdated results are not cached
+	mutable LruCache<FilePath, std::shared_ptr<TextAccess>> m_fileContentCache;
+	mutable LruCache<FilePath, std::shared_ptr<SourceLocationFile>> m_sourceLocationCache;
 };
 
 #endif	  // STORAGE_CACHE_H
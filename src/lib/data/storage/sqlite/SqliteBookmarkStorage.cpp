@@ -281,7 +281,7 @@ template <>
 std::vector<StorageBookmarkCategory> SqliteBookmarkStorage::doGetAll<StorageBookmarkCategory>(
 	const std::string& query) const
 {
-	CppSQLite3Query q = executeQuery("SELECT id, name FROM bookmark_category " + query + ";");
+	SqliteStorageQuery q = executeQuery("SELECT id, name FROM bookmark_category " + query + ";");
 
 	std::vector<StorageBookmarkCategory> categories;
 	while (!q.eof())
@@ -302,7 +302,7 @@ std::vector<StorageBookmarkCategory> SqliteBookmarkStorage::doGetAll<StorageBook
 template <>
 std::vector<StorageBookmark> SqliteBookmarkStorage::doGetAll<StorageBookmark>(const std::string& query) const
 {
-	CppSQLite3Query q = executeQuery(
+	SqliteStorageQuery q = executeQuery(
 		"SELECT id, name, comment, timestamp, category_id FROM bookmark " + query + ";");
 
 	std::vector<StorageBookmark> bookmarks;
@@ -333,7 +333,7 @@ template <>
 std::vector<StorageBookmarkedNode> SqliteBookmarkStorage::doGetAll<StorageBookmarkedNode>(
 	const std::string& query) const
 {
-	CppSQLite3Query q = executeQuery(
+	SqliteStorageQuery q = executeQuery(
 		"SELECT "
 		"bookmarked_node.id, bookmarked_element.bookmark_id, bookmarked_node.serialized_node_name "
 		"FROM bookmarked_node "
@@ -363,7 +363,7 @@ template <>
 std::vector<StorageBookmarkedEdge> SqliteBookmarkStorage::doGetAll<StorageBookmarkedEdge>(
 	const std::string& query) const
 {
-	CppSQLite3Query q = executeQuery(
+	SqliteStorageQuery q = executeQuery(
 		"SELECT "
 		"bookmarked_edge.id, bookmarked_element.bookmark_id, "
 		"bookmarked_edge.serialized_source_node_name, bookmarked_edge.serialized_target_node_name, "
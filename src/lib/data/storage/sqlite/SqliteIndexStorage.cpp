@@ -1,5 +1,6 @@
 #include "SqliteIndexStorage.h"
 
+#include <algorithm>
 #include <sstream>
 #include <unordered_map>
 
@@ -12,6 +13,7 @@
 #include "utilityString.h"
 
 const size_t SqliteIndexStorage::s_storageVersion = 25;
+const size_t SqliteIndexStorage::s_tempSourceLocationsSize = 32 * 1024 * 1024;
 
 namespace
 {
@@ -25,6 +27,34 @@ std::pair<std::wstring, std::wstring> splitLocalSymbolName(const std::wstring& n
 
 	return std::make_pair(name.substr(0, pos), name.substr(pos + 1, name.size() - pos - 2));
 }
+
+// orders by start line, start column, end line, end column and type, ignoring file and id
+bool isPositionLess(const StorageSourceLocationData& a, const StorageSourceLocationData& b)
+{
+	if (a.startLine != b.startLine)
+	{
+		return a.startLine < b.startLine;
+	}
+	else if (a.startCol != b.startCol)
+	{
+		return a.startCol < b.startCol;
+	}
+	else if (a.endLine != b.endLine)
+	{
+		return a.endLine < b.endLine;
+	}
+	else if (a.endCol != b.endCol)
+	{
+		return a.endCol < b.endCol;
+	}
+	return a.type < b.type;
+}
+
+bool isPositionEqual(const StorageSourceLocationData& a, const StorageSourceLocationData& b)
+{
+	return a.startLine == b.startLine && a.startCol == b.startCol && a.endLine == b.endLine &&
+		a.endCol == b.endCol && a.type == b.type;
+}
 }	 // namespace
 
 size_t SqliteIndexStorage::getStorageVersion()
@@ -34,6 +64,7 @@ size_t SqliteIndexStorage::getStorageVersion()
 
 SqliteIndexStorage::SqliteIndexStorage(const FilePath& dbFilePath)
 	: SqliteStorage(dbFilePath.getCanonical())
+	, m_tempSourceLocations(s_tempSourceLocationsSize)
 {
 }
 
@@ -44,12 +75,15 @@ size_t SqliteIndexStorage::getStaticVersion() const
 
 void SqliteIndexStorage::setMode(const StorageModeType mode)
 {
+	// the storage is only read in read mode, so other threads can query it on their own connection
+	setReadConnectionsEnabled(mode == STORAGE_MODE_READ);
+
 	m_tempNodeNameIndex.clear();
 	m_tempWNodeNameIndex.clear();
 	m_tempNodeTypes.clear();
 	m_tempEdgeIndex.clear();
 	m_tempLocalSymbolIndex.clear();
-	m_tempSourceLocationIndices.clear();
+	m_tempSourceLocations.clear();
 
 	std::vector<std::pair<int, SqliteDatabaseIndex>> indices = getIndices();
 	for (size_t i = 0; i < indices.size(); i++)
@@ -331,53 +365,63 @@ Id SqliteIndexStorage::addSourceLocation(const StorageSourceLocationData& data)
 
 std::vector<Id> SqliteIndexStorage::addSourceLocations(const std::vector<StorageSourceLocation>& locations)
 {
-	if (m_tempSourceLocationIndices.empty())
-	{
-		forEach<StorageSourceLocation>([this](StorageSourceLocation&& loc) {
-			std::map<TempSourceLocation, uint32_t>& index =
-				m_tempSourceLocationIndices[static_cast<uint32_t>(loc.fileNodeId)];
-			index.emplace(
-				TempSourceLocation(
-					static_cast<uint32_t>(loc.startLine),
-					static_cast<uint16_t>(loc.endLine - loc.startLine),
-					static_cast<uint16_t>(loc.startCol),
-					static_cast<uint16_t>(loc.endCol),
-					loc.type),
-				static_cast<uint32_t>(loc.id));
-		});
+	// the locations are deduplicated against the stored locations of their file, so no index of all
+	// stored locations has to be kept in memory
+	std::map<Id, std::vector<size_t>> fileNodeIdToLocationIndices;
+	for (size_t i = 0; i < locations.size(); i++)
+	{
+		fileNodeIdToLocationIndices[locations[i].fileNodeId].push_back(i);
 	}
 
 	std::vector<Id> locationIds(locations.size(), 0);
-	std::vector<StorageSourceLocationData> locationsToInsert;
+	std::vector<StorageSourceLocation> locationsToInsert;
 	size_t lastRowId = executeStatementScalar("SELECT MAX(rowid) from source_location", 0);
 
-	for (size_t i = 0; i < locations.size(); i++)
+	for (auto& p: fileNodeIdToLocationIndices)
 	{
-		const StorageSourceLocation& data = locations[i];
-		const TempSourceLocation tempLoc(
-			static_cast<uint32_t>(data.startLine),
-			static_cast<uint16_t>(data.endLine - data.startLine),
-			static_cast<uint16_t>(data.startCol),
-			static_cast<uint16_t>(data.endCol),
-			data.type);
-
-		std::map<TempSourceLocation, uint32_t>& index =
-			m_tempSourceLocationIndices[static_cast<uint32_t>(data.fileNodeId)];
-		std::map<TempSourceLocation, uint32_t>::const_iterator it = index.find(tempLoc);
-		if (it != index.end())
-		{
-			locationIds[i] = it->second;
-		}
-		else
+		std::vector<size_t>& locationIndices = p.second;
+		std::stable_sort(
+			locationIndices.begin(), locationIndices.end(), [&locations](size_t a, size_t b) {
+				return isPositionLess(locations[a], locations[b]);
+			});
+
+		std::shared_ptr<std::vector<StorageSourceLocation>> fileLocations =
+			getTempSourceLocations(p.first);
+		const size_t storedCount = fileLocations->size();
+
+		for (size_t index: locationIndices)
 		{
-			executeStatement(m_insertElementStmt);
-			Id id = lastRowId + 1 + locationsToInsert.size();
+			const StorageSourceLocation& data = locations[index];
 
-			locationIds[i] = id;
-			index.emplace(tempLoc, static_cast<uint32_t>(id));
+			std::vector<StorageSourceLocation>::const_iterator it = std::lower_bound(
+				fileLocations->begin(), fileLocations->begin() + storedCount, data, isPositionLess);
+			if (it != fileLocations->begin() + storedCount && isPositionEqual(*it, data))
+			{
+				locationIds[index] = it->id;
+			}
+			else if (
+				fileLocations->size() > storedCount && isPositionEqual(fileLocations->back(), data))
+			{
+				locationIds[index] = fileLocations->back().id;
+			}
+			else
+			{
+				executeStatement(m_insertElementStmt);
+				Id id = lastRowId + 1 + locationsToInsert.size();
 
-			locationsToInsert.emplace_back(data);
+				locationIds[index] = id;
+				fileLocations->emplace_back(id, data);
+				locationsToInsert.emplace_back(id, data);
+			}
 		}
+
+		std::inplace_merge(
+			fileLocations->begin(),
+			fileLocations->begin() + storedCount,
+			fileLocations->end(),
+			isPositionLess);
+		m_tempSourceLocations.setValue(
+			p.first, fileLocations, fileLocations->size() * sizeof(StorageSourceLocation));
 	}
 
 	if (locationsToInsert.size())
@@ -434,7 +478,7 @@ StorageError SqliteIndexStorage::addError(const StorageErrorData& data)
 		m_checkErrorExistsStmt.bind(1, utility::encodeToUtf8(sanitizedMessage).c_str());
 		m_checkErrorExistsStmt.bind(2, int(data.fatal));
 
-		CppSQLite3Query checkQuery = executeQuery(m_checkErrorExistsStmt);
+		SqliteStorageQuery checkQuery = executeQuery(m_checkErrorExistsStmt);
 		if (!checkQuery.eof() && checkQuery.numFields() > 0)
 		{
 			id = checkQuery.getIntField(0, -1);
@@ -472,6 +516,9 @@ void SqliteIndexStorage::removeElement(Id id)
 
 void SqliteIndexStorage::removeElements(const std::vector<Id>& ids)
 {
+	// removed file nodes take their source locations with them
+	m_tempSourceLocations.clear();
+
 	executeStatement(
 		"DELETE FROM element WHERE id IN (" + utility::join(utility::toStrings(ids), ',') + ");");
 }
@@ -501,6 +548,8 @@ void SqliteIndexStorage::removeElementsWithoutOccurrences(const std::vector<Id>&
 void SqliteIndexStorage::removeElementsWithLocationInFiles(
 	const std::vector<Id>& fileIds, std::function<void(int)> updateStatusCallback)
 {
+	m_tempSourceLocations.clear();
+
 	if (updateStatusCallback != nullptr)
 	{
 		updateStatusCallback(1);
@@ -778,7 +827,7 @@ StorageNode SqliteIndexStorage::getNodeBySerializedName(const std::wstring& seri
 		"SELECT id, type, serialized_name FROM node WHERE serialized_name == ? LIMIT 1;");
 
 	stmt.bind(1, utility::encodeToUtf8(serializedName).c_str());
-	CppSQLite3Query q = executeQuery(stmt);
+	SqliteStorageQuery q = executeQuery(stmt);
 
 	if (!q.eof())
 	{
@@ -799,7 +848,7 @@ StorageNode SqliteIndexStorage::getNodeBySerializedName(const std::wstring& seri
 
 std::vector<int> SqliteIndexStorage::getAvailableNodeTypes() const
 {
-	CppSQLite3Query q = executeQuery("SELECT DISTINCT type FROM node;");
+	SqliteStorageQuery q = executeQuery("SELECT DISTINCT type FROM node;");
 
 	std::vector<int> types;
 
@@ -819,7 +868,7 @@ std::vector<int> SqliteIndexStorage::getAvailableNodeTypes() const
 
 std::vector<int> SqliteIndexStorage::getAvailableEdgeTypes() const
 {
-	CppSQLite3Query q = executeQuery("SELECT DISTINCT type FROM edge;");
+	SqliteStorageQuery q = executeQuery("SELECT DISTINCT type FROM edge;");
 
 	std::vector<int> types;
 
@@ -850,7 +899,7 @@ std::vector<StorageFile> SqliteIndexStorage::getFilesByPaths(const std::vector<F
 
 std::shared_ptr<TextAccess> SqliteIndexStorage::getFileContentById(Id fileId) const
 {
-	CppSQLite3Query q = executeQuery(
+	SqliteStorageQuery q = executeQuery(
 		"SELECT content FROM filecontent WHERE id = '" + std::to_string(fileId) + "';");
 	if (!q.eof())
 	{
@@ -864,7 +913,7 @@ std::shared_ptr<TextAccess> SqliteIndexStorage::getFileContentByPath(const std::
 {
 	try
 	{
-		CppSQLite3Query q = executeQuery(
+		SqliteStorageQuery q = executeQuery(
 			"SELECT filecontent.content "
 			"FROM filecontent "
 			"INNER JOIN file ON filecontent.id = file.id "
@@ -988,7 +1037,7 @@ std::shared_ptr<SourceLocationCollection> SqliteIndexStorage::getSourceLocations
 		sourceLocationIdToElementIds[occurrence.sourceLocationId].push_back(occurrence.elementId);
 	}
 
-	CppSQLite3Query q = executeQuery(
+	SqliteStorageQuery q = executeQuery(
 		"SELECT source_location.id, file.path, source_location.start_line, "
 		"source_location.start_column, "
 		"source_location.end_line, source_location.end_column, source_location.type "
@@ -1067,19 +1116,19 @@ std::vector<StorageElementComponent> SqliteIndexStorage::getElementComponentsByE
 		"WHERE element_id IN (" + utility::join(utility::toStrings(elementIds), ',') + ")");
 }
 
-std::vector<ErrorInfo> SqliteIndexStorage::getAllErrorInfos() const
+std::vector<ErrorInfo> SqliteIndexStorage::getErrorInfosAfterOccurrence(int occurrenceRowId) const
 {
 	std::vector<ErrorInfo> errorInfos;
 
-	CppSQLite3Query q = executeQuery(
+	SqliteStorageQuery q = executeQuery(
 		"SELECT error.id, error.message, error.fatal, error.indexed, error.translation_unit, "
 		"file.path, source_location.start_line, source_location.start_column "
 		"FROM occurrence "
 		"INNER JOIN error ON (error.id = occurrence.element_id) "
 		"INNER JOIN source_location ON (source_location.id = occurrence.source_location_id) "
-		"INNER JOIN file ON (file.id = source_location.file_node_id);");
-
-	std::map<Id, size_t> errorIdCount;
+		"INNER JOIN file ON (file.id = source_location.file_node_id) "
+		"WHERE occurrence.rowid > " +
+		std::to_string(occurrenceRowId) + " ORDER BY occurrence.rowid;");
 
 	while (!q.eof())
 	{
@@ -1094,21 +1143,8 @@ std::vector<ErrorInfo> SqliteIndexStorage::getAllErrorInfos() const
 
 		if (id != 0)
 		{
-			// There can be multiple errors with the same id, so a count is added to the id
-			Id errorId = id * 10000;
-			auto it = errorIdCount.find(id);
-			if (it != errorIdCount.end())
-			{
-				errorId += it->second;
-				it->second = it->second + 1;
-			}
-			else
-			{
-				errorIdCount.emplace(id, 1);
-			}
-
 			errorInfos.push_back(ErrorInfo(
-				errorId,
+				id,
 				utility::decodeFromUtf8(message),
 				utility::decodeFromUtf8(filePath),
 				lineNumber,
@@ -1160,6 +1196,11 @@ int SqliteIndexStorage::getErrorCount() const
 		"SELECT COUNT(*) FROM error INNER JOIN occurrence ON (error.id = occurrence.element_id);", 0);
 }
 
+int SqliteIndexStorage::getLastOccurrenceRowId() const
+{
+	return executeStatementScalar("SELECT MAX(rowid) FROM occurrence;", 0);
+}
+
 std::vector<std::pair<int, SqliteDatabaseIndex>> SqliteIndexStorage::getIndices() const
 {
 	std::vector<std::pair<int, SqliteDatabaseIndex>> indices;
@@ -1212,6 +1253,8 @@ std::vector<std::pair<int, SqliteDatabaseIndex>> SqliteIndexStorage::getIndices(
 
 void SqliteIndexStorage::clearTables()
 {
+	m_tempSourceLocations.clear();
+
 	try
 	{
 		m_database.execDML("DROP TABLE IF EXISTS main.error;");
@@ -1392,16 +1435,17 @@ void SqliteIndexStorage::setupPrecompiledStatements()
 			},
 			m_database);
 		m_insertSourceLocationBatchStatement.compile(
-			"INSERT INTO source_location(file_node_id, start_line, start_column, end_line, "
+			"INSERT INTO source_location(id, file_node_id, start_line, start_column, end_line, "
 			"end_column, type) VALUES",
-			6,
-			[](CppSQLite3Statement& stmt, const StorageSourceLocationData& location, size_t index) {
-				stmt.bind(int(index) * 6 + 1, int(location.fileNodeId));
-				stmt.bind(int(index) * 6 + 2, int(location.startLine));
-				stmt.bind(int(index) * 6 + 3, int(location.startCol));
-				stmt.bind(int(index) * 6 + 4, int(location.endLine));
-				stmt.bind(int(index) * 6 + 5, int(location.endCol));
-				stmt.bind(int(index) * 6 + 6, int(location.type));
+			7,
+			[](CppSQLite3Statement& stmt, const StorageSourceLocation& location, size_t index) {
+				stmt.bind(int(index) * 7 + 1, int(location.id));
+				stmt.bind(int(index) * 7 + 2, int(location.fileNodeId));
+				stmt.bind(int(index) * 7 + 3, int(location.startLine));
+				stmt.bind(int(index) * 7 + 4, int(location.startCol));
+				stmt.bind(int(index) * 7 + 5, int(location.endLine));
+				stmt.bind(int(index) * 7 + 6, int(location.endCol));
+				stmt.bind(int(index) * 7 + 7, int(location.type));
 			},
 			m_database);
 		m_insertOccurrenceBatchStatement.compile(
@@ -1448,11 +1492,24 @@ void SqliteIndexStorage::setupPrecompiledStatements()
 	}
 }
 
+std::shared_ptr<std::vector<StorageSourceLocation>> SqliteIndexStorage::getTempSourceLocations(
+	Id fileNodeId)
+{
+	std::shared_ptr<std::vector<StorageSourceLocation>> locations;
+	if (!m_tempSourceLocations.getValue(fileNodeId, locations))
+	{
+		locations = std::make_shared<std::vector<StorageSourceLocation>>(
+			doGetAll<StorageSourceLocation>("WHERE file_node_id == " + std::to_string(fileNodeId)));
+		std::sort(locations->begin(), locations->end(), isPositionLess);
+	}
+	return locations;
+}
+
 template <>
 void SqliteIndexStorage::forEach<StorageEdge>(
 	const std::string& query, std::function<void(StorageEdge&&)> func) const
 {
-	CppSQLite3Query q = executeQuery(
+	SqliteStorageQuery q = executeQuery(
 		"SELECT id, type, source_node_id, target_node_id FROM edge " + query + ";");
 
 	while (!q.eof())
@@ -1475,7 +1532,7 @@ template <>
 void SqliteIndexStorage::forEach<StorageNode>(
 	const std::string& query, std::function<void(StorageNode&&)> func) const
 {
-	CppSQLite3Query q = executeQuery("SELECT id, type, serialized_name FROM node " + query + ";");
+	SqliteStorageQuery q = executeQuery("SELECT id, type, serialized_name FROM node " + query + ";");
 
 	while (!q.eof())
 	{
@@ -1496,7 +1553,7 @@ template <>
 void SqliteIndexStorage::forEach<StorageSymbol>(
 	const std::string& query, std::function<void(StorageSymbol&&)> func) const
 {
-	CppSQLite3Query q = executeQuery("SELECT id, definition_kind FROM symbol " + query + ";");
+	SqliteStorageQuery q = executeQuery("SELECT id, definition_kind FROM symbol " + query + ";");
 
 	while (!q.eof())
 	{
@@ -1516,7 +1573,7 @@ template <>
 void SqliteIndexStorage::forEach<StorageFile>(
 	const std::string& query, std::function<void(StorageFile&&)> func) const
 {
-	CppSQLite3Query q = executeQuery(
+	SqliteStorageQuery q = executeQuery(
 		"SELECT id, path, language, modification_time, indexed, complete FROM file " + query + ";");
 
 	while (!q.eof())
@@ -1546,7 +1603,7 @@ template <>
 void SqliteIndexStorage::forEach<StorageLocalSymbol>(
 	const std::string& query, std::function<void(StorageLocalSymbol&&)> func) const
 {
-	CppSQLite3Query q = executeQuery("SELECT id, name FROM local_symbol " + query + ";");
+	SqliteStorageQuery q = executeQuery("SELECT id, name FROM local_symbol " + query + ";");
 
 	while (!q.eof())
 	{
@@ -1566,7 +1623,7 @@ template <>
 void SqliteIndexStorage::forEach<StorageSourceLocation>(
 	const std::string& query, std::function<void(StorageSourceLocation&&)> func) const
 {
-	CppSQLite3Query q = executeQuery(
+	SqliteStorageQuery q = executeQuery(
 		"SELECT id, file_node_id, start_line, start_column, end_line, end_column, type FROM "
 		"source_location " +
 		query + ";");
@@ -1596,7 +1653,7 @@ template <>
 void SqliteIndexStorage::forEach<StorageOccurrence>(
 	const std::string& query, std::function<void(StorageOccurrence&&)> func) const
 {
-	CppSQLite3Query q = executeQuery(
+	SqliteStorageQuery q = executeQuery(
 		"SELECT element_id, source_location_id FROM occurrence " + query + ";");
 
 	while (!q.eof())
@@ -1617,7 +1674,7 @@ template <>
 void SqliteIndexStorage::forEach<StorageComponentAccess>(
 	const std::string& query, std::function<void(StorageComponentAccess&&)> func) const
 {
-	CppSQLite3Query q = executeQuery("SELECT node_id, type FROM component_access " + query + ";");
+	SqliteStorageQuery q = executeQuery("SELECT node_id, type FROM component_access " + query + ";");
 
 	while (!q.eof())
 	{
@@ -1637,7 +1694,7 @@ template <>
 void SqliteIndexStorage::forEach<StorageElementComponent>(
 	const std::string& query, std::function<void(StorageElementComponent&&)> func) const
 {
-	CppSQLite3Query q = executeQuery(
+	SqliteStorageQuery q = executeQuery(
 		"SELECT element_id, type, data FROM element_component " + query + ";");
 
 	while (!q.eof())
@@ -1659,7 +1716,7 @@ template <>
 void SqliteIndexStorage::forEach<StorageError>(
 	const std::string& query, std::function<void(StorageError&&)> func) const
 {
-	CppSQLite3Query q = executeQuery(
+	SqliteStorageQuery q = executeQuery(
 		"SELECT id, message, fatal, indexed, translation_unit FROM error " + query + ";");
 
 	while (!q.eof())
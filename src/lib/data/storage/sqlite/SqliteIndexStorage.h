@@ -8,6 +8,7 @@
 #include "ErrorInfo.h"
 #include "LocationType.h"
 #include "LowMemoryStringMap.h"
+#include "LruCache.h"
 #include "SqliteDatabaseIndex.h"
 #include "SqliteStorage.h"
 #include "StorageComponentAccess.h"
@@ -135,7 +136,8 @@ public:
 	std::vector<StorageElementComponent> getElementComponentsByElementIds(
 		const std::vector<Id>& elementIds) const;
 
-	std::vector<ErrorInfo> getAllErrorInfos() const;
+	// returns errors in recording order, with the ids of their error elements
+	std::vector<ErrorInfo> getErrorInfosAfterOccurrence(int occurrenceRowId) const;
 
 	template <typename ResultType>
 	std::vector<ResultType> getAll() const
@@ -192,48 +194,11 @@ public:
 	int getFileLineSum() const;
 	int getSourceLocationCount() const;
 	int getErrorCount() const;
+	int getLastOccurrenceRowId() const;
 
 private:
 	static const size_t s_storageVersion;
-
-	struct TempSourceLocation
-	{
-		TempSourceLocation(
-			uint32_t startLine, uint16_t lineDiff, uint16_t startCol, uint16_t endCol, uint8_t type)
-			: startLine(startLine), lineDiff(lineDiff), startCol(startCol), endCol(endCol), type(type)
-		{
-		}
-
-		bool operator<(const TempSourceLocation& other) const
-		{
-			if (startLine != other.startLine)
-			{
-				return startLine < other.startLine;
-			}
-			else if (lineDiff != other.lineDiff)
-			{
-				return lineDiff < other.lineDiff;
-			}
-			else if (startCol != other.startCol)
-			{
-				return startCol < other.startCol;
-			}
-			else if (endCol != other.endCol)
-			{
-				return endCol < other.endCol;
-			}
-			else
-			{
-				return type < other.type;
-			}
-		}
-
-		uint32_t startLine;
-		uint16_t lineDiff;
-		uint16_t startCol;
-		uint16_t endCol;
-		uint8_t type;
-	};
+	static const size_t s_tempSourceLocationsSize;
 
 	std::vector<std::pair<int, SqliteDatabaseIndex>> getIndices() const;
 
@@ -241,6 +206,10 @@ private:
 	virtual void setupTables();
 	virtual void setupPrecompiledStatements();
 
+	// stored locations of a file sorted by position, kept while writing, so the locations of a
+	// header added by many translation units are not read again for each of them
+	std::shared_ptr<std::vector<StorageSourceLocation>> getTempSourceLocations(Id fileNodeId);
+
 	template <typename ResultType>
 	std::vector<ResultType> doGetAll(const std::string& query) const
 	{
@@ -269,7 +238,7 @@ private:
 	std::map<uint32_t, int> m_tempNodeTypes;
 	std::map<StorageEdgeData, uint32_t> m_tempEdgeIndex;
 	std::map<std::wstring, std::map<std::wstring, uint32_t>> m_tempLocalSymbolIndex;
-	std::map<uint32_t, std::map<TempSourceLocation, uint32_t>> m_tempSourceLocationIndices;
+	LruCache<Id, std::shared_ptr<std::vector<StorageSourceLocation>>> m_tempSourceLocations;
 
 	template <typename StorageType>
 	class InsertBatchStatement
@@ -356,7 +325,7 @@ private:
 	InsertBatchStatement<StorageEdge> m_insertEdgeBatchStatement;
 	InsertBatchStatement<StorageSymbol> m_insertSymbolBatchStatement;
 	InsertBatchStatement<StorageLocalSymbol> m_insertLocalSymbolBatchStatement;
-	InsertBatchStatement<StorageSourceLocationData> m_insertSourceLocationBatchStatement;
+	InsertBatchStatement<StorageSourceLocation> m_insertSourceLocationBatchStatement;
 	InsertBatchStatement<StorageOccurrence> m_insertOccurrenceBatchStatement;
 	InsertBatchStatement<StorageComponentAccess> m_insertComponentAccessBatchStatement;
 
@@ -1,11 +1,112 @@
 #include "SqliteStorage.h"
 
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
 #include "FileSystem.h"
 #include "TimeStamp.h"
 #include "logging.h"
 #include "utilityString.h"
 
-SqliteStorage::SqliteStorage(const FilePath& dbFilePath): m_dbFilePath(dbFilePath.getCanonical())
+// read-only connections to one database file, each used by one query at a time
+class SqliteReadDatabasePool
+{
+public:
+	SqliteReadDatabasePool(const FilePath& dbFilePath, size_t maxSize, int busyTimeoutMilliseconds)
+		: m_dbFilePath(dbFilePath)
+		, m_maxSize(maxSize)
+		, m_busyTimeoutMilliseconds(busyTimeoutMilliseconds)
+	{
+	}
+
+	// returns nullptr if all connections are in use
+	CppSQLite3DB* acquire()
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		if (m_idleDatabases.size())
+		{
+			CppSQLite3DB* database = m_idleDatabases.back();
+			m_idleDatabases.pop_back();
+			return database;
+		}
+
+		if (m_databases.size() >= m_maxSize)
+		{
+			return nullptr;
+		}
+
+		std::unique_ptr<CppSQLite3DB> database = std::make_unique<CppSQLite3DB>();
+		try
+		{
+			database->open(utility::encodeToUtf8(m_dbFilePath.wstr()).c_str());
+			database->setBusyTimeout(m_busyTimeoutMilliseconds);
+			database->execDML("PRAGMA query_only=ON;");
+		}
+		catch (CppSQLite3Exception& e)
+		{
+			LOG_ERROR(
+				L"Failed to open read connection to database file \"" + m_dbFilePath.wstr() +
+				L"\" with message: " + utility::decodeFromUtf8(e.errorMessage()));
+			return nullptr;
+		}
+
+		m_databases.push_back(std::move(database));
+		return m_databases.back().get();
+	}
+
+	void release(CppSQLite3DB* database)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_idleDatabases.push_back(database);
+	}
+
+	void close()
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		for (std::unique_ptr<CppSQLite3DB>& database: m_databases)
+		{
+			try
+			{
+				database->close();
+			}
+			catch (CppSQLite3Exception& e)
+			{
+				LOG_ERROR(e.errorMessage());
+			}
+		}
+		m_databases.clear();
+		m_idleDatabases.clear();
+	}
+
+	size_t getSize() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_databases.size();
+	}
+
+private:
+	const FilePath m_dbFilePath;
+	const size_t m_maxSize;
+	const int m_busyTimeoutMilliseconds;
+
+	mutable std::mutex m_mutex;
+	std::vector<std::unique_ptr<CppSQLite3DB>> m_databases;
+	std::vector<CppSQLite3DB*> m_idleDatabases;
+};
+
+const size_t SqliteStorage::s_maxReadConnectionCount = 16;
+const int SqliteStorage::s_busyTimeoutMilliseconds = 5000;
+
+SqliteStorage::SqliteStorage(const FilePath& dbFilePath)
+	: m_dbFilePath(dbFilePath.getCanonical())
+	, m_readConnectionsEnabled(false)
+	, m_openTransactionCount(0)
+	, m_transactionThreadId(std::thread::id())
+	, m_readDatabasePool(std::make_shared<SqliteReadDatabasePool>(
+		  m_dbFilePath, s_maxReadConnectionCount, s_busyTimeoutMilliseconds))
 {
 	if (!m_dbFilePath.getParentDirectory().empty() && !m_dbFilePath.getParentDirectory().exists())
 	{
@@ -24,11 +125,15 @@ SqliteStorage::SqliteStorage(const FilePath& dbFilePath): m_dbFilePath(dbFilePat
 		throw;
 	}
 
+	// readers on other connections may hold a shared lock for a moment when this one writes
+	m_database.setBusyTimeout(s_busyTimeoutMilliseconds);
 	executeStatement("PRAGMA foreign_keys=ON;");
 }
 
 SqliteStorage::~SqliteStorage()
 {
+	closeReadDatabases();
+
 	try
 	{
 		m_database.close();
@@ -84,17 +189,31 @@ void SqliteStorage::setVersion(size_t version)
 
 void SqliteStorage::beginTransaction()
 {
+	// other connections can't see uncommitted data, so reads of this thread need to stay on
+	// m_database from here on, while other threads keep reading the committed data
+	if (m_openTransactionCount++ == 0)
+	{
+		m_transactionThreadId = std::this_thread::get_id();
+	}
 	executeStatement("BEGIN TRANSACTION;");
 }
 
 void SqliteStorage::commitTransaction()
 {
 	executeStatement("COMMIT TRANSACTION;");
+	if (--m_openTransactionCount == 0)
+	{
+		m_transactionThreadId = std::thread::id();
+	}
 }
 
 void SqliteStorage::rollbackTransaction()
 {
 	executeStatement("ROLLBACK TRANSACTION;");
+	if (--m_openTransactionCount == 0)
+	{
+		m_transactionThreadId = std::thread::id();
+	}
 }
 
 void SqliteStorage::optimizeMemory() const
@@ -200,7 +319,8 @@ int SqliteStorage::executeStatementScalar(const std::string& statement, const in
 	int ret = 0;
 	try
 	{
-		ret = m_database.execScalar(statement.c_str(), nullValue);
+		std::shared_ptr<CppSQLite3DB> readDatabase = acquireReadDatabase();
+		ret = (readDatabase ? *readDatabase : m_database).execScalar(statement.c_str(), nullValue);
 	}
 	catch (CppSQLite3Exception e)
 	{
@@ -214,7 +334,7 @@ int SqliteStorage::executeStatementScalar(CppSQLite3Statement& statement, const
 	int ret = 0;
 	try
 	{
-		CppSQLite3Query q = executeQuery(statement);
+		SqliteStorageQuery q = executeQuery(statement);
 
 		if (q.eof() || q.numFields() < 1)
 		{
@@ -232,20 +352,22 @@ int SqliteStorage::executeStatementScalar(CppSQLite3Statement& statement, const
 	return ret;
 }
 
-CppSQLite3Query SqliteStorage::executeQuery(const std::string& statement) const
+SqliteStorageQuery SqliteStorage::executeQuery(const std::string& statement) const
 {
 	try
 	{
-		return m_database.execQuery(statement.c_str());
+		std::shared_ptr<CppSQLite3DB> readDatabase = acquireReadDatabase();
+		return SqliteStorageQuery(
+			(readDatabase ? *readDatabase : m_database).execQuery(statement.c_str()), readDatabase);
 	}
 	catch (CppSQLite3Exception e)
 	{
 		LOG_ERROR(std::to_string(e.errorCode()) + ": " + e.errorMessage());
 	}
-	return CppSQLite3Query();
+	return SqliteStorageQuery();
 }
 
-CppSQLite3Query SqliteStorage::executeQuery(CppSQLite3Statement& statement) const
+SqliteStorageQuery SqliteStorage::executeQuery(CppSQLite3Statement& statement) const
 {
 	try
 	{
@@ -255,12 +377,39 @@ CppSQLite3Query SqliteStorage::executeQuery(CppSQLite3Statement& statement) cons
 	{
 		LOG_ERROR(std::to_string(e.errorCode()) + ": " + e.errorMessage());
 	}
-	return CppSQLite3Query();
+	return SqliteStorageQuery();
+}
+
+std::map<std::string, size_t> SqliteStorage::getTableRowCounts() const
+{
+	std::vector<std::string> tableNames;
+	{
+		SqliteStorageQuery q = executeQuery(
+			"SELECT name FROM sqlite_master WHERE type='table' AND name NOT LIKE 'sqlite_%';");
+		while (!q.eof())
+		{
+			tableNames.push_back(q.getStringField(0, ""));
+			q.nextRow();
+		}
+	}
+
+	std::map<std::string, size_t> rowCounts;
+	for (const std::string& tableName: tableNames)
+	{
+		rowCounts[tableName] = static_cast<size_t>(
+			std::max(executeStatementScalar("SELECT COUNT(*) FROM " + tableName + ";", 0), 0));
+	}
+	return rowCounts;
+}
+
+size_t SqliteStorage::getReadConnectionCount() const
+{
+	return m_readDatabasePool->getSize();
 }
 
 bool SqliteStorage::hasTable(const std::string& tableName) const
 {
-	CppSQLite3Query q = executeQuery(
+	SqliteStorageQuery q = executeQuery(
 		"SELECT name FROM sqlite_master WHERE type='table' AND name='" + tableName + "';");
 
 	if (!q.eof())
@@ -271,11 +420,16 @@ bool SqliteStorage::hasTable(const std::string& tableName) const
 	return false;
 }
 
+void SqliteStorage::setReadConnectionsEnabled(bool enabled)
+{
+	m_readConnectionsEnabled = enabled;
+}
+
 std::string SqliteStorage::getMetaValue(const std::string& key) const
 {
 	if (hasTable("meta"))
 	{
-		CppSQLite3Query q = executeQuery("SELECT value FROM meta WHERE key = '" + key + "';");
+		SqliteStorageQuery q = executeQuery("SELECT value FROM meta WHERE key = '" + key + "';");
 
 		if (!q.eof())
 		{
@@ -299,3 +453,31 @@ void SqliteStorage::insertOrUpdateMetaValue(const std::string& key, const std::s
 	stmt.bind(3, value.c_str());
 	executeStatement(stmt);
 }
+
+std::shared_ptr<CppSQLite3DB> SqliteStorage::acquireReadDatabase() const
+{
+	if (!m_readConnectionsEnabled || m_transactionThreadId == std::this_thread::get_id())
+	{
+		return nullptr;
+	}
+
+	CppSQLite3DB* database = m_readDatabasePool->acquire();
+	if (!database)
+	{
+		return nullptr;
+	}
+
+	std::weak_ptr<SqliteReadDatabasePool> weakPool = m_readDatabasePool;
+	return std::shared_ptr<CppSQLite3DB>(database, [weakPool](CppSQLite3DB* database) {
+		// the pool is gone if its storage was destroyed, which also closed the connection
+		if (std::shared_ptr<SqliteReadDatabasePool> pool = weakPool.lock())
+		{
+			pool->release(database);
+		}
+	});
+}
+
+void SqliteStorage::closeReadDatabases()
+{
+	m_readDatabasePool->close();
+}
@@ -1,11 +1,18 @@
 #ifndef SQLITE_STORAGE_H
 #define SQLITE_STORAGE_H
 
+#include <atomic>
+#include <map>
+#include <memory>
+#include <thread>
+
 #include "CppSQLite3.h"
 
 #include "FilePath.h"
 #include "SqliteDatabaseIndex.h"
+#include "SqliteStorageQuery.h"
 
+class SqliteReadDatabasePool;
 class SqliteStorageMigration;
 class TimeStamp;
 
@@ -35,6 +42,10 @@ public:
 	void setTime();
 	TimeStamp getTime() const;
 
+	std::map<std::string, size_t> getTableRowCounts() const;
+
+	size_t getReadConnectionCount() const;
+
 protected:
 	void setupMetaTable();
 	void clearMetaTable();
@@ -43,11 +54,17 @@ protected:
 	bool executeStatement(CppSQLite3Statement& statement) const;
 	int executeStatementScalar(const std::string& statement, const int nullValue) const;
 	int executeStatementScalar(CppSQLite3Statement& statement, const int nullValue) const;
-	CppSQLite3Query executeQuery(const std::string& statement) const;
-	CppSQLite3Query executeQuery(CppSQLite3Statement& statement) const;
+	SqliteStorageQuery executeQuery(const std::string& statement) const;
+	SqliteStorageQuery executeQuery(CppSQLite3Statement& statement) const;
 
 	bool hasTable(const std::string& tableName) const;
 
+	// While enabled, queries passed as string run on a read-only connection taken from a pool, so
+	// threads reading the database don't have to wait for each other. Precompiled statements, writes
+	// and all queries of the thread running a transaction keep using m_database. A query holds its
+	// connection until it is destroyed, then the connection is reused by the next query.
+	void setReadConnectionsEnabled(bool enabled);
+
 	std::string getMetaValue(const std::string& key) const;
 	void insertOrUpdateMetaValue(const std::string& key, const std::string& value);
 
@@ -60,6 +77,18 @@ private:
 	virtual void setupTables() = 0;
 	virtual void setupPrecompiledStatements() = 0;
 
+	// returns nullptr if the query has to run on m_database
+	std::shared_ptr<CppSQLite3DB> acquireReadDatabase() const;
+	void closeReadDatabases();
+
+	static const size_t s_maxReadConnectionCount;
+	static const int s_busyTimeoutMilliseconds;
+
+	std::atomic<bool> m_readConnectionsEnabled;
+	int m_openTransactionCount;
+	std::atomic<std::thread::id> m_transactionThreadId;
+	std::shared_ptr<SqliteReadDatabasePool> m_readDatabasePool;
+
 	std::vector<std::pair<int, SqliteDatabaseIndex>> m_indices;
 
 	bool m_precompiledStatementsInitialized = false;
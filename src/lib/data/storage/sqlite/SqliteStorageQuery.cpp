@@ -0,0 +1,19 @@
+#include "SqliteStorageQuery.h"
+
+SqliteStorageQuery::SqliteStorageQuery(
+	const CppSQLite3Query& query, std::shared_ptr<CppSQLite3DB> readDatabase)
+	: CppSQLite3Query(query), m_readDatabase(readDatabase)
+{
+}
+
+SqliteStorageQuery::~SqliteStorageQuery()
+{
+	// the statement has to be finished before another query may get the connection
+	try
+	{
+		finalize();
+	}
+	catch (...)
+	{
+	}
+}
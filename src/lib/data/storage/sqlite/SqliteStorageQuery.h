@@ -0,0 +1,32 @@
+#ifndef SQLITE_STORAGE_QUERY_H
+#define SQLITE_STORAGE_QUERY_H
+
+#include <memory>
+
+#include "CppSQLite3.h"
+
+// Result of a query run by SqliteStorage. It holds on to the read connection it runs on until it is
+// destroyed, so the connection is only returned to the pool of its storage once the query ends.
+class SqliteStorageQuery: private CppSQLite3Query
+{
+public:
+	SqliteStorageQuery() = default;
+	SqliteStorageQuery(
+		const CppSQLite3Query& query, std::shared_ptr<CppSQLite3DB> readDatabase = nullptr);
+	SqliteStorageQuery(const SqliteStorageQuery& other) = default;
+	SqliteStorageQuery& operator=(const SqliteStorageQuery& other) = default;
+	~SqliteStorageQuery() override;
+
+	using CppSQLite3Query::eof;
+	using CppSQLite3Query::fieldIsNull;
+	using CppSQLite3Query::getInt64Field;
+	using CppSQLite3Query::getIntField;
+	using CppSQLite3Query::getStringField;
+	using CppSQLite3Query::nextRow;
+	using CppSQLite3Query::numFields;
+
+private:
+	std::shared_ptr<CppSQLite3DB> m_readDatabase;
+};
+
+#endif	  // SQLITE_STORAGE_QUERY_H
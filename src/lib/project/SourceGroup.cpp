@@ -2,6 +2,7 @@
 
 #include "FilePath.h"
 #include "FilePathFilter.h"
+#include "FilePathFilterMatcher.h"
 #include "MemoryIndexerCommandProvider.h"
 #include "ProjectSettings.h"
 #include "SourceGroupSettings.h"
@@ -74,6 +75,7 @@ std::set<FilePath> SourceGroup::filterToContainedFilePaths(
 	const std::vector<FilePathFilter>& excludeFilters) const
 {
 	std::set<FilePath> containedFilePaths;
+	const FilePathFilterMatcher excludeFilterMatcher(excludeFilters);
 
 	for (const FilePath& filePath: filePaths)
 	{
@@ -96,7 +98,7 @@ std::set<FilePath> SourceGroup::filterToContainedFilePaths(
 
 		if (isInIndexedPaths)
 		{
-			isInIndexedPaths = !FilePathFilter::areMatching(excludeFilters, filePath);
+			isInIndexedPaths = !excludeFilterMatcher.isMatching(filePath);
 		}
 
 		if (isInIndexedPaths)
@@ -393,6 +393,16 @@ void ApplicationSettings::setMultiProcessIndexingEnabled(bool enabled)
 	setValue<bool>("indexing/multi_process_indexing", enabled);
 }
 
+bool ApplicationSettings::getIndexSnapshotEnabled() const
+{
+	return getValue<bool>("indexing/index_snapshot", true);
+}
+
+void ApplicationSettings::setIndexSnapshotEnabled(bool enabled)
+{
+	setValue<bool>("indexing/index_snapshot", enabled);
+}
+
 FilePath ApplicationSettings::getJavaPath() const
 {
 	return FilePath(getValue<std::wstring>("indexing/java/java_path", L""));
@@ -98,6 +98,9 @@ public:
 	bool getMultiProcessIndexingEnabled() const;
 	void setMultiProcessIndexingEnabled(bool enabled);
 
+	bool getIndexSnapshotEnabled() const;
+	void setIndexSnapshotEnabled(bool enabled);
+
 	FilePath getJavaPath() const;
 	void setJavaPath(const FilePath& path);
 
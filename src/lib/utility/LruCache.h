@@ -0,0 +1,143 @@
+#ifndef LRU_CACHE_H
+#define LRU_CACHE_H
+
+#include <iterator>
+#include <list>
+#include <map>
+
+// Keeps values until their total size exceeds the size limit and then removes the least recently
+// used values first. The size of each value is given by the caller, e.g. as its memory in bytes.
+template <typename KeyType, typename ValType>
+class LruCache
+{
+public:
+	explicit LruCache(size_t maxSize);
+
+	// returns false if the value is not cached
+	bool getValue(const KeyType& key, ValType& value);
+	// values bigger than the size limit are not cached
+	void setValue(const KeyType& key, ValType value, size_t size);
+
+	void clear();
+
+	size_t getSize() const;
+	size_t getMaxSize() const;
+	size_t getValueCount() const;
+	size_t getHitCount() const;
+	size_t getMissCount() const;
+
+private:
+	struct Entry
+	{
+		KeyType key;
+		ValType value;
+		size_t size;
+	};
+
+	void remove(typename std::list<Entry>::iterator it);
+
+	const size_t m_maxSize;
+	size_t m_size;
+
+	std::list<Entry> m_entries;	   // most recently used first
+	std::map<KeyType, typename std::list<Entry>::iterator> m_index;
+
+	size_t m_hitCount;
+	size_t m_missCount;
+};
+
+template <typename KeyType, typename ValType>
+LruCache<KeyType, ValType>::LruCache(size_t maxSize)
+	: m_maxSize(maxSize), m_size(0), m_hitCount(0), m_missCount(0)
+{
+}
+
+template <typename KeyType, typename ValType>
+bool LruCache<KeyType, ValType>::getValue(const KeyType& key, ValType& value)
+{
+	auto it = m_index.find(key);
+	if (it == m_index.end())
+	{
+		++m_missCount;
+		return false;
+	}
+
+	++m_hitCount;
+	m_entries.splice(m_entries.begin(), m_entries, it->second);
+	value = it->second->value;
+	return true;
+}
+
+template <typename KeyType, typename ValType>
+void LruCache<KeyType, ValType>::setValue(const KeyType& key, ValType value, size_t size)
+{
+	auto it = m_index.find(key);
+	if (it != m_index.end())
+	{
+		remove(it->second);
+	}
+
+	if (size > m_maxSize)
+	{
+		return;
+	}
+
+	while (m_size + size > m_maxSize)
+	{
+		remove(std::prev(m_entries.end()));
+	}
+
+	m_entries.push_front({key, std::move(value), size});
+	m_index.emplace(key, m_entries.begin());
+	m_size += size;
+}
+
+template <typename KeyType, typename ValType>
+void LruCache<KeyType, ValType>::clear()
+{
+	m_entries.clear();
+	m_index.clear();
+	m_size = 0;
+	m_hitCount = 0;
+	m_missCount = 0;
+}
+
+template <typename KeyType, typename ValType>
+size_t LruCache<KeyType, ValType>::getSize() const
+{
+	return m_size;
+}
+
+template <typename KeyType, typename ValType>
+size_t LruCache<KeyType, ValType>::getMaxSize() const
+{
+	return m_maxSize;
+}
+
+template <typename KeyType, typename ValType>
+size_t LruCache<KeyType, ValType>::getValueCount() const
+{
+	return m_entries.size();
+}
+
+template <typename KeyType, typename ValType>
+size_t LruCache<KeyType, ValType>::getHitCount() const
+{
+	return m_hitCount;
+}
+
+template <typename KeyType, typename ValType>
+size_t LruCache<KeyType, ValType>::getMissCount() const
+{
+	return m_missCount;
+}
+
+template <typename KeyType, typename ValType>
+void LruCache<KeyType, ValType>::remove(typename std::list<Entry>::iterator it)
+{
+	m_size -= it->size;
+	m_index.erase(it->key);
+	m_entries.erase(it);
+}
+
+#endif	  // LRU_CACHE_H
@@ -0,0 +1,141 @@
+#ifndef OBJECT_ARENA_H
+#define OBJECT_ARENA_H
+
+#include <algorithm>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Creates objects in chunks of growing size, so creating many small objects doesn't need an
+// allocation for each of them. Objects keep their address until they are destroyed and the slots
+// of destroyed objects are reused.
+template <typename T>
+class ObjectArena
+{
+public:
+	ObjectArena();
+	~ObjectArena();
+
+	template <typename... Args>
+	T* create(Args&&... args);
+	void destroy(T* object);
+
+	// destroys all objects that were not destroyed yet
+	void clear();
+
+	size_t size() const;
+
+private:
+	struct Slot
+	{
+		typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+		bool alive;
+	};
+
+	struct Chunk
+	{
+		std::unique_ptr<Slot[]> slots;
+		size_t size;
+	};
+
+	static constexpr size_t s_firstChunkSize = 64;
+	static constexpr size_t s_maxChunkSize = 8192;
+
+	ObjectArena(const ObjectArena&);
+	void operator=(const ObjectArena&);
+
+	Slot* getFreeSlot();
+
+	std::vector<Chunk> m_chunks;
+	size_t m_usedSlotCountOfLastChunk;
+	std::vector<Slot*> m_freeSlots;
+	size_t m_size;
+};
+
+template <typename T>
+ObjectArena<T>::ObjectArena(): m_usedSlotCountOfLastChunk(0), m_size(0)
+{
+}
+
+template <typename T>
+ObjectArena<T>::~ObjectArena()
+{
+	clear();
+}
+
+template <typename T>
+template <typename... Args>
+T* ObjectArena<T>::create(Args&&... args)
+{
+	Slot* slot = getFreeSlot();
+	T* object = new (&slot->storage) T(std::forward<Args>(args)...);
+	slot->alive = true;
+	m_size++;
+	return object;
+}
+
+template <typename T>
+void ObjectArena<T>::destroy(T* object)
+{
+	// the storage is the first member of the slot
+	Slot* slot = reinterpret_cast<Slot*>(object);
+	object->~T();
+	slot->alive = false;
+	m_freeSlots.push_back(slot);
+	m_size--;
+}
+
+template <typename T>
+void ObjectArena<T>::clear()
+{
+	for (size_t i = 0; i < m_chunks.size(); i++)
+	{
+		const size_t usedSlotCount = i + 1 < m_chunks.size() ? m_chunks[i].size
+															  : m_usedSlotCountOfLastChunk;
+		for (size_t j = 0; j < usedSlotCount; j++)
+		{
+			Slot& slot = m_chunks[i].slots[j];
+			if (slot.alive)
+			{
+				reinterpret_cast<T*>(&slot.storage)->~T();
+				slot.alive = false;
+			}
+		}
+	}
+
+	m_chunks.clear();
+	m_usedSlotCountOfLastChunk = 0;
+	m_freeSlots.clear();
+	m_size = 0;
+}
+
+template <typename T>
+size_t ObjectArena<T>::size() const
+{
+	return m_size;
+}
+
+template <typename T>
+typename ObjectArena<T>::Slot* ObjectArena<T>::getFreeSlot()
+{
+	if (!m_freeSlots.empty())
+	{
+		Slot* slot = m_freeSlots.back();
+		m_freeSlots.pop_back();
+		return slot;
+	}
+
+	if (m_chunks.empty() || m_usedSlotCountOfLastChunk == m_chunks.back().size)
+	{
+		const size_t chunkSize = m_chunks.empty()
+			? s_firstChunkSize
+			: std::min(m_chunks.back().size * 2, s_maxChunkSize);
+		m_chunks.push_back({std::unique_ptr<Slot[]>(new Slot[chunkSize]), chunkSize});
+		m_usedSlotCountOfLastChunk = 0;
+	}
+
+	return &m_chunks.back().slots[m_usedSlotCountOfLastChunk++];
+}
+
+#endif	  // OBJECT_ARENA_H
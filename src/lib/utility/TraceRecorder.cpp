@@ -0,0 +1,248 @@
+#include "TraceRecorder.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <locale>
+#include <set>
+#include <sstream>
+
+namespace
+{
+std::string toJsonString(const std::string& str)
+{
+	std::ostringstream ss;
+	ss << '"';
+	for (const char c: str)
+	{
+		if (c == '"' || c == '\\')
+		{
+			ss << '\\' << c;
+		}
+		else if (static_cast<unsigned char>(c) >= 0x20)
+		{
+			ss << c;
+		}
+	}
+	ss << '"';
+	return ss.str();
+}
+}	 // namespace
+
+const size_t TraceRecorder::s_threadBufferSize = 16384;
+
+TraceRecorder::ThreadBuffer::ThreadBuffer(size_t threadIndex)
+	: threadIndex(threadIndex), events(s_threadBufferSize), writeCount(0), readCount(0), owned(true)
+{
+}
+
+TraceRecorder::ThreadBufferOwner::~ThreadBufferOwner()
+{
+	if (buffer)
+	{
+		// the next thread that starts recording continues in this buffer
+		buffer->owned = false;
+	}
+}
+
+TraceRecorder* TraceRecorder::getInstance()
+{
+	// never destroyed, so traces in destructors of other static objects stay safe
+	static TraceRecorder* s_instance = new TraceRecorder();
+	return s_instance;
+}
+
+uint64_t TraceRecorder::now()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+			   std::chrono::steady_clock::now().time_since_epoch())
+		.count();
+}
+
+std::string TraceRecorder::toChromeTraceJson(const std::vector<TraceRecord>& records)
+{
+	uint64_t firstStartNS = 0;
+	std::set<Id> processIds;
+	for (const TraceRecord& record: records)
+	{
+		if (!firstStartNS || record.startNS < firstStartNS)
+		{
+			firstStartNS = record.startNS;
+		}
+		processIds.insert(record.processId);
+	}
+
+	std::ostringstream ss;
+	ss.imbue(std::locale::classic());
+	ss << std::fixed << std::setprecision(3);
+
+	ss << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+
+	bool first = true;
+	for (const Id processId: processIds)
+	{
+		ss << (first ? "" : ",") << "\n{\"name\": \"process_name\", \"ph\": \"M\", \"pid\": "
+		   << processId << ", \"args\": {\"name\": \""
+		   << (processId ? "indexer " + std::to_string(processId) : std::string("Sourcetrail"))
+		   << "\"}}";
+		first = false;
+	}
+
+	for (const TraceRecord& record: records)
+	{
+		ss << (first ? "" : ",") << "\n{\"name\": " << toJsonString(record.eventName)
+		   << ", \"cat\": \"sourcetrail\", \"ph\": \"X\", \"pid\": " << record.processId
+		   << ", \"tid\": " << record.threadIndex
+		   << ", \"ts\": " << (record.startNS - firstStartNS) / 1000.0
+		   << ", \"dur\": " << record.durationNS / 1000.0 << "}";
+		first = false;
+	}
+
+	ss << "\n]}\n";
+
+	return ss.str();
+}
+
+uint32_t TraceRecorder::registerEventName(
+	const std::string& eventName, const std::string& functionName)
+{
+	std::lock_guard<std::mutex> lock(m_eventNamesMutex);
+	m_eventNames.push_back(eventName.empty() ? functionName : eventName);
+	return static_cast<uint32_t>(m_eventNames.size() - 1);
+}
+
+void TraceRecorder::setEnabled(bool enabled)
+{
+	m_enabled = enabled;
+}
+
+void TraceRecorder::record(uint32_t eventNameId, uint64_t startNS, uint64_t endNS)
+{
+	ThreadBuffer* buffer = getThreadBuffer();
+
+	// only the owning thread writes, the odd sequence marks the slot as being overwritten and the
+	// release fence keeps the event fields from being written before that
+	const uint64_t writeCount = buffer->writeCount.load(std::memory_order_relaxed);
+	EventSlot& slot = buffer->events[writeCount % s_threadBufferSize];
+	slot.sequence.store(writeCount * 2 + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	slot.eventNameId.store(eventNameId, std::memory_order_relaxed);
+	slot.startNS.store(startNS, std::memory_order_relaxed);
+	slot.durationNS.store(endNS - startNS, std::memory_order_relaxed);
+	slot.sequence.store(writeCount * 2 + 2, std::memory_order_release);
+	buffer->writeCount.store(writeCount + 1, std::memory_order_release);
+}
+
+std::vector<TraceRecord> TraceRecorder::collectRecords(Id processId)
+{
+	std::vector<TraceRecord> records;
+
+	std::lock_guard<std::mutex> lock(m_buffersMutex);
+	for (const std::unique_ptr<ThreadBuffer>& buffer: m_buffers)
+	{
+		collectBufferRecords(buffer.get(), processId, records);
+	}
+
+	return records;
+}
+
+std::vector<TraceRecord> TraceRecorder::collectThreadRecords(Id processId)
+{
+	std::vector<TraceRecord> records;
+
+	ThreadBuffer* buffer = getThreadBuffer();
+
+	std::lock_guard<std::mutex> lock(m_buffersMutex);
+	collectBufferRecords(buffer, processId, records);
+
+	return records;
+}
+
+void TraceRecorder::addRecords(const std::vector<TraceRecord>& records)
+{
+	std::lock_guard<std::mutex> lock(m_addedRecordsMutex);
+	m_addedRecords.insert(m_addedRecords.end(), records.begin(), records.end());
+}
+
+std::vector<TraceRecord> TraceRecorder::collectAllRecords()
+{
+	std::vector<TraceRecord> records = collectRecords(0);
+
+	std::lock_guard<std::mutex> lock(m_addedRecordsMutex);
+	records.insert(records.end(), m_addedRecords.begin(), m_addedRecords.end());
+	m_addedRecords.clear();
+
+	return records;
+}
+
+TraceRecorder::TraceRecorder(): m_enabled(false) {}
+
+TraceRecorder::ThreadBuffer* TraceRecorder::getThreadBuffer()
+{
+	thread_local ThreadBufferOwner owner;
+	if (owner.buffer)
+	{
+		return owner.buffer;
+	}
+
+	std::lock_guard<std::mutex> lock(m_buffersMutex);
+	for (const std::unique_ptr<ThreadBuffer>& buffer: m_buffers)
+	{
+		bool owned = false;
+		if (buffer->owned.compare_exchange_strong(owned, true))
+		{
+			owner.buffer = buffer.get();
+			return owner.buffer;
+		}
+	}
+
+	m_buffers.push_back(std::make_unique<ThreadBuffer>(m_buffers.size() + 1));
+	owner.buffer = m_buffers.back().get();
+	return owner.buffer;
+}
+
+void TraceRecorder::collectBufferRecords(
+	ThreadBuffer* buffer, Id processId, std::vector<TraceRecord>& records) const
+{
+	const uint64_t writeCount = buffer->writeCount.load(std::memory_order_acquire);
+	const uint64_t oldestCount = writeCount > s_threadBufferSize ? writeCount - s_threadBufferSize
+																  : 0;
+	const uint64_t readCount = std::max(buffer->readCount, oldestCount);
+
+	// the owning thread keeps writing while the events are copied, an event is only kept if its
+	// slot holds the same complete event before and after copying it
+	std::vector<Event> events;
+	for (uint64_t i = readCount; i < writeCount; i++)
+	{
+		const EventSlot& slot = buffer->events[i % s_threadBufferSize];
+		const uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+		if (sequence != i * 2 + 2)
+		{
+			continue;
+		}
+
+		Event event;
+		event.eventNameId = slot.eventNameId.load(std::memory_order_relaxed);
+		event.startNS = slot.startNS.load(std::memory_order_relaxed);
+		event.durationNS = slot.durationNS.load(std::memory_order_relaxed);
+
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (slot.sequence.load(std::memory_order_relaxed) == sequence)
+		{
+			events.push_back(event);
+		}
+	}
+	buffer->readCount = writeCount;
+
+	std::lock_guard<std::mutex> lock(m_eventNamesMutex);
+	for (const Event& event: events)
+	{
+		TraceRecord record;
+		record.eventName = m_eventNames[event.eventNameId];
+		record.processId = processId;
+		record.threadIndex = buffer->threadIndex;
+		record.startNS = event.startNS;
+		record.durationNS = event.durationNS;
+		records.push_back(record);
+	}
+}
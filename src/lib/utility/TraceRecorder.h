@@ -0,0 +1,134 @@
+#ifndef TRACE_RECORDER_H
+#define TRACE_RECORDER_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "types.h"
+
+struct TraceRecord
+{
+	std::string eventName;
+	Id processId = 0;
+	size_t threadIndex = 0;
+	uint64_t startNS = 0;
+	uint64_t durationNS = 0;
+};
+
+// Records trace events into a ring buffer per thread. Writing an event takes no lock and
+// recording is switched on at runtime, so the TRACE() calls stay compiled in. Event names are
+// registered once per call site and only referenced by their id while recording.
+class TraceRecorder
+{
+public:
+	static TraceRecorder* getInstance();
+
+	// nanoseconds of a monotonic clock that all processes of a machine share
+	static uint64_t now();
+
+	static std::string toChromeTraceJson(const std::vector<TraceRecord>& records);
+
+	uint32_t registerEventName(const std::string& eventName, const std::string& functionName);
+
+	void setEnabled(bool enabled);
+	bool isEnabled() const
+	{
+		return m_enabled.load(std::memory_order_relaxed);
+	}
+
+	void record(uint32_t eventNameId, uint64_t startNS, uint64_t endNS);
+
+	// takes the records that were written since the last collection, older ones that got
+	// overwritten in between are lost
+	std::vector<TraceRecord> collectRecords(Id processId);
+	std::vector<TraceRecord> collectThreadRecords(Id processId);
+
+	// keeps records of other processes until they get collected together with the local ones
+	void addRecords(const std::vector<TraceRecord>& records);
+	std::vector<TraceRecord> collectAllRecords();
+
+private:
+	struct Event
+	{
+		uint32_t eventNameId;
+		uint64_t startNS;
+		uint64_t durationNS;
+	};
+
+	// the fields are atomics, because collecting threads read slots the owner may overwrite
+	struct EventSlot
+	{
+		// odd while the event with index (sequence - 1) / 2 is written, even when it is complete
+		std::atomic<uint64_t> sequence{0};
+		std::atomic<uint32_t> eventNameId{0};
+		std::atomic<uint64_t> startNS{0};
+		std::atomic<uint64_t> durationNS{0};
+	};
+
+	struct ThreadBuffer
+	{
+		ThreadBuffer(size_t threadIndex);
+
+		const size_t threadIndex;
+		std::vector<EventSlot> events;
+		std::atomic<uint64_t> writeCount;
+		uint64_t readCount;
+		std::atomic<bool> owned;
+	};
+
+	class ThreadBufferOwner
+	{
+	public:
+		~ThreadBufferOwner();
+		ThreadBuffer* buffer = nullptr;
+	};
+
+	static const size_t s_threadBufferSize;
+
+	TraceRecorder();
+	TraceRecorder(const TraceRecorder&) = delete;
+	void operator=(const TraceRecorder&) = delete;
+
+	ThreadBuffer* getThreadBuffer();
+	void collectBufferRecords(
+		ThreadBuffer* buffer, Id processId, std::vector<TraceRecord>& records) const;
+
+	std::atomic<bool> m_enabled;
+
+	mutable std::mutex m_eventNamesMutex;
+	std::vector<std::string> m_eventNames;
+
+	std::mutex m_buffersMutex;
+	std::vector<std::unique_ptr<ThreadBuffer>> m_buffers;
+
+	std::mutex m_addedRecordsMutex;
+	std::vector<TraceRecord> m_addedRecords;
+};
+
+class ScopedTraceRecord
+{
+public:
+	ScopedTraceRecord(uint32_t eventNameId)
+		: m_eventNameId(eventNameId)
+		, m_startNS(TraceRecorder::getInstance()->isEnabled() ? TraceRecorder::now() : 0)
+	{
+	}
+
+	~ScopedTraceRecord()
+	{
+		if (m_startNS)
+		{
+			TraceRecorder::getInstance()->record(m_eventNameId, m_startNS, TraceRecorder::now());
+		}
+	}
+
+private:
+	const uint32_t m_eventNameId;
+	const uint64_t m_startNS;
+};
+
+#endif	  // TRACE_RECORDER_H
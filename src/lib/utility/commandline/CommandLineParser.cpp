@@ -5,8 +5,11 @@
 
 #include <boost/program_options.hpp>
 
+#include "CommandlineCommandBenchmark.h"
 #include "CommandlineCommandConfig.h"
 #include "CommandlineCommandIndex.h"
+#include "CommandlineCommandQueryLoadTest.h"
+#include "CommandlineCommandServe.h"
 #include "CommandlineHelper.h"
 #include "ConfigManager.h"
 #include "TextAccess.h"
@@ -28,6 +31,10 @@ CommandLineParser::CommandLineParser(const std::string& version): m_version(vers
 
 	m_commands.push_back(std::make_unique<commandline::CommandlineCommandConfig>(this));
 	m_commands.push_back(std::make_unique<commandline::CommandlineCommandIndex>(this));
+	m_commands.push_back(std::make_unique<commandline::CommandlineCommandBenchmark>(this));
+	m_commands.push_back(std::make_unique<commandline::CommandlineCommandServe>(this));
+	m_commands.push_back(
+		std::make_unique<commandline::CommandlineCommandQueryLoadTest>(this));
 
 	for (auto& command: m_commands)
 	{
@@ -250,4 +257,52 @@ bool CommandLineParser::getShallowIndexingRequested() const
 	return m_shallowIndexingRequested;
 }
 
+void CommandLineParser::setIndexingBenchmarkOptions(const IndexingBenchmarkOptions& options)
+{
+	m_indexingBenchmarkOptions = options;
+	m_runIndexingBenchmark = true;
+}
+
+bool CommandLineParser::runIndexingBenchmark() const
+{
+	return m_runIndexingBenchmark;
+}
+
+const IndexingBenchmarkOptions& CommandLineParser::getIndexingBenchmarkOptions() const
+{
+	return m_indexingBenchmarkOptions;
+}
+
+void CommandLineParser::setQueryServerOptions(const QueryServerOptions& options)
+{
+	m_queryServerOptions = options;
+	m_runQueryServer = true;
+}
+
+bool CommandLineParser::runQueryServer() const
+{
+	return m_runQueryServer;
+}
+
+const QueryServerOptions& CommandLineParser::getQueryServerOptions() const
+{
+	return m_queryServerOptions;
+}
+
+void CommandLineParser::setQueryLoadTestOptions(const QueryLoadTestOptions& options)
+{
+	m_queryLoadTestOptions = options;
+	m_runQueryLoadTest = true;
+}
+
+bool CommandLineParser::runQueryLoadTest() const
+{
+	return m_runQueryLoadTest;
+}
+
+const QueryLoadTestOptions& CommandLineParser::getQueryLoadTestOptions() const
+{
+	return m_queryLoadTestOptions;
+}
+
 }	 // namespace commandline
@@ -16,6 +16,28 @@ namespace commandline
 {
 class CommandlineCommand;
 
+struct IndexingBenchmarkOptions
+{
+	size_t runCount = 0;
+	FilePath outputFilePath;
+	FilePath traceFilePath;
+};
+
+struct QueryServerOptions
+{
+	std::wstring socketName;
+	size_t workerCount = 0;
+	size_t maxPendingRequestCount = 0;
+};
+
+struct QueryLoadTestOptions
+{
+	std::wstring socketName;
+	FilePath requestsFilePath;
+	size_t connectionCount = 0;
+	size_t requestCount = 0;
+};
+
 class CommandLineParser
 {
 public:
@@ -42,6 +64,18 @@ public:
 	RefreshMode getRefreshMode() const;
 	bool getShallowIndexingRequested() const;
 
+	void setIndexingBenchmarkOptions(const IndexingBenchmarkOptions& options);
+	bool runIndexingBenchmark() const;
+	const IndexingBenchmarkOptions& getIndexingBenchmarkOptions() const;
+
+	void setQueryServerOptions(const QueryServerOptions& options);
+	bool runQueryServer() const;
+	const QueryServerOptions& getQueryServerOptions() const;
+
+	void setQueryLoadTestOptions(const QueryLoadTestOptions& options);
+	bool runQueryLoadTest() const;
+	const QueryLoadTestOptions& getQueryLoadTestOptions() const;
+
 private:
 	void processProjectfile();
 	void printHelp() const;
@@ -57,6 +91,13 @@ private:
 	RefreshMode m_refreshMode = REFRESH_UPDATED_FILES;
 	bool m_shallowIndexingRequested = false;
 
+	bool m_runIndexingBenchmark = false;
+	IndexingBenchmarkOptions m_indexingBenchmarkOptions;
+	bool m_runQueryServer = false;
+	QueryServerOptions m_queryServerOptions;
+	bool m_runQueryLoadTest = false;
+	QueryLoadTestOptions m_queryLoadTestOptions;
+
 	bool m_quit = false;
 	bool m_withoutGUI = false;
 
@@ -0,0 +1,91 @@
+#include "CommandlineCommandBenchmark.h"
+
+#include <iostream>
+
+#include "CommandLineParser.h"
+#include "CommandlineHelper.h"
+
+namespace po = boost::program_options;
+
+namespace commandline
+{
+CommandlineCommandBenchmark::CommandlineCommandBenchmark(CommandLineParser* parser)
+	: CommandlineCommand(
+		  "benchmark", "Index a certain project repeatedly and report the timings.", parser)
+{
+}
+
+CommandlineCommandBenchmark::~CommandlineCommandBenchmark() {}
+
+void CommandlineCommandBenchmark::setup()
+{
+	po::options_description options("Benchmark Options");
+	options.add_options()("help,h", "Print this help message")(
+		"runs,r",
+		po::value<int>()->default_value(3),
+		"Number of times the project gets indexed, the first run is cold, all others are warm")(
+		"full,f", "Index full project on each run (omit to only index new/changed files)")(
+		"output,o",
+		po::value<std::string>()->default_value("benchmark.json"),
+		"File the JSON report is written to")(
+		"trace,t",
+		po::value<std::string>(),
+		"Also record a trace of all runs and write it to this file in Chrome trace event format")(
+		"project-file", po::value<std::string>(), "Project file to index (.srctrlprj)");
+
+	m_options.add(options);
+	m_positional.add("project-file", 1);
+}
+
+CommandlineCommand::ReturnStatus CommandlineCommandBenchmark::parse(std::vector<std::string>& args)
+{
+	po::variables_map vm;
+	try
+	{
+		po::store(
+			po::command_line_parser(args).options(m_options).positional(m_positional).run(), vm);
+		po::notify(vm);
+
+		parseConfigFile(vm, m_options);
+	}
+	catch (po::error& e)
+	{
+		std::cerr << "ERROR: " << e.what() << std::endl << std::endl;
+		std::cerr << m_options << std::endl;
+		return ReturnStatus::CMD_FAILURE;
+	}
+
+	if (vm.count("help") || args.size() == 0 || args[0] == "help")
+	{
+		printHelp();
+		return ReturnStatus::CMD_QUIT;
+	}
+
+	if (!vm.count("project-file") || vm["runs"].as<int>() < 1)
+	{
+		std::cerr << "ERROR: A project file is required and runs need to be positive." << std::endl
+				  << std::endl;
+		std::cerr << m_options << std::endl;
+		return ReturnStatus::CMD_FAILURE;
+	}
+
+	if (vm.count("full"))
+	{
+		m_parser->fullRefresh();
+	}
+
+	IndexingBenchmarkOptions options;
+	options.runCount = vm["runs"].as<int>();
+	options.outputFilePath = FilePath(vm["output"].as<std::string>()).makeAbsolute();
+	if (vm.count("trace"))
+	{
+		options.traceFilePath = FilePath(vm["trace"].as<std::string>()).makeAbsolute();
+	}
+	m_parser->setIndexingBenchmarkOptions(options);
+
+	m_parser->setProjectFile(FilePath(vm["project-file"].as<std::string>()));
+
+	return ReturnStatus::CMD_OK;
+}
+
+}	 // namespace commandline
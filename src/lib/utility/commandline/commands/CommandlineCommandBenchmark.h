@@ -0,0 +1,25 @@
+#ifndef COMMANDLINE_COMMAND_BENCHMARK_H
+#define COMMANDLINE_COMMAND_BENCHMARK_H
+
+#include "CommandlineCommand.h"
+
+namespace commandline
+{
+class CommandlineCommandBenchmark: public CommandlineCommand
+{
+public:
+	CommandlineCommandBenchmark(CommandLineParser* parser);
+	virtual ~CommandlineCommandBenchmark();
+
+	virtual void setup();
+	virtual ReturnStatus parse(std::vector<std::string>& args);
+
+	virtual bool hasHelp() const
+	{
+		return true;
+	}
+};
+
+}	 // namespace commandline
+
+#endif	  // COMMANDLINE_COMMAND_BENCHMARK_H
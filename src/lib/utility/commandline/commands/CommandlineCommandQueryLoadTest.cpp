@@ -0,0 +1,91 @@
+#include "CommandlineCommandQueryLoadTest.h"
+
+#include <iostream>
+
+#include "CommandLineParser.h"
+#include "CommandlineHelper.h"
+#include "utilityString.h"
+
+namespace po = boost::program_options;
+
+namespace commandline
+{
+CommandlineCommandQueryLoadTest::CommandlineCommandQueryLoadTest(CommandLineParser* parser)
+	: CommandlineCommand(
+		  "query-load-test", "Send queries to a running server and report its throughput.", parser)
+{
+}
+
+CommandlineCommandQueryLoadTest::~CommandlineCommandQueryLoadTest() {}
+
+void CommandlineCommandQueryLoadTest::setup()
+{
+	po::options_description options("Query Load Test Options");
+	options.add_options()("help,h", "Print this help message")(
+		"socket,s", po::value<std::string>(), "Name or path of the local socket of the server")(
+		"connections,c",
+		po::value<int>()->default_value(4),
+		"Number of clients sending queries at the same time")(
+		"count,n", po::value<int>()->default_value(1000), "Total number of queries to send")(
+		"requests-file",
+		po::value<std::string>(),
+		"File with one query per line, like \"search<TAB>main\". The queries are sent in turn.");
+
+	m_options.add(options);
+	m_positional.add("requests-file", 1);
+}
+
+CommandlineCommand::ReturnStatus CommandlineCommandQueryLoadTest::parse(
+	std::vector<std::string>& args)
+{
+	po::variables_map vm;
+	try
+	{
+		po::store(
+			po::command_line_parser(args).options(m_options).positional(m_positional).run(), vm);
+		po::notify(vm);
+
+		parseConfigFile(vm, m_options);
+	}
+	catch (po::error& e)
+	{
+		std::cerr << "ERROR: " << e.what() << std::endl << std::endl;
+		std::cerr << m_options << std::endl;
+		return ReturnStatus::CMD_FAILURE;
+	}
+
+	if (vm.count("help") || args.size() == 0 || args[0] == "help")
+	{
+		printHelp();
+		return ReturnStatus::CMD_QUIT;
+	}
+
+	if (!vm.count("socket") || !vm.count("requests-file") || vm["connections"].as<int>() < 1 ||
+		vm["count"].as<int>() < 1)
+	{
+		std::cerr << "ERROR: A socket and a requests file are required, connections and count "
+					 "need to be positive."
+				  << std::endl
+				  << std::endl;
+		std::cerr << m_options << std::endl;
+		return ReturnStatus::CMD_FAILURE;
+	}
+
+	QueryLoadTestOptions options;
+	options.socketName = utility::decodeFromUtf8(vm["socket"].as<std::string>());
+	options.requestsFilePath = FilePath(vm["requests-file"].as<std::string>()).makeAbsolute();
+	options.connectionCount = vm["connections"].as<int>();
+	options.requestCount = vm["count"].as<int>();
+
+	if (!options.requestsFilePath.exists())
+	{
+		std::cerr << "ERROR: The requests file does not exist." << std::endl;
+		return ReturnStatus::CMD_FAILURE;
+	}
+
+	m_parser->setQueryLoadTestOptions(options);
+
+	return ReturnStatus::CMD_OK;
+}
+
+}	 // namespace commandline
@@ -0,0 +1,25 @@
+#ifndef COMMANDLINE_COMMAND_QUERY_LOAD_TEST_H
+#define COMMANDLINE_COMMAND_QUERY_LOAD_TEST_H
+
+#include "CommandlineCommand.h"
+
+namespace commandline
+{
+class CommandlineCommandQueryLoadTest: public CommandlineCommand
+{
+public:
+	CommandlineCommandQueryLoadTest(CommandLineParser* parser);
+	virtual ~CommandlineCommandQueryLoadTest();
+
+	virtual void setup();
+	virtual ReturnStatus parse(std::vector<std::string>& args);
+
+	virtual bool hasHelp() const
+	{
+		return true;
+	}
+};
+
+}	 // namespace commandline
+
+#endif	  // COMMANDLINE_COMMAND_QUERY_LOAD_TEST_H
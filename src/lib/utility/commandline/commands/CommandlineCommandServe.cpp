@@ -0,0 +1,90 @@
+#include "CommandlineCommandServe.h"
+
+#include <algorithm>
+#include <iostream>
+#include <thread>
+
+#include "CommandLineParser.h"
+#include "CommandlineHelper.h"
+#include "utilityString.h"
+
+namespace po = boost::program_options;
+
+namespace commandline
+{
+CommandlineCommandServe::CommandlineCommandServe(CommandLineParser* parser)
+	: CommandlineCommand(
+		  "serve", "Answer queries on the index of a project via a local socket.", parser)
+{
+}
+
+CommandlineCommandServe::~CommandlineCommandServe() {}
+
+void CommandlineCommandServe::setup()
+{
+	po::options_description options("Serve Options");
+	options.add_options()("help,h", "Print this help message")(
+		"socket,s",
+		po::value<std::string>(),
+		"Name or path of the local socket to listen on")(
+		"workers,w",
+		po::value<int>()->default_value(std::max<int>(std::thread::hardware_concurrency(), 1)),
+		"Number of threads answering queries")(
+		"queue,q",
+		po::value<int>()->default_value(256),
+		"Number of waiting queries before new ones get rejected")(
+		"project-file",
+		po::value<std::string>(),
+		"Project file of the index to serve (.srctrlprj)");
+
+	m_options.add(options);
+	m_positional.add("project-file", 1);
+}
+
+CommandlineCommand::ReturnStatus CommandlineCommandServe::parse(std::vector<std::string>& args)
+{
+	po::variables_map vm;
+	try
+	{
+		po::store(
+			po::command_line_parser(args).options(m_options).positional(m_positional).run(), vm);
+		po::notify(vm);
+
+		parseConfigFile(vm, m_options);
+	}
+	catch (po::error& e)
+	{
+		std::cerr << "ERROR: " << e.what() << std::endl << std::endl;
+		std::cerr << m_options << std::endl;
+		return ReturnStatus::CMD_FAILURE;
+	}
+
+	if (vm.count("help") || args.size() == 0 || args[0] == "help")
+	{
+		printHelp();
+		return ReturnStatus::CMD_QUIT;
+	}
+
+	if (!vm.count("socket") || !vm.count("project-file") || vm["workers"].as<int>() < 1 ||
+		vm["queue"].as<int>() < 1)
+	{
+		std::cerr << "ERROR: A socket and a project file are required, workers and queue need to "
+					 "be positive."
+				  << std::endl
+				  << std::endl;
+		std::cerr << m_options << std::endl;
+		return ReturnStatus::CMD_FAILURE;
+	}
+
+	QueryServerOptions options;
+	options.socketName = utility::decodeFromUtf8(vm["socket"].as<std::string>());
+	options.workerCount = vm["workers"].as<int>();
+	options.maxPendingRequestCount = vm["queue"].as<int>();
+	m_parser->setQueryServerOptions(options);
+
+	m_parser->setProjectFile(FilePath(vm["project-file"].as<std::string>()));
+
+	return ReturnStatus::CMD_OK;
+}
+
+}	 // namespace commandline
@@ -0,0 +1,352 @@
+#include "DirectoryCrawler.h"
+
+#include <algorithm>
+#include <iterator>
+#include <thread>
+#include <unordered_set>
+
+#include <boost/filesystem.hpp>
+
+#include "FilePathFilterMatcher.h"
+#include "FileSystem.h"
+#include "utilityString.h"
+
+DirectoryCrawler::DirectoryCrawler(
+	SymLinkMode symLinkMode,
+	const std::vector<std::wstring>& extensions,
+	bool caseSensitiveExtensions,
+	std::shared_ptr<const FilePathFilterMatcher> excludeFilterMatcher)
+	: m_symLinkMode(symLinkMode)
+	, m_caseSensitiveExtensions(caseSensitiveExtensions)
+	, m_excludeFilterMatcher(excludeFilterMatcher)
+	, m_resolveCanonicalPaths(false)
+	, m_busyWorkerCount(0)
+{
+	for (const std::wstring& extension: extensions)
+	{
+		m_extensions.insert(
+			m_caseSensitiveExtensions ? extension : utility::toLowerCase(extension));
+	}
+}
+
+std::vector<FilePath> DirectoryCrawler::getFilePaths(const std::vector<FilePath>& directoryPaths)
+{
+	m_resolveCanonicalPaths = false;
+
+	std::vector<std::unique_ptr<Directory>> roots;
+	for (const FilePath& directoryPath: directoryPaths)
+	{
+		if (directoryPath.isDirectory())
+		{
+			roots.push_back(std::make_unique<Directory>());
+			roots.back()->path = directoryPath.getPath();
+		}
+	}
+
+	crawl(roots);
+
+	std::vector<CrawledFile> files;
+	for (const std::unique_ptr<Directory>& root: roots)
+	{
+		collectFiles(*root, files);
+	}
+
+	std::vector<FilePath> filePaths;
+	filePaths.reserve(files.size());
+	for (const CrawledFile& file: files)
+	{
+		filePaths.push_back(FilePath(file.path.generic_wstring()));
+	}
+	return filePaths;
+}
+
+std::vector<FileInfo> DirectoryCrawler::getFileInfos(const std::vector<FilePath>& directoryPaths)
+{
+	m_resolveCanonicalPaths = true;
+
+	std::vector<std::unique_ptr<Directory>> roots;
+	for (const FilePath& directoryPath: directoryPaths)
+	{
+		if (!directoryPath.isDirectory())
+		{
+			continue;
+		}
+
+		boost::system::error_code ec;
+		boost::filesystem::path canonicalPath = boost::filesystem::canonical(
+			directoryPath.getPath(), ec);
+		if (ec || isExcludedDirectory(canonicalPath))
+		{
+			continue;
+		}
+
+		roots.push_back(std::make_unique<Directory>());
+		roots.back()->path = directoryPath.getPath();
+		roots.back()->canonicalPath = std::move(canonicalPath);
+	}
+
+	crawl(roots);
+
+	std::vector<CrawledFile> files;
+	for (const std::unique_ptr<Directory>& root: roots)
+	{
+		collectFiles(*root, files);
+	}
+
+	// files reached through symlinks or overlapping directories are only returned once
+	std::unordered_set<boost::filesystem::path::string_type> filePaths;
+	std::vector<FileInfo> fileInfos;
+	fileInfos.reserve(files.size());
+	for (const CrawledFile& file: files)
+	{
+		if (filePaths.insert(file.path.native()).second)
+		{
+			fileInfos.push_back(FileInfo(FilePath(file.path.wstring()), file.lastWriteTime));
+		}
+	}
+	return fileInfos;
+}
+
+size_t DirectoryCrawler::getThreadCount()
+{
+	// reading directories is mostly waiting for the file system, more threads don't help
+	return std::max(size_t(1), std::min(size_t(std::thread::hardware_concurrency()), size_t(8)));
+}
+
+void DirectoryCrawler::crawl(const std::vector<std::unique_ptr<Directory>>& roots)
+{
+	m_symLinkedDirectories.clear();
+	m_workerException = nullptr;
+	for (const std::unique_ptr<Directory>& root: roots)
+	{
+		m_pendingDirectories.push_back(root.get());
+	}
+
+	std::vector<std::thread> threads;
+	for (size_t i = 1; i < getThreadCount(); i++)
+	{
+		threads.emplace_back(&DirectoryCrawler::runWorker, this);
+	}
+
+	runWorker();
+
+	for (std::thread& thread: threads)
+	{
+		thread.join();
+	}
+
+	if (m_workerException)
+	{
+		std::rethrow_exception(m_workerException);
+	}
+}
+
+void DirectoryCrawler::runWorker()
+{
+	std::unique_lock<std::mutex> lock(m_pendingDirectoriesMutex);
+	while (true)
+	{
+		m_pendingDirectoriesCondition.wait(
+			lock, [this]() { return !m_pendingDirectories.empty() || m_busyWorkerCount == 0; });
+
+		// no directory is left and no other worker can add one anymore
+		if (m_pendingDirectories.empty())
+		{
+			return;
+		}
+
+		Directory* directory = m_pendingDirectories.back();
+		m_pendingDirectories.pop_back();
+		m_busyWorkerCount++;
+
+		lock.unlock();
+		try
+		{
+			crawlDirectory(*directory);
+			lock.lock();
+		}
+		catch (...)
+		{
+			// the crawl is abandoned, the other workers finish their directories and stop
+			lock.lock();
+			if (!m_workerException)
+			{
+				m_workerException = std::current_exception();
+			}
+			m_pendingDirectories.clear();
+		}
+
+		m_busyWorkerCount--;
+		if (m_pendingDirectories.empty() && m_busyWorkerCount == 0)
+		{
+			m_pendingDirectoriesCondition.notify_all();
+		}
+	}
+}
+
+void DirectoryCrawler::crawlDirectory(Directory& directory)
+{
+	std::vector<std::unique_ptr<Directory>> subDirectories;
+
+	boost::system::error_code ec;
+	boost::filesystem::directory_iterator it(directory.path, ec);
+	for (; !ec && it != boost::filesystem::directory_iterator(); it.increment(ec))
+	{
+		const boost::filesystem::path& path = it->path();
+
+		// the type of the entry is taken from the directory listing if the platform reports it
+		boost::system::error_code statusEc;
+		const boost::filesystem::file_status status = it->symlink_status(statusEc);
+
+		if (boost::filesystem::is_symlink(status))
+		{
+			if (m_symLinkMode == SYMLINKS_IGNORED)
+			{
+				continue;
+			}
+
+			// check for self-referencing symlinks
+			const boost::filesystem::path target = boost::filesystem::read_symlink(path, statusEc);
+			if (target.filename() == target.string() && target.filename() == path.filename())
+			{
+				continue;
+			}
+
+			const boost::filesystem::file_status targetStatus = it->status(statusEc);
+			if (boost::filesystem::is_directory(targetStatus))
+			{
+				if (m_symLinkMode != SYMLINKS_FOLLOWED)
+				{
+					continue;
+				}
+
+				// check for duplicates when following directory symlinks
+				boost::filesystem::path canonicalPath = boost::filesystem::canonical(
+					target, directory.path, statusEc);
+				if (statusEc || !addSymLinkedDirectory(canonicalPath) ||
+					isExcludedDirectory(canonicalPath))
+				{
+					continue;
+				}
+
+				subDirectories.push_back(std::make_unique<Directory>());
+				subDirectories.back()->path = path;
+				subDirectories.back()->canonicalPath = std::move(canonicalPath);
+			}
+			else if (boost::filesystem::is_regular_file(targetStatus) && hasExtension(path))
+			{
+				boost::filesystem::path canonicalPath;
+				if (m_resolveCanonicalPaths)
+				{
+					canonicalPath = boost::filesystem::canonical(path, statusEc);
+					if (statusEc)
+					{
+						canonicalPath = path;
+					}
+				}
+				addFile(directory, path, canonicalPath);
+			}
+		}
+		else if (boost::filesystem::is_directory(status))
+		{
+			boost::filesystem::path canonicalPath;
+			if (m_resolveCanonicalPaths)
+			{
+				canonicalPath = directory.canonicalPath / path.filename();
+				if (isExcludedDirectory(canonicalPath))
+				{
+					continue;
+				}
+			}
+
+			subDirectories.push_back(std::make_unique<Directory>());
+			subDirectories.back()->path = path;
+			subDirectories.back()->canonicalPath = std::move(canonicalPath);
+		}
+		else if (boost::filesystem::is_regular_file(status) && hasExtension(path))
+		{
+			addFile(
+				directory,
+				path,
+				m_resolveCanonicalPaths ? directory.canonicalPath / path.filename()
+										: boost::filesystem::path());
+		}
+	}
+
+	std::sort(
+		directory.files.begin(),
+		directory.files.end(),
+		[](const CrawledFile& a, const CrawledFile& b) {
+			return a.path.native() < b.path.native();
+		});
+	std::sort(
+		subDirectories.begin(),
+		subDirectories.end(),
+		[](const std::unique_ptr<Directory>& a, const std::unique_ptr<Directory>& b) {
+			return a->path.native() < b->path.native();
+		});
+
+	// the sub directories are owned by their parent before other workers can pick them up
+	directory.subDirectories = std::move(subDirectories);
+	if (!directory.subDirectories.empty())
+	{
+		std::lock_guard<std::mutex> lock(m_pendingDirectoriesMutex);
+		for (const std::unique_ptr<Directory>& subDirectory: directory.subDirectories)
+		{
+			m_pendingDirectories.push_back(subDirectory.get());
+		}
+		m_pendingDirectoriesCondition.notify_all();
+	}
+}
+
+bool DirectoryCrawler::hasExtension(const boost::filesystem::path& path) const
+{
+	if (m_extensions.empty())
+	{
+		return true;
+	}
+
+	const std::wstring extension = path.extension().wstring();
+	return m_extensions.find(
+			   m_caseSensitiveExtensions ? extension : utility::toLowerCase(extension)) !=
+		m_extensions.end();
+}
+
+bool DirectoryCrawler::isExcludedDirectory(const boost::filesystem::path& canonicalPath) const
+{
+	return m_excludeFilterMatcher &&
+		m_excludeFilterMatcher->isMatchingAllFilesInDirectory(FilePath(canonicalPath.wstring()));
+}
+
+bool DirectoryCrawler::addSymLinkedDirectory(const boost::filesystem::path& canonicalPath)
+{
+	std::lock_guard<std::mutex> lock(m_symLinkedDirectoriesMutex);
+	return m_symLinkedDirectories.insert(canonicalPath).second;
+}
+
+void DirectoryCrawler::addFile(
+	Directory& directory,
+	const boost::filesystem::path& path,
+	const boost::filesystem::path& canonicalPath) const
+{
+	CrawledFile file;
+	if (m_resolveCanonicalPaths)
+	{
+		file.path = canonicalPath;
+		file.lastWriteTime = FileSystem::getLastWriteTime(FilePath(canonicalPath.wstring()));
+	}
+	else
+	{
+		file.path = path;
+	}
+	directory.files.push_back(std::move(file));
+}
+
+void DirectoryCrawler::collectFiles(Directory& directory, std::vector<CrawledFile>& files) const
+{
+	std::move(directory.files.begin(), directory.files.end(), std::back_inserter(files));
+	for (const std::unique_ptr<Directory>& subDirectory: directory.subDirectories)
+	{
+		collectFiles(*subDirectory, files);
+	}
+}
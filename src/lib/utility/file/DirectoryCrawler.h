@@ -0,0 +1,96 @@
+#ifndef DIRECTORY_CRAWLER_H
+#define DIRECTORY_CRAWLER_H
+
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem/path.hpp>
+
+#include "FileInfo.h"
+#include "FilePath.h"
+#include "TimeStamp.h"
+
+class FilePathFilterMatcher;
+
+// Collects the files below a set of directories. Directories are read by several threads at once
+// and the file types reported by the directory listing are used, so only symlinks and collected
+// files need additional file system calls. Files are returned in depth first order, the files of
+// a directory come before the files of its sub directories and both are sorted by name. Errors
+// reading a directory or file skip it, other exceptions of the workers are rethrown by the calling
+// thread once all workers are done.
+class DirectoryCrawler
+{
+public:
+	enum SymLinkMode
+	{
+		SYMLINKS_IGNORED,
+		SYMLINKED_FILES_FOLLOWED,	 // symlinked directories are not entered
+		SYMLINKS_FOLLOWED	 // each symlinked directory is entered once
+	};
+
+	DirectoryCrawler(
+		SymLinkMode symLinkMode,
+		const std::vector<std::wstring>& extensions,
+		bool caseSensitiveExtensions,
+		std::shared_ptr<const FilePathFilterMatcher> excludeFilterMatcher = nullptr);
+
+	// paths of the files as found below the directories
+	std::vector<FilePath> getFilePaths(const std::vector<FilePath>& directoryPaths);
+
+	// canonical paths and write times of the files, without duplicates. Directories whose files
+	// are all matched by the exclude filters are skipped.
+	std::vector<FileInfo> getFileInfos(const std::vector<FilePath>& directoryPaths);
+
+private:
+	struct CrawledFile
+	{
+		boost::filesystem::path path;	 // canonical if canonical paths are resolved
+		TimeStamp lastWriteTime;
+	};
+
+	struct Directory
+	{
+		boost::filesystem::path path;
+		boost::filesystem::path canonicalPath;
+		std::vector<CrawledFile> files;
+		std::vector<std::unique_ptr<Directory>> subDirectories;
+	};
+
+	static size_t getThreadCount();
+
+	void crawl(const std::vector<std::unique_ptr<Directory>>& roots);
+	void runWorker();
+	void crawlDirectory(Directory& directory);
+	bool hasExtension(const boost::filesystem::path& path) const;
+	bool isExcludedDirectory(const boost::filesystem::path& canonicalPath) const;
+	bool addSymLinkedDirectory(const boost::filesystem::path& canonicalPath);
+	void addFile(
+		Directory& directory,
+		const boost::filesystem::path& path,
+		const boost::filesystem::path& canonicalPath) const;
+
+	void collectFiles(Directory& directory, std::vector<CrawledFile>& files) const;
+
+	const SymLinkMode m_symLinkMode;
+	std::set<std::wstring> m_extensions;
+	const bool m_caseSensitiveExtensions;
+	const std::shared_ptr<const FilePathFilterMatcher> m_excludeFilterMatcher;
+
+	bool m_resolveCanonicalPaths;
+
+	std::mutex m_pendingDirectoriesMutex;
+	std::condition_variable m_pendingDirectoriesCondition;
+	std::vector<Directory*> m_pendingDirectories;
+	size_t m_busyWorkerCount;
+	std::exception_ptr m_workerException;
+
+	std::mutex m_symLinkedDirectoriesMutex;
+	std::set<boost::filesystem::path> m_symLinkedDirectories;
+};
+
+#endif	  // DIRECTORY_CRAWLER_H
@@ -4,6 +4,7 @@
 
 #include "FilePath.h"
 #include "FilePathFilter.h"
+#include "FilePathFilterMatcher.h"
 #include "FileSystem.h"
 
 FileManager::FileManager() {}
@@ -16,13 +17,14 @@ void FileManager::update(
 	const std::vector<std::wstring>& sourceExtensions)
 {
 	m_sourcePaths = sourcePaths;
-	m_excludeFilters = excludeFilters;
+	m_excludeFilterMatcher = std::make_shared<FilePathFilterMatcher>(excludeFilters);
 	m_sourceExtensions = sourceExtensions;
 
 	m_allSourceFilePaths.clear();
 
 	for (const FileInfo& fileInfo:
-		 FileSystem::getFileInfosFromPaths(m_sourcePaths, m_sourceExtensions))
+		 FileSystem::getFileInfosFromPaths(
+			 m_sourcePaths, m_sourceExtensions, true, m_excludeFilterMatcher))
 	{
 		const FilePath& filePath = fileInfo.path;
 		if (isExcluded(filePath))
@@ -56,5 +58,5 @@ std::set<FilePath> FileManager::getAllSourceFilePaths() const
 
 bool FileManager::isExcluded(const FilePath& filePath) const
 {
-	return FilePathFilter::areMatching(m_excludeFilters, filePath);
+	return m_excludeFilterMatcher && m_excludeFilterMatcher->isMatching(filePath);
 }
@@ -2,12 +2,14 @@
 #define FILE_MANAGER_H
 
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
 
 class FilePath;
 class FilePathFilter;
+class FilePathFilterMatcher;
 
 class FileManager
 {
@@ -33,7 +35,7 @@ private:
 	bool isExcluded(const FilePath& filePath) const;
 
 	std::vector<FilePath> m_sourcePaths;
-	std::vector<FilePathFilter> m_excludeFilters;
+	std::shared_ptr<FilePathFilterMatcher> m_excludeFilterMatcher;
 	std::vector<std::wstring> m_sourceExtensions;
 
 	std::set<FilePath> m_allSourceFilePaths;
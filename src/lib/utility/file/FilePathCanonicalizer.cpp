@@ -0,0 +1,81 @@
+#include "FilePathCanonicalizer.h"
+
+#include <iterator>
+
+#include <boost/filesystem/path.hpp>
+
+#include "utilityString.h"
+
+std::shared_ptr<FilePathCanonicalizer> FilePathCanonicalizer::getInstance()
+{
+	// indexer threads query the instance concurrently, so it is created on first use in a
+	// thread safe way
+	static std::shared_ptr<FilePathCanonicalizer> s_instance(new FilePathCanonicalizer());
+	return s_instance;
+}
+
+FilePath FilePathCanonicalizer::getCachedCanonicalFilePath(
+	const std::wstring& path, size_t* fileSystemCallCount) const
+{
+	const std::wstring key = getCacheKey(path);
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	auto it = m_canonicalPaths.find(key);
+	if (it != m_canonicalPaths.end())
+	{
+		if (fileSystemCallCount)
+		{
+			*fileSystemCallCount += it->second.fileSystemCallCount;
+		}
+		return it->second.canonicalPath;
+	}
+	return FilePath();
+}
+
+FilePath FilePathCanonicalizer::resolveCanonicalFilePath(const std::wstring& path)
+{
+	// resolved without holding the lock, other threads may resolve the same path meanwhile
+	FilePath filePath(path);
+	const bool exists = filePath.exists();
+	const FilePath canonicalPath = filePath.makeCanonical();
+
+	// one call checks that the path exists, resolving symlinks checks each component once
+	size_t fileSystemCallCount = 1;
+	if (exists)
+	{
+		const boost::filesystem::path components = canonicalPath.getPath();
+		fileSystemCallCount += std::distance(components.begin(), components.end());
+	}
+
+	std::wstring key = getCacheKey(path);
+	std::wstring canonicalKey = getCacheKey(canonicalPath.wstr());
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_canonicalPaths.emplace(std::move(key), CachedPath {canonicalPath, fileSystemCallCount});
+	m_canonicalPaths.emplace(
+		std::move(canonicalKey), CachedPath {canonicalPath, fileSystemCallCount});
+	return canonicalPath;
+}
+
+size_t FilePathCanonicalizer::getCachedPathCount() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_canonicalPaths.size();
+}
+
+void FilePathCanonicalizer::clear()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_canonicalPaths.clear();
+}
+
+std::wstring FilePathCanonicalizer::getCacheKey(const std::wstring& path)
+{
+#if defined(_WIN32) || defined(__APPLE__)
+	return utility::toLowerCase(path);
+#else
+	return path;
+#endif
+}
+
+FilePathCanonicalizer::FilePathCanonicalizer() {}
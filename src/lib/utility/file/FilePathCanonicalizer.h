@@ -0,0 +1,49 @@
+#ifndef FILE_PATH_CANONICALIZER_H
+#define FILE_PATH_CANONICALIZER_H
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "FilePath.h"
+
+// Process wide cache of canonical file paths. Resolving a path touches the file system for every
+// path component, so translation units indexed by the same process share the resolved paths of
+// the headers they have in common. Paths are looked up case insensitively on Windows and macOS,
+// where file systems usually ignore case.
+class FilePathCanonicalizer
+{
+public:
+	static std::shared_ptr<FilePathCanonicalizer> getInstance();
+
+	// returns an empty path if the path was not resolved yet, otherwise the number of file system
+	// calls that resolving the path took is added to fileSystemCallCount
+	FilePath getCachedCanonicalFilePath(
+		const std::wstring& path, size_t* fileSystemCallCount = nullptr) const;
+
+	// resolves the path on the file system and caches the result
+	FilePath resolveCanonicalFilePath(const std::wstring& path);
+
+	size_t getCachedPathCount() const;
+
+	void clear();
+
+private:
+	struct CachedPath
+	{
+		FilePath canonicalPath;
+		size_t fileSystemCallCount;
+	};
+
+	static std::wstring getCacheKey(const std::wstring& path);
+
+	FilePathCanonicalizer();
+	FilePathCanonicalizer(const FilePathCanonicalizer&) = delete;
+	void operator=(const FilePathCanonicalizer&) = delete;
+
+	mutable std::mutex m_mutex;
+	std::unordered_map<std::wstring, CachedPath> m_canonicalPaths;
+};
+
+#endif	  // FILE_PATH_CANONICALIZER_H
@@ -1,7 +1,7 @@
 #include "FilePathFilter.h"
 
 FilePathFilter::FilePathFilter(const std::wstring& filterString)
-	: m_filterString(filterString), m_filterRegex(convertFilterStringToRegex(filterString))
+	: m_filterString(filterString), m_filterRegex(std::make_shared<FilterRegex>())
 {
 }
 
@@ -17,7 +17,7 @@ bool FilePathFilter::isMatching(const FilePath& filePath) const
 
 bool FilePathFilter::isMatching(const std::wstring& fileStr) const
 {
-	return std::regex_match(fileStr, m_filterRegex);
+	return std::regex_match(fileStr, getFilterRegex());
 }
 
 bool FilePathFilter::operator<(const FilePathFilter& other) const
@@ -25,6 +25,14 @@ bool FilePathFilter::operator<(const FilePathFilter& other) const
 	return m_filterString.compare(other.m_filterString) < 0;
 }
 
+const std::wregex& FilePathFilter::getFilterRegex() const
+{
+	std::call_once(m_filterRegex->compiled, [this]() {
+		m_filterRegex->regex = convertFilterStringToRegex(m_filterString);
+	});
+	return m_filterRegex->regex;
+}
+
 std::wregex FilePathFilter::convertFilterStringToRegex(const std::wstring& filterString)
 {
 	std::wstring regexFilterString = filterString;
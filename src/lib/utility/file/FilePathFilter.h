@@ -1,6 +1,8 @@
 #ifndef FILE_PATH_FILTER_H
 #define FILE_PATH_FILTER_H
 
+#include <memory>
+#include <mutex>
 #include <regex>
 #include <string>
 
@@ -9,9 +11,6 @@
 class FilePathFilter
 {
 public:
-	template<typename ContainerType>
-	static bool areMatching(const ContainerType& filters, const FilePath& filePath);
-
 	explicit FilePathFilter(const std::wstring& filterString);
 
 	std::wstring wstr() const;
@@ -22,26 +21,19 @@ public:
 	bool operator<(const FilePathFilter& other) const;
 
 private:
+	// compiled on first use, filters matched with a FilePathFilterMatcher mostly never need it
+	struct FilterRegex
+	{
+		std::once_flag compiled;
+		std::wregex regex;
+	};
+
 	static std::wregex convertFilterStringToRegex(const std::wstring& filterString);
 
+	const std::wregex& getFilterRegex() const;
+
 	std::wstring m_filterString;
-	std::wregex m_filterRegex;
+	std::shared_ptr<FilterRegex> m_filterRegex;
 };
 
-template<typename ContainerType>
-bool FilePathFilter::areMatching(const ContainerType& filters, const FilePath& filePath)
-{
-	const std::wstring fileStr = filePath.wstr();
-
-	for (const FilePathFilter& filter: filters)
-	{
-		if (filter.isMatching(fileStr))
-		{
-			return true;
-		}
-	}
-
-	return false;
-}
-
 #endif	  // FILE_PATH_FILTER_H
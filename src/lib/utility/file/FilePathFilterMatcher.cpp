@@ -0,0 +1,209 @@
+#include "FilePathFilterMatcher.h"
+
+#include <algorithm>
+
+bool FilePathFilterMatcher::isMatching(const FilePath& filePath) const
+{
+	return isMatching(filePath.wstr());
+}
+
+bool FilePathFilterMatcher::isMatching(const std::wstring& fileStr) const
+{
+	if (m_nodes.size() > 1)
+	{
+		for (uint32_t nodeId: getStates(fileStr))
+		{
+			if (m_nodes[nodeId].accepting)
+			{
+				return true;
+			}
+		}
+	}
+
+	for (const FilePathFilter& filter: m_uncompiledFilters)
+	{
+		if (filter.isMatching(fileStr))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool FilePathFilterMatcher::isMatchingAllFilesInDirectory(const FilePath& directoryPath) const
+{
+	if (m_nodes.size() > 1)
+	{
+		// a trailing double star that is reached after the separator matches any remaining path
+		for (uint32_t nodeId: getStates(directoryPath.wstr() + L'/'))
+		{
+			if (m_nodes[nodeId].accepting && m_nodes[nodeId].kind == NODE_DOUBLE_STAR)
+			{
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+bool FilePathFilterMatcher::isCompilable(const std::wstring& filterString)
+{
+	// these are not escaped when converting the filter to a regex and keep their regex meaning
+	return filterString.find_first_of(L"?|") == std::wstring::npos;
+}
+
+bool FilePathFilterMatcher::isSeparator(wchar_t c)
+{
+	return c == L'/' || c == L'\\';
+}
+
+void FilePathFilterMatcher::addFilter(const FilePathFilter& filter)
+{
+	const std::wstring filterString = filter.wstr();
+	if (!isCompilable(filterString))
+	{
+		m_uncompiledFilters.push_back(filter);
+		return;
+	}
+
+	uint32_t nodeId = 0;
+	for (size_t i = 0; i < filterString.size(); i++)
+	{
+		const wchar_t c = filterString[i];
+		if (c == L'*')
+		{
+			if (i + 1 < filterString.size() && filterString[i + 1] == L'*')
+			{
+				nodeId = addChild(nodeId, NODE_DOUBLE_STAR, 0);
+				i++;
+			}
+			else
+			{
+				nodeId = addChild(nodeId, NODE_STAR, 0);
+			}
+		}
+		else if (isSeparator(c))
+		{
+			nodeId = addChild(nodeId, NODE_SEPARATOR, 0);
+		}
+		else
+		{
+			nodeId = addChild(nodeId, NODE_LITERAL, c);
+		}
+	}
+
+	m_nodes[nodeId].accepting = true;
+}
+
+uint32_t FilePathFilterMatcher::addChild(uint32_t nodeId, NodeKind kind, wchar_t c)
+{
+	const uint32_t childId = static_cast<uint32_t>(m_nodes.size());
+
+	switch (kind)
+	{
+	case NODE_LITERAL:
+	{
+		std::vector<std::pair<wchar_t, uint32_t>>& children = m_nodes[nodeId].literalChildren;
+		auto it = std::lower_bound(
+			children.begin(), children.end(), std::make_pair(c, uint32_t(0)));
+		if (it != children.end() && it->first == c)
+		{
+			return it->second;
+		}
+		children.insert(it, std::make_pair(c, childId));
+		break;
+	}
+	case NODE_SEPARATOR:
+		if (m_nodes[nodeId].separatorChild)
+		{
+			return m_nodes[nodeId].separatorChild;
+		}
+		m_nodes[nodeId].separatorChild = childId;
+		break;
+	case NODE_STAR:
+		if (m_nodes[nodeId].starChild)
+		{
+			return m_nodes[nodeId].starChild;
+		}
+		m_nodes[nodeId].starChild = childId;
+		break;
+	case NODE_DOUBLE_STAR:
+		if (m_nodes[nodeId].doubleStarChild)
+		{
+			return m_nodes[nodeId].doubleStarChild;
+		}
+		m_nodes[nodeId].doubleStarChild = childId;
+		break;
+	}
+
+	m_nodes.push_back(Node {kind, false, {}, 0, 0, 0});
+	return childId;
+}
+
+std::vector<uint32_t> FilePathFilterMatcher::getStates(const std::wstring& fileStr) const
+{
+	std::vector<uint32_t> states;
+	std::vector<uint32_t> nextStates;
+	addState(0, states);
+
+	for (size_t i = 0; i < fileStr.size() && !states.empty(); i++)
+	{
+		const wchar_t c = fileStr[i];
+		const bool separator = isSeparator(c);
+
+		nextStates.clear();
+		for (uint32_t nodeId: states)
+		{
+			const Node& node = m_nodes[nodeId];
+
+			if ((node.kind == NODE_STAR && !separator) || node.kind == NODE_DOUBLE_STAR)
+			{
+				addState(nodeId, nextStates);
+			}
+
+			if (separator)
+			{
+				if (node.separatorChild)
+				{
+					addState(node.separatorChild, nextStates);
+				}
+			}
+			else
+			{
+				auto it = std::lower_bound(
+					node.literalChildren.begin(),
+					node.literalChildren.end(),
+					std::make_pair(c, uint32_t(0)));
+				if (it != node.literalChildren.end() && it->first == c)
+				{
+					addState(it->second, nextStates);
+				}
+			}
+		}
+
+		// a node can be reached by its own wildcard and by its parent at the same time
+		std::sort(nextStates.begin(), nextStates.end());
+		nextStates.erase(std::unique(nextStates.begin(), nextStates.end()), nextStates.end());
+		states.swap(nextStates);
+	}
+
+	return states;
+}
+
+void FilePathFilterMatcher::addState(uint32_t nodeId, std::vector<uint32_t>& states) const
+{
+	states.push_back(nodeId);
+
+	// wildcards may match nothing, so the nodes following them are reached right away
+	const Node& node = m_nodes[nodeId];
+	if (node.starChild)
+	{
+		addState(node.starChild, states);
+	}
+	if (node.doubleStarChild)
+	{
+		addState(node.doubleStarChild, states);
+	}
+}
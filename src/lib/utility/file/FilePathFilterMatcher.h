@@ -0,0 +1,70 @@
+#ifndef FILE_PATH_FILTER_MATCHER_H
+#define FILE_PATH_FILTER_MATCHER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "FilePath.h"
+#include "FilePathFilter.h"
+
+// Matches a path against many FilePathFilters in a single pass. All filters are compiled into one
+// trie of literal characters, separators and wildcards, so filters sharing a prefix are checked
+// once and a path is rejected as soon as no filter can match anymore. Filters using regex syntax
+// that has no wildcard equivalent fall back to the regex of the FilePathFilter.
+class FilePathFilterMatcher
+{
+public:
+	template <typename ContainerType>
+	explicit FilePathFilterMatcher(const ContainerType& filters);
+
+	bool isMatching(const FilePath& filePath) const;
+	bool isMatching(const std::wstring& fileStr) const;
+
+	// true if every file below the directory is matched, so the directory does not need to be
+	// searched at all. Filters that are not compiled are not considered.
+	bool isMatchingAllFilesInDirectory(const FilePath& directoryPath) const;
+
+private:
+	enum NodeKind
+	{
+		NODE_LITERAL,
+		NODE_SEPARATOR,
+		NODE_STAR,	  // any characters except separators
+		NODE_DOUBLE_STAR	// any characters
+	};
+
+	struct Node
+	{
+		NodeKind kind;
+		bool accepting;
+		std::vector<std::pair<wchar_t, uint32_t>> literalChildren;
+		uint32_t separatorChild;
+		uint32_t starChild;
+		uint32_t doubleStarChild;
+	};
+
+	static bool isCompilable(const std::wstring& filterString);
+	static bool isSeparator(wchar_t c);
+
+	void addFilter(const FilePathFilter& filter);
+	uint32_t addChild(uint32_t nodeId, NodeKind kind, wchar_t c);
+	// all nodes reached after matching the string
+	std::vector<uint32_t> getStates(const std::wstring& fileStr) const;
+	void addState(uint32_t nodeId, std::vector<uint32_t>& states) const;
+
+	std::vector<Node> m_nodes;
+	std::vector<FilePathFilter> m_uncompiledFilters;
+};
+
+template <typename ContainerType>
+FilePathFilterMatcher::FilePathFilterMatcher(const ContainerType& filters)
+	: m_nodes(1, Node {NODE_LITERAL, false, {}, 0, 0, 0})
+{
+	for (const FilePathFilter& filter: filters)
+	{
+		addFilter(filter);
+	}
+}
+
+#endif	  // FILE_PATH_FILTER_MATCHER_H
@@ -1,59 +1,166 @@
 #include "FileRegister.h"
 
+#include <boost/filesystem/path.hpp>
+
 #include "FilePath.h"
 #include "FilePathFilter.h"
 
+std::mutex FileRegister::s_sharedStatesMutex;
+std::map<std::wstring, std::shared_ptr<FileRegister::SharedState>> FileRegister::s_sharedStates;
+
+void FileRegister::clearSharedState()
+{
+	std::lock_guard<std::mutex> lock(s_sharedStatesMutex);
+	s_sharedStates.clear();
+}
+
 FileRegister::FileRegister(
 	const FilePath& currentPath,
 	const std::set<FilePath>& indexedPaths,
 	const std::set<FilePathFilter>& excludeFilters)
 	: m_currentPath(currentPath)
-	, m_indexedPaths(indexedPaths)
-	, m_excludeFilters(excludeFilters)
-	, m_hasFilePathCache([&](const std::wstring& f) {
-		const FilePath filePath(f);
-		bool ret = false;
+	, m_sharedState(getSharedState(indexedPaths, excludeFilters))
+	, m_hasCurrentPath(!m_sharedState->isExcluded(currentPath))
+{
+}
+
+FileRegister::~FileRegister() {}
+
+bool FileRegister::hasFilePath(const FilePath& filePath) const
+{
+	// the current path differs between translation units, so it is not part of the shared state
+	if (filePath == m_currentPath)
+	{
+		return m_hasCurrentPath;
+	}
+
+	return m_sharedState->hasFilePath(filePath);
+}
+
+std::shared_ptr<FileRegister::SharedState> FileRegister::getSharedState(
+	const std::set<FilePath>& indexedPaths, const std::set<FilePathFilter>& excludeFilters)
+{
+	std::wstring key;
+	for (const FilePath& indexedPath: indexedPaths)
+	{
+		key += indexedPath.wstr() + L'\n';
+	}
+	key += L'\n';
+	for (const FilePathFilter& excludeFilter: excludeFilters)
+	{
+		key += excludeFilter.wstr() + L'\n';
+	}
+
+	std::lock_guard<std::mutex> lock(s_sharedStatesMutex);
+
+	auto it = s_sharedStates.find(key);
+	if (it != s_sharedStates.end())
+	{
+		return it->second;
+	}
+
+	// a process usually indexes a single source group at a time, so old states are rarely reused
+	if (s_sharedStates.size() >= 8)
+	{
+		s_sharedStates.clear();
+	}
+
+	std::shared_ptr<SharedState> sharedState = std::make_shared<SharedState>(
+		indexedPaths, excludeFilters);
+	s_sharedStates.emplace(std::move(key), sharedState);
+	return sharedState;
+}
+
+FileRegister::SharedState::SharedState(
+	const std::set<FilePath>& indexedPaths, const std::set<FilePathFilter>& excludeFilters)
+	: m_indexedPathNodes(1, IndexedPathNode {{}, false, false})
+	, m_excludeFilterMatcher(excludeFilters)
+{
+	for (const FilePath& indexedPath: indexedPaths)
+	{
+		addIndexedPath(indexedPath);
+	}
+}
+
+bool FileRegister::SharedState::isExcluded(const FilePath& filePath) const
+{
+	return m_excludeFilterMatcher.isMatching(filePath);
+}
 
-		if (filePath == m_currentPath)
+bool FileRegister::SharedState::hasFilePath(const FilePath& filePath)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_hasFilePathMutex);
+		auto it = m_hasFilePathCache.find(filePath.wstr());
+		if (it != m_hasFilePathCache.end())
 		{
-			ret = true;
+			return it->second;
 		}
+	}
+
+	// the trie and the matcher are not modified after construction, so no lock is needed here
+	const bool ret = isInIndexedPaths(filePath) && !isExcluded(filePath);
 
-		if (!ret)
+	std::lock_guard<std::mutex> lock(m_hasFilePathMutex);
+	m_hasFilePathCache.emplace(filePath.wstr(), ret);
+	return ret;
+}
+
+void FileRegister::SharedState::addIndexedPath(const FilePath& indexedPath)
+{
+	const bool isDirectory = indexedPath.isDirectory();
+
+	boost::filesystem::path path = indexedPath.getPath();
+	if (isDirectory && path.filename() == ".")
+	{
+		path.remove_filename();
+	}
+
+	size_t nodeIndex = 0;
+	for (const boost::filesystem::path& component: path)
+	{
+		auto it = m_indexedPathNodes[nodeIndex].children.find(component.wstring());
+		if (it != m_indexedPathNodes[nodeIndex].children.end())
 		{
-			for (const FilePath& indexedPath: m_indexedPaths)
-			{
-				if (indexedPath.isDirectory())
-				{
-					if (indexedPath.contains(filePath))
-					{
-						ret = true;
-						break;
-					}
-				}
-				else
-				{
-					if (indexedPath == filePath)
-					{
-						ret = true;
-						break;
-					}
-				}
-			}
+			nodeIndex = it->second;
 		}
-
-		if (ret)
+		else
 		{
-			ret = !FilePathFilter::areMatching(m_excludeFilters, filePath);
+			const size_t childIndex = m_indexedPathNodes.size();
+			m_indexedPathNodes[nodeIndex].children.emplace(component.wstring(), childIndex);
+			m_indexedPathNodes.push_back(IndexedPathNode {{}, false, false});
+			nodeIndex = childIndex;
 		}
-		return ret;
-	})
-{
-}
+	}
 
-FileRegister::~FileRegister() {}
+	if (isDirectory)
+	{
+		m_indexedPathNodes[nodeIndex].isIndexedDirectory = true;
+	}
+	else
+	{
+		m_indexedPathNodes[nodeIndex].isIndexedFile = true;
+	}
+}
 
-bool FileRegister::hasFilePath(const FilePath& filePath) const
+bool FileRegister::SharedState::isInIndexedPaths(const FilePath& filePath) const
 {
-	return m_hasFilePathCache.getValue(filePath.wstr());
+	// walks down the trie, the file is contained by any indexed directory passed on the way
+	size_t nodeIndex = 0;
+	for (const boost::filesystem::path& component: filePath.getPath())
+	{
+		auto it = m_indexedPathNodes[nodeIndex].children.find(component.wstring());
+		if (it == m_indexedPathNodes[nodeIndex].children.end())
+		{
+			return false;
+		}
+
+		nodeIndex = it->second;
+		if (m_indexedPathNodes[nodeIndex].isIndexedDirectory)
+		{
+			return true;
+		}
+	}
+
+	return m_indexedPathNodes[nodeIndex].isIndexedFile;
 }
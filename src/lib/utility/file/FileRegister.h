@@ -1,16 +1,26 @@
 #ifndef FILE_REGISTER_H
 #define FILE_REGISTER_H
 
+#include <map>
+#include <memory>
+#include <mutex>
 #include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "FilePath.h"
-#include "UnorderedCache.h"
+#include "FilePathFilterMatcher.h"
 
 class FilePathFilter;
 
 class FileRegister
 {
 public:
+	// drops the state shared by registers of equal indexed paths and exclude filters, required
+	// when the files on disk may have changed
+	static void clearSharedState();
+
 	FileRegister(
 		const FilePath& currentPath,
 		const std::set<FilePath>& indexedPaths,
@@ -20,10 +30,45 @@ public:
 	virtual bool hasFilePath(const FilePath& filePath) const;
 
 private:
-	const FilePath& m_currentPath;
-	const std::set<FilePath> m_indexedPaths;
-	const std::set<FilePathFilter> m_excludeFilters;
-	mutable UnorderedCache<std::wstring, bool> m_hasFilePathCache;
+	// node of a trie over the path components of all indexed files and directories
+	struct IndexedPathNode
+	{
+		std::map<std::wstring, size_t> children;
+		bool isIndexedDirectory;
+		bool isIndexedFile;
+	};
+
+	// the indexed paths, exclude filters and decisions of all registers of the same source group,
+	// shared by the translation units indexed in this process
+	class SharedState
+	{
+	public:
+		SharedState(
+			const std::set<FilePath>& indexedPaths, const std::set<FilePathFilter>& excludeFilters);
+
+		bool isExcluded(const FilePath& filePath) const;
+		bool hasFilePath(const FilePath& filePath);
+
+	private:
+		void addIndexedPath(const FilePath& indexedPath);
+		bool isInIndexedPaths(const FilePath& filePath) const;
+
+		std::vector<IndexedPathNode> m_indexedPathNodes;
+		const FilePathFilterMatcher m_excludeFilterMatcher;
+
+		std::mutex m_hasFilePathMutex;
+		std::unordered_map<std::wstring, bool> m_hasFilePathCache;
+	};
+
+	static std::shared_ptr<SharedState> getSharedState(
+		const std::set<FilePath>& indexedPaths, const std::set<FilePathFilter>& excludeFilters);
+
+	static std::mutex s_sharedStatesMutex;
+	static std::map<std::wstring, std::shared_ptr<SharedState>> s_sharedStates;
+
+	const FilePath m_currentPath;
+	const std::shared_ptr<SharedState> m_sharedState;
+	const bool m_hasCurrentPath;
 };
 
 #endif	  // FILE_REGISTER_H
@@ -6,40 +6,14 @@
 #include <boost/date_time/c_local_time_adjustor.hpp>
 #include <boost/filesystem.hpp>
 
+#include "DirectoryCrawler.h"
 #include "utilityString.h"
 
 std::vector<FilePath> FileSystem::getFilePathsFromDirectory(
 	const FilePath& path, const std::vector<std::wstring>& extensions)
 {
-	std::set<std::wstring> ext(extensions.begin(), extensions.end());
-	std::vector<FilePath> files;
-
-	if (path.isDirectory())
-	{
-		boost::filesystem::recursive_directory_iterator it(path.getPath());
-		boost::filesystem::recursive_directory_iterator endit;
-		while (it != endit)
-		{
-			if (boost::filesystem::is_symlink(*it))
-			{
-				// check for self-referencing symlinks
-				boost::filesystem::path p = boost::filesystem::read_symlink(*it);
-				if (p.filename() == p.string() && p.filename() == it->path().filename())
-				{
-					++it;
-					continue;
-				}
-			}
-
-			if (boost::filesystem::is_regular_file(*it) &&
-				(ext.empty() || ext.find(it->path().extension().wstring()) != ext.end()))
-			{
-				files.push_back(FilePath(it->path().generic_wstring()));
-			}
-			++it;
-		}
-	}
-	return files;
+	return DirectoryCrawler(DirectoryCrawler::SYMLINKED_FILES_FOLLOWED, extensions, true)
+		.getFilePaths({path});
 }
 
 FileInfo FileSystem::getFileInfoForPath(const FilePath& filePath)
@@ -54,7 +28,8 @@ FileInfo FileSystem::getFileInfoForPath(const FilePath& filePath)
 std::vector<FileInfo> FileSystem::getFileInfosFromPaths(
 	const std::vector<FilePath>& paths,
 	const std::vector<std::wstring>& fileExtensions,
-	bool followSymLinks)
+	bool followSymLinks,
+	std::shared_ptr<const FilePathFilterMatcher> excludeFilterMatcher)
 {
 	std::set<std::wstring> ext;
 	for (const std::wstring& e: fileExtensions)
@@ -62,75 +37,44 @@ std::vector<FileInfo> FileSystem::getFileInfosFromPaths(
 		ext.insert(utility::toLowerCase(e));
 	}
 
-	std::set<boost::filesystem::path> symlinkDirs;
-	std::set<FilePath> filePaths;
-
-	std::vector<FileInfo> files;
-
+	std::vector<FilePath> directoryPaths;
+	std::vector<FilePath> filePaths;
 	for (const FilePath& path: paths)
 	{
 		if (path.isDirectory())
 		{
-			boost::filesystem::recursive_directory_iterator it(
-				path.getPath(), boost::filesystem::symlink_option::recurse);
-			boost::filesystem::recursive_directory_iterator endit;
-			boost::system::error_code ec;
-			for (; it != endit; it.increment(ec))
-			{
-				if (boost::filesystem::is_symlink(*it))
-				{
-					if (!followSymLinks)
-					{
-						it.no_push();
-						continue;
-					}
-
-					// check for self-referencing symlinks
-					boost::filesystem::path p = boost::filesystem::read_symlink(*it);
-					if (p.filename() == p.string() && p.filename() == it->path().filename())
-					{
-						continue;
-					}
-
-					// check for duplicates when following directory symlinks
-					if (boost::filesystem::is_directory(*it))
-					{
-						boost::filesystem::path absDir = boost::filesystem::canonical(
-							p, it->path().parent_path());
-
-						if (symlinkDirs.find(absDir) != symlinkDirs.end())
-						{
-							it.no_push();
-							continue;
-						}
+			directoryPaths.push_back(path);
+		}
+		else if (
+			path.exists() &&
+			(ext.empty() || ext.find(utility::toLowerCase(path.extension())) != ext.end()))
+		{
+			filePaths.push_back(path.getCanonical());
+		}
+	}
 
-						symlinkDirs.insert(absDir);
-					}
-				}
+	// all directories are crawled at once, so they are read in parallel
+	DirectoryCrawler crawler(
+		followSymLinks ? DirectoryCrawler::SYMLINKS_FOLLOWED : DirectoryCrawler::SYMLINKS_IGNORED,
+		fileExtensions,
+		false,
+		excludeFilterMatcher);
+	std::vector<FileInfo> files = crawler.getFileInfos(directoryPaths);
 
-				if (boost::filesystem::is_regular_file(*it) &&
-					(ext.empty() ||
-					 ext.find(utility::toLowerCase(it->path().extension().wstring())) != ext.end()))
-				{
-					const FilePath canonicalPath = FilePath(it->path().wstring()).getCanonical();
-					if (filePaths.find(canonicalPath) != filePaths.end())
-					{
-						continue;
-					}
-					filePaths.insert(canonicalPath);
-					files.push_back(getFileInfoForPath(canonicalPath));
-				}
-			}
+	if (!filePaths.empty())
+	{
+		std::set<FilePath> canonicalPaths;
+		for (const FileInfo& file: files)
+		{
+			canonicalPaths.insert(file.path);
 		}
-		else if (path.exists() && (ext.empty() || ext.find(utility::toLowerCase(path.extension())) != ext.end()))
+
+		for (const FilePath& canonicalPath: filePaths)
 		{
-			const FilePath canonicalPath = path.getCanonical();
-			if (filePaths.find(canonicalPath) != filePaths.end())
+			if (canonicalPaths.insert(canonicalPath).second)
 			{
-				continue;
+				files.push_back(getFileInfoForPath(canonicalPath));
 			}
-			filePaths.insert(canonicalPath);
-			files.push_back(getFileInfoForPath(canonicalPath));
 		}
 	}
 
@@ -200,9 +144,10 @@ unsigned long long FileSystem::getFileByteSize(const FilePath& filePath)
 TimeStamp FileSystem::getLastWriteTime(const FilePath& filePath)
 {
 	boost::posix_time::ptime lastWriteTime;
-	if (filePath.exists())
+	boost::system::error_code ec;
+	std::time_t t = boost::filesystem::last_write_time(filePath.getPath(), ec);
+	if (!ec)
 	{
-		std::time_t t = boost::filesystem::last_write_time(filePath.getPath());
 		lastWriteTime = boost::posix_time::from_time_t(t);
 		lastWriteTime = boost::date_time::c_local_adjustor<boost::posix_time::ptime>::utc_to_local(
 			lastWriteTime);
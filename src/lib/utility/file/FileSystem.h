@@ -1,6 +1,7 @@
 #ifndef FILE_SYSTEM_H
 #define FILE_SYSTEM_H
 
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
@@ -8,24 +9,31 @@
 #include "FileInfo.h"
 #include "TimeStamp.h"
 
+class FilePathFilterMatcher;
+
 class FileSystem
 {
 public:
+	// files of a directory come before the files of its sub directories, both sorted by name
 	static std::vector<FilePath> getFilePathsFromDirectory(
 		const FilePath& path, const std::vector<std::wstring>& extensions = {});
 
 	static FileInfo getFileInfoForPath(const FilePath& filePath);
 
+	// files below the directories in the order of getFilePathsFromDirectory, followed by the
+	// files passed directly
 	static std::vector<FileInfo> getFileInfosFromPaths(
 		const std::vector<FilePath>& paths,
 		const std::vector<std::wstring>& fileExtensions,
-		bool followSymLinks = true);
+		bool followSymLinks = true,
+		std::shared_ptr<const FilePathFilterMatcher> excludeFilterMatcher = nullptr);
 
 	static std::set<FilePath> getSymLinkedDirectories(const FilePath& path);
 	static std::set<FilePath> getSymLinkedDirectories(const std::vector<FilePath>& paths);
 
 	static unsigned long long getFileByteSize(const FilePath& filePath);
 
+	// returns an invalid TimeStamp if the file doesn't exist or can't be accessed
 	static TimeStamp getLastWriteTime(const FilePath& filePath);
 
 	static bool remove(const FilePath& path);
@@ -1,13 +1,45 @@
 #include "FileLogger.h"
 
+#include <algorithm>
+#include <cctype>
+#include <chrono>
 #include <cstdio>
 #include <ctime>
-#include <fstream>
+#include <iomanip>
 #include <sstream>
 
 #include "FileSystem.h"
 #include "utilityString.h"
 
+namespace
+{
+// reads the "HH:MM:SS.mmm" timestamp at the start of a log line
+bool getLineMillisecondOfDay(const std::string& line, unsigned long long& millisecondOfDay)
+{
+	const std::string format = "00:00:00.000";
+	if (line.size() < format.size())
+	{
+		return false;
+	}
+
+	for (size_t i = 0; i < format.size(); i++)
+	{
+		if (format[i] == '0' ? !std::isdigit(static_cast<unsigned char>(line[i]))
+							 : line[i] != format[i])
+		{
+			return false;
+		}
+	}
+
+	millisecondOfDay = std::stoull(line.substr(0, 2)) * 60 * 60 * 1000 +
+		std::stoull(line.substr(3, 2)) * 60 * 1000 + std::stoull(line.substr(6, 2)) * 1000 +
+		std::stoull(line.substr(9, 3));
+	return true;
+}
+}	 // namespace
+
+const size_t FileLogger::s_batchSize = 256;
+
 std::wstring FileLogger::generateDatedFileName(
 	const std::wstring& prefix, const std::wstring& suffix, int offsetDays)
 {
@@ -46,73 +78,110 @@ std::wstring FileLogger::generateDatedFileName(
 	return filename.str();
 }
 
+FilePath FileLogger::getProcessLogFilePath(const FilePath& logFilePath, int processId)
+{
+	return FilePath(
+		logFilePath.withoutExtension().wstr() + L"_indexer" + std::to_wstring(processId) +
+		logFilePath.extension());
+}
+
+FileLogger::QueuedMessage::QueuedMessage(const char* type, const LogMessage& message)
+	: type(type), message(message)
+{
+}
+
 FileLogger::FileLogger()
 	: Logger("FileLogger")
 	, m_logFileName(L"log")
 	, m_logDirectory(L"user/log/")
-	, m_maxLogLineCount(0)
+	, m_maxLogFileSize(0)
 	, m_maxLogFileCount(0)
-	, m_currentLogLineCount(0)
+	, m_currentLogFileSize(0)
 	, m_currentLogFileCount(0)
+	, m_queuedMessages(nullptr)
+	, m_queuedMessageCount(0)
+	, m_writeSynchronously(false)
+	, m_writerStopped(false)
 {
 	updateLogFileName();
+
+	m_writerThread = std::thread(&FileLogger::runWriter, this);
+}
+
+FileLogger::~FileLogger()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_writerMutex);
+		m_writerStopped = true;
+	}
+	m_writerCondition.notify_one();
+	m_writerThread.join();
 }
 
 FilePath FileLogger::getLogFilePath() const
 {
+	std::lock_guard<std::mutex> lock(m_fileMutex);
 	return m_currentLogFilePath;
 }
 
 void FileLogger::setLogFilePath(const FilePath& filePath)
 {
+	std::lock_guard<std::mutex> lock(m_fileMutex);
 	m_currentLogFilePath = filePath;
 	m_logFileName = L"";
+	m_fileStream.close();
 }
 
 void FileLogger::setLogDirectory(const FilePath& filePath)
 {
+	std::lock_guard<std::mutex> lock(m_fileMutex);
 	m_logDirectory = filePath;
 	FileSystem::createDirectory(m_logDirectory);
 }
 
 void FileLogger::setFileName(const std::wstring& fileName)
 {
+	std::lock_guard<std::mutex> lock(m_fileMutex);
 	if (fileName != m_logFileName)
 	{
 		m_logFileName = fileName;
-		m_currentLogLineCount = 0;
+		m_currentLogFileSize = 0;
 		m_currentLogFileCount = 0;
 		updateLogFileName();
+		m_fileStream.close();
 	}
 }
 
 void FileLogger::logInfo(const LogMessage& message)
 {
-	logMessage("INFO", message);
+	logMessage(new QueuedMessage("INFO", message), false);
 }
 
 void FileLogger::logWarning(const LogMessage& message)
 {
-	logMessage("WARNING", message);
+	logMessage(new QueuedMessage("WARNING", message), true);
 }
 
 void FileLogger::logError(const LogMessage& message)
 {
-	logMessage("ERROR", message);
+	logMessage(new QueuedMessage("ERROR", message), true);
 }
 
-void FileLogger::setMaxLogLineCount(unsigned int lineCount)
+void FileLogger::setMaxLogFileSize(unsigned long long byteCount)
 {
-	m_maxLogLineCount = lineCount;
+	std::lock_guard<std::mutex> lock(m_fileMutex);
+	m_maxLogFileSize = byteCount;
 }
 
 void FileLogger::setMaxLogFileCount(unsigned int fileCount)
 {
+	std::lock_guard<std::mutex> lock(m_fileMutex);
 	m_maxLogFileCount = fileCount;
 }
 
 void FileLogger::deleteLogFiles(const std::wstring& cutoffDate)
 {
+	std::lock_guard<std::mutex> lock(m_fileMutex);
 	for (const FilePath& file: FileSystem::getFilePathsFromDirectory(m_logDirectory, {L".txt"}))
 	{
 		if (file.fileName() < cutoffDate)
@@ -122,6 +191,195 @@ void FileLogger::deleteLogFiles(const std::wstring& cutoffDate)
 	}
 }
 
+void FileLogger::setWriteSynchronously(bool writeSynchronously)
+{
+	m_writeSynchronously = writeSynchronously;
+	flush();
+}
+
+void FileLogger::flush()
+{
+	std::lock_guard<std::mutex> lock(m_fileMutex);
+	writeQueuedMessages();
+}
+
+void FileLogger::mergeLogFiles(const std::vector<FilePath>& filePaths)
+{
+	struct Entry
+	{
+		unsigned long long time;
+		std::string text;
+	};
+
+	std::vector<Entry> entries;
+	for (const FilePath& filePath: filePaths)
+	{
+		std::ifstream fileStream(filePath.str());
+		if (!fileStream.is_open())
+		{
+			continue;
+		}
+
+		// the lines of each file are ordered, a smaller time than the one before means that the
+		// day changed
+		const size_t firstEntryIndex = entries.size();
+		unsigned long long previousTime = 0;
+		unsigned long long dayOffset = 0;
+
+		std::string line;
+		while (std::getline(fileStream, line))
+		{
+			unsigned long long time = 0;
+			if (getLineMillisecondOfDay(line, time))
+			{
+				if (time + dayOffset < previousTime)
+				{
+					dayOffset += 24 * 60 * 60 * 1000;
+				}
+				previousTime = time + dayOffset;
+				entries.push_back({previousTime, line + '\n'});
+			}
+			else if (entries.size() > firstEntryIndex)
+			{
+				// continuation of a message that spans multiple lines
+				entries.back().text += line + '\n';
+			}
+		}
+
+		fileStream.close();
+		FileSystem::remove(filePath);
+	}
+
+	std::stable_sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+		return a.time < b.time;
+	});
+
+	std::lock_guard<std::mutex> lock(m_fileMutex);
+	writeQueuedMessages();
+
+	for (const Entry& entry: entries)
+	{
+		writeLine(entry.text);
+	}
+	m_fileStream.flush();
+}
+
+void FileLogger::logMessage(QueuedMessage* message, bool urgent)
+{
+	message->next = m_queuedMessages.load(std::memory_order_relaxed);
+	while (!m_queuedMessages.compare_exchange_weak(
+		message->next, message, std::memory_order_release, std::memory_order_relaxed))
+		;
+
+	if (m_writeSynchronously)
+	{
+		m_queuedMessageCount.fetch_add(1, std::memory_order_relaxed);
+
+		std::lock_guard<std::mutex> lock(m_fileMutex);
+		writeQueuedMessages();
+		return;
+	}
+
+	// the writer wakes up on its own from time to time, it is only woken early once a batch is
+	// complete or if the message should not get lost in a crash
+	if (m_queuedMessageCount.fetch_add(1, std::memory_order_relaxed) + 1 >= s_batchSize || urgent)
+	{
+		m_writerCondition.notify_one();
+	}
+}
+
+void FileLogger::runWriter()
+{
+	std::unique_lock<std::mutex> writerLock(m_writerMutex);
+	while (true)
+	{
+		if (!m_writerStopped)
+		{
+			m_writerCondition.wait_for(writerLock, std::chrono::milliseconds(100));
+		}
+		const bool stopped = m_writerStopped;
+		writerLock.unlock();
+
+		{
+			std::lock_guard<std::mutex> lock(m_fileMutex);
+			writeQueuedMessages();
+		}
+
+		if (stopped)
+		{
+			break;
+		}
+		writerLock.lock();
+	}
+}
+
+void FileLogger::writeQueuedMessages()
+{
+	QueuedMessage* message = m_queuedMessages.exchange(nullptr, std::memory_order_acquire);
+	if (!message)
+	{
+		return;
+	}
+
+	// the stack holds the latest message first
+	QueuedMessage* orderedMessages = nullptr;
+	size_t messageCount = 0;
+	while (message)
+	{
+		QueuedMessage* next = message->next;
+		message->next = orderedMessages;
+		orderedMessages = message;
+		message = next;
+		messageCount++;
+	}
+	m_queuedMessageCount.fetch_sub(messageCount, std::memory_order_relaxed);
+
+	std::ostringstream lineStream;
+	while (orderedMessages)
+	{
+		const LogMessage& logMessage = orderedMessages->message;
+
+		lineStream.str("");
+		lineStream << logMessage.getTimeString("%H:%M:%S") << '.' << std::setfill('0')
+				   << std::setw(3) << logMessage.millisecond << " | ";
+		lineStream << logMessage.threadId << " | ";
+
+		if (logMessage.filePath.size())
+		{
+			lineStream << logMessage.getFileName() << ':' << logMessage.line << ' '
+					   << logMessage.functionName << "() | ";
+		}
+
+		lineStream << orderedMessages->type << ": " << utility::encodeToUtf8(logMessage.message)
+				   << '\n';
+		writeLine(lineStream.str());
+
+		QueuedMessage* next = orderedMessages->next;
+		delete orderedMessages;
+		orderedMessages = next;
+	}
+
+	m_fileStream.flush();
+}
+
+void FileLogger::writeLine(const std::string& line)
+{
+	// the stream stays open until the log file changes
+	if (!m_fileStream.is_open())
+	{
+		m_fileStream.clear();
+		m_fileStream.open(m_currentLogFilePath.str(), std::ios::app);
+	}
+
+	m_fileStream << line;
+
+	m_currentLogFileSize += line.size();
+	if (m_maxLogFileCount > 0)
+	{
+		updateLogFileName();
+	}
+}
+
 void FileLogger::updateLogFileName()
 {
 	if (m_logFileName.empty())
@@ -135,9 +393,9 @@ void FileLogger::updateLogFileName()
 	if (m_maxLogFileCount > 0)
 	{
 		currentLogFilePath += L"_";
-		if (m_currentLogLineCount >= m_maxLogLineCount)
+		if (m_currentLogFileSize >= m_maxLogFileSize)
 		{
-			m_currentLogLineCount = 0;
+			m_currentLogFileSize = 0;
 
 			m_currentLogFileCount++;
 			if (m_currentLogFileCount >= m_maxLogFileCount)
@@ -154,29 +412,7 @@ void FileLogger::updateLogFileName()
 
 	if (fileChanged)
 	{
+		m_fileStream.close();
 		FileSystem::remove(m_currentLogFilePath);
 	}
 }
-
-void FileLogger::logMessage(const std::string& type, const LogMessage& message)
-{
-	std::ofstream fileStream;
-	fileStream.open(m_currentLogFilePath.str(), std::ios::app);
-	fileStream << message.getTimeString("%H:%M:%S") << " | ";
-	fileStream << message.threadId << " | ";
-
-	if (message.filePath.size())
-	{
-		fileStream << message.getFileName() << ':' << message.line << ' ' << message.functionName
-				   << "() | ";
-	}
-
-	fileStream << type << ": " << utility::encodeToUtf8(message.message) << std::endl;
-	fileStream.close();
-
-	m_currentLogLineCount++;
-	if (m_maxLogFileCount > 0)
-	{
-		updateLogFileName();
-	}
-}
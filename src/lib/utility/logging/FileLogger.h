@@ -1,48 +1,96 @@
 #ifndef FILE_LOGGER_H
 #define FILE_LOGGER_H
 
+#include <atomic>
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "FilePath.h"
 #include "LogMessage.h"
 #include "Logger.h"
 
+// Logging only queues the message without taking a lock, a background thread formats the queued
+// messages and writes them to the log file in batches. In synchronous mode each message is written
+// before logging returns, so no message gets lost if the process crashes.
 class FileLogger: public Logger
 {
 public:
 	static std::wstring generateDatedFileName(
 		const std::wstring& prefix = L"", const std::wstring& suffix = L"", int offsetDays = 0);
 
+	// each indexer process writes to a file of its own next to the log file of the app
+	static FilePath getProcessLogFilePath(const FilePath& logFilePath, int processId);
+
 	FileLogger();
+	~FileLogger() override;
 
 	FilePath getLogFilePath() const;
 	void setLogFilePath(const FilePath& filePath);
 
 	void setLogDirectory(const FilePath& filePath);
 	void setFileName(const std::wstring& fileName);
-	void setMaxLogLineCount(unsigned int logCount);
+	void setMaxLogFileSize(unsigned long long byteCount);
 
 	// setting the max log file count to 0 will disable ringlogging
 	void setMaxLogFileCount(unsigned int amount);
 
 	void deleteLogFiles(const std::wstring& cutoffDate);
 
+	void setWriteSynchronously(bool writeSynchronously);
+
+	// blocks until all queued messages are written
+	void flush();
+
+	// appends the lines of the given log files ordered by their timestamps and removes the files
+	void mergeLogFiles(const std::vector<FilePath>& filePaths);
+
 private:
+	struct QueuedMessage
+	{
+		QueuedMessage(const char* type, const LogMessage& message);
+
+		const char* type;
+		const LogMessage message;
+		QueuedMessage* next = nullptr;
+	};
+
+	static const size_t s_batchSize;
+
 	void logInfo(const LogMessage& message) override;
 	void logWarning(const LogMessage& message) override;
 	void logError(const LogMessage& message) override;
 
-	void logMessage(const std::string& type, const LogMessage& message);
+	void logMessage(QueuedMessage* message, bool urgent);
+	void runWriter();
+	void writeQueuedMessages();
+	void writeLine(const std::string& line);
 	void updateLogFileName();
 
 	std::wstring m_logFileName;
 	FilePath m_logDirectory;
 	FilePath m_currentLogFilePath;
 
-	unsigned int m_maxLogLineCount;
+	unsigned long long m_maxLogFileSize;
 	unsigned int m_maxLogFileCount;
-	unsigned int m_currentLogLineCount;
+	unsigned long long m_currentLogFileSize;
 	unsigned int m_currentLogFileCount;
+
+	std::ofstream m_fileStream;
+	mutable std::mutex m_fileMutex;
+
+	// messages are pushed onto a lock-free stack by any thread and taken all at once by the writer
+	std::atomic<QueuedMessage*> m_queuedMessages;
+	std::atomic<size_t> m_queuedMessageCount;
+	std::atomic<bool> m_writeSynchronously;
+
+	std::mutex m_writerMutex;
+	std::condition_variable m_writerCondition;
+	bool m_writerStopped;
+	std::thread m_writerThread;
 };
 
 #endif	  // FILE_LOGGER_H
@@ -1,6 +1,7 @@
 #include "LogManagerImplementation.h"
 
 #include <algorithm>
+#include <chrono>
 
 LogManagerImplementation::LogManagerImplementation() {}
 
@@ -88,11 +89,12 @@ void LogManagerImplementation::logInfo(
 	const std::string& function,
 	const unsigned int line)
 {
+	const LogMessage logMessage = createLogMessage(message, file, function, line);
+
 	std::lock_guard<std::mutex> lockGuardLogger(m_loggerMutex);
 	for (unsigned int i = 0; i < m_loggers.size(); i++)
 	{
-		m_loggers[i]->onInfo(
-			LogMessage(message, file, function, line, getTime(), std::this_thread::get_id()));
+		m_loggers[i]->onInfo(logMessage);
 	}
 }
 
@@ -102,11 +104,12 @@ void LogManagerImplementation::logWarning(
 	const std::string& function,
 	const unsigned int line)
 {
+	const LogMessage logMessage = createLogMessage(message, file, function, line);
+
 	std::lock_guard<std::mutex> lockGuardLogger(m_loggerMutex);
 	for (unsigned int i = 0; i < m_loggers.size(); i++)
 	{
-		m_loggers[i]->onWarning(
-			LogMessage(message, file, function, line, getTime(), std::this_thread::get_id()));
+		m_loggers[i]->onWarning(logMessage);
 	}
 }
 
@@ -116,24 +119,37 @@ void LogManagerImplementation::logError(
 	const std::string& function,
 	const unsigned int line)
 {
+	const LogMessage logMessage = createLogMessage(message, file, function, line);
+
 	std::lock_guard<std::mutex> lockGuardLogger(m_loggerMutex);
 	for (unsigned int i = 0; i < m_loggers.size(); i++)
 	{
-		m_loggers[i]->onError(
-			LogMessage(message, file, function, line, getTime(), std::this_thread::get_id()));
+		m_loggers[i]->onError(logMessage);
 	}
 }
 
-tm LogManagerImplementation::getTime()
+LogMessage LogManagerImplementation::createLogMessage(
+	const std::wstring& message,
+	const std::string& file,
+	const std::string& function,
+	const unsigned int line) const
 {
-	time_t time;
-	std::time(&time);
-
-#pragma warning(push)
-#pragma warning(disable : 4996)
-	tm result = *std::localtime(&time);	   // this is done because localtime returns a pointer to a
-										   // statically allocated object
-#pragma warning(pop)
-
-	return result;
+	// the message is created before locking, so threads logging at the same time only wait for
+	// each other while it is handed to the loggers
+	const std::chrono::system_clock::time_point now = std::chrono::system_clock::now();
+	const time_t time = std::chrono::system_clock::to_time_t(now);
+	const unsigned int millisecond = static_cast<unsigned int>(
+		std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count() %
+		1000);
+
+	// std::localtime returns a statically allocated object that other threads may overwrite
+	tm result;
+#ifdef _WIN32
+	localtime_s(&result, &time);
+#else
+	localtime_r(&time, &result);
+#endif
+
+	return LogMessage(
+		message, file, function, line, result, millisecond, std::this_thread::get_id());
 }
@@ -46,7 +46,11 @@ public:
 		const unsigned int line);
 
 private:
-	tm getTime();
+	LogMessage createLogMessage(
+		const std::wstring& message,
+		const std::string& file,
+		const std::string& function,
+		const unsigned int line) const;
 
 	std::vector<std::shared_ptr<Logger>> m_loggers;
 
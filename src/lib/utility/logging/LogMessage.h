@@ -14,12 +14,14 @@ public:
 		const std::string& functionName,
 		const unsigned int line,
 		const std::tm& time,
+		const unsigned int millisecond,
 		const std::thread::id& threadId)
 		: message(message)
 		, filePath(filePath)
 		, functionName(functionName)
 		, line(line)
 		, time(time)
+		, millisecond(millisecond)
 		, threadId(threadId)
 	{
 	}
@@ -41,6 +43,7 @@ public:
 	const std::string functionName;
 	const unsigned int line;
 	const std::tm time;
+	const unsigned int millisecond;
 	const std::thread::id threadId;
 };
 
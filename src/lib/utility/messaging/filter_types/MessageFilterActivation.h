@@ -0,0 +1,25 @@
+#ifndef MESSAGE_FILTER_ACTIVATION_H
+#define MESSAGE_FILTER_ACTIVATION_H
+
+#include "CancellationToken.h"
+#include "MessageActivateBase.h"
+#include "MessageFilter.h"
+
+// Doesn't remove messages, but cancels all older activations of a tab as soon as a newer activation
+// replacing the content of that tab gets processed. Their running storage queries stop early and
+// their results are dropped.
+class MessageFilterActivation: public MessageFilter
+{
+	void filter(MessageQueue::MessageBufferType* messageBuffer) override
+	{
+		MessageBase* message = messageBuffer->front().get();
+		MessageActivateBase* activation = dynamic_cast<MessageActivateBase*>(message);
+		if (activation && message->getSchedulerId() && !message->keepContent())
+		{
+			CancellationToken::cancel(message->getSchedulerId());
+			activation->setCancellationToken(CancellationToken(message->getSchedulerId()));
+		}
+	}
+};
+
+#endif	  // MESSAGE_FILTER_ACTIVATION_H
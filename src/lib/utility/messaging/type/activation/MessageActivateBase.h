@@ -1,6 +1,7 @@
 #ifndef MESSAGE_ACTIVATE_BASE_H
 #define MESSAGE_ACTIVATE_BASE_H
 
+#include "CancellationToken.h"
 #include "SearchMatch.h"
 
 class MessageActivateBase
@@ -9,6 +10,20 @@ public:
 	virtual ~MessageActivateBase() = default;
 
 	virtual std::vector<SearchMatch> getSearchMatches() const = 0;
+
+	// canceled once a newer activation for the same tab gets processed
+	const CancellationToken& getCancellationToken() const
+	{
+		return m_cancellationToken;
+	}
+
+	void setCancellationToken(const CancellationToken& cancellationToken)
+	{
+		m_cancellationToken = cancellationToken;
+	}
+
+private:
+	CancellationToken m_cancellationToken;
 };
 
 #endif	  // MESSAGE_ACTIVATE_BASE_H
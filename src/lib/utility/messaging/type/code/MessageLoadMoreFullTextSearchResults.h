@@ -0,0 +1,21 @@
+#ifndef MESSAGE_LOAD_MORE_FULLTEXT_SEARCH_RESULTS_H
+#define MESSAGE_LOAD_MORE_FULLTEXT_SEARCH_RESULTS_H
+
+#include "Message.h"
+#include "TabId.h"
+
+class MessageLoadMoreFullTextSearchResults: public Message<MessageLoadMoreFullTextSearchResults>
+{
+public:
+	static const std::string getStaticType()
+	{
+		return "MessageLoadMoreFullTextSearchResults";
+	}
+
+	MessageLoadMoreFullTextSearchResults()
+	{
+		setSchedulerId(TabId::currentTab());
+	}
+};
+
+#endif	  // MESSAGE_LOAD_MORE_FULLTEXT_SEARCH_RESULTS_H
@@ -1,8 +1,10 @@
 #include "Blackboard.h"
 
-Blackboard::Blackboard() {}
+#include <chrono>
 
-Blackboard::Blackboard(std::shared_ptr<Blackboard> parent): m_parent(parent) {}
+Blackboard::Blackboard(): m_changeCount(0) {}
+
+Blackboard::Blackboard(std::shared_ptr<Blackboard> parent): m_parent(parent), m_changeCount(0) {}
 
 bool Blackboard::exists(const std::string& key)
 {
@@ -20,7 +22,29 @@ bool Blackboard::clear(const std::string& key)
 	if (it != m_items.end())
 	{
 		m_items.erase(it);
+		notifyChange();
 		return true;
 	}
 	return false;
 }
+
+size_t Blackboard::getChangeCount()
+{
+	std::lock_guard<std::mutex> lock(m_itemMutex);
+	return m_changeCount;
+}
+
+bool Blackboard::waitForChange(size_t changeCount, size_t timeoutMS)
+{
+	std::unique_lock<std::mutex> lock(m_itemMutex);
+	return m_changeCondition.wait_for(lock, std::chrono::milliseconds(timeoutMS), [&]() {
+		return m_changeCount != changeCount;
+	});
+}
+
+void Blackboard::notifyChange()
+{
+	// called with the item mutex locked
+	m_changeCount++;
+	m_changeCondition.notify_all();
+}
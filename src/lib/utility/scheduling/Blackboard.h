@@ -1,6 +1,7 @@
 #ifndef BLACKBOARD_H
 #define BLACKBOARD_H
 
+#include <condition_variable>
 #include <functional>
 #include <map>
 #include <memory>
@@ -45,13 +46,24 @@ public:
 	bool exists(const std::string& key);
 	bool clear(const std::string& key);
 
+	// counts every set, update and clear, so tasks can wait for changes instead of polling
+	size_t getChangeCount();
+
+	// returns true if the change count differs from the given one before the timeout
+	bool waitForChange(size_t changeCount, size_t timeoutMS);
+
 private:
+	void notifyChange();
+
 	typedef std::map<std::string, std::shared_ptr<BlackboardItemBase>> ItemMap;
 
 	std::shared_ptr<Blackboard> m_parent;
 
 	ItemMap m_items;
 	std::mutex m_itemMutex;
+
+	size_t m_changeCount;
+	std::condition_variable m_changeCondition;
 };
 
 
@@ -61,6 +73,7 @@ void Blackboard::set(const std::string& key, const T& value)
 	std::lock_guard<std::mutex> lock(m_itemMutex);
 
 	m_items[key] = std::make_shared<BlackboardItem<T>>(value);
+	notifyChange();
 }
 
 template <typename T>
@@ -99,6 +112,7 @@ bool Blackboard::update(const std::string& key, std::function<T(const T&)> updat
 				it->second))
 		{
 			item->value = updater(item->value);
+			notifyChange();
 			return true;
 		}
 	}
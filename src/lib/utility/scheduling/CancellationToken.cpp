@@ -0,0 +1,53 @@
+#include "CancellationToken.h"
+
+namespace
+{
+thread_local CancellationToken s_currentToken;
+}
+
+CancellationToken::Scope::Scope(const CancellationToken& token): m_previousToken(s_currentToken)
+{
+	s_currentToken = token;
+}
+
+CancellationToken::Scope::~Scope()
+{
+	s_currentToken = m_previousToken;
+}
+
+std::map<Id, std::shared_ptr<std::atomic<Id>>> CancellationToken::s_generations;
+std::mutex CancellationToken::s_generationsMutex;
+
+void CancellationToken::cancel(Id schedulerId)
+{
+	(*getGeneration(schedulerId))++;
+}
+
+CancellationToken CancellationToken::getCurrent()
+{
+	return s_currentToken;
+}
+
+CancellationToken::CancellationToken(): m_startGeneration(0) {}
+
+CancellationToken::CancellationToken(Id schedulerId)
+	: m_generation(getGeneration(schedulerId)), m_startGeneration(m_generation->load())
+{
+}
+
+bool CancellationToken::isCanceled() const
+{
+	return m_generation && m_generation->load() != m_startGeneration;
+}
+
+std::shared_ptr<std::atomic<Id>> CancellationToken::getGeneration(Id schedulerId)
+{
+	std::lock_guard<std::mutex> lock(s_generationsMutex);
+
+	std::shared_ptr<std::atomic<Id>>& generation = s_generations[schedulerId];
+	if (!generation)
+	{
+		generation = std::make_shared<std::atomic<Id>>(0);
+	}
+	return generation;
+}
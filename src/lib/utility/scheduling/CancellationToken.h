@@ -0,0 +1,49 @@
+#ifndef CANCELLATION_TOKEN_H
+#define CANCELLATION_TOKEN_H
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+
+#include "types.h"
+
+// Handed out to long running work of a scheduler, e.g. storage queries of an activation. All tokens
+// of a scheduler get canceled when a newer request for that scheduler arrives, so the work can stop
+// early instead of delaying the request that replaces its result.
+class CancellationToken
+{
+public:
+	class Scope;
+
+	static void cancel(Id schedulerId);
+
+	static CancellationToken getCurrent();
+
+	CancellationToken();	// never canceled
+	CancellationToken(Id schedulerId);
+
+	bool isCanceled() const;
+
+private:
+	static std::shared_ptr<std::atomic<Id>> getGeneration(Id schedulerId);
+
+	static std::map<Id, std::shared_ptr<std::atomic<Id>>> s_generations;
+	static std::mutex s_generationsMutex;
+
+	std::shared_ptr<std::atomic<Id>> m_generation;
+	Id m_startGeneration;
+};
+
+// makes a token the current one of the calling thread for the lifetime of the scope
+class CancellationToken::Scope
+{
+public:
+	Scope(const CancellationToken& token);
+	~Scope();
+
+private:
+	CancellationToken m_previousToken;
+};
+
+#endif	  // CANCELLATION_TOKEN_H
@@ -1,7 +1,6 @@
 #include "TaskDecoratorRepeat.h"
 
-#include <chrono>
-#include <thread>
+#include "Blackboard.h"
 
 TaskDecoratorRepeat::TaskDecoratorRepeat(ConditionType condition, TaskState exitState, size_t delayMS)
 	: m_condition(condition), m_exitState(exitState), m_delayMS(delayMS)
@@ -14,6 +13,10 @@ Task::TaskState TaskDecoratorRepeat::doUpdate(std::shared_ptr<Blackboard> blackb
 {
 	TaskState state = m_taskRunner->update(blackboard);
 
+	// changes made by the child itself don't count, otherwise a child that writes to the
+	// blackboard on every update would be repeated without any delay
+	const size_t changeCount = blackboard->getChangeCount();
+
 	switch (m_condition)
 	{
 	case CONDITION_WHILE_SUCCESS:
@@ -29,7 +32,7 @@ Task::TaskState TaskDecoratorRepeat::doUpdate(std::shared_ptr<Blackboard> blackb
 		break;
 	}
 
-	std::this_thread::sleep_for(std::chrono::milliseconds(m_delayMS));
+	blackboard->waitForChange(changeCount, m_delayMS);
 
 	return state;
 }
@@ -14,6 +14,7 @@ public:
 		CONDITION_WHILE_SUCCESS
 	};
 
+	// repeats after delayMS at the latest, or as soon as another task changes the blackboard
 	TaskDecoratorRepeat(ConditionType condition, TaskState exitState, size_t delayMS);
 
 private:
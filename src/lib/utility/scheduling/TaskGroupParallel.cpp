@@ -1,12 +1,11 @@
 #include "TaskGroupParallel.h"
 
 #include <chrono>
-#include <thread>
 
-#include "ScopedFunctor.h"
+#include "ThreadPool.h"
 
 TaskGroupParallel::TaskGroupParallel()
-	: m_needsToStartThreads(true), m_activeTaskCountMutex(std::make_shared<std::mutex>())
+	: m_needsToStartThreads(true), m_taskFailed(false), m_activeTaskCount(0)
 {
 }
 
@@ -17,30 +16,31 @@ void TaskGroupParallel::addTask(std::shared_ptr<Task> task)
 
 void TaskGroupParallel::doEnter(std::shared_ptr<Blackboard> blackboard)
 {
-	m_taskFailed = false;
+	{
+		std::lock_guard<std::mutex> lock(m_activeTaskCountMutex);
+		m_taskFailed = false;
+	}
 
 	if (m_needsToStartThreads)
 	{
 		m_needsToStartThreads = false;
-		m_activeTaskCount = static_cast<int>(m_tasks.size());
 		for (size_t i = 0; i < m_tasks.size(); i++)
 		{
-			m_tasks[i]->active = true;
-			m_tasks[i]->thread = std::make_shared<std::thread>(
-				&TaskGroupParallel::processTaskThreaded,
-				this,
-				m_tasks[i],
-				blackboard,
-				m_activeTaskCountMutex);
+			startTask(m_tasks[i], blackboard);
 		}
 	}
 }
 
 Task::TaskState TaskGroupParallel::doUpdate(std::shared_ptr<Blackboard> blackboard)
 {
-	std::this_thread::sleep_for(std::chrono::milliseconds(25));
+	std::unique_lock<std::mutex> lock(m_activeTaskCountMutex);
+
+	// returns as soon as the last task finished, the timeout keeps the scheduler responsive to
+	// interruption
+	m_activeTaskCountCondition.wait_for(
+		lock, std::chrono::milliseconds(25), [this]() { return m_activeTaskCount == 0; });
 
-	if (m_tasks.size() != 0 && getActiveTaskCount() > 0)
+	if (m_activeTaskCount > 0)
 	{
 		return STATE_RUNNING;
 	}
@@ -50,11 +50,7 @@ Task::TaskState TaskGroupParallel::doUpdate(std::shared_ptr<Blackboard> blackboa
 
 void TaskGroupParallel::doExit(std::shared_ptr<Blackboard> blackboard)
 {
-	for (size_t i = 0; i < m_tasks.size(); i++)
-	{
-		m_tasks[i]->thread->join();
-		m_tasks[i]->thread.reset();
-	}
+	waitForActiveTasks();
 }
 
 void TaskGroupParallel::doReset(std::shared_ptr<Blackboard> blackboard)
@@ -62,20 +58,16 @@ void TaskGroupParallel::doReset(std::shared_ptr<Blackboard> blackboard)
 	for (size_t i = 0; i < m_tasks.size(); i++)
 	{
 		m_tasks[i]->taskRunner->reset();
-		if (!m_tasks[i]->active)
+
+		bool active = false;
 		{
-			{
-				std::lock_guard<std::mutex> lock(*m_activeTaskCountMutex.get());
-				m_activeTaskCount++;
-			}
-			m_tasks[i]->thread->join();
-			m_tasks[i]->active = true;
-			m_tasks[i]->thread = std::make_shared<std::thread>(
-				&TaskGroupParallel::processTaskThreaded,
-				this,
-				m_tasks[i],
-				blackboard,
-				m_activeTaskCountMutex);
+			std::lock_guard<std::mutex> lock(m_activeTaskCountMutex);
+			active = m_tasks[i]->active;
+		}
+
+		if (!active)
+		{
+			startTask(m_tasks[i], blackboard);
 		}
 	}
 }
@@ -87,44 +79,44 @@ void TaskGroupParallel::doTerminate()
 		m_tasks[i]->taskRunner->terminate();
 	}
 
-	for (size_t i = 0; i < m_tasks.size(); i++)
+	waitForActiveTasks();
+}
+
+void TaskGroupParallel::startTask(
+	std::shared_ptr<TaskInfo> taskInfo, std::shared_ptr<Blackboard> blackboard)
+{
 	{
-		if (m_tasks[i]->thread)
-		{
-			m_tasks[i]->thread->join();
-			m_tasks[i]->thread.reset();
-		}
+		std::lock_guard<std::mutex> lock(m_activeTaskCountMutex);
+		taskInfo->active = true;
+		m_activeTaskCount++;
 	}
+
+	ThreadPool::getInstance()->run(
+		[this, taskInfo, blackboard]() { processTask(taskInfo, blackboard); });
 }
 
-void TaskGroupParallel::processTaskThreaded(
-	std::shared_ptr<TaskInfo> taskInfo,
-	std::shared_ptr<Blackboard> blackboard,
-	std::shared_ptr<std::mutex> activeTaskCountMutex)
+void TaskGroupParallel::processTask(
+	std::shared_ptr<TaskInfo> taskInfo, std::shared_ptr<Blackboard> blackboard)
 {
-	ScopedFunctor functor([&]() {
-		std::lock_guard<std::mutex> lock(*activeTaskCountMutex.get());
-		m_activeTaskCount--;
-	});
-
-	while (true)
+	TaskState state = STATE_RUNNING;
+	while (state != STATE_SUCCESS && state != STATE_FAILURE)
 	{
-		TaskState state = taskInfo->taskRunner->update(blackboard);
+		state = taskInfo->taskRunner->update(blackboard);
+	}
 
-		if (state == STATE_SUCCESS || state == STATE_FAILURE)
-		{
-			if (state == STATE_FAILURE)
-			{
-				m_taskFailed = true;
-			}
-			taskInfo->active = false;
-			break;
-		}
+	// notifying while locked, because this group may be destroyed right after the count reaches 0
+	std::lock_guard<std::mutex> lock(m_activeTaskCountMutex);
+	if (state == STATE_FAILURE)
+	{
+		m_taskFailed = true;
 	}
+	taskInfo->active = false;
+	m_activeTaskCount--;
+	m_activeTaskCountCondition.notify_all();
 }
 
-int TaskGroupParallel::getActiveTaskCount() const
+void TaskGroupParallel::waitForActiveTasks()
 {
-	std::lock_guard<std::mutex> lock(*m_activeTaskCountMutex.get());
-	return m_activeTaskCount;
+	std::unique_lock<std::mutex> lock(m_activeTaskCountMutex);
+	m_activeTaskCountCondition.wait(lock, [this]() { return m_activeTaskCount == 0; });
 }
@@ -1,13 +1,13 @@
 #ifndef TASK_GROUP_PARALLEL_H
 #define TASK_GROUP_PARALLEL_H
 
-#include <map>
+#include <condition_variable>
 #include <mutex>
-#include <thread>
 
 #include "TaskGroup.h"
 #include "TaskRunner.h"
 
+// Runs all child tasks at the same time on threads of the ThreadPool.
 class TaskGroupParallel: public TaskGroup
 {
 public:
@@ -20,8 +20,7 @@ private:
 	{
 		TaskInfo(std::shared_ptr<TaskRunner> taskRunner): taskRunner(taskRunner), active(false) {}
 		std::shared_ptr<TaskRunner> taskRunner;
-		std::shared_ptr<std::thread> thread;
-		volatile bool active;
+		bool active;
 	};
 
 	void doEnter(std::shared_ptr<Blackboard> blackboard) override;
@@ -30,18 +29,18 @@ private:
 	void doReset(std::shared_ptr<Blackboard> blackboard) override;
 	void doTerminate() override;
 
-	void processTaskThreaded(
-		std::shared_ptr<TaskInfo> taskInfo,
-		std::shared_ptr<Blackboard> blackboard,
-		std::shared_ptr<std::mutex> activeTaskCountMutex);
-	int getActiveTaskCount() const;
+	void startTask(std::shared_ptr<TaskInfo> taskInfo, std::shared_ptr<Blackboard> blackboard);
+	void processTask(std::shared_ptr<TaskInfo> taskInfo, std::shared_ptr<Blackboard> blackboard);
+	void waitForActiveTasks();
 
 	std::vector<std::shared_ptr<TaskInfo>> m_tasks;
 	bool m_needsToStartThreads;
 
-	volatile bool m_taskFailed;
-	volatile int m_activeTaskCount;
-	mutable std::shared_ptr<std::mutex> m_activeTaskCountMutex;
+	// guarded by the mutex, as well as the active flags of the tasks
+	bool m_taskFailed;
+	int m_activeTaskCount;
+	std::mutex m_activeTaskCountMutex;
+	std::condition_variable m_activeTaskCountCondition;
 };
 
 #endif	  // TASK_GROUP_PARALLEL_H
@@ -1,6 +1,5 @@
 #include "TaskScheduler.h"
 
-#include <chrono>
 #include <thread>
 
 #include "ScopedFunctor.h"
@@ -23,6 +22,7 @@ void TaskScheduler::pushTask(std::shared_ptr<Task> task)
 {
 	std::lock_guard<std::mutex> lock(m_tasksMutex);
 	m_taskRunners.push_back(std::make_shared<TaskRunner>(task));
+	m_tasksCondition.notify_all();
 }
 
 void TaskScheduler::pushNextTask(std::shared_ptr<Task> task)
@@ -37,14 +37,18 @@ void TaskScheduler::pushNextTask(std::shared_ptr<Task> task)
 	{
 		m_taskRunners.insert(m_taskRunners.begin() + 1, std::make_shared<TaskRunner>(task));
 	}
+	m_tasksCondition.notify_all();
 }
 
 void TaskScheduler::startSchedulerLoopThreaded()
 {
-	std::thread(&TaskScheduler::startSchedulerLoop, this).detach();
+	{
+		// set before starting, so a loop that stops right away can't be overwritten
+		std::lock_guard<std::mutex> lock(m_threadMutex);
+		m_threadIsRunning = true;
+	}
 
-	std::lock_guard<std::mutex> lock(m_threadMutex);
-	m_threadIsRunning = true;
+	std::thread(&TaskScheduler::startSchedulerLoop, this).detach();
 }
 
 void TaskScheduler::startSchedulerLoop()
@@ -65,16 +69,13 @@ void TaskScheduler::startSchedulerLoop()
 	{
 		processTasks();
 
-		{
-			std::lock_guard<std::mutex> lock(m_loopMutex);
+		std::unique_lock<std::mutex> lock(m_tasksMutex);
+		m_tasksCondition.wait(lock, [this]() { return m_taskRunners.size() || !loopIsRunning(); });
 
-			if (!m_loopIsRunning)
-			{
-				break;
-			}
+		if (!loopIsRunning())
+		{
+			break;
 		}
-
-		std::this_thread::sleep_for(std::chrono::milliseconds(25));
 	}
 
 	{
@@ -82,6 +83,7 @@ void TaskScheduler::startSchedulerLoop()
 		if (m_threadIsRunning)
 		{
 			m_threadIsRunning = false;
+			m_threadCondition.notify_all();
 		}
 	}
 }
@@ -99,18 +101,10 @@ void TaskScheduler::stopSchedulerLoop()
 		m_loopIsRunning = false;
 	}
 
-	while (true)
-	{
-		{
-			std::lock_guard<std::mutex> lock(m_threadMutex);
-			if (!m_threadIsRunning)
-			{
-				break;
-			}
-		}
+	notifyTasksChanged();
 
-		std::this_thread::sleep_for(std::chrono::milliseconds(25));
-	}
+	std::unique_lock<std::mutex> lock(m_threadMutex);
+	m_threadCondition.wait(lock, [this]() { return !m_threadIsRunning; });
 }
 
 bool TaskScheduler::loopIsRunning() const
@@ -125,6 +119,13 @@ bool TaskScheduler::hasTasksQueued() const
 	return m_taskRunners.size();
 }
 
+void TaskScheduler::notifyTasksChanged()
+{
+	// locking makes sure the loop either sees the change or is already waiting for the notification
+	std::lock_guard<std::mutex> lock(m_tasksMutex);
+	m_tasksCondition.notify_all();
+}
+
 void TaskScheduler::terminateRunningTasks()
 {
 	m_terminateRunningTasks = true;
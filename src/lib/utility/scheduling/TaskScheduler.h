@@ -1,6 +1,7 @@
 #ifndef TASK_SCHEDULER_H
 #define TASK_SCHEDULER_H
 
+#include <condition_variable>
 #include <deque>
 #include <memory>
 #include <mutex>
@@ -29,6 +30,7 @@ public:
 
 private:
 	void processTasks();
+	void notifyTasksChanged();
 
 	const Id m_schedulerId;
 
@@ -38,9 +40,14 @@ private:
 
 	std::deque<std::shared_ptr<TaskRunner>> m_taskRunners;
 
+	// when locking both, the tasks mutex is locked first
 	mutable std::mutex m_tasksMutex;
 	mutable std::mutex m_loopMutex;
 	mutable std::mutex m_threadMutex;
+
+	// notified when tasks are pushed, the loop is stopped or the loop thread finished
+	std::condition_variable m_tasksCondition;
+	std::condition_variable m_threadCondition;
 };
 
 #endif	  // TASK_SCHEDULER_H
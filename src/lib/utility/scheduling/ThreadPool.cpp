@@ -0,0 +1,73 @@
+#include "ThreadPool.h"
+
+#include <chrono>
+#include <thread>
+
+const size_t ThreadPool::s_idleTimeoutMS = 30000;
+
+std::shared_ptr<ThreadPool> ThreadPool::getInstance()
+{
+	static std::shared_ptr<ThreadPool> s_instance(new ThreadPool());
+	return s_instance;
+}
+
+void ThreadPool::run(std::function<void()> function)
+{
+	std::lock_guard<std::mutex> lock(m_state->mutex);
+
+	m_state->functions.push_back(std::move(function));
+
+	// idle threads that were already notified are counted until they took a function
+	if (m_state->idleThreadCount >= m_state->functions.size())
+	{
+		m_state->condition.notify_one();
+		return;
+	}
+
+	m_state->threadCount++;
+	std::thread(&ThreadPool::runThread, m_state).detach();
+}
+
+size_t ThreadPool::getThreadCount() const
+{
+	std::lock_guard<std::mutex> lock(m_state->mutex);
+	return m_state->threadCount;
+}
+
+size_t ThreadPool::getIdleThreadCount() const
+{
+	std::lock_guard<std::mutex> lock(m_state->mutex);
+	return m_state->idleThreadCount;
+}
+
+void ThreadPool::runThread(std::shared_ptr<State> state)
+{
+	std::unique_lock<std::mutex> lock(state->mutex);
+	while (true)
+	{
+		if (state->functions.empty())
+		{
+			state->idleThreadCount++;
+			const bool hasFunction = state->condition.wait_for(
+				lock, std::chrono::milliseconds(s_idleTimeoutMS), [state]() {
+					return !state->functions.empty();
+				});
+			state->idleThreadCount--;
+
+			if (!hasFunction)
+			{
+				state->threadCount--;
+				return;
+			}
+		}
+
+		std::function<void()> function = std::move(state->functions.front());
+		state->functions.pop_front();
+
+		lock.unlock();
+		function();
+		lock.lock();
+	}
+}
+
+ThreadPool::ThreadPool(): m_state(std::make_shared<State>()) {}
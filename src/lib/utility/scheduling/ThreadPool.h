@@ -0,0 +1,45 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+// Runs functions on threads that are kept alive and reused after a function returned. A new
+// thread is started whenever no thread is idle, so functions that block until other functions
+// finish can't starve each other. Idle threads quit after a while.
+class ThreadPool
+{
+public:
+	static std::shared_ptr<ThreadPool> getInstance();
+
+	void run(std::function<void()> function);
+
+	size_t getThreadCount() const;
+	size_t getIdleThreadCount() const;
+
+private:
+	// owned by the threads as well, so threads still running at shutdown don't outlive it
+	struct State
+	{
+		std::mutex mutex;
+		std::condition_variable condition;
+		std::deque<std::function<void()>> functions;
+		size_t threadCount = 0;
+		size_t idleThreadCount = 0;
+	};
+
+	static void runThread(std::shared_ptr<State> state);
+
+	static const size_t s_idleTimeoutMS;
+
+	ThreadPool();
+	ThreadPool(const ThreadPool&) = delete;
+	void operator=(const ThreadPool&) = delete;
+
+	std::shared_ptr<State> m_state;
+};
+
+#endif	  // THREAD_POOL_H
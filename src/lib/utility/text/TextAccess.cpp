@@ -6,43 +6,35 @@
 
 namespace
 {
-std::istream& safeGetline(std::istream& is, std::string& t)
+// converts "\r\n" and "\r" line endings to "\n" and terminates the last line
+std::string normalizeLineEndings(const std::string& content)
 {
-	t.clear();
+	std::string text;
+	text.reserve(content.size() + 1);
 
-	// The characters in the stream are read one-by-one using a std::streambuf.
-	// That is faster than reading them one-by-one using the std::istream.
-	// Code that uses streambuf this way must be guarded by a sentry object.
-	// The sentry object performs various tasks,
-	// such as thread synchronization and updating the stream state.
-
-	std::istream::sentry se(is, true);
-	std::streambuf* sb = is.rdbuf();
-
-	while (true)
+	for (size_t i = 0; i < content.size(); i++)
 	{
-		const int c = sb->sbumpc();
-		switch (c)
+		const char c = content[i];
+		if (c == '\r')
 		{
-		case '\n':
-			return is;
-		case '\r':
-			if (sb->sgetc() == '\n')
-			{
-				sb->sbumpc();
-			}
-			return is;
-		case std::streambuf::traits_type::eof():
-			// Also handle the case when the last line has no line ending
-			if (t.empty())
+			if (i + 1 < content.size() && content[i + 1] == '\n')
 			{
-				is.setstate(std::ios::eofbit);
+				i++;
 			}
-			return is;
-		default:
-			t += (char)c;
+			text += '\n';
+		}
+		else
+		{
+			text += c;
 		}
 	}
+
+	if (!text.empty() && text.back() != '\n')
+	{
+		text += '\n';
+	}
+
+	return text;
 }
 }	 // namespace
 
@@ -51,7 +43,8 @@ std::shared_ptr<TextAccess> TextAccess::createFromFile(const FilePath& filePath)
 	std::shared_ptr<TextAccess> result(new TextAccess());
 
 	result->m_filePath = filePath;
-	result->m_lines = readFile(filePath);
+	result->m_text = readFile(filePath);
+	result->m_lineOffsets = getLineOffsets(result->m_text);
 
 	return result;
 }
@@ -60,7 +53,8 @@ std::shared_ptr<TextAccess> TextAccess::createFromString(const std::string& text
 {
 	std::shared_ptr<TextAccess> result(new TextAccess());
 
-	result->m_lines = splitStringByLines(text);
+	result->m_text = text;
+	result->m_lineOffsets = getLineOffsets(result->m_text);
 	result->m_filePath = filePath;
 
 	return result;
@@ -71,7 +65,19 @@ std::shared_ptr<TextAccess> TextAccess::createFromLines(
 {
 	std::shared_ptr<TextAccess> result(new TextAccess());
 
-	result->m_lines = lines;
+	size_t size = 0;
+	for (const std::string& line: lines)
+	{
+		size += line.size();
+	}
+
+	result->m_text.reserve(size);
+	result->m_lineOffsets.reserve(lines.size());
+	for (const std::string& line: lines)
+	{
+		result->m_lineOffsets.push_back(result->m_text.size());
+		result->m_text += line;
+	}
 	result->m_filePath = filePath;
 
 	return result;
@@ -79,12 +85,12 @@ std::shared_ptr<TextAccess> TextAccess::createFromLines(
 
 unsigned int TextAccess::getLineCount() const
 {
-	return static_cast<unsigned int>(m_lines.size());
+	return static_cast<unsigned int>(m_lineOffsets.size());
 }
 
 bool TextAccess::isEmpty() const
 {
-	return m_lines.empty();
+	return m_lineOffsets.empty();
 }
 
 FilePath TextAccess::getFilePath() const
@@ -94,48 +100,62 @@ FilePath TextAccess::getFilePath() const
 
 std::string TextAccess::getLine(const unsigned int lineNumber) const
 {
-	if (!checkIndexInRange(lineNumber))
+	return std::string(getLineView(lineNumber));
+}
+
+std::vector<std::string> TextAccess::getLines(
+	const unsigned int firstLineNumber, const unsigned int lastLineNumber) const
+{
+	if (!checkIndexIntervalInRange(firstLineNumber, lastLineNumber))
 	{
-		return "";
+		return std::vector<std::string>();
 	}
 
-	return m_lines[lineNumber - 1];	   // -1 to correct for use as index
+	std::vector<std::string> lines;
+	lines.reserve(lastLineNumber - firstLineNumber + 1);
+	for (unsigned int i = firstLineNumber; i <= lastLineNumber; i++)
+	{
+		const size_t offset = m_lineOffsets[i - 1];	   // -1 to correct for use as index
+		lines.emplace_back(m_text, offset, getLineEndOffset(i) - offset);
+	}
+	return lines;
 }
 
-std::vector<std::string> TextAccess::getLines(
-	const unsigned int firstLineNumber, const unsigned int lastLineNumber)
+std::vector<std::string> TextAccess::getAllLines() const
 {
-	if (!checkIndexIntervalInRange(firstLineNumber, lastLineNumber))
+	if (isEmpty())
 	{
 		return std::vector<std::string>();
 	}
 
-	std::vector<std::string>::iterator first = m_lines.begin() + firstLineNumber -
-		1;	  // -1 to correct for use as index
-	std::vector<std::string>::iterator last = m_lines.begin() + lastLineNumber;
-	return std::vector<std::string>(first, last);
+	return getLines(1, getLineCount());
 }
 
-const std::vector<std::string>& TextAccess::getAllLines() const
+const std::string& TextAccess::getText() const
 {
-	return m_lines;
+	return m_text;
 }
 
-std::string TextAccess::getText() const
+std::string_view TextAccess::getLineView(const unsigned int lineNumber) const
 {
-	std::string result = "";
+	return getTextView(lineNumber, lineNumber);
+}
 
-	for (unsigned int i = 0; i < m_lines.size(); i++)
+std::string_view TextAccess::getTextView(
+	const unsigned int firstLineNumber, const unsigned int lastLineNumber) const
+{
+	if (!checkIndexIntervalInRange(firstLineNumber, lastLineNumber))
 	{
-		result += m_lines[i];
+		return std::string_view();
 	}
 
-	return result;
+	const size_t offset = m_lineOffsets[firstLineNumber - 1];	 // -1 to correct for use as index
+	return std::string_view(m_text).substr(offset, getLineEndOffset(lastLineNumber) - offset);
 }
 
-std::vector<std::string> TextAccess::readFile(const FilePath& filePath)
+std::string TextAccess::readFile(const FilePath& filePath)
 {
-	std::vector<std::string> result;
+	std::string result;
 
 	try
 	{
@@ -148,14 +168,20 @@ std::vector<std::string> TextAccess::readFile(const FilePath& filePath)
 			return result;
 		}
 
-		while (!srcFile.eof())
+		std::string content;
+		srcFile.seekg(0, std::ios::end);
+		const std::streamoff size = srcFile.tellg();
+		if (size > 0)
 		{
-			std::string line;
-			safeGetline(srcFile, line);
-			result.push_back(line + '\n');
+			content.resize(static_cast<size_t>(size));
+			srcFile.seekg(0, std::ios::beg);
+			srcFile.read(&content[0], size);
+			content.resize(static_cast<size_t>(srcFile.gcount()));
 		}
 
 		srcFile.close();
+
+		result = normalizeLineEndings(content);
 	}
 	catch (std::exception& e)
 	{
@@ -169,36 +195,24 @@ std::vector<std::string> TextAccess::readFile(const FilePath& filePath)
 		result.clear();
 	}
 
-	if (!result.empty())
-	{
-		std::string last = result.back().substr(0, result.back().size() - 1);
-		result.pop_back();
-		if (!last.empty())
-		{
-			result.push_back(last);
-		}
-	}
-
 	return result;
 }
 
-std::vector<std::string> TextAccess::splitStringByLines(const std::string& text)
+std::vector<size_t> TextAccess::getLineOffsets(const std::string& text)
 {
-	std::vector<std::string> result;
-	size_t prevIndex = 0;
-	size_t index = text.find('\n');
+	std::vector<size_t> result;
+	size_t offset = 0;
 
-	while (index != std::string::npos)
+	while (offset < text.length())
 	{
-		result.push_back(text.substr(prevIndex, index - prevIndex) + '\n');
-
-		prevIndex = index + 1;
-		index = text.find('\n', prevIndex);
-	}
+		result.push_back(offset);
 
-	if (prevIndex < text.length())
-	{
-		result.push_back(text.substr(prevIndex));
+		const size_t index = text.find('\n', offset);
+		if (index == std::string::npos)
+		{
+			break;
+		}
+		offset = index + 1;
 	}
 
 	return result;
@@ -206,6 +220,10 @@ std::vector<std::string> TextAccess::splitStringByLines(const std::string& text)
 
 TextAccess::TextAccess(): m_filePath(L"") {}
 
+size_t TextAccess::getLineEndOffset(const unsigned int lineNumber) const
+{
+	return lineNumber < m_lineOffsets.size() ? m_lineOffsets[lineNumber] : m_text.size();
+}
 bool TextAccess::checkIndexInRange(const unsigned int index) const
 {
 	if (index < 1)
@@ -213,10 +231,10 @@ bool TextAccess::checkIndexInRange(const unsigned int index) const
 		LOG_WARNING_STREAM(<< "Line numbers start with one, is " << index);
 		return false;
 	}
-	else if (index > m_lines.size())
+	else if (index > m_lineOffsets.size())
 	{
 		LOG_WARNING_STREAM(
-			<< "Tried to access index " << index << ". Maximum index is " << m_lines.size());
+			<< "Tried to access index " << index << ". Maximum index is " << m_lineOffsets.size());
 		return false;
 	}
 
@@ -3,6 +3,7 @@
 
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "FilePath.h"
@@ -32,13 +33,25 @@ public:
 	 * @param lastLineNumber: starts with 1
 	 */
 	std::vector<std::string> getLines(
-		const unsigned int firstLineNumber, const unsigned int lastLineNumber);
-	const std::vector<std::string>& getAllLines() const;
-	std::string getText() const;
+		const unsigned int firstLineNumber, const unsigned int lastLineNumber) const;
+	std::vector<std::string> getAllLines() const;
+	const std::string& getText() const;
+
+	/**
+	 * Views into the text buffer, only valid as long as this TextAccess exists.
+	 * @param lineNumber: starts with 1
+	 */
+	std::string_view getLineView(const unsigned int lineNumber) const;
+	/**
+	 * @param firstLineNumber: starts with 1
+	 * @param lastLineNumber: starts with 1
+	 */
+	std::string_view getTextView(
+		const unsigned int firstLineNumber, const unsigned int lastLineNumber) const;
 
 private:
-	static std::vector<std::string> readFile(const FilePath& filePath);
-	static std::vector<std::string> splitStringByLines(const std::string& text);
+	static std::string readFile(const FilePath& filePath);
+	static std::vector<size_t> getLineOffsets(const std::string& text);
 
 	TextAccess();
 	TextAccess(const TextAccess&);
@@ -47,8 +60,11 @@ private:
 	bool checkIndexInRange(const unsigned int index) const;
 	bool checkIndexIntervalInRange(const unsigned int firstIndex, const unsigned int lastIndex) const;
 
+	size_t getLineEndOffset(const unsigned int lineNumber) const;
+
 	FilePath m_filePath;
-	std::vector<std::string> m_lines;
+	std::string m_text;
+	std::vector<size_t> m_lineOffsets;	  // start of each line within m_text
 };
 
 #endif	  // TEXT_ACCESS_H
@@ -2,6 +2,8 @@
 #define TRACING_H
 
 
+// TRACE() records into the TraceRecorder, which is switched on at runtime. Defining
+// TRACING_ENABLED replaces it with the tracers below that print their report on PRINT_TRACES().
 // #define TRACING_ENABLED
 // #define USE_ACCUMULATED_TRACING
 
@@ -12,6 +14,7 @@
 
 #include "FilePath.h"
 #include "TimeStamp.h"
+#include "TraceRecorder.h"
 #include "types.h"
 #include "utilityString.h"
 
@@ -148,7 +151,11 @@ ScopedTrace<TracerType>::~ScopedTrace()
 
 
 #else
-#	define TRACE(__name__)
+#	define TRACE(__name__)                                                                        \
+		static const uint32_t __trace_name_id__ =                                                  \
+			TraceRecorder::getInstance()->registerEventName(std::string(__name__), __FUNCTION__);  \
+		ScopedTraceRecord __trace__(__trace_name_id__)
+
 #	define PRINT_TRACES()
 #endif
 
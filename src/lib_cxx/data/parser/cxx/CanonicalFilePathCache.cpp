@@ -2,11 +2,15 @@
 
 #include <clang/AST/ASTContext.h>
 #include <clang/Basic/FileManager.h>
+#include "FilePathCanonicalizer.h"
 #include "utilityClang.h"
 #include "utilityString.h"
 
 CanonicalFilePathCache::CanonicalFilePathCache(std::shared_ptr<FileRegister> fileRegister)
 	: m_fileRegister(fileRegister)
+	, m_resolvedPathCount(0)
+	, m_reusedPathCount(0)
+	, m_savedFileSystemCallCount(0)
 {
 }
 
@@ -56,7 +60,20 @@ FilePath CanonicalFilePathCache::getCanonicalFilePath(const std::wstring& path)
 		return it->second;
 	}
 
-	const FilePath canonicalPath = FilePath(path).makeCanonical();
+	// paths resolved while indexing earlier translation units are taken from the process wide cache
+	std::shared_ptr<FilePathCanonicalizer> canonicalizer = FilePathCanonicalizer::getInstance();
+	FilePath canonicalPath = canonicalizer->getCachedCanonicalFilePath(
+		path, &m_savedFileSystemCallCount);
+	if (canonicalPath.empty())
+	{
+		canonicalPath = canonicalizer->resolveCanonicalFilePath(path);
+		m_resolvedPathCount++;
+	}
+	else
+	{
+		m_reusedPathCount++;
+	}
+
 	const std::wstring lowercaseCanonicalPath = utility::toLowerCase(canonicalPath.wstr());
 
 	m_fileStringMap.emplace(std::move(lowercasePath), canonicalPath);
@@ -65,6 +82,21 @@ FilePath CanonicalFilePathCache::getCanonicalFilePath(const std::wstring& path)
 	return canonicalPath;
 }
 
+size_t CanonicalFilePathCache::getResolvedPathCount() const
+{
+	return m_resolvedPathCount;
+}
+
+size_t CanonicalFilePathCache::getReusedPathCount() const
+{
+	return m_reusedPathCount;
+}
+
+size_t CanonicalFilePathCache::getSavedFileSystemCallCount() const
+{
+	return m_savedFileSystemCallCount;
+}
+
 FilePath CanonicalFilePathCache::getCanonicalFilePath(const Id symbolId)
 {
 	auto it = m_symbolIdFileIdMap.find(symbolId);
@@ -24,6 +24,12 @@ public:
 	FilePath getCanonicalFilePath(const std::wstring& path);
 	FilePath getCanonicalFilePath(const Id symbolId);
 
+	// number of paths resolved on the file system and taken from earlier translation units
+	size_t getResolvedPathCount() const;
+	size_t getReusedPathCount() const;
+	// number of file system calls that resolving the reused paths would have taken
+	size_t getSavedFileSystemCallCount() const;
+
 	void addFileSymbolId(const clang::FileID& fileId, const FilePath& path, Id symbolId);
 	Id getFileSymbolId(const clang::FileID& fileId);
 	Id getFileSymbolId(const clang::FileEntry* entry);
@@ -45,6 +51,10 @@ private:
 	std::unordered_map<std::wstring, Id> m_fileStringSymbolIdMap;
 
 	std::map<clang::FileID, bool> m_isProjectFileMap;
+
+	size_t m_resolvedPathCount;
+	size_t m_reusedPathCount;
+	size_t m_savedFileSystemCallCount;
 };
 
 #endif	  // CANONICAL_FILE_PATH_CACHE_H
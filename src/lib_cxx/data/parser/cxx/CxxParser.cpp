@@ -202,6 +202,13 @@ void CxxParser::runTool(
 		m_client, canonicalFilePathCache, m_indexerStateInfo);
 	tool.run(new SingleFrontendActionFactory(action));
 
+	LOG_INFO(
+		"Canonical file paths: " + std::to_string(canonicalFilePathCache->getResolvedPathCount()) +
+		" resolved, " + std::to_string(canonicalFilePathCache->getReusedPathCount()) +
+		" reused from earlier translation units, " +
+		std::to_string(canonicalFilePathCache->getSavedFileSystemCallCount()) +
+		" file system calls saved");
+
 	if (!m_client->hasContent())
 	{
 		if (info.invocation.empty())
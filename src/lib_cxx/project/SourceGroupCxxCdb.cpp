@@ -8,6 +8,7 @@
 #include "ClangInvocationInfo.h"
 #include "CxxCompilationDatabaseSingle.h"
 #include "CxxIndexerCommandProvider.h"
+#include "FilePathFilterMatcher.h"
 #include "IndexerCommandCxx.h"
 #include "MessageStatus.h"
 #include "SourceGroupSettingsCxxCdb.h"
@@ -59,12 +60,12 @@ std::set<FilePath> SourceGroupCxxCdb::getAllSourceFilePaths(
 
 	if (cdb)
 	{
-		const std::vector<FilePathFilter> excludeFilters =
-			m_settings->getExcludeFiltersExpandedAndAbsolute();
+		const FilePathFilterMatcher excludeFilterMatcher(
+			m_settings->getExcludeFiltersExpandedAndAbsolute());
 		for (const FilePath& path: IndexerCommandCxx::getSourceFilesFromCDB(
 				 cdb, m_settings->getCompilationDatabasePathExpandedAndAbsolute()))
 		{
-			bool excluded = FilePathFilter::areMatching(excludeFilters, path);
+			bool excluded = excludeFilterMatcher.isMatching(path);
 			if (!excluded && path.exists())
 			{
 				sourceFilePaths.insert(path);
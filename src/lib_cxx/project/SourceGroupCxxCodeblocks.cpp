@@ -4,6 +4,7 @@
 #include "ApplicationSettings.h"
 #include "CodeblocksProject.h"
 #include "CxxIndexerCommandProvider.h"
+#include "FilePathFilterMatcher.h"
 #include "IndexerCommandCxx.h"
 #include "MessageStatus.h"
 #include "SourceGroupSettingsCxxCodeblocks.h"
@@ -46,13 +47,13 @@ std::set<FilePath> SourceGroupCxxCodeblocks::getAllSourceFilePaths() const
 	if (std::shared_ptr<Codeblocks::Project> project = Codeblocks::Project::load(
 			m_settings->getCodeblocksProjectPathExpandedAndAbsolute()))
 	{
-		const std::vector<FilePathFilter> excludeFilters =
-			m_settings->getExcludeFiltersExpandedAndAbsolute();
+		const FilePathFilterMatcher excludeFilterMatcher(
+			m_settings->getExcludeFiltersExpandedAndAbsolute());
 
 		for (const FilePath& filePath:
 			 project->getAllSourceFilePathsCanonical(m_settings->getSourceExtensions()))
 		{
-			bool isExcluded = FilePathFilter::areMatching(excludeFilters, filePath);
+			bool isExcluded = excludeFilterMatcher.isMatching(filePath);
 			if (!isExcluded && filePath.exists())
 			{
 				sourceFilePaths.insert(filePath);
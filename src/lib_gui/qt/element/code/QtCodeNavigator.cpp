@@ -4,6 +4,7 @@
 #include <QButtonGroup>
 #include <QHBoxLayout>
 #include <QLabel>
+#include <QPushButton>
 #include <QScrollBar>
 #include <QStyle>
 #include <QTimer>
@@ -15,6 +16,7 @@
 #include "MessageFocusView.h"
 #include "MessageHistoryRedo.h"
 #include "MessageHistoryUndo.h"
+#include "MessageLoadMoreFullTextSearchResults.h"
 #include "MessageScrollCode.h"
 #include "MessageTabOpenWith.h"
 #include "MessageToNextCodeReference.h"
@@ -86,6 +88,18 @@ QtCodeNavigator::QtCodeNavigator(QWidget* parent)
 			m_refLabel->setObjectName(QStringLiteral("references_label"));
 			navLayout->addWidget(m_refLabel);
 
+			m_loadMoreButton = new QPushButton(QStringLiteral("load more"));
+			m_loadMoreButton->setObjectName(QStringLiteral("load_more_button"));
+			m_loadMoreButton->setToolTip(QStringLiteral("search the next files for more results"));
+			m_loadMoreButton->hide();
+			navLayout->addWidget(m_loadMoreButton);
+
+			connect(
+				m_loadMoreButton,
+				&QPushButton::clicked,
+				this,
+				&QtCodeNavigator::loadMoreFullTextSearchResults);
+
 			navLayout->addStretch();
 		}
 
@@ -248,6 +262,11 @@ void QtCodeNavigator::updateReferenceCount(
 	m_localRefLabel->setVisible(localReferenceCount > 1);
 }
 
+void QtCodeNavigator::setHasMoreFullTextSearchResults(bool hasMoreResults)
+{
+	m_loadMoreButton->setVisible(hasMoreResults);
+}
+
 void QtCodeNavigator::clear()
 {
 	clearSnippets();
@@ -261,6 +280,7 @@ void QtCodeNavigator::clear()
 	m_errorInfos.clear();
 
 	updateReferenceCount(0, 0, 0, 0);
+	setHasMoreFullTextSearchResults(false);
 }
 
 void QtCodeNavigator::clearSnippets()
@@ -910,6 +930,11 @@ void QtCodeNavigator::nextLocalReference()
 	MessageCodeReference(MessageCodeReference::REFERENCE_NEXT, true).dispatch();
 }
 
+void QtCodeNavigator::loadMoreFullTextSearchResults()
+{
+	MessageLoadMoreFullTextSearchResults().dispatch();
+}
+
 void QtCodeNavigator::setModeList()
 {
 	if (m_mode == MODE_LIST)
@@ -44,6 +44,7 @@ public:
 		size_t referenceIndex,
 		size_t localReferenceCount,
 		size_t localReferenceIndex);
+	void setHasMoreFullTextSearchResults(bool hasMoreResults);
 
 	void clear();
 	void clearSnippets();
@@ -125,6 +126,8 @@ private slots:
 	void previousLocalReference();
 	void nextLocalReference();
 
+	void loadMoreFullTextSearchResults();
+
 	void setModeList();
 	void setModeSingle();
 
@@ -157,6 +160,7 @@ private:
 	QtSearchBarButton* m_prevReferenceButton;
 	QtSearchBarButton* m_nextReferenceButton;
 	QLabel* m_refLabel;
+	QPushButton* m_loadMoreButton;
 
 	QtSearchBarButton* m_prevLocalReferenceButton;
 	QtSearchBarButton* m_nextLocalReferenceButton;
@@ -0,0 +1,202 @@
+#include "QtQueryLoadTest.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+#include <QLocalSocket>
+
+#include "QueryProtocolHelper.h"
+#include "TextAccess.h"
+
+namespace
+{
+const int s_timeoutMilliseconds = 30000;
+
+bool readLine(QLocalSocket& socket, std::string& line)
+{
+	while (!socket.canReadLine())
+	{
+		if (!socket.waitForReadyRead(s_timeoutMilliseconds))
+		{
+			return false;
+		}
+	}
+
+	const QByteArray data = socket.readLine();
+	line.assign(data.constData(), data.size());
+	return true;
+}
+
+double getPercentile(const std::vector<double>& sortedValues, double percentile)
+{
+	if (sortedValues.empty())
+	{
+		return 0.0;
+	}
+
+	const size_t index = static_cast<size_t>(percentile / 100.0 * (sortedValues.size() - 1) + 0.5);
+	return sortedValues[std::min(index, sortedValues.size() - 1)];
+}
+}	 // namespace
+
+QtQueryLoadTest::QtQueryLoadTest(
+	const std::wstring& socketName,
+	const FilePath& requestsFilePath,
+	size_t connectionCount,
+	size_t requestCount)
+	: m_socketName(socketName)
+	, m_requestsFilePath(requestsFilePath)
+	, m_connectionCount(connectionCount)
+	, m_requestCount(requestCount)
+	, m_nextRequestIndex(0)
+{
+}
+
+bool QtQueryLoadTest::run() const
+{
+	std::vector<std::string> requests;
+	for (std::string line: TextAccess::createFromFile(m_requestsFilePath)->getAllLines())
+	{
+		while (!line.empty() && (line.back() == '\n' || line.back() == '\r'))
+		{
+			line.pop_back();
+		}
+
+		if (!line.empty() && line[0] != '#')
+		{
+			requests.push_back(line);
+		}
+	}
+
+	if (requests.empty())
+	{
+		std::cerr << "ERROR: The requests file contains no queries." << std::endl;
+		return false;
+	}
+
+	m_nextRequestIndex = 0;
+	std::vector<ConnectionResult> results(m_connectionCount);
+
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	{
+		std::vector<std::thread> threads;
+		for (size_t i = 0; i < m_connectionCount; i++)
+		{
+			threads.emplace_back(
+				[this, &requests, &results, i]() { results[i] = runConnection(requests); });
+		}
+		for (std::thread& thread: threads)
+		{
+			thread.join();
+		}
+	}
+	const double durationSeconds =
+		std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	std::vector<double> latenciesMS;
+	size_t connectedCount = 0;
+	size_t errorCount = 0;
+	for (const ConnectionResult& result: results)
+	{
+		connectedCount += result.connected ? 1 : 0;
+		errorCount += result.errorCount;
+		latenciesMS.insert(latenciesMS.end(), result.latenciesMS.begin(), result.latenciesMS.end());
+	}
+
+	if (latenciesMS.empty())
+	{
+		std::cerr << "ERROR: No query was answered by the server." << std::endl;
+		return false;
+	}
+
+	std::sort(latenciesMS.begin(), latenciesMS.end());
+
+	std::cout << std::fixed << std::setprecision(2);
+	std::cout << "connections:    " << connectedCount << "/" << m_connectionCount << "\n";
+	std::cout << "queries:        " << latenciesMS.size() << "\n";
+	std::cout << "errors:         " << errorCount << "\n";
+	std::cout << "duration:       " << durationSeconds << " s\n";
+	std::cout << "queries/sec:    " << latenciesMS.size() / std::max(durationSeconds, 0.000001)
+			  << "\n";
+	std::cout << "latency p50:    " << getPercentile(latenciesMS, 50) << " ms\n";
+	std::cout << "latency p90:    " << getPercentile(latenciesMS, 90) << " ms\n";
+	std::cout << "latency p99:    " << getPercentile(latenciesMS, 99) << " ms\n";
+	std::cout << "latency max:    " << latenciesMS.back() << " ms" << std::endl;
+
+	return true;
+}
+
+QtQueryLoadTest::ConnectionResult QtQueryLoadTest::runConnection(
+	const std::vector<std::string>& requests) const
+{
+	ConnectionResult result;
+
+	QLocalSocket socket;
+	socket.connectToServer(QString::fromStdWString(m_socketName));
+	if (!socket.waitForConnected(s_timeoutMilliseconds))
+	{
+		std::cerr << "ERROR: Failed to connect to query server: "
+				  << socket.errorString().toStdString() << std::endl;
+		return result;
+	}
+	result.connected = true;
+
+	while (true)
+	{
+		const size_t index = m_nextRequestIndex++;
+		if (index >= m_requestCount)
+		{
+			break;
+		}
+
+		const std::string request =
+			std::to_string(index + 1) + '\t' + requests[index % requests.size()] + '\n';
+
+		const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+		socket.write(request.data(), request.size());
+		if (!socket.waitForBytesWritten(s_timeoutMilliseconds))
+		{
+			result.errorCount++;
+			break;
+		}
+
+		std::string line;
+		if (!readLine(socket, line))
+		{
+			result.errorCount++;
+			break;
+		}
+
+		const QueryProtocolHelper::ResponseHeader header =
+			QueryProtocolHelper::parseResponseHeader(line);
+
+		size_t rowCount = 0;
+		while (rowCount < header.rowCount && readLine(socket, line))
+		{
+			rowCount++;
+		}
+
+		if (rowCount < header.rowCount)
+		{
+			result.errorCount++;
+			break;
+		}
+
+		if (!header.valid || !header.ok)
+		{
+			result.errorCount++;
+			continue;
+		}
+
+		const std::chrono::duration<double, std::milli> latency =
+			std::chrono::steady_clock::now() - start;
+		result.latenciesMS.push_back(latency.count());
+	}
+
+	socket.disconnectFromServer();
+	return result;
+}
@@ -0,0 +1,42 @@
+#ifndef QT_QUERY_LOAD_TEST_H
+#define QT_QUERY_LOAD_TEST_H
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include "FilePath.h"
+
+// Client for measuring a running QtQueryServer. Each connection sends its next query as soon as
+// the previous one is answered, the queries of the requests file are used in turn.
+class QtQueryLoadTest
+{
+public:
+	QtQueryLoadTest(
+		const std::wstring& socketName,
+		const FilePath& requestsFilePath,
+		size_t connectionCount,
+		size_t requestCount);
+
+	// prints throughput and latency percentiles, returns false if nothing could be measured
+	bool run() const;
+
+private:
+	struct ConnectionResult
+	{
+		bool connected = false;
+		std::vector<double> latenciesMS;
+		size_t errorCount = 0;
+	};
+
+	ConnectionResult runConnection(const std::vector<std::string>& requests) const;
+
+	const std::wstring m_socketName;
+	const FilePath m_requestsFilePath;
+	const size_t m_connectionCount;
+	const size_t m_requestCount;
+
+	mutable std::atomic<size_t> m_nextRequestIndex;
+};
+
+#endif	  // QT_QUERY_LOAD_TEST_H
@@ -0,0 +1,112 @@
+#include "QtQueryServer.h"
+
+#include <QMetaObject>
+
+#include "logging.h"
+
+QtQueryServer::QtQueryServer(
+	const std::wstring& socketName,
+	std::shared_ptr<const PersistentStorage> storage,
+	size_t workerCount,
+	size_t maxPendingRequestCount)
+	: QueryServer(storage, workerCount, maxPendingRequestCount)
+	, m_socketName(QString::fromStdWString(socketName))
+	, m_server(new QLocalServer(this))
+{
+	connect(m_server, &QLocalServer::newConnection, this, &QtQueryServer::acceptConnections);
+}
+
+QtQueryServer::~QtQueryServer()
+{
+	stopWorkers();
+	stopListening();
+}
+
+bool QtQueryServer::startListening()
+{
+	// a socket file left behind by a server that crashed would block listening
+	QLocalServer::removeServer(m_socketName);
+
+	if (!m_server->listen(m_socketName))
+	{
+		LOG_ERROR(
+			"Query server failed to listen on \"" + m_socketName.toStdString() +
+			"\" with error: " + m_server->errorString().toStdString());
+		return false;
+	}
+
+	LOG_INFO("Query server listening on \"" + m_server->fullServerName().toStdString() + "\"");
+	return true;
+}
+
+void QtQueryServer::stopListening()
+{
+	for (auto& p: m_clients)
+	{
+		p.second->disconnect(this);
+		p.second->abort();
+		p.second->deleteLater();
+	}
+	m_clients.clear();
+
+	if (m_server->isListening())
+	{
+		m_server->close();
+	}
+}
+
+bool QtQueryServer::isListening() const
+{
+	return m_server->isListening();
+}
+
+void QtQueryServer::sendResponse(Id clientId, const std::string& response)
+{
+	QMetaObject::invokeMethod(
+		this,
+		[this, clientId, response]() {
+			auto it = m_clients.find(clientId);
+			if (it != m_clients.end())
+			{
+				it->second->write(response.data(), response.size());
+			}
+		},
+		Qt::QueuedConnection);
+}
+
+void QtQueryServer::acceptConnections()
+{
+	while (QLocalSocket* socket = m_server->nextPendingConnection())
+	{
+		const Id clientId = m_nextClientId++;
+		m_clients.emplace(clientId, socket);
+
+		connect(socket, &QLocalSocket::readyRead, this, [this, clientId]() {
+			readRequests(clientId);
+		});
+		connect(socket, &QLocalSocket::disconnected, this, [this, clientId]() {
+			auto it = m_clients.find(clientId);
+			if (it != m_clients.end())
+			{
+				it->second->deleteLater();
+				m_clients.erase(it);
+			}
+		});
+	}
+}
+
+void QtQueryServer::readRequests(Id clientId)
+{
+	auto it = m_clients.find(clientId);
+	if (it == m_clients.end())
+	{
+		return;
+	}
+
+	QLocalSocket* socket = it->second;
+	while (socket->canReadLine())
+	{
+		const QByteArray line = socket->readLine();
+		handleRequest(clientId, std::string(line.constData(), line.size()));
+	}
+}
@@ -0,0 +1,41 @@
+#ifndef QT_QUERY_SERVER_H
+#define QT_QUERY_SERVER_H
+
+#include <map>
+
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QObject>
+
+#include "QueryServer.h"
+
+// Listens on a local socket, a unix domain socket or a named pipe on Windows. All socket handling
+// happens on the Qt thread, only the queries themselves run on the workers of the QueryServer.
+class QtQueryServer: public QObject, public QueryServer
+{
+public:
+	QtQueryServer(
+		const std::wstring& socketName,
+		std::shared_ptr<const PersistentStorage> storage,
+		size_t workerCount,
+		size_t maxPendingRequestCount);
+	~QtQueryServer() override;
+
+	bool startListening() override;
+	void stopListening() override;
+	bool isListening() const override;
+
+private:
+	void sendResponse(Id clientId, const std::string& response) override;
+
+	void acceptConnections();
+	void readRequests(Id clientId);
+
+	const QString m_socketName;
+	QLocalServer* m_server;
+
+	std::map<Id, QLocalSocket*> m_clients;
+	Id m_nextClientId = 1;
+};
+
+#endif	  // QT_QUERY_SERVER_H
@@ -252,6 +252,8 @@ void QtCodeView::setNavigationState(const CodeParams& params)
 		m_widget->setCurrentActiveLocalLocationIds(params.currentActiveLocalLocationIds);
 	}
 
+	m_widget->setHasMoreFullTextSearchResults(params.hasMoreFullTextSearchResults);
+
 	m_widget->updateReferenceCount(
 		params.referenceCount,
 		params.referenceIndex,
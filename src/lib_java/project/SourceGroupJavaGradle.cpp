@@ -105,7 +105,9 @@ std::vector<FilePath> SourceGroupJavaGradle::doGetAllSourcePaths() const
 		const FilePath projectRootPath =
 			m_settings->getGradleProjectFilePathExpandedAndAbsolute().getParentDirectory();
 		sourcePaths = utility::gradleGetAllSourceDirectories(
-			projectRootPath, m_settings->getShouldIndexGradleTests());
+			projectRootPath,
+			m_settings->getGradleDependenciesDirectoryPath(),
+			m_settings->getShouldIndexGradleTests());
 
 		dialogView->hideUnknownProgressDialog();
 	}
@@ -0,0 +1,399 @@
+#include "BuildFileCache.h"
+
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <regex>
+#include <set>
+#include <sstream>
+
+#include "tinyxml.h"
+
+#include "FileSystem.h"
+#include "TextAccess.h"
+#include "logging.h"
+#include "utility.h"
+#include "utilityString.h"
+#include "utilityXml.h"
+
+namespace
+{
+// FNV-1a, which doesn't change between builds like std::hash may do
+void addToHash(const std::string& data, uint64_t& hash)
+{
+	for (char c: data)
+	{
+		hash ^= static_cast<unsigned char>(c);
+		hash *= 1099511628211ull;
+	}
+
+	// separates consecutive values
+	hash ^= 0xFF;
+	hash *= 1099511628211ull;
+}
+
+FilePath getPomFilePath(const FilePath& path)
+{
+	if (path.isDirectory())
+	{
+		return path.getConcatenated(L"pom.xml");
+	}
+	return path;
+}
+
+void addMavenBuildFilePaths(
+	const FilePath& pomFilePath, bool addModules, std::set<FilePath>& pomFilePaths)
+{
+	if (!pomFilePath.exists() || !pomFilePaths.insert(pomFilePath).second)
+	{
+		return;
+	}
+
+	const FilePath directoryPath = pomFilePath.getParentDirectory();
+	std::shared_ptr<TextAccess> xmlAccess = TextAccess::createFromFile(pomFilePath);
+
+	// the parent defaults to the pom of the parent directory
+	if (!utility::getValuesOfAllXmlElementsOnPath(xmlAccess, {"project", "parent", "artifactId"})
+			 .empty())
+	{
+		std::string relativePath = "../pom.xml";
+		for (const std::string& value: utility::getValuesOfAllXmlElementsOnPath(
+				 xmlAccess, {"project", "parent", "relativePath"}))
+		{
+			relativePath = value;
+		}
+
+		if (!relativePath.empty())
+		{
+			const FilePath parentPath =
+				directoryPath.getConcatenated(FilePath(relativePath)).makeCanonical();
+			addMavenBuildFilePaths(getPomFilePath(parentPath), false, pomFilePaths);
+		}
+	}
+
+	if (addModules)
+	{
+		std::vector<std::string> modules = utility::getValuesOfAllXmlElementsOnPath(
+			xmlAccess, {"project", "modules", "module"});
+		utility::append(
+			modules,
+			utility::getValuesOfAllXmlElementsOnPath(
+				xmlAccess, {"project", "profiles", "profile", "modules", "module"}));
+
+		for (const std::string& module: modules)
+		{
+			const FilePath modulePath =
+				directoryPath.getConcatenated(FilePath(module)).makeCanonical();
+			addMavenBuildFilePaths(getPomFilePath(modulePath), true, pomFilePaths);
+		}
+	}
+}
+
+std::string readFile(const FilePath& filePath)
+{
+	std::ifstream file(filePath.str(), std::ios::in | std::ios::binary);
+	std::stringstream content;
+	if (file)
+	{
+		content << file.rdbuf();
+	}
+	return content.str();
+}
+
+std::string getChildText(const TiXmlElement* element, const char* childName)
+{
+	const TiXmlElement* child = element->FirstChildElement(childName);
+	const char* text = child ? child->GetText() : nullptr;
+	return text ? utility::trim(std::string(text)) : "";
+}
+
+bool pomFilesDeclareChangingVersions(const std::vector<FilePath>& pomFilePaths)
+{
+	std::vector<std::shared_ptr<TiXmlDocument>> documents;
+	std::set<std::string> moduleArtifactIds;
+	std::map<std::string, std::string> properties;
+	for (const FilePath& pomFilePath: pomFilePaths)
+	{
+		std::shared_ptr<TiXmlDocument> document = std::make_shared<TiXmlDocument>();
+		document->Parse(readFile(pomFilePath).c_str(), 0, TIXML_ENCODING_UTF8);
+		TiXmlElement* rootElement = document->RootElement();
+		if (!rootElement)
+		{
+			continue;
+		}
+
+		moduleArtifactIds.insert(getChildText(rootElement, "artifactId"));
+		for (TiXmlElement* propertiesElement:
+			 utility::getAllXmlTagsByName(rootElement, "properties"))
+		{
+			for (const TiXmlElement* property = propertiesElement->FirstChildElement(); property;
+				 property = property->NextSiblingElement())
+			{
+				const char* text = property->GetText();
+				properties[property->Value()] = text ? utility::trim(std::string(text)) : "";
+			}
+		}
+		documents.push_back(document);
+	}
+
+	for (const std::shared_ptr<TiXmlDocument>& document: documents)
+	{
+		for (const char* tag: {"parent", "dependency", "plugin", "extension"})
+		{
+			for (const TiXmlElement* element:
+				 utility::getAllXmlTagsByName(document->RootElement(), tag))
+			{
+				// modules of the project are built from the checked build files
+				if (moduleArtifactIds.find(getChildText(element, "artifactId")) !=
+					moduleArtifactIds.end())
+				{
+					continue;
+				}
+
+				std::string version = getChildText(element, "version");
+				if (version.size() > 3 && version.substr(0, 2) == "${" && version.back() == '}')
+				{
+					auto it = properties.find(version.substr(2, version.size() - 3));
+					if (it != properties.end())
+					{
+						version = it->second;
+					}
+				}
+
+				if (BuildFileCache::isChangingVersion(version))
+				{
+					return true;
+				}
+			}
+		}
+	}
+	return false;
+}
+
+bool gradleFileDeclaresChangingVersions(const FilePath& buildFilePath)
+{
+	// coordinates like "group:name:version" in scripts, all quoted values in version catalogs
+	static const std::regex coordinateRegex("[\"']([\\w.\\-]+:[\\w.\\-]+:([^\"'\\s:@$]+))");
+	static const std::regex valueRegex("[\"']([^\"'\\s]*)[\"']");
+
+	const bool isVersionCatalog = buildFilePath.extension() == L".toml";
+	const std::string content = readFile(buildFilePath);
+	for (std::sregex_iterator it(
+			 content.begin(), content.end(), isVersionCatalog ? valueRegex : coordinateRegex);
+		 it != std::sregex_iterator();
+		 ++it)
+	{
+		std::string version = (*it)[isVersionCatalog ? 1 : 2].str();
+		version = version.substr(version.find_last_of(':') + 1);
+		if (BuildFileCache::isChangingVersion(version))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+}	 // namespace
+
+std::vector<FilePath> BuildFileCache::getMavenBuildFilePaths(
+	const FilePath& projectDirectoryPath, const FilePath& settingsFilePath)
+{
+	std::set<FilePath> pomFilePaths;
+	addMavenBuildFilePaths(
+		projectDirectoryPath.getConcatenated(L"pom.xml").makeCanonical(), true, pomFilePaths);
+
+	std::vector<FilePath> buildFilePaths(pomFilePaths.begin(), pomFilePaths.end());
+	for (const wchar_t* configFileName: {L".mvn/maven.config", L".mvn/extensions.xml"})
+	{
+		buildFilePaths.push_back(projectDirectoryPath.getConcatenated(configFileName));
+	}
+	if (!settingsFilePath.empty())
+	{
+		buildFilePaths.push_back(settingsFilePath);
+	}
+	return buildFilePaths;
+}
+
+std::vector<FilePath> BuildFileCache::getGradleBuildFilePaths(const FilePath& projectDirectoryPath)
+{
+	// projects are included by settings scripts, so all build scripts of the tree are considered
+	const std::set<std::wstring> buildFileNames = {
+		L"build.gradle",
+		L"build.gradle.kts",
+		L"settings.gradle",
+		L"settings.gradle.kts",
+		L"gradle.properties",
+		L"gradle-wrapper.properties"};
+
+	std::vector<FilePath> buildFilePaths;
+	for (const FilePath& filePath: FileSystem::getFilePathsFromDirectory(
+			 projectDirectoryPath, {L".gradle", L".kts", L".properties", L".toml"}))
+	{
+		if (buildFileNames.find(filePath.fileName()) != buildFileNames.end() ||
+			filePath.extension() == L".toml")
+		{
+			buildFilePaths.push_back(filePath);
+		}
+	}
+	return buildFilePaths;
+}
+
+bool BuildFileCache::isChangingVersion(const std::string& version)
+{
+	if (version.empty())
+	{
+		return false;
+	}
+
+	const bool isRange = (version.front() == '[' || version.front() == '(') &&
+		version.find(',') != std::string::npos;
+
+	return isRange || version.find("SNAPSHOT") != std::string::npos || version == "LATEST" ||
+		version == "RELEASE" || utility::isPrefix<std::string>("latest.", version) ||
+		version.back() == '+';
+}
+
+bool BuildFileCache::declaresChangingVersions(const std::vector<FilePath>& buildFilePaths)
+{
+	std::vector<FilePath> pomFilePaths;
+	for (const FilePath& buildFilePath: buildFilePaths)
+	{
+		const std::wstring extension = buildFilePath.extension();
+		if (extension == L".xml")
+		{
+			pomFilePaths.push_back(buildFilePath);
+		}
+		else if (
+			(extension == L".gradle" || extension == L".kts" || extension == L".toml") &&
+			gradleFileDeclaresChangingVersions(buildFilePath))
+		{
+			return true;
+		}
+	}
+	return pomFilesDeclareChangingVersions(pomFilePaths);
+}
+
+BuildFileCache::BuildFileCache(
+	const FilePath& cacheFilePath,
+	const std::vector<FilePath>& buildFilePaths,
+	const std::wstring& configuration)
+	: m_cacheFilePath(
+		  cacheFilePath.empty() || declaresChangingVersions(buildFilePaths) ? FilePath()
+																			  : cacheFilePath)
+	, m_key(m_cacheFilePath.empty() ? "" : computeKey(buildFilePaths, configuration))
+{
+	if (!cacheFilePath.empty() && m_cacheFilePath.empty())
+	{
+		LOG_INFO(
+			L"Build files declare snapshot or dynamic versions, not using cache: " +
+			cacheFilePath.wstr());
+	}
+}
+
+const std::string& BuildFileCache::getKey() const
+{
+	return m_key;
+}
+
+bool BuildFileCache::isValid() const
+{
+	return read(nullptr);
+}
+
+std::vector<FilePath> BuildFileCache::getPaths() const
+{
+	std::vector<FilePath> paths;
+	read(&paths);
+	return paths;
+}
+
+void BuildFileCache::store(const std::vector<FilePath>& paths) const
+{
+	if (m_cacheFilePath.empty())
+	{
+		return;
+	}
+
+	FileSystem::createDirectory(m_cacheFilePath.getParentDirectory());
+
+	// written next to the cache file and renamed, so an interrupted write can't leave a valid key
+	const FilePath tempFilePath(m_cacheFilePath.wstr() + L".tmp");
+	{
+		std::ofstream file(tempFilePath.str(), std::ios::out | std::ios::trunc);
+		if (!file)
+		{
+			LOG_WARNING(L"Unable to write build file cache: " + m_cacheFilePath.wstr());
+			return;
+		}
+
+		file << m_key << '\n';
+		for (const FilePath& path: paths)
+		{
+			file << utility::encodeToUtf8(path.wstr()) << '\n';
+		}
+	}
+
+	FileSystem::remove(m_cacheFilePath);
+	FileSystem::rename(tempFilePath, m_cacheFilePath);
+}
+
+void BuildFileCache::clear() const
+{
+	if (!m_cacheFilePath.empty() && m_cacheFilePath.recheckExists())
+	{
+		FileSystem::remove(m_cacheFilePath);
+	}
+}
+
+std::string BuildFileCache::computeKey(
+	const std::vector<FilePath>& buildFilePaths, const std::wstring& configuration)
+{
+	uint64_t hash = 14695981039346656037ull;
+	addToHash(utility::encodeToUtf8(configuration), hash);
+
+	for (const FilePath& buildFilePath: buildFilePaths)
+	{
+		addToHash(utility::encodeToUtf8(buildFilePath.wstr()), hash);
+
+		// missing files are part of the key as well, because adding one changes the build
+		std::ifstream file(buildFilePath.str(), std::ios::in | std::ios::binary);
+		addToHash(file ? "found" : "missing", hash);
+		if (file)
+		{
+			std::stringstream content;
+			content << file.rdbuf();
+			addToHash(content.str(), hash);
+		}
+	}
+
+	std::stringstream key;
+	key << std::hex << std::setw(16) << std::setfill('0') << hash;
+	return key.str();
+}
+
+bool BuildFileCache::read(std::vector<FilePath>* paths) const
+{
+	if (m_cacheFilePath.empty())
+	{
+		return false;
+	}
+
+	std::ifstream file(m_cacheFilePath.str(), std::ios::in);
+	std::string line;
+	if (!file || !std::getline(file, line) || line != m_key)
+	{
+		return false;
+	}
+
+	if (paths)
+	{
+		while (std::getline(file, line))
+		{
+			if (!line.empty())
+			{
+				paths->push_back(FilePath(utility::decodeFromUtf8(line)));
+			}
+		}
+	}
+	return true;
+}
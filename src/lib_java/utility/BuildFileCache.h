@@ -0,0 +1,52 @@
+#ifndef BUILD_FILE_CACHE_H
+#define BUILD_FILE_CACHE_H
+
+#include <string>
+#include <vector>
+
+#include "FilePath.h"
+
+// Stores the paths resolved by a Maven or Gradle run in a file, together with a hash of the build
+// files and the configuration they were resolved with. The paths are reused until one of the build
+// files changes, so refreshing a project doesn't need to start the build tool again.
+// Snapshot, dynamic and ranged versions of external dependencies, plugins and extensions may
+// resolve differently without a build file change, so the cache is disabled for build files that
+// declare them. Versions that are only given by Gradle variables are not detected.
+class BuildFileCache
+{
+public:
+	// all pom files that make up the build of the project, including modules and parents
+	static std::vector<FilePath> getMavenBuildFilePaths(
+		const FilePath& projectDirectoryPath, const FilePath& settingsFilePath);
+	static std::vector<FilePath> getGradleBuildFilePaths(const FilePath& projectDirectoryPath);
+
+	// true for versions like "1.0-SNAPSHOT", "LATEST", "[1.0,2.0)", "1.+" or "latest.release"
+	static bool isChangingVersion(const std::string& version);
+	static bool declaresChangingVersions(const std::vector<FilePath>& buildFilePaths);
+
+	// an empty cache file path or build files declaring changing versions disable the cache
+	BuildFileCache(
+		const FilePath& cacheFilePath,
+		const std::vector<FilePath>& buildFilePaths,
+		const std::wstring& configuration);
+
+	const std::string& getKey() const;
+
+	// true if the cache file was written with the same key
+	bool isValid() const;
+	std::vector<FilePath> getPaths() const;
+
+	void store(const std::vector<FilePath>& paths) const;
+	void clear() const;
+
+private:
+	static std::string computeKey(
+		const std::vector<FilePath>& buildFilePaths, const std::wstring& configuration);
+
+	bool read(std::vector<FilePath>* paths) const;
+
+	const FilePath m_cacheFilePath;
+	const std::string m_key;
+};
+
+#endif	  // BUILD_FILE_CACHE_H
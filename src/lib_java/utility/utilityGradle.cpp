@@ -4,6 +4,8 @@
 
 #include "Application.h"
 #include "ApplicationSettings.h"
+#include "BuildFileCache.h"
+#include "FileSystem.h"
 #include "JavaEnvironment.h"
 #include "JavaEnvironmentFactory.h"
 #include "MessageStatus.h"
@@ -12,11 +14,102 @@
 #include "utilityJava.h"
 #include "utilityString.h"
 
+namespace
+{
+bool fetchSourceDirectories(
+	std::set<std::wstring>& uncheckedDirectories,
+	const FilePath& projectDirectoryPath,
+	const FilePath& gradleInitScriptPath,
+	bool addTestDirectories)
+{
+	std::shared_ptr<JavaEnvironment> javaEnvironment =
+		JavaEnvironmentFactory::getInstance()->createEnvironment();
+	{
+		std::string output = "";
+		javaEnvironment->callStaticStringMethod(
+			"com/sourcetrail/gradle/InfoRetriever",
+			"getMainSrcDirs",
+			output,
+			utility::encodeToUtf8(projectDirectoryPath.wstr()),
+			utility::encodeToUtf8(gradleInitScriptPath.wstr()));
+
+		if (utility::isPrefix<std::string>("[ERROR]", utility::trim(output)))
+		{
+			// TODO: move error handling to caller of this function
+			const std::wstring dialogMessage =
+				L"The following error occurred while executing a Gradle command:\n\n" +
+				utility::decodeFromUtf8(utility::replace(output, "\r\n", "\n"));
+			MessageStatus(dialogMessage, true, false).dispatch();
+			if (Application::getInstance())
+			{
+				Application::getInstance()->handleDialog(dialogMessage);
+			}
+			return false;
+		}
+
+		for (const std::string mainSrcDir: utility::splitToVector(output, ";"))
+		{
+			uncheckedDirectories.insert(utility::decodeFromUtf8(mainSrcDir));
+		}
+	}
+
+	if (addTestDirectories)
+	{
+		std::string output = "";
+		javaEnvironment->callStaticStringMethod(
+			"com/sourcetrail/gradle/InfoRetriever",
+			"getTestSrcDirs",
+			output,
+			utility::encodeToUtf8(projectDirectoryPath.wstr()),
+			utility::encodeToUtf8(gradleInitScriptPath.wstr()));
+
+		if (utility::isPrefix<std::string>("[ERROR]", utility::trim(output)))
+		{
+			// TODO: move error handling to caller of this function
+			const std::wstring dialogMessage =
+				L"The following error occurred while executing a Gradle command:\n\n" +
+				utility::decodeFromUtf8(utility::replace(output, "\r\n", "\n"));
+			MessageStatus(dialogMessage, true, false).dispatch();
+			Application::getInstance()->handleDialog(dialogMessage);
+
+			return false;
+		}
+
+		for (const std::string testSrcDir: utility::splitToVector(output, ";"))
+		{
+			uncheckedDirectories.insert(utility::decodeFromUtf8(testSrcDir));
+		}
+	}
+
+	return true;
+}
+}	 // namespace
+
 namespace utility
 {
 bool gradleCopyDependencies(
 	const FilePath& projectDirectoryPath, const FilePath& outputDirectoryPath, bool addTestDependencies)
 {
+	const BuildFileCache cache(
+		outputDirectoryPath.getConcatenated(L"dependency_paths.cache"),
+		BuildFileCache::getGradleBuildFilePaths(projectDirectoryPath),
+		addTestDependencies ? L"copyCompileLibs\ncopyTestCompileLibs" : L"copyCompileLibs");
+	if (cache.isValid())
+	{
+		bool allDependenciesExist = true;
+		for (const FilePath& dependencyPath: cache.getPaths())
+		{
+			allDependenciesExist = allDependenciesExist && dependencyPath.exists();
+		}
+
+		if (allDependenciesExist)
+		{
+			LOG_INFO("Gradle dependencies are up to date, build files didn't change.");
+			return true;
+		}
+	}
+	cache.clear();
+
 	const FilePath gradleInitScriptPath = ResourcePaths::getJavaDirectoryPath().concatenate(
 		L"gradle/init.gradle");
 
@@ -42,78 +135,54 @@ bool gradleCopyDependencies(
 			utility::encodeToUtf8(outputDirectoryPath.wstr()));
 	}
 
+	if (success)
+	{
+		cache.store(FileSystem::getFilePathsFromDirectory(outputDirectoryPath, {L".jar"}));
+	}
+
 	return success;
 }
 
 std::vector<FilePath> gradleGetAllSourceDirectories(
-	const FilePath& projectDirectoryPath, bool addTestDirectories)
+	const FilePath& projectDirectoryPath,
+	const FilePath& outputDirectoryPath,
+	bool addTestDirectories)
 {
-	const FilePath gradleInitScriptPath = ResourcePaths::getJavaDirectoryPath().concatenate(
-		L"gradle/init.gradle");
-
-	utility::setJavaHomeVariableIfNotExists();
-	utility::prepareJavaEnvironment();
+	const BuildFileCache cache(
+		outputDirectoryPath.empty()
+			? FilePath()
+			: outputDirectoryPath.getConcatenated(L"source_directory_paths.cache"),
+		BuildFileCache::getGradleBuildFilePaths(projectDirectoryPath),
+		addTestDirectories ? L"getMainSrcDirs\ngetTestSrcDirs" : L"getMainSrcDirs");
 
 	std::set<std::wstring> uncheckedDirectories;
+	if (cache.isValid())
 	{
-		std::shared_ptr<JavaEnvironment> javaEnvironment =
-			JavaEnvironmentFactory::getInstance()->createEnvironment();
+		LOG_INFO("Using cached source directories, Gradle build files didn't change.");
+		for (const FilePath& path: cache.getPaths())
 		{
-			std::string output = "";
-			javaEnvironment->callStaticStringMethod(
-				"com/sourcetrail/gradle/InfoRetriever",
-				"getMainSrcDirs",
-				output,
-				utility::encodeToUtf8(projectDirectoryPath.wstr()),
-				utility::encodeToUtf8(gradleInitScriptPath.wstr()));
-
-			if (utility::isPrefix<std::string>("[ERROR]", utility::trim(output)))
-			{
-				// TODO: move error handling to caller of this function
-				const std::wstring dialogMessage =
-					L"The following error occurred while executing a Gradle command:\n\n" +
-					utility::decodeFromUtf8(utility::replace(output, "\r\n", "\n"));
-				MessageStatus(dialogMessage, true, false).dispatch();
-				if (Application::getInstance())
-				{
-					Application::getInstance()->handleDialog(dialogMessage);
-				}
-				return std::vector<FilePath>();
-			}
-
-			for (const std::string mainSrcDir: utility::splitToVector(output, ";"))
-			{
-				uncheckedDirectories.insert(utility::decodeFromUtf8(mainSrcDir));
-			}
+			uncheckedDirectories.insert(path.wstr());
 		}
+	}
+	else
+	{
+		const FilePath gradleInitScriptPath = ResourcePaths::getJavaDirectoryPath().concatenate(
+			L"gradle/init.gradle");
 
-		if (addTestDirectories)
-		{
-			std::string output = "";
-			javaEnvironment->callStaticStringMethod(
-				"com/sourcetrail/gradle/InfoRetriever",
-				"getTestSrcDirs",
-				output,
-				utility::encodeToUtf8(projectDirectoryPath.wstr()),
-				utility::encodeToUtf8(gradleInitScriptPath.wstr()));
-
-			if (utility::isPrefix<std::string>("[ERROR]", utility::trim(output)))
-			{
-				// TODO: move error handling to caller of this function
-				const std::wstring dialogMessage =
-					L"The following error occurred while executing a Gradle command:\n\n" +
-					utility::decodeFromUtf8(utility::replace(output, "\r\n", "\n"));
-				MessageStatus(dialogMessage, true, false).dispatch();
-				Application::getInstance()->handleDialog(dialogMessage);
-
-				return std::vector<FilePath>();
-			}
+		utility::setJavaHomeVariableIfNotExists();
+		utility::prepareJavaEnvironment();
 
-			for (const std::string testSrcDir: utility::splitToVector(output, ";"))
-			{
-				uncheckedDirectories.insert(utility::decodeFromUtf8(testSrcDir));
-			}
+		if (!fetchSourceDirectories(
+				uncheckedDirectories,
+				projectDirectoryPath,
+				gradleInitScriptPath,
+				addTestDirectories))
+		{
+			cache.clear();
+			return std::vector<FilePath>();
 		}
+
+		cache.store(std::vector<FilePath>(uncheckedDirectories.begin(), uncheckedDirectories.end()));
 	}
 
 	std::vector<FilePath> directories;
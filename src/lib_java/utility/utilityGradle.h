@@ -11,8 +11,11 @@ bool gradleCopyDependencies(
 	const FilePath& projectDirectoryPath,
 	const FilePath& outputDirectoryPath,
 	bool addTestDependencies);
+// the resolved directories are cached in the output directory, an empty path disables the cache
 std::vector<FilePath> gradleGetAllSourceDirectories(
-	const FilePath& projectDirectoryPath, bool addTestDirectories);
+	const FilePath& projectDirectoryPath,
+	const FilePath& outputDirectoryPath,
+	bool addTestDirectories);
 }	 // namespace utility
 
 #endif	  // UTILITY_GRADLE_H
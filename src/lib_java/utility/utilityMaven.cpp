@@ -4,7 +4,9 @@
 
 #include "Application.h"
 #include "ApplicationSettings.h"
+#include "BuildFileCache.h"
 #include "FilePath.h"
+#include "FileSystem.h"
 #include "MessageStatus.h"
 #include "TextAccess.h"
 #include "logging.h"
@@ -92,65 +94,27 @@ std::vector<std::wstring> getMavenArgs(const FilePath& settingsFilePath)
 	return args;
 }
 
-}	 // namespace
-
-namespace utility
-{
-std::wstring mavenGenerateSources(
-	const FilePath& mavenPath, const FilePath& settingsFilePath, const FilePath& projectDirectoryPath)
+std::vector<FilePath> getExistingPaths(const std::vector<FilePath>& paths)
 {
-	utility::setJavaHomeVariableIfNotExists();
-
-	auto args = getMavenArgs(settingsFilePath);
-	args.push_back(L"generate-sources");
-
-	std::shared_ptr<TextAccess> outputAccess = TextAccess::createFromString(utility::encodeToUtf8(
-		utility::executeProcess(mavenPath.wstr(), args, projectDirectoryPath, true, 60000).output));
-
-	if (outputAccess->isEmpty())
+	std::vector<FilePath> existingPaths;
+	for (const FilePath& path: paths)
 	{
-		return L"Sourcetrail was unable to locate Maven on this machine.\n"
-			   "Please make sure to provide the correct Maven Path in the preferences.";
-	}
-
-	return getErrorMessageFromMavenOutput(outputAccess);
-}
-
-bool mavenCopyDependencies(
-	const FilePath& mavenPath,
-	const FilePath& settingsFilePath,
-	const FilePath& projectDirectoryPath,
-	const FilePath& outputDirectoryPath)
-{
-	utility::setJavaHomeVariableIfNotExists();
-
-	auto args = getMavenArgs(settingsFilePath);
-	args.push_back(L"dependency:copy-dependencies");
-	args.push_back(L"-DoutputDirectory=" + outputDirectoryPath.wstr());
-
-	std::shared_ptr<TextAccess> outputAccess = TextAccess::createFromString(utility::encodeToUtf8(
-		utility::executeProcess(mavenPath.wstr(), args, projectDirectoryPath, true, 60000).output));
-
-	const std::wstring errorMessage = getErrorMessageFromMavenOutput(outputAccess);
-	if (!errorMessage.empty())
-	{
-		MessageStatus(errorMessage, true, false).dispatch();
-		Application::getInstance()->handleDialog(errorMessage);
-		return false;
+		if (path.exists())
+		{
+			existingPaths.push_back(path);
+		}
 	}
-
-	return !outputAccess->isEmpty();
+	return existingPaths;
 }
 
-std::vector<FilePath> mavenGetAllDirectoriesFromEffectivePom(
+bool fetchDirectoriesFromEffectivePom(
+	std::vector<FilePath>& uncheckedDirectories,
 	const FilePath& mavenPath,
 	const FilePath& settingsFilePath,
 	const FilePath& projectDirectoryPath,
 	const FilePath& outputDirectoryPath,
 	bool addTestDirectories)
 {
-	utility::setJavaHomeVariableIfNotExists();
-
 	FilePath outputPath = outputDirectoryPath.getConcatenated(FilePath("/effective-pom.xml"));
 
 	auto args = getMavenArgs(settingsFilePath);
@@ -165,17 +129,16 @@ std::vector<FilePath> mavenGetAllDirectoriesFromEffectivePom(
 	{
 		MessageStatus(errorMessage, true, false).dispatch();
 		Application::getInstance()->handleDialog(errorMessage);
-		return {};
+		return false;
 	}
 	else if (!outputPath.exists())
 	{
 		LOG_ERROR("Maven effective-pom didn't generate an output file: " + outputPath.str());
-		return {};
+		return false;
 	}
 
 	std::shared_ptr<TextAccess> xmlAccess = TextAccess::createFromFile(outputPath);
 
-	std::vector<FilePath> uncheckedDirectories;
 	fetchDirectories(
 		uncheckedDirectories,
 		xmlAccess,
@@ -221,15 +184,120 @@ std::vector<FilePath> mavenGetAllDirectoriesFromEffectivePom(
 			FilePath(L"generated-test-sources"));
 	}
 
-	std::vector<FilePath> directories;
-	for (const FilePath& uncheckedDirectory: uncheckedDirectories)
+	return true;
+}
+}	 // namespace
+
+namespace utility
+{
+std::wstring mavenGenerateSources(
+	const FilePath& mavenPath, const FilePath& settingsFilePath, const FilePath& projectDirectoryPath)
+{
+	utility::setJavaHomeVariableIfNotExists();
+
+	auto args = getMavenArgs(settingsFilePath);
+	args.push_back(L"generate-sources");
+
+	std::shared_ptr<TextAccess> outputAccess = TextAccess::createFromString(utility::encodeToUtf8(
+		utility::executeProcess(mavenPath.wstr(), args, projectDirectoryPath, true, 60000).output));
+
+	if (outputAccess->isEmpty())
+	{
+		return L"Sourcetrail was unable to locate Maven on this machine.\n"
+			   "Please make sure to provide the correct Maven Path in the preferences.";
+	}
+
+	return getErrorMessageFromMavenOutput(outputAccess);
+}
+
+bool mavenCopyDependencies(
+	const FilePath& mavenPath,
+	const FilePath& settingsFilePath,
+	const FilePath& projectDirectoryPath,
+	const FilePath& outputDirectoryPath)
+{
+	const BuildFileCache cache(
+		outputDirectoryPath.getConcatenated(L"dependency_paths.cache"),
+		BuildFileCache::getMavenBuildFilePaths(projectDirectoryPath, settingsFilePath),
+		L"dependency:copy-dependencies\n" + mavenPath.wstr());
+	if (cache.isValid())
+	{
+		const std::vector<FilePath> dependencyPaths = cache.getPaths();
+		if (getExistingPaths(dependencyPaths).size() == dependencyPaths.size())
+		{
+			LOG_INFO("Maven dependencies are up to date, build files didn't change.");
+			return true;
+		}
+	}
+	cache.clear();
+
+	utility::setJavaHomeVariableIfNotExists();
+
+	// no parallel build (-T), all modules copy their dependencies into the same output directory
+	auto args = getMavenArgs(settingsFilePath);
+	args.push_back(L"dependency:copy-dependencies");
+	args.push_back(L"-DoutputDirectory=" + outputDirectoryPath.wstr());
+
+	std::shared_ptr<TextAccess> outputAccess = TextAccess::createFromString(utility::encodeToUtf8(
+		utility::executeProcess(mavenPath.wstr(), args, projectDirectoryPath, true, 60000).output));
+
+	const std::wstring errorMessage = getErrorMessageFromMavenOutput(outputAccess);
+	if (!errorMessage.empty())
+	{
+		MessageStatus(errorMessage, true, false).dispatch();
+		Application::getInstance()->handleDialog(errorMessage);
+		return false;
+	}
+
+	if (outputAccess->isEmpty())
 	{
-		if (uncheckedDirectory.exists())
+		return false;
+	}
+
+	cache.store(FileSystem::getFilePathsFromDirectory(outputDirectoryPath, {L".jar"}));
+	return true;
+}
+
+std::vector<FilePath> mavenGetAllDirectoriesFromEffectivePom(
+	const FilePath& mavenPath,
+	const FilePath& settingsFilePath,
+	const FilePath& projectDirectoryPath,
+	const FilePath& outputDirectoryPath,
+	bool addTestDirectories)
+{
+	// all candidates are cached, because generated source directories may not exist yet
+	const BuildFileCache cache(
+		outputDirectoryPath.getConcatenated(L"source_directory_paths.cache"),
+		BuildFileCache::getMavenBuildFilePaths(projectDirectoryPath, settingsFilePath),
+		L"help:effective-pom\n" + mavenPath.wstr() + (addTestDirectories ? L"\ntests" : L""));
+
+	std::vector<FilePath> uncheckedDirectories;
+	if (cache.isValid())
+	{
+		LOG_INFO("Using cached source directories, Maven build files didn't change.");
+		uncheckedDirectories = cache.getPaths();
+	}
+	else
+	{
+		utility::setJavaHomeVariableIfNotExists();
+
+		if (!fetchDirectoriesFromEffectivePom(
+				uncheckedDirectories,
+				mavenPath,
+				settingsFilePath,
+				projectDirectoryPath,
+				outputDirectoryPath,
+				addTestDirectories))
 		{
-			directories.push_back(uncheckedDirectory);
+			cache.clear();
+			return {};
 		}
+
+		cache.store(uncheckedDirectories);
 	}
 
+	std::vector<FilePath> directories = getExistingPaths(uncheckedDirectories);
+
 	LOG_INFO(
 		"Found " + std::to_string(directories.size()) + " of " +
 		std::to_string(uncheckedDirectories.size()) + " directories on system.");
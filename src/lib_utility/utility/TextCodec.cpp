@@ -1,12 +1,17 @@
 #include "TextCodec.h"
 
+#include <algorithm>
+#include <cstdint>
+
 #include <QTextCodec>
 
-TextCodec::TextCodec(const std::string& name): m_name(name)
+#include "utilityString.h"
+
+TextCodec::TextCodec(const std::string& name)
+	: m_name(name)
+	, m_codec(QTextCodec::codecForName(m_name.c_str()))
+	, m_isAsciiCompatible(isAsciiCompatible(m_codec))
 {
-	m_codec = QTextCodec::codecForName(m_name.c_str());
-	m_decoder = std::make_shared<QTextDecoder>(m_codec);
-	m_encoder = std::make_shared<QTextEncoder>(m_codec);
 }
 
 std::string TextCodec::getName() const
@@ -25,18 +30,49 @@ bool TextCodec::isValid() const
 
 std::wstring TextCodec::decode(const std::string& unicodeString) const
 {
-	if (m_decoder)
+	if (m_isAsciiCompatible && utility::isAscii(unicodeString))
+	{
+		return std::wstring(unicodeString.begin(), unicodeString.end());
+	}
+
+	if (m_codec)
 	{
-		return m_decoder->toUnicode(unicodeString.c_str()).toStdWString();
+		return m_codec->toUnicode(unicodeString.c_str(), static_cast<int>(unicodeString.size()))
+			.toStdWString();
 	}
 	return QString::fromStdString(unicodeString).toStdWString();
 }
 
 std::string TextCodec::encode(const std::wstring& string) const
 {
-	if (m_encoder)
+	if (m_isAsciiCompatible && std::all_of(string.begin(), string.end(), [](wchar_t c) {
+			return static_cast<uint32_t>(c) < 0x80;
+		}))
+	{
+		return std::string(string.begin(), string.end());
+	}
+
+	if (m_codec)
 	{
-		return m_encoder->fromUnicode(QString::fromStdWString(string)).toStdString();
+		return m_codec->fromUnicode(QString::fromStdWString(string)).toStdString();
 	}
 	return QString::fromStdWString(string).toStdString();
 }
+
+bool TextCodec::isAsciiCompatible(QTextCodec* codec)
+{
+	if (!codec)
+	{
+		return false;
+	}
+
+	std::string ascii;
+	for (int c = 0; c < 0x80; c++)
+	{
+		ascii.push_back(static_cast<char>(c));
+	}
+
+	const QString decoded = codec->toUnicode(ascii.c_str(), static_cast<int>(ascii.size()));
+	return decoded.toStdWString() == std::wstring(ascii.begin(), ascii.end()) &&
+		codec->fromUnicode(decoded).toStdString() == ascii;
+}
@@ -1,13 +1,13 @@
 #ifndef TEXT_CODEC_H
 #define TEXT_CODEC_H
 
-#include <memory>
 #include <string>
 
 class QTextCodec;
-class QTextDecoder;
-class QTextEncoder;
 
+// Converts text of the encoding set in the application settings. Each call is converted on its
+// own, so a codec can be shared by threads. Plain ascii text is copied without calling the codec
+// if the encoding stores ascii characters as single bytes.
 class TextCodec
 {
 public:
@@ -21,10 +21,11 @@ public:
 	std::string encode(const std::wstring& string) const;
 
 private:
+	static bool isAsciiCompatible(QTextCodec* codec);
+
 	const std::string m_name;
 	QTextCodec* m_codec;
-	std::shared_ptr<QTextDecoder> m_decoder;
-	std::shared_ptr<QTextEncoder> m_encoder;
+	bool m_isAsciiCompatible;
 };
 
 #endif	  // TEXT_CODEC_H
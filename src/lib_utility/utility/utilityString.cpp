@@ -2,13 +2,179 @@
 
 #include <algorithm>
 #include <cctype>
+#include <cstdint>
+#include <cstring>
 #include <iterator>
 #include <string>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#	include <emmintrin.h>
+#	define UTILITY_STRING_USE_SSE2
+#endif
+
 #include <boost/locale/encoding_utf.hpp>
 
 namespace
 {
+// number of leading bytes below 0x80
+size_t getAsciiLength(const char* data, size_t size)
+{
+	size_t pos = 0;
+
+#ifdef UTILITY_STRING_USE_SSE2
+	for (; pos + 16 <= size; pos += 16)
+	{
+		if (_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos))))
+		{
+			break;
+		}
+	}
+#else
+	for (; pos + 8 <= size; pos += 8)
+	{
+		uint64_t block;
+		std::memcpy(&block, data + pos, 8);
+		if (block & 0x8080808080808080ull)
+		{
+			break;
+		}
+	}
+#endif
+
+	while (pos < size && !(data[pos] & 0x80))
+	{
+		pos++;
+	}
+	return pos;
+}
+
+// number of leading characters below 0x80
+size_t getAsciiLength(const wchar_t* data, size_t size)
+{
+	size_t pos = 0;
+	for (; pos + 8 <= size; pos += 8)
+	{
+		// no early exit within the block, so the compiler can vectorize the check
+		uint32_t bits = 0;
+		for (size_t i = 0; i < 8; i++)
+		{
+			bits |= static_cast<uint32_t>(data[pos + i]);
+		}
+		if (bits >= 0x80)
+		{
+			break;
+		}
+	}
+
+	while (pos < size && static_cast<uint32_t>(data[pos]) < 0x80)
+	{
+		pos++;
+	}
+	return pos;
+}
+
+// decodes one well-formed multi byte sequence, invalid input is left to boost
+bool decodeUtf8Sequence(const unsigned char* data, size_t size, uint32_t& codePoint, size_t& length)
+{
+	const unsigned char lead = data[0];
+	unsigned char secondMin = 0x80;
+	unsigned char secondMax = 0xBF;
+
+	if (lead >= 0xC2 && lead <= 0xDF)
+	{
+		length = 2;
+		codePoint = lead & 0x1F;
+	}
+	else if (lead >= 0xE0 && lead <= 0xEF)
+	{
+		length = 3;
+		codePoint = lead & 0x0F;
+		secondMin = (lead == 0xE0 ? 0xA0 : 0x80);	  // overlong
+		secondMax = (lead == 0xED ? 0x9F : 0xBF);	  // surrogates
+	}
+	else if (lead >= 0xF0 && lead <= 0xF4)
+	{
+		length = 4;
+		codePoint = lead & 0x07;
+		secondMin = (lead == 0xF0 ? 0x90 : 0x80);	  // overlong
+		secondMax = (lead == 0xF4 ? 0x8F : 0xBF);	  // above 0x10FFFF
+	}
+	else
+	{
+		return false;
+	}
+
+	if (size < length || data[1] < secondMin || data[1] > secondMax)
+	{
+		return false;
+	}
+
+	for (size_t i = 1; i < length; i++)
+	{
+		if ((data[i] & 0xC0) != 0x80)
+		{
+			return false;
+		}
+		codePoint = (codePoint << 6) | (data[i] & 0x3F);
+	}
+	return true;
+}
+
+// encodes one valid code point, lone surrogates and values above 0x10FFFF are left to boost
+bool encodeUtf8Sequence(const wchar_t* data, size_t size, std::string& result, size_t& length)
+{
+	uint32_t codePoint = static_cast<uint32_t>(data[0]);
+	length = 1;
+
+	if (codePoint >= 0xD800 && codePoint <= 0xDFFF)
+	{
+		if (sizeof(wchar_t) != 2 || codePoint > 0xDBFF || size < 2 ||
+			static_cast<uint32_t>(data[1]) < 0xDC00 || static_cast<uint32_t>(data[1]) > 0xDFFF)
+		{
+			return false;
+		}
+		codePoint = 0x10000 + ((codePoint - 0xD800) << 10) +
+			(static_cast<uint32_t>(data[1]) - 0xDC00);
+		length = 2;
+	}
+
+	if (codePoint < 0x800)
+	{
+		result.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+	}
+	else if (codePoint < 0x10000)
+	{
+		result.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+		result.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+	}
+	else if (codePoint <= 0x10FFFF)
+	{
+		result.push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+		result.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+		result.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+	}
+	else
+	{
+		return false;
+	}
+	result.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+	return true;
+}
+
+void appendCodePoint(uint32_t codePoint, std::wstring& result)
+{
+	if (sizeof(wchar_t) == 2 && codePoint >= 0x10000)
+	{
+		codePoint -= 0x10000;
+		result.push_back(static_cast<wchar_t>(0xD800 + (codePoint >> 10)));
+		result.push_back(static_cast<wchar_t>(0xDC00 + (codePoint & 0x3FF)));
+	}
+	else
+	{
+		result.push_back(static_cast<wchar_t>(codePoint));
+	}
+}
+
 template <typename StringType>
 StringType doReplace(StringType str, const StringType& from, const StringType& to)
 {
@@ -71,12 +237,80 @@ namespace utility
 {
 std::string encodeToUtf8(const std::wstring& s)
 {
-	return boost::locale::conv::utf_to_utf<char>(s.c_str(), s.c_str() + s.size());
+	const wchar_t* data = s.c_str();
+	const size_t size = s.size();
+
+	size_t pos = getAsciiLength(data, size);
+	std::string result(data, data + pos);
+	if (pos == size)
+	{
+		return result;
+	}
+
+	result.reserve(size + (size - pos) / 2);
+	while (pos < size)
+	{
+		const size_t asciiLength = getAsciiLength(data + pos, size - pos);
+		result.append(data + pos, data + pos + asciiLength);
+		pos += asciiLength;
+
+		size_t length = 0;
+		if (pos == size)
+		{
+			break;
+		}
+		else if (!encodeUtf8Sequence(data + pos, size - pos, result, length))
+		{
+			// boost decides how invalid characters are skipped
+			result += boost::locale::conv::utf_to_utf<char>(data + pos, data + size);
+			break;
+		}
+		pos += length;
+	}
+	return result;
 }
 
 std::wstring decodeFromUtf8(const std::string& s)
 {
-	return boost::locale::conv::utf_to_utf<wchar_t>(s.c_str(), s.c_str() + s.size());
+	const char* data = s.c_str();
+	const size_t size = s.size();
+
+	size_t pos = getAsciiLength(data, size);
+	std::wstring result(data, data + pos);
+	if (pos == size)
+	{
+		return result;
+	}
+
+	result.reserve(size);
+	while (pos < size)
+	{
+		const size_t asciiLength = getAsciiLength(data + pos, size - pos);
+		result.append(data + pos, data + pos + asciiLength);
+		pos += asciiLength;
+
+		const unsigned char* sequence = reinterpret_cast<const unsigned char*>(data + pos);
+		uint32_t codePoint = 0;
+		size_t length = 0;
+		if (pos == size)
+		{
+			break;
+		}
+		else if (!decodeUtf8Sequence(sequence, size - pos, codePoint, length))
+		{
+			// boost decides how invalid sequences are skipped
+			result += boost::locale::conv::utf_to_utf<wchar_t>(data + pos, data + size);
+			break;
+		}
+		appendCodePoint(codePoint, result);
+		pos += length;
+	}
+	return result;
+}
+
+bool isAscii(const std::string& s)
+{
+	return getAsciiLength(s.c_str(), s.size()) == s.size();
 }
 
 std::deque<std::string> split(const std::string& str, char delimiter)
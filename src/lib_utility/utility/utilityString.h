@@ -9,8 +9,10 @@
 
 namespace utility
 {
+// text that is plain ascii is copied without decoding, invalid input is skipped
 std::string encodeToUtf8(const std::wstring& s);
 std::wstring decodeFromUtf8(const std::string& s);
+bool isAscii(const std::string& s);
 
 template <typename ContainerType>
 ContainerType split(const std::string& str, const std::string& delimiter);
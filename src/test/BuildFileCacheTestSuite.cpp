@@ -0,0 +1,186 @@
+#include "catch.hpp"
+
+#include "language_packages.h"
+
+#if BUILD_JAVA_LANGUAGE_PACKAGE
+
+#	include <fstream>
+
+#	include <boost/filesystem.hpp>
+
+#	include "BuildFileCache.h"
+#	include "FilePath.h"
+#	include "FileSystem.h"
+#	include "utility.h"
+
+namespace
+{
+FilePath getTempDirectoryPath(const std::wstring& name)
+{
+	const FilePath directoryPath = FilePath(boost::filesystem::temp_directory_path().wstring())
+									   .getConcatenated(name);
+	boost::filesystem::remove_all(directoryPath.getPath());
+	FileSystem::createDirectory(directoryPath);
+	return directoryPath;
+}
+
+void writeFile(const FilePath& filePath, const std::string& content)
+{
+	FileSystem::createDirectory(filePath.getParentDirectory());
+	std::ofstream file(filePath.str(), std::ios::out | std::ios::trunc);
+	file << content;
+}
+
+std::string getPom(const std::string& artifactId, const std::vector<std::string>& modules)
+{
+	std::string pom = "<project>\n";
+	if (artifactId != "root")
+	{
+		pom += "\t<parent>\n\t\t<artifactId>root</artifactId>\n\t</parent>\n";
+	}
+	pom += "\t<artifactId>" + artifactId + "</artifactId>\n";
+	if (!modules.empty())
+	{
+		pom += "\t<modules>\n";
+		for (const std::string& module: modules)
+		{
+			pom += "\t\t<module>" + module + "</module>\n";
+		}
+		pom += "\t</modules>\n";
+	}
+	return pom + "</project>\n";
+}
+}	 // namespace
+
+TEST_CASE("build file cache finds pom files of modules and parents")
+{
+	const FilePath rootPath = getTempDirectoryPath(L"sourcetrail_build_file_cache_modules");
+	writeFile(rootPath.getConcatenated(L"pom.xml"), getPom("root", {"core", "app"}));
+	writeFile(rootPath.getConcatenated(L"core/pom.xml"), getPom("core", {}));
+	writeFile(rootPath.getConcatenated(L"app/pom.xml"), getPom("app", {"plugin"}));
+	writeFile(rootPath.getConcatenated(L"app/plugin/pom.xml"), getPom("plugin", {}));
+	writeFile(rootPath.getConcatenated(L"unused/pom.xml"), getPom("unused", {}));
+
+	const std::vector<FilePath> buildFilePaths = BuildFileCache::getMavenBuildFilePaths(
+		rootPath.getConcatenated(L"app"), FilePath());
+
+	const FilePath canonicalRootPath = rootPath.getCanonical();
+	REQUIRE(utility::containsElement<FilePath>(
+		buildFilePaths, canonicalRootPath.getConcatenated(L"app/pom.xml")));
+	REQUIRE(utility::containsElement<FilePath>(
+		buildFilePaths, canonicalRootPath.getConcatenated(L"app/plugin/pom.xml")));
+	REQUIRE(utility::containsElement<FilePath>(
+		buildFilePaths, canonicalRootPath.getConcatenated(L"pom.xml")));
+	REQUIRE(!utility::containsElement<FilePath>(
+		buildFilePaths, canonicalRootPath.getConcatenated(L"core/pom.xml")));
+	REQUIRE(!utility::containsElement<FilePath>(
+		buildFilePaths, canonicalRootPath.getConcatenated(L"unused/pom.xml")));
+
+	boost::filesystem::remove_all(rootPath.getPath());
+}
+
+TEST_CASE("build file cache returns stored paths until a build file changes")
+{
+	const FilePath rootPath = getTempDirectoryPath(L"sourcetrail_build_file_cache_paths");
+	const FilePath pomFilePath = rootPath.getConcatenated(L"pom.xml");
+	const FilePath cacheFilePath = rootPath.getConcatenated(L"cache/paths.cache");
+	writeFile(pomFilePath, getPom("root", {}));
+
+	const std::vector<FilePath> paths = {
+		rootPath.getConcatenated(L"lib/a.jar"), rootPath.getConcatenated(L"lib/b.jar")};
+
+	{
+		const BuildFileCache cache(cacheFilePath, {pomFilePath}, L"config");
+		REQUIRE(!cache.isValid());
+		cache.store(paths);
+	}
+
+	{
+		const BuildFileCache cache(cacheFilePath, {pomFilePath}, L"config");
+		REQUIRE(cache.isValid());
+		REQUIRE(cache.getPaths() == paths);
+	}
+
+	REQUIRE(!BuildFileCache(cacheFilePath, {pomFilePath}, L"other config").isValid());
+
+	writeFile(pomFilePath, getPom("changed", {}));
+	REQUIRE(!BuildFileCache(cacheFilePath, {pomFilePath}, L"config").isValid());
+
+	boost::filesystem::remove_all(rootPath.getPath());
+}
+
+TEST_CASE("build file cache is invalidated by adding a missing build file")
+{
+	const FilePath rootPath = getTempDirectoryPath(L"sourcetrail_build_file_cache_missing");
+	const FilePath configFilePath = rootPath.getConcatenated(L".mvn/maven.config");
+	const FilePath cacheFilePath = rootPath.getConcatenated(L"paths.cache");
+
+	BuildFileCache(cacheFilePath, {configFilePath}, L"").store({});
+	REQUIRE(BuildFileCache(cacheFilePath, {configFilePath}, L"").isValid());
+
+	writeFile(configFilePath, "");
+	REQUIRE(!BuildFileCache(cacheFilePath, {configFilePath}, L"").isValid());
+
+	boost::filesystem::remove_all(rootPath.getPath());
+}
+
+TEST_CASE("build file cache detects snapshot, dynamic and ranged versions")
+{
+	REQUIRE(BuildFileCache::isChangingVersion("1.0-SNAPSHOT"));
+	REQUIRE(BuildFileCache::isChangingVersion("LATEST"));
+	REQUIRE(BuildFileCache::isChangingVersion("[1.0,2.0)"));
+	REQUIRE(BuildFileCache::isChangingVersion("1.+"));
+	REQUIRE(BuildFileCache::isChangingVersion("latest.release"));
+	REQUIRE(!BuildFileCache::isChangingVersion("1.0"));
+	REQUIRE(!BuildFileCache::isChangingVersion("[1.0]"));
+	REQUIRE(!BuildFileCache::isChangingVersion(""));
+}
+
+TEST_CASE("build file cache is disabled for external snapshot dependencies")
+{
+	const FilePath rootPath = getTempDirectoryPath(L"sourcetrail_build_file_cache_snapshot");
+	const FilePath pomFilePath = rootPath.getConcatenated(L"pom.xml");
+	const FilePath cacheFilePath = rootPath.getConcatenated(L"paths.cache");
+
+	// snapshots of modules of the project are built from the checked build files
+	writeFile(
+		pomFilePath,
+		"<project>\n\t<artifactId>root</artifactId>\n\t<version>1.0-SNAPSHOT</version>\n"
+		"\t<properties>\n\t\t<lib.version>[1.0,2.0)</lib.version>\n\t</properties>\n"
+		"\t<dependencies>\n\t\t<dependency>\n\t\t\t<artifactId>root</artifactId>\n"
+		"\t\t\t<version>1.0-SNAPSHOT</version>\n\t\t</dependency>\n\t</dependencies>\n"
+		"</project>\n");
+	BuildFileCache(cacheFilePath, {pomFilePath}, L"").store({});
+	REQUIRE(BuildFileCache(cacheFilePath, {pomFilePath}, L"").isValid());
+
+	writeFile(
+		pomFilePath,
+		"<project>\n\t<artifactId>root</artifactId>\n"
+		"\t<properties>\n\t\t<lib.version>[1.0,2.0)</lib.version>\n\t</properties>\n"
+		"\t<dependencies>\n\t\t<dependency>\n\t\t\t<artifactId>lib</artifactId>\n"
+		"\t\t\t<version>${lib.version}</version>\n\t\t</dependency>\n\t</dependencies>\n"
+		"</project>\n");
+	BuildFileCache(cacheFilePath, {pomFilePath}, L"").store({});
+	REQUIRE(!BuildFileCache(cacheFilePath, {pomFilePath}, L"").isValid());
+
+	const FilePath gradleFilePath = rootPath.getConcatenated(L"build.gradle");
+	writeFile(gradleFilePath, "dependencies {\n\timplementation 'com.example:lib:1.0'\n}\n");
+	BuildFileCache(cacheFilePath, {gradleFilePath}, L"").store({});
+	REQUIRE(BuildFileCache(cacheFilePath, {gradleFilePath}, L"").isValid());
+
+	writeFile(gradleFilePath, "dependencies {\n\timplementation 'com.example:lib:1.+'\n}\n");
+	REQUIRE(!BuildFileCache(cacheFilePath, {gradleFilePath}, L"").isValid());
+
+	boost::filesystem::remove_all(rootPath.getPath());
+}
+
+TEST_CASE("build file cache is disabled without cache file path")
+{
+	const BuildFileCache cache(FilePath(), {}, L"");
+	cache.store({FilePath(L"a.jar")});
+
+	REQUIRE(!cache.isValid());
+	REQUIRE(cache.getPaths().empty());
+}
+
+#endif	  // BUILD_JAVA_LANGUAGE_PACKAGE
@@ -0,0 +1,50 @@
+#include "catch.hpp"
+
+#include "CancellationToken.h"
+
+TEST_CASE("default cancellation token is never canceled")
+{
+	CancellationToken token;
+	CancellationToken::cancel(1);
+
+	REQUIRE(!token.isCanceled());
+}
+
+TEST_CASE("cancellation token is canceled by cancel of its scheduler")
+{
+	CancellationToken token(2);
+	REQUIRE(!token.isCanceled());
+
+	CancellationToken::cancel(2);
+	REQUIRE(token.isCanceled());
+}
+
+TEST_CASE("cancellation token is not canceled by cancel of other scheduler")
+{
+	CancellationToken token(3);
+	CancellationToken::cancel(4);
+
+	REQUIRE(!token.isCanceled());
+}
+
+TEST_CASE("cancellation token created after cancel is not canceled")
+{
+	CancellationToken::cancel(5);
+	CancellationToken token(5);
+
+	REQUIRE(!token.isCanceled());
+}
+
+TEST_CASE("cancellation token scope sets current token of thread")
+{
+	REQUIRE(!CancellationToken::getCurrent().isCanceled());
+
+	{
+		CancellationToken::Scope scope{CancellationToken(6)};
+		CancellationToken::cancel(6);
+
+		REQUIRE(CancellationToken::getCurrent().isCanceled());
+	}
+
+	REQUIRE(!CancellationToken::getCurrent().isCanceled());
+}
@@ -0,0 +1,124 @@
+#include "catch.hpp"
+
+#include "ErrorInfoCache.h"
+
+namespace
+{
+ErrorInfo createError(Id id, const std::wstring& filePath, bool fatal)
+{
+	return ErrorInfo(id, L"message", filePath, 1, 1, L"tu.cpp", fatal, true);
+}
+}	 // namespace
+
+TEST_CASE("error info cache appends nothing before being loaded")
+{
+	ErrorInfoCache cache;
+
+	REQUIRE(!cache.isLoaded());
+	REQUIRE(cache.append({createError(1, L"a.cpp", false)}).empty());
+	REQUIRE(0 == cache.getErrorCount());
+}
+
+TEST_CASE("error info cache gives each occurrence of an error a unique id")
+{
+	ErrorInfoCache cache;
+	cache.load({createError(1, L"a.cpp", false), createError(2, L"a.cpp", true)});
+
+	std::vector<ErrorInfo> appended = cache.append(
+		{createError(1, L"b.cpp", false), createError(3, L"b.cpp", false)});
+
+	REQUIRE(2 == appended.size());
+	REQUIRE(10001 == appended[0].id);
+	REQUIRE(30000 == appended[1].id);
+
+	std::vector<ErrorInfo> errors = cache.getErrors();
+	REQUIRE(4 == errors.size());
+	REQUIRE(10000 == errors[0].id);
+	REQUIRE(20000 == errors[1].id);
+	REQUIRE(10001 == errors[2].id);
+	REQUIRE(30000 == errors[3].id);
+}
+
+TEST_CASE("error info cache counts total and fatal errors")
+{
+	ErrorInfoCache cache;
+	cache.load({createError(1, L"a.cpp", false)});
+	cache.append({createError(2, L"a.cpp", true), createError(3, L"b.cpp", true)});
+
+	ErrorCountInfo errorCount = cache.getErrorCountInfo();
+	REQUIRE(3 == errorCount.total);
+	REQUIRE(2 == errorCount.fatal);
+
+	REQUIRE(2 == cache.getErrors(1).size());
+	REQUIRE(cache.getErrors(3).empty());
+}
+
+TEST_CASE("error info cache finds errors of files in recording order")
+{
+	ErrorInfoCache cache;
+	cache.load({createError(1, L"a.cpp", false), createError(2, L"b.cpp", true)});
+	cache.append({createError(3, L"a.cpp", true), createError(4, L"c.cpp", false)});
+
+	std::vector<ErrorInfo> errors = cache.getErrorsInFiles({L"a.cpp", L"b.cpp"}, ErrorFilter(), false);
+	REQUIRE(3 == errors.size());
+	REQUIRE(10000 == errors[0].id);
+	REQUIRE(20000 == errors[1].id);
+	REQUIRE(30000 == errors[2].id);
+
+	errors = cache.getErrorsInFiles({L"a.cpp", L"b.cpp"}, ErrorFilter(), true);
+	REQUIRE(2 == errors.size());
+	REQUIRE(20000 == errors[0].id);
+	REQUIRE(30000 == errors[1].id);
+
+	ErrorFilter filter;
+	filter.fatal = false;
+	errors = cache.getErrorsInFiles({L"a.cpp", L"c.cpp"}, filter, false);
+	REQUIRE(2 == errors.size());
+	REQUIRE(10000 == errors[0].id);
+	REQUIRE(40000 == errors[1].id);
+}
+
+TEST_CASE("error info cache is empty after clear")
+{
+	ErrorInfoCache cache;
+	cache.load({createError(1, L"a.cpp", false)});
+	cache.clear();
+
+	REQUIRE(!cache.isLoaded());
+	REQUIRE(0 == cache.getErrorCount());
+	REQUIRE(cache.getErrorsInFiles({L"a.cpp"}, ErrorFilter(), false).empty());
+}
+
+TEST_CASE("error info cache requests errors only when loading if not loaded")
+{
+	ErrorInfoCache cache;
+	int requestCount = 0;
+	auto getErrors = [&requestCount]() {
+		requestCount++;
+		return std::vector<ErrorInfo>({createError(1, L"a.cpp", false)});
+	};
+
+	cache.loadIfNotLoaded(getErrors);
+	cache.loadIfNotLoaded(getErrors);
+
+	REQUIRE(1 == requestCount);
+	REQUIRE(cache.isLoaded());
+	REQUIRE(1 == cache.getErrorCount());
+}
+
+TEST_CASE("error info cache appends new errors if loaded and loads all errors otherwise")
+{
+	ErrorInfoCache cache;
+	auto getNewErrors = []() { return std::vector<ErrorInfo>({createError(2, L"b.cpp", true)}); };
+	auto getAllErrors = []() {
+		return std::vector<ErrorInfo>(
+			{createError(1, L"a.cpp", false), createError(2, L"b.cpp", true)});
+	};
+
+	cache.appendOrLoad(getNewErrors, getAllErrors);
+	REQUIRE(2 == cache.getErrorCount());
+
+	cache.appendOrLoad(getNewErrors, getAllErrors);
+	REQUIRE(3 == cache.getErrorCount());
+	REQUIRE(2 == cache.getErrorCountInfo().fatal);
+}
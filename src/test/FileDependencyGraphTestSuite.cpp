@@ -0,0 +1,47 @@
+#include "catch.hpp"
+
+#include "FileDependencyGraph.h"
+
+TEST_CASE("file dependency graph finds transitive dependencies")
+{
+	FileDependencyGraph graph({{1, 2}, {2, 3}, {4, 3}, {5, 6}});
+
+	REQUIRE(6 == graph.getFileCount());
+	REQUIRE(std::set<Id>({2, 3}) == graph.getDependencies({1}));
+	REQUIRE(std::set<Id>({3}) == graph.getDependencies({4}));
+	REQUIRE(std::set<Id>({2, 3, 6}) == graph.getDependencies({1, 5}));
+	REQUIRE(graph.getDependencies({3}).empty());
+}
+
+TEST_CASE("file dependency graph finds transitive dependents")
+{
+	FileDependencyGraph graph({{1, 2}, {2, 3}, {4, 3}, {5, 6}});
+
+	REQUIRE(std::set<Id>({1, 2, 4}) == graph.getDependents({3}));
+	REQUIRE(std::set<Id>({1}) == graph.getDependents({2}));
+	REQUIRE(graph.getDependents({1}).empty());
+}
+
+TEST_CASE("file dependency graph only contains given files that are reachable")
+{
+	FileDependencyGraph graph({{1, 2}, {2, 1}, {3, 1}, {3, 3}});
+
+	REQUIRE(std::set<Id>({1, 2}) == graph.getDependencies({1}));
+	REQUIRE(std::set<Id>({1, 2}) == graph.getDependencies({1, 2}));
+	REQUIRE(std::set<Id>({1, 2, 3}) == graph.getDependencies({3}));
+	REQUIRE(std::set<Id>({1, 2, 3}) == graph.getDependents({1}));
+}
+
+TEST_CASE("file dependency graph ignores unknown and duplicate files")
+{
+	FileDependencyGraph graph({{1, 2}, {1, 2}, {2, 3}});
+
+	REQUIRE(3 == graph.getFileCount());
+	REQUIRE(graph.getDependencies({7}).empty());
+	REQUIRE(graph.getDependents({0}).empty());
+	REQUIRE(std::set<Id>({2, 3}) == graph.getDependencies({1, 7}));
+
+	FileDependencyGraph emptyGraph;
+	REQUIRE(0 == emptyGraph.getFileCount());
+	REQUIRE(emptyGraph.getDependencies({1}).empty());
+}
@@ -0,0 +1,211 @@
+#include "catch.hpp"
+
+#include <fstream>
+#include <thread>
+
+#include "FileLogger.h"
+#include "FileSystem.h"
+#include "LogManagerImplementation.h"
+#include "utilityString.h"
+
+namespace
+{
+const FilePath s_logDirectoryPath(L"data/FileLoggerTestSuite/");
+
+std::vector<std::string> readLines(const FilePath& filePath)
+{
+	std::vector<std::string> lines;
+
+	std::ifstream fileStream(filePath.str());
+	std::string line;
+	while (std::getline(fileStream, line))
+	{
+		lines.push_back(line);
+	}
+
+	return lines;
+}
+
+void writeLines(const FilePath& filePath, const std::vector<std::string>& lines)
+{
+	std::ofstream fileStream(filePath.str());
+	for (const std::string& line: lines)
+	{
+		fileStream << line << '\n';
+	}
+}
+
+void logNumberedMessages(
+	LogManagerImplementation* logManagerImplementation,
+	const unsigned int threadIndex,
+	const unsigned int messageCount)
+{
+	for (unsigned int i = 0; i < messageCount; i++)
+	{
+		logManagerImplementation->logInfo(
+			L"thread " + std::to_wstring(threadIndex) + L" message " + std::to_wstring(i),
+			__FILE__,
+			__FUNCTION__,
+			__LINE__);
+	}
+}
+
+void removeLogFiles()
+{
+	for (const FilePath& filePath: FileSystem::getFilePathsFromDirectory(s_logDirectoryPath))
+	{
+		FileSystem::remove(filePath);
+	}
+}
+}	 // namespace
+
+TEST_CASE("file logger writes messages of all threads in the order they were logged")
+{
+	const unsigned int threadCount = 8;
+	const unsigned int messageCount = 1000;
+
+	FilePath logFilePath;
+	{
+		std::shared_ptr<FileLogger> logger = std::make_shared<FileLogger>();
+		logger->setLogDirectory(s_logDirectoryPath);
+		logger->setFileName(L"threaded");
+		logFilePath = logger->getLogFilePath();
+
+		LogManagerImplementation logManagerImplementation;
+		logManagerImplementation.addLogger(logger);
+
+		std::vector<std::thread> threads;
+		for (unsigned int i = 0; i < threadCount; i++)
+		{
+			threads.emplace_back(logNumberedMessages, &logManagerImplementation, i, messageCount);
+		}
+		for (std::thread& thread: threads)
+		{
+			thread.join();
+		}
+	}
+
+	const std::vector<std::string> lines = readLines(logFilePath);
+	removeLogFiles();
+
+	REQUIRE(lines.size() == threadCount * messageCount);
+
+	std::vector<unsigned int> nextMessageIndices(threadCount, 0);
+	for (const std::string& line: lines)
+	{
+		const std::vector<std::string> words = utility::splitToVector(line, ' ');
+		REQUIRE(words.size() >= 3);
+
+		const unsigned int threadIndex = std::stoi(words[words.size() - 3]);
+		const unsigned int messageIndex = std::stoi(words.back());
+		REQUIRE(threadIndex < threadCount);
+		REQUIRE(messageIndex == nextMessageIndices[threadIndex]);
+		nextMessageIndices[threadIndex]++;
+	}
+}
+
+TEST_CASE("file logger writes queued messages on flush")
+{
+	std::shared_ptr<FileLogger> logger = std::make_shared<FileLogger>();
+	logger->setLogDirectory(s_logDirectoryPath);
+	logger->setFileName(L"flushed");
+
+	LogManagerImplementation logManagerImplementation;
+	logManagerImplementation.addLogger(logger);
+	logManagerImplementation.logInfo(L"foo", "", "", 0);
+	logManagerImplementation.logError(L"bar", "", "", 0);
+
+	logger->flush();
+	const std::vector<std::string> lines = readLines(logger->getLogFilePath());
+	removeLogFiles();
+
+	REQUIRE(lines.size() == 2);
+	REQUIRE(utility::isPostfix<std::string>(" | INFO: foo", lines[0]));
+	REQUIRE(utility::isPostfix<std::string>(" | ERROR: bar", lines[1]));
+}
+
+TEST_CASE("file logger continues in next log file when max file size is reached")
+{
+	std::shared_ptr<FileLogger> logger = std::make_shared<FileLogger>();
+	logger->setLogDirectory(s_logDirectoryPath);
+	logger->setMaxLogFileSize(1500);
+	logger->setMaxLogFileCount(3);
+	logger->setFileName(L"rotated");
+
+	LogManagerImplementation logManagerImplementation;
+	logManagerImplementation.addLogger(logger);
+	logNumberedMessages(&logManagerImplementation, 0, 20);
+	logger->flush();
+
+	const std::vector<std::string> lines0 = readLines(
+		s_logDirectoryPath.getConcatenated(L"rotated_0.txt"));
+	const std::vector<std::string> lines1 = readLines(
+		s_logDirectoryPath.getConcatenated(L"rotated_1.txt"));
+	const bool file2Exists = s_logDirectoryPath.getConcatenated(L"rotated_2.txt").exists();
+	removeLogFiles();
+
+	REQUIRE(!lines0.empty());
+	REQUIRE(!lines1.empty());
+	REQUIRE(lines0.size() + lines1.size() == 20);
+	REQUIRE(!file2Exists);
+}
+
+TEST_CASE("file logger merges log files of processes by timestamp")
+{
+	const FilePath logFilePath = s_logDirectoryPath.getConcatenated(L"merged.txt");
+
+	std::shared_ptr<FileLogger> logger = std::make_shared<FileLogger>();
+	logger->setLogDirectory(s_logDirectoryPath);
+	logger->setLogFilePath(logFilePath);
+
+	const FilePath processLogFilePath1 = FileLogger::getProcessLogFilePath(logFilePath, 1);
+	const FilePath processLogFilePath2 = FileLogger::getProcessLogFilePath(logFilePath, 2);
+	writeLines(
+		processLogFilePath1,
+		{"10:00:00.100 | 1 | INFO: a", "10:00:00.300 | 1 | INFO: c", "multiline c",
+		 "10:00:01.000 | 1 | INFO: e"});
+	writeLines(processLogFilePath2, {"10:00:00.200 | 2 | INFO: b", "10:00:00.400 | 2 | INFO: d"});
+
+	logger->mergeLogFiles(
+		{processLogFilePath1,
+		 processLogFilePath2,
+		 FileLogger::getProcessLogFilePath(logFilePath, 3)});
+
+	const std::vector<std::string> lines = readLines(logFilePath);
+	const bool processLogFilesExist = processLogFilePath1.exists() || processLogFilePath2.exists();
+	removeLogFiles();
+
+	REQUIRE(processLogFilePath1.fileName() == L"merged_indexer1.txt");
+	REQUIRE(!processLogFilesExist);
+	REQUIRE(lines.size() == 6);
+	REQUIRE(lines[0] == "10:00:00.100 | 1 | INFO: a");
+	REQUIRE(lines[1] == "10:00:00.200 | 2 | INFO: b");
+	REQUIRE(lines[2] == "10:00:00.300 | 1 | INFO: c");
+	REQUIRE(lines[3] == "multiline c");
+	REQUIRE(lines[4] == "10:00:00.400 | 2 | INFO: d");
+	REQUIRE(lines[5] == "10:00:01.000 | 1 | INFO: e");
+}
+
+TEST_CASE("file logger writes messages before returning when writing synchronously")
+{
+	std::shared_ptr<FileLogger> logger = std::make_shared<FileLogger>();
+	logger->setLogDirectory(s_logDirectoryPath);
+	logger->setFileName(L"synchronous");
+	logger->setWriteSynchronously(true);
+
+	LogManagerImplementation logManagerImplementation;
+	logManagerImplementation.addLogger(logger);
+	logManagerImplementation.logInfo(L"foo", "", "", 0);
+
+	std::vector<std::string> lines = readLines(logger->getLogFilePath());
+	REQUIRE(lines.size() == 1);
+	REQUIRE(lines[0].find("INFO: foo") != std::string::npos);
+
+	logManagerImplementation.logInfo(L"bar", "", "", 0);
+
+	lines = readLines(logger->getLogFilePath());
+	removeLogFiles();
+
+	REQUIRE(lines.size() == 2);
+	REQUIRE(lines[1].find("INFO: bar") != std::string::npos);
+}
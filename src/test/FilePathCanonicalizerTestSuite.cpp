@@ -0,0 +1,77 @@
+#include "catch.hpp"
+
+#include "FilePathCanonicalizer.h"
+
+TEST_CASE("file path canonicalizer does not have unresolved paths")
+{
+	std::shared_ptr<FilePathCanonicalizer> canonicalizer = FilePathCanonicalizer::getInstance();
+	canonicalizer->clear();
+
+	REQUIRE(canonicalizer->getCachedCanonicalFilePath(L"data/FilePathTestSuite/a.cpp").empty());
+	REQUIRE(canonicalizer->getCachedPathCount() == 0);
+}
+
+TEST_CASE("file path canonicalizer returns resolved path")
+{
+	std::shared_ptr<FilePathCanonicalizer> canonicalizer = FilePathCanonicalizer::getInstance();
+	canonicalizer->clear();
+
+	const FilePath canonicalPath = canonicalizer->resolveCanonicalFilePath(
+		L"data/FilePathTestSuite/../FilePathTestSuite/a.cpp");
+
+	REQUIRE(canonicalPath == FilePath(L"data/FilePathTestSuite/a.cpp"));
+	REQUIRE(
+		canonicalizer->getCachedCanonicalFilePath(
+			L"data/FilePathTestSuite/../FilePathTestSuite/a.cpp") == canonicalPath);
+	REQUIRE(canonicalizer->getCachedCanonicalFilePath(canonicalPath.wstr()) == canonicalPath);
+}
+
+TEST_CASE("file path canonicalizer folds case only on case insensitive platforms")
+{
+	std::shared_ptr<FilePathCanonicalizer> canonicalizer = FilePathCanonicalizer::getInstance();
+	canonicalizer->clear();
+
+	const FilePath canonicalPath = canonicalizer->resolveCanonicalFilePath(
+		L"data/FilePathTestSuite/a.cpp");
+
+#if defined(_WIN32) || defined(__APPLE__)
+	REQUIRE(
+		canonicalizer->getCachedCanonicalFilePath(L"DATA/FilePathTestSuite/A.cpp") ==
+		canonicalPath);
+#else
+	REQUIRE(canonicalizer->getCachedCanonicalFilePath(L"DATA/FilePathTestSuite/A.cpp").empty());
+#endif
+}
+
+TEST_CASE("file path canonicalizer counts file system calls of reused paths")
+{
+	std::shared_ptr<FilePathCanonicalizer> canonicalizer = FilePathCanonicalizer::getInstance();
+	canonicalizer->clear();
+
+	const FilePath canonicalPath = canonicalizer->resolveCanonicalFilePath(
+		L"data/FilePathTestSuite/a.cpp");
+	canonicalizer->resolveCanonicalFilePath(L"data/FilePathTestSuite/missing.cpp");
+
+	size_t fileSystemCallCount = 0;
+	canonicalizer->getCachedCanonicalFilePath(L"data/FilePathTestSuite/a.cpp", &fileSystemCallCount);
+	REQUIRE(fileSystemCallCount > 3);
+
+	fileSystemCallCount = 0;
+	canonicalizer->getCachedCanonicalFilePath(
+		L"data/FilePathTestSuite/missing.cpp", &fileSystemCallCount);
+	REQUIRE(fileSystemCallCount == 1);
+
+	fileSystemCallCount = 0;
+	canonicalizer->getCachedCanonicalFilePath(L"data/FilePathTestSuite/b.cpp", &fileSystemCallCount);
+	REQUIRE(fileSystemCallCount == 0);
+}
+
+TEST_CASE("file path canonicalizer forgets paths when cleared")
+{
+	std::shared_ptr<FilePathCanonicalizer> canonicalizer = FilePathCanonicalizer::getInstance();
+	canonicalizer->resolveCanonicalFilePath(L"data/FilePathTestSuite/a.cpp");
+	canonicalizer->clear();
+
+	REQUIRE(canonicalizer->getCachedCanonicalFilePath(L"data/FilePathTestSuite/a.cpp").empty());
+	REQUIRE(canonicalizer->getCachedPathCount() == 0);
+}
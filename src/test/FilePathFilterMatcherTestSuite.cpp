@@ -0,0 +1,111 @@
+#include "catch.hpp"
+
+#include "FilePathFilter.h"
+#include "FilePathFilterMatcher.h"
+#include "utilityString.h"
+
+TEST_CASE("file path filter matcher matches like each of its filters")
+{
+	const std::vector<std::wstring> filterStrings = {
+		L"test.h",
+		L"*test.*",
+		L"*/this_is_a_test.h",
+		L"*/test.h",
+		L"**test.h",
+		L"root/**/test.h",
+		L"**/test.h",
+		L"folder/test+.h",
+		L"folder/test[-].h",
+		L"folder/test$.h",
+		L"folder/test^.h",
+		L"folder/test(.h",
+		L"folder\\test).h",
+		L"folder/test{.h",
+		L"folder/test}.h",
+		L"folder/test[.h",
+		L"folder\\test].h",
+		L"a/*/b/**",
+		L"***.cpp"};
+
+	const std::vector<std::wstring> fileStrings = {
+		L"test.h",
+		L"testyh",
+		L"this_is_a_test.h",
+		L"folder/this_is_a_test.h",
+		L"root/folder1/folder2/test.h",
+		L"root/test.h",
+		L"folder/test+.h",
+		L"folder/test[-].h",
+		L"folder/test$.h",
+		L"folder/test^.h",
+		L"folder\\test(.h",
+		L"folder/test).h",
+		L"folder/test{.h",
+		L"folder/test}.h",
+		L"folder/test[.h",
+		L"folder/test].h",
+		L"a/x/b/c/d.h",
+		L"a/x/y/b/c.h",
+		L"a/x/b",
+		L"dir/file.cpp",
+		L""};
+
+	for (const std::wstring& filterString: filterStrings)
+	{
+		const FilePathFilter filter(filterString);
+		const FilePathFilterMatcher matcher(std::vector<FilePathFilter>({filter}));
+
+		for (const std::wstring& fileString: fileStrings)
+		{
+			INFO(
+				utility::encodeToUtf8(filterString) + " with " + utility::encodeToUtf8(fileString));
+			REQUIRE(matcher.isMatching(fileString) == filter.isMatching(fileString));
+		}
+	}
+}
+
+TEST_CASE("file path filter matcher matches any of its filters")
+{
+	const FilePathFilterMatcher matcher(std::vector<FilePathFilter>(
+		{FilePathFilter(L"/root/src/**.h"),
+		 FilePathFilter(L"/root/src/*.cpp"),
+		 FilePathFilter(L"/root/build/**")}));
+
+	REQUIRE(matcher.isMatching(FilePath(L"/root/src/a/b.h")));
+	REQUIRE(matcher.isMatching(FilePath(L"/root/src/a.cpp")));
+	REQUIRE(matcher.isMatching(FilePath(L"/root/build/a/b.cpp")));
+	REQUIRE(!matcher.isMatching(FilePath(L"/root/src/a/b.cpp")));
+	REQUIRE(!matcher.isMatching(FilePath(L"/root/include/a.h")));
+}
+
+TEST_CASE("file path filter matcher without filters matches nothing")
+{
+	const FilePathFilterMatcher matcher((std::vector<FilePathFilter>()));
+
+	REQUIRE(!matcher.isMatching(FilePath(L"test.h")));
+	REQUIRE(!matcher.isMatching(FilePath(L"")));
+}
+
+TEST_CASE("file path filter matcher keeps regex meaning of question mark")
+{
+	const FilePathFilterMatcher matcher(std::vector<FilePathFilter>({FilePathFilter(L"tests?.h")}));
+
+	REQUIRE(matcher.isMatching(FilePath(L"test.h")));
+	REQUIRE(matcher.isMatching(FilePath(L"tests.h")));
+	REQUIRE(!matcher.isMatching(FilePath(L"testx.h")));
+}
+
+TEST_CASE("file path filter matcher matches all files in directory only for trailing double star")
+{
+	const FilePathFilterMatcher matcher(std::vector<FilePathFilter>(
+		{FilePathFilter(L"**/node_modules/**"),
+		 FilePathFilter(L"/root/build/*.o"),
+		 FilePathFilter(L"/root/gen*/**")}));
+
+	REQUIRE(matcher.isMatchingAllFilesInDirectory(FilePath(L"/root/node_modules")));
+	REQUIRE(matcher.isMatchingAllFilesInDirectory(FilePath(L"/root/node_modules/a/b")));
+	REQUIRE(matcher.isMatchingAllFilesInDirectory(FilePath(L"/root/generated")));
+	REQUIRE(!matcher.isMatchingAllFilesInDirectory(FilePath(L"/root/build")));
+	REQUIRE(!matcher.isMatchingAllFilesInDirectory(FilePath(L"/root/src")));
+	REQUIRE(!matcher.isMatchingAllFilesInDirectory(FilePath(L"/root/node_modules_old")));
+}
@@ -0,0 +1,80 @@
+#include "catch.hpp"
+
+#include "FilePathFilter.h"
+#include "FileRegister.h"
+
+TEST_CASE("file register has files of indexed directory")
+{
+	const FilePath currentPath(L"data/FileManagerTestSuite/src/a.cpp");
+	const FileRegister fileRegister(
+		currentPath, {FilePath(L"data/FileManagerTestSuite/src/")}, {});
+
+	REQUIRE(fileRegister.hasFilePath(FilePath(L"data/FileManagerTestSuite/src/d.c")));
+	REQUIRE(fileRegister.hasFilePath(FilePath(L"data/FileManagerTestSuite/src/other/x.h")));
+	REQUIRE(!fileRegister.hasFilePath(FilePath(L"data/FileManagerTestSuite/include/c.h")));
+	REQUIRE(!fileRegister.hasFilePath(FilePath(L"data/FileManagerTestSuite/srcx/d.c")));
+}
+
+TEST_CASE("file register has indexed files and current file")
+{
+	const FilePath currentPath(L"data/FileManagerTestSuite/src/a.cpp");
+	const FileRegister fileRegister(
+		currentPath, {FilePath(L"data/FileManagerTestSuite/include/c.h")}, {});
+
+	REQUIRE(fileRegister.hasFilePath(FilePath(L"data/FileManagerTestSuite/src/a.cpp")));
+	REQUIRE(fileRegister.hasFilePath(FilePath(L"data/FileManagerTestSuite/include/c.h")));
+	REQUIRE(!fileRegister.hasFilePath(FilePath(L"data/FileManagerTestSuite/include/b.hpp")));
+	REQUIRE(!fileRegister.hasFilePath(FilePath(L"data/FileManagerTestSuite/include")));
+}
+
+TEST_CASE("file register does not have excluded files of indexed directory")
+{
+	const FilePath currentPath(L"data/FileManagerTestSuite/src/a.cpp");
+	const FileRegister fileRegister(
+		currentPath,
+		{FilePath(L"data/FileManagerTestSuite")},
+		{FilePathFilter(L"data/FileManagerTestSuite/include/**")});
+
+	REQUIRE(fileRegister.hasFilePath(FilePath(L"data/FileManagerTestSuite/src/d.c")));
+	REQUIRE(!fileRegister.hasFilePath(FilePath(L"data/FileManagerTestSuite/include/c.h")));
+}
+
+TEST_CASE("file registers of different current files share decisions for other files")
+{
+	FileRegister::clearSharedState();
+
+	const FileRegister fileRegister1(
+		FilePath(L"data/FileManagerTestSuite/src/a.cpp"),
+		{FilePath(L"data/FileManagerTestSuite/src/")},
+		{FilePathFilter(L"**/other/**")});
+	const FileRegister fileRegister2(
+		FilePath(L"data/FileManagerTestSuite/src/other/x.h"),
+		{FilePath(L"data/FileManagerTestSuite/src/")},
+		{FilePathFilter(L"**/other/**")});
+
+	REQUIRE(fileRegister1.hasFilePath(FilePath(L"data/FileManagerTestSuite/src/d.c")));
+	REQUIRE(fileRegister2.hasFilePath(FilePath(L"data/FileManagerTestSuite/src/d.c")));
+	REQUIRE(fileRegister1.hasFilePath(FilePath(L"data/FileManagerTestSuite/src/a.cpp")));
+	REQUIRE(fileRegister2.hasFilePath(FilePath(L"data/FileManagerTestSuite/src/a.cpp")));
+	REQUIRE(!fileRegister1.hasFilePath(FilePath(L"data/FileManagerTestSuite/src/other/x.h")));
+	REQUIRE(!fileRegister2.hasFilePath(FilePath(L"data/FileManagerTestSuite/src/other/x.h")));
+}
+
+TEST_CASE("file registers of different indexed paths do not share decisions")
+{
+	FileRegister::clearSharedState();
+
+	const FileRegister fileRegister1(
+		FilePath(L"data/FileManagerTestSuite/src/a.cpp"),
+		{FilePath(L"data/FileManagerTestSuite/src/")},
+		{});
+	const FileRegister fileRegister2(
+		FilePath(L"data/FileManagerTestSuite/src/a.cpp"),
+		{FilePath(L"data/FileManagerTestSuite/include/")},
+		{});
+
+	REQUIRE(fileRegister1.hasFilePath(FilePath(L"data/FileManagerTestSuite/src/d.c")));
+	REQUIRE(!fileRegister2.hasFilePath(FilePath(L"data/FileManagerTestSuite/src/d.c")));
+	REQUIRE(!fileRegister1.hasFilePath(FilePath(L"data/FileManagerTestSuite/include/c.h")));
+	REQUIRE(fileRegister2.hasFilePath(FilePath(L"data/FileManagerTestSuite/include/c.h")));
+}
@@ -5,6 +5,8 @@
 #include <string>
 #include <vector>
 
+#include "FilePathFilter.h"
+#include "FilePathFilterMatcher.h"
 #include "FileSystem.h"
 #include "utility.h"
 
@@ -133,6 +135,67 @@ TEST_CASE("find file infos with symlinks")
 #endif
 }
 
+TEST_CASE("find file infos without excluded directories")
+{
+#ifndef _WIN32
+	std::vector<FilePath> directoryPaths;
+	directoryPaths.push_back(FilePath(L"./data/FileSystemTestSuite"));
+
+	std::vector<FileInfo> files = FileSystem::getFileInfosFromPaths(
+		directoryPaths,
+		{L".h", L".hpp", L".cpp"},
+		true,
+		std::make_shared<FilePathFilterMatcher>(
+			std::vector<FilePathFilter>({FilePathFilter(L"**/Settings/**")})));
+
+	REQUIRE(files.size() == 5);
+	REQUIRE(isInFileInfos(files, L"./data/FileSystemTestSuite/main.cpp"));
+	REQUIRE(isInFileInfos(files, L"./data/FileSystemTestSuite/Sound.hpp"));
+	REQUIRE(isInFileInfos(files, L"./data/FileSystemTestSuite/tictactoe.h"));
+	REQUIRE(isInFileInfos(files, L"./data/FileSystemTestSuite/src/test.cpp"));
+	REQUIRE(isInFileInfos(files, L"./data/FileSystemTestSuite/src/test.h"));
+#endif
+}
+
+TEST_CASE("find files of directory before files of sub directories")
+{
+	std::vector<std::wstring> headerFiles = utility::convert<FilePath, std::wstring>(
+		FileSystem::getFilePathsFromDirectory(FilePath(L"data/FileSystemTestSuite"), {L".h"}),
+		[](const FilePath& filePath) { return filePath.wstr(); });
+
+	REQUIRE(
+		headerFiles ==
+		std::vector<std::wstring>(
+			{L"data/FileSystemTestSuite/tictactoe.h",
+			 L"data/FileSystemTestSuite/Settings/player.h",
+			 L"data/FileSystemTestSuite/src/test.h"}));
+}
+
+TEST_CASE("find file infos of directories before passed files")
+{
+	std::vector<FileInfo> files = FileSystem::getFileInfosFromPaths(
+		{FilePath(L"data/FileSystemTestSuite/tictactoe.h"),
+		 FilePath(L"data/FileSystemTestSuite/Settings")},
+		{L".h"},
+		false);
+
+	REQUIRE(files.size() == 2);
+	REQUIRE(
+		files[0].path.wstr() ==
+		FilePath(L"data/FileSystemTestSuite/Settings/player.h").getCanonical().wstr());
+	REQUIRE(
+		files[1].path.wstr() ==
+		FilePath(L"data/FileSystemTestSuite/tictactoe.h").getCanonical().wstr());
+}
+
+TEST_CASE("last write time of missing file is invalid")
+{
+	REQUIRE(
+		!FileSystem::getLastWriteTime(FilePath(L"data/FileSystemTestSuite/missing.h")).isValid());
+	REQUIRE(
+		FileSystem::getLastWriteTime(FilePath(L"data/FileSystemTestSuite/tictactoe.h")).isValid());
+}
+
 TEST_CASE("find symlinked directories")
 {
 #ifndef _WIN32
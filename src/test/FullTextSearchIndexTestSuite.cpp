@@ -0,0 +1,41 @@
+#include "catch.hpp"
+
+#include "FullTextSearchIndex.h"
+
+TEST_CASE("fulltext search index finds case insensitive positions of term")
+{
+	FullTextSearchIndex index;
+	index.addFile(1, L"foo bar\nBar baz\n");
+	index.addFile(2, L"nothing here\n");
+
+	std::vector<FullTextSearchResult> results = index.searchForTerm(L"bar");
+
+	REQUIRE(1 == results.size());
+	REQUIRE(1 == results[0].fileId);
+	REQUIRE(2 == results[0].positions.size());
+	REQUIRE(4 == results[0].positions[0]);
+	REQUIRE(8 == results[0].positions[1]);
+}
+
+TEST_CASE("fulltext search result maps positions to lines and columns")
+{
+	FullTextSearchIndex index;
+	index.addFile(1, L"foo bar\nBar baz\n\nbar");
+
+	std::vector<FullTextSearchResult> results = index.searchForTerm(L"bar");
+
+	REQUIRE(1 == results.size());
+	const FullTextSearchResult& result = results[0];
+	REQUIRE(3 == result.positions.size());
+
+	REQUIRE(1 == result.getLineNumber(result.positions[0]));
+	REQUIRE(5 == result.getColumnNumber(result.positions[0]));
+	REQUIRE(2 == result.getLineNumber(result.positions[1]));
+	REQUIRE(1 == result.getColumnNumber(result.positions[1]));
+	REQUIRE(4 == result.getLineNumber(result.positions[2]));
+	REQUIRE(1 == result.getColumnNumber(result.positions[2]));
+
+	// line break belongs to the line it ends
+	REQUIRE(1 == result.getLineNumber(7));
+	REQUIRE(8 == result.getColumnNumber(7));
+}
@@ -324,3 +324,62 @@ TEST_CASE("graph removes nodes")
 
 	REQUIRE(1 == graph.getNodeCount());
 }
+
+TEST_CASE("graph removes child nodes and edges of removed node")
+{
+	Graph graph;
+
+	Node* a = graph.createNode(
+		3, NodeType(NODE_CLASS), NameHierarchy(L"A", NAME_DELIMITER_CXX), DEFINITION_EXPLICIT);
+	Node* b = graph.createNode(
+		1, NodeType(NODE_METHOD), NameHierarchy(L"B", NAME_DELIMITER_CXX), DEFINITION_EXPLICIT);
+	Node* c = graph.createNode(
+		2, NodeType(NODE_FUNCTION), NameHierarchy(L"C", NAME_DELIMITER_CXX), DEFINITION_EXPLICIT);
+
+	graph.createEdge(5, Edge::EDGE_MEMBER, a, b);
+	graph.createEdge(4, Edge::EDGE_CALL, c, b);
+
+	std::vector<Id> nodeIds;
+	graph.forEachNode([&nodeIds](Node* node) { nodeIds.push_back(node->getId()); });
+	REQUIRE(nodeIds == std::vector<Id>({1, 2, 3}));
+	REQUIRE(2 == b->getEdgeCount());
+
+	graph.removeNode(a);
+
+	REQUIRE(1 == graph.getNodeCount());
+	REQUIRE(0 == graph.getEdgeCount());
+	REQUIRE(graph.getNodeById(2) == c);
+	REQUIRE(0 == c->getEdgeCount());
+}
+
+TEST_CASE("graph keeps remaining edges of node after removing and adding edges")
+{
+	Graph graph;
+
+	Node* a = graph.createNode(
+		1, NodeType(NODE_FUNCTION), NameHierarchy(L"A", NAME_DELIMITER_CXX), DEFINITION_EXPLICIT);
+	std::vector<Edge*> edges;
+	for (Id i = 0; i < 10; i++)
+	{
+		Node* b = graph.createNode(
+			i + 2,
+			NodeType(NODE_FUNCTION),
+			NameHierarchy(L"B" + std::to_wstring(i), NAME_DELIMITER_CXX),
+			DEFINITION_EXPLICIT);
+		edges.push_back(graph.createEdge(i + 20, Edge::EDGE_CALL, a, b));
+	}
+
+	for (size_t i = 0; i < 8; i++)
+	{
+		graph.removeEdge(edges[i]);
+	}
+	REQUIRE(2 == a->getEdgeCount());
+
+	Edge* edge = graph.createEdge(15, Edge::EDGE_CALL, a, graph.getNodeById(2));
+
+	std::vector<Id> edgeIds;
+	a->forEachEdge([&edgeIds](Edge* e) { edgeIds.push_back(e->getId()); });
+	REQUIRE(edgeIds == std::vector<Id>({15, 28, 29}));
+	REQUIRE(a->findEdge([](Edge* e) { return e->getId() == 28; }) == edges[8]);
+	REQUIRE(a->findEdgeOfType(Edge::EDGE_CALL) == edge);
+}
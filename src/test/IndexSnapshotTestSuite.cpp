@@ -0,0 +1,35 @@
+#include "catch.hpp"
+
+#include "IndexSnapshot.h"
+
+TEST_CASE("index snapshot rejects nodes with more distinct types than it can encode")
+{
+	IndexSnapshot snapshot;
+	for (int type = 0; type < 256; type++)
+	{
+		REQUIRE(snapshot.addNode(type + 1, type));
+	}
+
+	REQUIRE(!snapshot.addNode(257, 256));
+	REQUIRE(snapshot.addNode(258, 255));
+	REQUIRE(snapshot.getNodeCount() == 257);
+	REQUIRE(
+		snapshot.getNodeIds([](int type) { return type == 255; }) ==
+		std::vector<Id>({256, 258}));
+	REQUIRE(snapshot.getNodeIds([](int type) { return type == 256; }).empty());
+}
+
+TEST_CASE("index snapshot returns ids of nodes with matching types in order")
+{
+	IndexSnapshot snapshot;
+	snapshot.addNode(1, 4);
+	snapshot.addNode(2, 8);
+	snapshot.addNode(3, 16);
+	snapshot.addNode(4, 4);
+
+	REQUIRE(snapshot.getNodeCount() == 4);
+	REQUIRE(
+		snapshot.getNodeIds([](int type) { return type != 8; }) == std::vector<Id>({1, 3, 4}));
+	REQUIRE(snapshot.getNodeIds([](int type) { return type == 8; }) == std::vector<Id>({2}));
+	REQUIRE(snapshot.getNodeIds([](int type) { return false; }).empty());
+}
@@ -0,0 +1,129 @@
+#include "catch.hpp"
+
+#include "IndexingBenchmarkReport.h"
+#include "IndexingStatistics.h"
+
+namespace
+{
+class ScopedStatisticsRecording
+{
+public:
+	ScopedStatisticsRecording()
+	{
+		IndexingStatistics::getInstance()->clear();
+		IndexingStatistics::getInstance()->setEnabled(true);
+	}
+
+	~ScopedStatisticsRecording()
+	{
+		IndexingStatistics::getInstance()->setEnabled(false);
+		IndexingStatistics::getInstance()->clear();
+	}
+};
+
+IndexingStatistics::SourceFileTime createSourceFileTime(
+	const std::wstring& filePath, Id processId, double parseMS, double transferMS)
+{
+	IndexingStatistics::SourceFileTime sourceFileTime;
+	sourceFileTime.filePath = FilePath(filePath);
+	sourceFileTime.processId = processId;
+	sourceFileTime.parseMS = parseMS;
+	sourceFileTime.transferMS = transferMS;
+	return sourceFileTime;
+}
+}	 // namespace
+
+TEST_CASE("indexing statistics ignore phases while disabled")
+{
+	IndexingStatistics::getInstance()->clear();
+	{
+		IndexingStatistics::ScopedPhase phase(IndexingStatistics::s_mergePhaseName);
+	}
+
+	REQUIRE(IndexingStatistics::getInstance()->getPhaseTimes().empty());
+}
+
+TEST_CASE("indexing statistics accumulate phase times")
+{
+	ScopedStatisticsRecording recording;
+	std::shared_ptr<IndexingStatistics> statistics = IndexingStatistics::getInstance();
+
+	statistics->addPhaseTime(IndexingStatistics::s_injectPhaseName, 3.0);
+	statistics->addPhaseTime(IndexingStatistics::s_injectPhaseName, 5.0);
+	{
+		IndexingStatistics::ScopedPhase phase(IndexingStatistics::s_mergePhaseName);
+	}
+
+	const std::map<std::string, IndexingStatistics::PhaseTime> phaseTimes =
+		statistics->getPhaseTimes();
+
+	REQUIRE(phaseTimes.size() == 2);
+	REQUIRE(phaseTimes.at("inject").count == 2);
+	REQUIRE(phaseTimes.at("inject").totalMS == Approx(8.0));
+	REQUIRE(phaseTimes.at("inject").maxMS == Approx(5.0));
+	REQUIRE(phaseTimes.at("merge").count == 1);
+}
+
+TEST_CASE("indexing statistics add source file times to parse and transfer phases")
+{
+	ScopedStatisticsRecording recording;
+	std::shared_ptr<IndexingStatistics> statistics = IndexingStatistics::getInstance();
+
+	statistics->addSourceFileTime(createSourceFileTime(L"a.cpp", 1, 10.0, 1.0));
+	statistics->addSourceFileTime(createSourceFileTime(L"b.cpp", 2, 20.0, 2.0));
+
+	const std::map<std::string, IndexingStatistics::PhaseTime> phaseTimes =
+		statistics->getPhaseTimes();
+
+	REQUIRE(statistics->getSourceFileTimes().size() == 2);
+	REQUIRE(phaseTimes.at("parse").totalMS == Approx(30.0));
+	REQUIRE(phaseTimes.at("parse").maxMS == Approx(20.0));
+	REQUIRE(phaseTimes.at("shared_memory_transfer").totalMS == Approx(3.0));
+}
+
+TEST_CASE("indexing statistics keep highest peak memory usage per process")
+{
+	ScopedStatisticsRecording recording;
+	std::shared_ptr<IndexingStatistics> statistics = IndexingStatistics::getInstance();
+
+	statistics->addPeakMemoryUsage(1, 200);
+	statistics->addPeakMemoryUsage(1, 100);
+	statistics->addPeakMemoryUsage(2, 50);
+
+	const std::map<Id, size_t> peakMemoryUsages = statistics->getPeakMemoryUsages();
+
+	REQUIRE(peakMemoryUsages.size() == 2);
+	REQUIRE(peakMemoryUsages.at(1) == 200);
+	REQUIRE(peakMemoryUsages.at(2) == 50);
+	REQUIRE(IndexingStatistics::getPeakMemoryUsage() > 0);
+}
+
+TEST_CASE("indexing benchmark report writes runs as json")
+{
+	ScopedStatisticsRecording recording;
+	std::shared_ptr<IndexingStatistics> statistics = IndexingStatistics::getInstance();
+
+	IndexingBenchmarkReport report(FilePath(L"data/project.srctrlprj"), true, 4, false);
+
+	statistics->addPhaseTime(IndexingStatistics::s_finishPhaseName, 1.5);
+	statistics->addSourceFileTime(createSourceFileTime(L"dir/\"quoted\".cpp", 1, 2.0, 0.25));
+	report.addRun(true, 100.0, *statistics, {{"node", 12}, {"edge", 7}});
+
+	statistics->clear();
+	report.addRun(false, 50.0, *statistics, {});
+
+	const std::string json = report.toJson();
+
+	REQUIRE(report.getRunCount() == 2);
+	REQUIRE(json.find("\"refresh_mode\": \"full\"") != std::string::npos);
+	REQUIRE(json.find("\"indexer_thread_count\": 4") != std::string::npos);
+	REQUIRE(json.find("\"cache\": \"cold\"") != std::string::npos);
+	REQUIRE(json.find("\"cache\": \"warm\"") != std::string::npos);
+	REQUIRE(json.find("\"duration_ms\": 100.000") != std::string::npos);
+	REQUIRE(
+		json.find("\"finish\": {\"count\": 1, \"total_ms\": 1.500, \"max_ms\": 1.500}") !=
+		std::string::npos);
+	REQUIRE(json.find("\"node\": 12") != std::string::npos);
+	REQUIRE(json.find("dir/\\\"quoted\\\".cpp") != std::string::npos);
+	REQUIRE(json.find("\"transfer_ms\": 0.250") != std::string::npos);
+}
@@ -0,0 +1,76 @@
+#include "catch.hpp"
+
+#include <string>
+
+#include "LruCache.h"
+
+TEST_CASE("lru cache returns stored values and counts hits and misses")
+{
+	LruCache<std::string, int> cache(10);
+	cache.setValue("a", 1, 3);
+	cache.setValue("b", 2, 4);
+
+	int value = 0;
+	REQUIRE(cache.getValue("a", value));
+	REQUIRE(value == 1);
+	REQUIRE(cache.getValue("b", value));
+	REQUIRE(value == 2);
+	REQUIRE(!cache.getValue("c", value));
+
+	REQUIRE(cache.getValueCount() == 2);
+	REQUIRE(cache.getSize() == 7);
+	REQUIRE(cache.getHitCount() == 2);
+	REQUIRE(cache.getMissCount() == 1);
+}
+
+TEST_CASE("lru cache removes least recently used values when exceeding max size")
+{
+	LruCache<std::string, int> cache(10);
+	cache.setValue("a", 1, 4);
+	cache.setValue("b", 2, 4);
+
+	int value = 0;
+	REQUIRE(cache.getValue("a", value));
+
+	cache.setValue("c", 3, 4);
+
+	REQUIRE(cache.getValue("a", value));
+	REQUIRE(!cache.getValue("b", value));
+	REQUIRE(cache.getValue("c", value));
+	REQUIRE(cache.getSize() == 8);
+}
+
+TEST_CASE("lru cache replaces values of same key and skips values bigger than max size")
+{
+	LruCache<std::string, int> cache(10);
+	cache.setValue("a", 1, 4);
+	cache.setValue("a", 2, 6);
+
+	int value = 0;
+	REQUIRE(cache.getValue("a", value));
+	REQUIRE(value == 2);
+	REQUIRE(cache.getSize() == 6);
+
+	cache.setValue("b", 3, 11);
+	REQUIRE(!cache.getValue("b", value));
+	REQUIRE(cache.getValue("a", value));
+
+	cache.setValue("a", 4, 11);
+	REQUIRE(!cache.getValue("a", value));
+	REQUIRE(cache.getSize() == 0);
+}
+
+TEST_CASE("lru cache is empty after clear")
+{
+	LruCache<std::string, int> cache(10);
+	cache.setValue("a", 1, 4);
+
+	int value = 0;
+	cache.getValue("a", value);
+	cache.clear();
+
+	REQUIRE(cache.getValueCount() == 0);
+	REQUIRE(cache.getSize() == 0);
+	REQUIRE(cache.getHitCount() == 0);
+	REQUIRE(!cache.getValue("a", value));
+}
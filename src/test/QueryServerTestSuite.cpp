@@ -0,0 +1,349 @@
+#include "catch.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+
+#include "Edge.h"
+#include "IntermediateStorage.h"
+#include "LocationType.h"
+#include "NodeKind.h"
+#include "PersistentStorage.h"
+#include "QueryProtocolHelper.h"
+#include "QueryServer.h"
+
+namespace
+{
+class TestQueryServer: public QueryServer
+{
+public:
+	TestQueryServer(size_t workerCount, size_t maxPendingRequestCount)
+		: QueryServer(nullptr, workerCount, maxPendingRequestCount)
+	{
+	}
+
+	TestQueryServer(std::shared_ptr<const PersistentStorage> storage)
+		: QueryServer(storage, 1, 10)
+	{
+	}
+
+	~TestQueryServer() override
+	{
+		stopWorkers();
+	}
+
+	bool startListening() override
+	{
+		return true;
+	}
+
+	void stopListening() override {}
+
+	bool isListening() const override
+	{
+		return true;
+	}
+
+	void receive(Id clientId, const std::string& requestLine)
+	{
+		handleRequest(clientId, requestLine);
+	}
+
+	std::vector<std::string> waitForResponses(Id clientId, size_t count)
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_condition.wait(lock, [&]() { return m_responses[clientId].size() >= count; });
+		return m_responses[clientId];
+	}
+
+private:
+	void sendResponse(Id clientId, const std::string& response) override
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_responses[clientId].push_back(response);
+		m_condition.notify_all();
+	}
+
+	std::mutex m_mutex;
+	std::condition_variable m_condition;
+	std::map<Id, std::vector<std::string>> m_responses;
+};
+
+// main.cpp includes util.h, which includes base.h
+// main() calls run(), which calls step()
+struct TestIndex
+{
+	TestIndex()
+		: storage(std::make_shared<PersistentStorage>(
+			  FilePath(L"data/test.sqlite"), FilePath(L"data/testBookmarks.sqlite")))
+	{
+		storage->clear();
+
+		std::shared_ptr<IntermediateStorage> intermediateStorage =
+			std::make_shared<IntermediateStorage>();
+
+		const Id mainFileId = addFile(intermediateStorage.get(), L"main.cpp");
+		const Id utilFileId = addFile(intermediateStorage.get(), L"util.h");
+		const Id baseFileId = addFile(intermediateStorage.get(), L"base.h");
+
+		intermediateStorage->addEdge(
+			StorageEdgeData(Edge::typeToInt(Edge::EDGE_INCLUDE), mainFileId, utilFileId));
+		intermediateStorage->addEdge(
+			StorageEdgeData(Edge::typeToInt(Edge::EDGE_INCLUDE), utilFileId, baseFileId));
+
+		const Id mainTempId = addFunction(intermediateStorage.get(), L"main");
+		const Id runTempId = addFunction(intermediateStorage.get(), L"run");
+		const Id stepTempId = addFunction(intermediateStorage.get(), L"step");
+
+		intermediateStorage->addEdge(
+			StorageEdgeData(Edge::typeToInt(Edge::EDGE_CALL), mainTempId, runTempId));
+		intermediateStorage->addEdge(
+			StorageEdgeData(Edge::typeToInt(Edge::EDGE_CALL), runTempId, stepTempId));
+
+		addReference(intermediateStorage.get(), runTempId, utilFileId, 2, 6, 8);
+		addReference(intermediateStorage.get(), runTempId, mainFileId, 5, 2, 4);
+
+		storage->inject(intermediateStorage.get());
+		storage->buildCaches();
+
+		// ids change when injected into the storage
+		mainId = storage->getNodeIdForNameHierarchy(getFunctionNameHierarchy(L"main"));
+		runId = storage->getNodeIdForNameHierarchy(getFunctionNameHierarchy(L"run"));
+		stepId = storage->getNodeIdForNameHierarchy(getFunctionNameHierarchy(L"step"));
+	}
+
+	static NameHierarchy getFunctionNameHierarchy(const std::wstring& name)
+	{
+		NameHierarchy nameHierarchy(NAME_DELIMITER_CXX);
+		nameHierarchy.push(NameElement(name, L"void", L"()"));
+		return nameHierarchy;
+	}
+
+	Id addFile(IntermediateStorage* intermediateStorage, const std::wstring& filePath)
+	{
+		const Id fileId = intermediateStorage
+							  ->addNode(StorageNodeData(
+								  nodeKindToInt(NODE_FILE),
+								  NameHierarchy::serialize(
+									  NameHierarchy(filePath, NAME_DELIMITER_FILE))))
+							  .first;
+		intermediateStorage->addFile(StorageFile(fileId, filePath, L"cpp", "someTime", true, true));
+		return fileId;
+	}
+
+	Id addFunction(IntermediateStorage* intermediateStorage, const std::wstring& name)
+	{
+		const Id functionId = intermediateStorage
+								  ->addNode(StorageNodeData(
+									  nodeKindToInt(NODE_FUNCTION),
+									  NameHierarchy::serialize(getFunctionNameHierarchy(name))))
+								  .first;
+		intermediateStorage->addSymbol(StorageSymbol(functionId, DEFINITION_EXPLICIT));
+		return functionId;
+	}
+
+	void addReference(
+		IntermediateStorage* intermediateStorage,
+		Id elementId,
+		Id fileId,
+		size_t line,
+		size_t startColumn,
+		size_t endColumn)
+	{
+		const Id locationId = intermediateStorage->addSourceLocation(StorageSourceLocationData(
+			fileId, line, startColumn, line, endColumn, locationTypeToInt(LOCATION_TOKEN)));
+		intermediateStorage->addOccurrence(StorageOccurrence(elementId, locationId));
+	}
+
+	std::vector<std::vector<std::wstring>> query(const std::string& requestLine) const
+	{
+		const std::string response = TestQueryServer(storage).processRequest(requestLine);
+
+		const size_t headerEnd = response.find('\n');
+		const QueryProtocolHelper::ResponseHeader header =
+			QueryProtocolHelper::parseResponseHeader(response.substr(0, headerEnd + 1));
+		REQUIRE(header.valid);
+		REQUIRE(header.ok);
+
+		std::vector<std::vector<std::wstring>> rows;
+		for (size_t rowStart = headerEnd + 1; rowStart < response.size();)
+		{
+			const size_t rowEnd = response.find('\n', rowStart);
+			rows.push_back(QueryProtocolHelper::parseResponseRow(
+				response.substr(rowStart, rowEnd - rowStart + 1)));
+			rowStart = rowEnd + 1;
+		}
+		REQUIRE(rows.size() == header.rowCount);
+
+		std::sort(rows.begin(), rows.end());
+		return rows;
+	}
+
+	std::shared_ptr<PersistentStorage> storage;
+
+	Id mainId;
+	Id runId;
+	Id stepId;
+};
+}	 // namespace
+
+TEST_CASE("query protocol parses request with escaped arguments")
+{
+	const std::string line = QueryProtocolHelper::buildRequest(
+		"7", "search", {L"std::vector<std::vector<int>>", L"a\tb\\c\nd"});
+
+	REQUIRE(line.back() == '\n');
+	REQUIRE(std::count(line.begin(), line.end(), '\n') == 1);
+
+	const QueryProtocolHelper::Request request = QueryProtocolHelper::parseRequest(line);
+
+	REQUIRE(request.valid);
+	REQUIRE(request.id == "7");
+	REQUIRE(request.command == "search");
+	REQUIRE(request.arguments.size() == 2);
+	REQUIRE(request.arguments[0] == L"std::vector<std::vector<int>>");
+	REQUIRE(request.arguments[1] == L"a\tb\\c\nd");
+}
+
+TEST_CASE("query protocol rejects request without command")
+{
+	REQUIRE_FALSE(QueryProtocolHelper::parseRequest("").valid);
+	REQUIRE_FALSE(QueryProtocolHelper::parseRequest("1\n").valid);
+	REQUIRE_FALSE(QueryProtocolHelper::parseRequest("1\t\n").valid);
+}
+
+TEST_CASE("query protocol builds response with rows")
+{
+	const std::string response =
+		QueryProtocolHelper::buildResponse("3", {{L"1", L"foo"}, {L"2", L"b\tar"}});
+
+	const size_t headerEnd = response.find('\n');
+	const QueryProtocolHelper::ResponseHeader header =
+		QueryProtocolHelper::parseResponseHeader(response.substr(0, headerEnd + 1));
+
+	REQUIRE(header.valid);
+	REQUIRE(header.ok);
+	REQUIRE(header.id == "3");
+	REQUIRE(header.rowCount == 2);
+
+	const size_t rowEnd = response.find('\n', headerEnd + 1);
+	const std::vector<std::wstring> row = QueryProtocolHelper::parseResponseRow(
+		response.substr(rowEnd + 1, response.size() - rowEnd - 1));
+
+	REQUIRE(row.size() == 2);
+	REQUIRE(row[0] == L"2");
+	REQUIRE(row[1] == L"b\tar");
+}
+
+TEST_CASE("query protocol builds error response")
+{
+	const QueryProtocolHelper::ResponseHeader header = QueryProtocolHelper::parseResponseHeader(
+		QueryProtocolHelper::buildErrorResponse("5", L"Unknown command: foo"));
+
+	REQUIRE(header.valid);
+	REQUIRE_FALSE(header.ok);
+	REQUIRE(header.id == "5");
+	REQUIRE(header.errorMessage == L"Unknown command: foo");
+}
+
+TEST_CASE("query server answers requests on its workers")
+{
+	TestQueryServer server(4, 100);
+
+	for (int i = 0; i < 20; i++)
+	{
+		server.receive(i % 2 + 1, std::to_string(i) + "\tping\n");
+	}
+
+	for (Id clientId = 1; clientId <= 2; clientId++)
+	{
+		for (const std::string& response: server.waitForResponses(clientId, 10))
+		{
+			const QueryProtocolHelper::ResponseHeader header =
+				QueryProtocolHelper::parseResponseHeader(response);
+			REQUIRE(header.ok);
+			REQUIRE(std::stoi(header.id) % 2 + 1 == int(clientId));
+		}
+	}
+}
+
+TEST_CASE("query server reports errors of requests")
+{
+	TestQueryServer server(1, 10);
+
+	REQUIRE_FALSE(QueryProtocolHelper::parseResponseHeader(server.processRequest("1\tfoo\n")).ok);
+	REQUIRE_FALSE(
+		QueryProtocolHelper::parseResponseHeader(server.processRequest("2\tsearch\tmain\n")).ok);
+	REQUIRE(QueryProtocolHelper::parseResponseHeader(server.processRequest("3\tping\n")).ok);
+}
+
+TEST_CASE("query server searches symbols of storage")
+{
+	TestIndex index;
+
+	const std::vector<std::vector<std::wstring>> rows = index.query("1\tsearch\tstep\n");
+
+	REQUIRE(rows.size() == 1);
+	REQUIRE(rows[0].size() == 3);
+	REQUIRE(rows[0][0] == std::to_wstring(index.stepId));
+	REQUIRE(rows[0][1] == L"function");
+	REQUIRE(rows[0][2] == L"step");
+}
+
+TEST_CASE("query server lists references of symbol")
+{
+	TestIndex index;
+
+	const std::vector<std::vector<std::wstring>> rows = index.query(
+		"1\treferences\t" + std::to_string(index.runId) + "\n");
+
+	REQUIRE(rows.size() == 2);
+	REQUIRE(rows[0] == std::vector<std::wstring>({L"main.cpp", L"5", L"2", L"5", L"4"}));
+	REQUIRE(rows[1] == std::vector<std::wstring>({L"util.h", L"2", L"6", L"2", L"8"}));
+}
+
+TEST_CASE("query server lists direct and transitive callers")
+{
+	TestIndex index;
+
+	const std::wstring mainId = std::to_wstring(index.mainId);
+	const std::wstring runId = std::to_wstring(index.runId);
+	const std::wstring stepId = std::to_wstring(index.stepId);
+
+	std::vector<std::vector<std::wstring>> rows = index.query(
+		"1\tcallers\t" + std::to_string(index.stepId) + "\n");
+
+	REQUIRE(rows.size() == 1);
+	REQUIRE(rows[0] == std::vector<std::wstring>({runId, L"run", stepId, L"step"}));
+
+	rows = index.query("2\tcallers\t" + std::to_string(index.stepId) + "\t0\n");
+
+	REQUIRE(rows.size() == 2);
+	REQUIRE(
+		std::find(
+			rows.begin(), rows.end(), std::vector<std::wstring>({mainId, L"main", runId, L"run"})) !=
+		rows.end());
+	REQUIRE(
+		std::find(
+			rows.begin(), rows.end(), std::vector<std::wstring>({runId, L"run", stepId, L"step"})) !=
+		rows.end());
+
+	rows = index.query("3\tcallees\t" + std::to_string(index.mainId) + "\n");
+
+	REQUIRE(rows.size() == 1);
+	REQUIRE(rows[0] == std::vector<std::wstring>({mainId, L"main", runId, L"run"}));
+}
+
+TEST_CASE("query server lists transitive file dependencies and dependents")
+{
+	TestIndex index;
+
+	REQUIRE(
+		index.query("1\tdependencies\tmain.cpp\n") ==
+		std::vector<std::vector<std::wstring>>({{L"base.h"}, {L"util.h"}}));
+	REQUIRE(
+		index.query("2\tdependents\tbase.h\n") ==
+		std::vector<std::vector<std::wstring>>({{L"main.cpp"}, {L"util.h"}}));
+	REQUIRE(index.query("3\tdependents\tmain.cpp\n").empty());
+}
@@ -1,5 +1,7 @@
 #include "catch.hpp"
 
+#include <thread>
+
 #include "NameHierarchy.h"
 #include "SearchIndex.h"
 #include "utility.h"
@@ -91,3 +93,145 @@ TEST_CASE("search index rates higher on consecutive letters")
 	REQUIRE(L"ocbcabc" == results[0].text);
 	REQUIRE(L"oaabbcc" == results[1].text);
 }
+
+TEST_CASE("search index finds same results for extended query as for new query")
+{
+	const std::vector<std::wstring> names = {
+		L"foo::bar", L"foo::baz", L"fooBar", L"FoBaz", L"format", L"ofbar", L"barFoo"};
+
+	SearchIndex incrementalIndex;
+	SearchIndex index;
+	for (size_t i = 0; i < names.size(); i++)
+	{
+		incrementalIndex.addNode(i + 1, names[i]);
+		index.addNode(i + 1, names[i]);
+	}
+	incrementalIndex.finishSetup();
+	index.finishSetup();
+
+	const std::wstring query = L"FoBa";
+	for (size_t i = 1; i <= query.size(); i++)
+	{
+		std::vector<SearchResult> incrementalResults = incrementalIndex.search(
+			query.substr(0, i), NodeTypeSet::all(), 0);
+
+		index.clear();
+		for (size_t j = 0; j < names.size(); j++)
+		{
+			index.addNode(j + 1, names[j]);
+		}
+		index.finishSetup();
+		std::vector<SearchResult> results = index.search(query.substr(0, i), NodeTypeSet::all(), 0);
+
+		REQUIRE(results.size() == incrementalResults.size());
+		for (size_t j = 0; j < results.size(); j++)
+		{
+			REQUIRE(results[j].text == incrementalResults[j].text);
+			REQUIRE(results[j].indices == incrementalResults[j].indices);
+			REQUIRE(results[j].score == incrementalResults[j].score);
+		}
+	}
+}
+
+TEST_CASE("search index does not reuse results of previous query after adding nodes")
+{
+	SearchIndex index;
+	index.addNode(1, L"foo");
+	index.finishSetup();
+	REQUIRE(1 == index.search(L"f", NodeTypeSet::all(), 0).size());
+
+	index.addNode(2, L"fob");
+	index.finishSetup();
+	std::vector<SearchResult> results = index.search(L"fo", NodeTypeSet::all(), 0);
+
+	REQUIRE(2 == results.size());
+}
+
+TEST_CASE("search index finds same results after merging other indices")
+{
+	const std::vector<std::wstring> names = {L"foo", L"bar", L"fob", L"baz", L"qux", L"foobar"};
+
+	SearchIndex index;
+	for (size_t i = 0; i < names.size(); i++)
+	{
+		index.addNode(i + 1, names[i]);
+	}
+	index.finishSetup();
+
+	SearchIndex mergedIndex;
+	mergedIndex.addNode(1, names[0]);
+	mergedIndex.finishSetup();
+
+	SearchIndex otherIndex;
+	for (size_t i = 1; i < names.size(); i++)
+	{
+		otherIndex.addNode(i + 1, names[i]);
+	}
+	otherIndex.finishSetup();
+
+	mergedIndex.merge(otherIndex);
+
+	REQUIRE(0 == otherIndex.search(L"o", NodeTypeSet::all(), 0).size());
+	for (const std::wstring query: {L"o", L"fo", L"ba", L"x", L"fbr"})
+	{
+		std::vector<SearchResult> results = index.search(query, NodeTypeSet::all(), 0);
+		std::vector<SearchResult> mergedResults = mergedIndex.search(query, NodeTypeSet::all(), 0);
+
+		REQUIRE(results.size() == mergedResults.size());
+		for (size_t i = 0; i < results.size(); i++)
+		{
+			REQUIRE(results[i].text == mergedResults[i].text);
+			REQUIRE(results[i].elementIds == mergedResults[i].elementIds);
+		}
+	}
+}
+
+TEST_CASE("search index finds same results for queries extended on several threads")
+{
+	const std::vector<std::wstring> names = {
+		L"foo::bar", L"foo::baz", L"fooBar", L"FoBaz", L"format", L"ofbar", L"barFoo"};
+
+	SearchIndex index;
+	for (size_t i = 0; i < names.size(); i++)
+	{
+		index.addNode(i + 1, names[i]);
+	}
+	index.finishSetup();
+
+	const std::vector<std::wstring> queries = {L"FoBa", L"bar", L"fmt", L"ofb"};
+	std::vector<std::vector<size_t>> resultCounts(queries.size());
+	std::vector<std::thread> threads;
+	for (size_t i = 0; i < queries.size(); i++)
+	{
+		threads.emplace_back([&index, &queries, &resultCounts, i]() {
+			for (size_t repetition = 0; repetition < 100; repetition++)
+			{
+				for (size_t j = 1; j <= queries[i].size(); j++)
+				{
+					resultCounts[i].push_back(
+						index.search(queries[i].substr(0, j), NodeTypeSet::all(), 0).size());
+				}
+			}
+		});
+	}
+	for (std::thread& thread: threads)
+	{
+		thread.join();
+	}
+
+	for (size_t i = 0; i < queries.size(); i++)
+	{
+		for (size_t j = 0; j < resultCounts[i].size(); j++)
+		{
+			SearchIndex newIndex;
+			for (size_t k = 0; k < names.size(); k++)
+			{
+				newIndex.addNode(k + 1, names[k]);
+			}
+			newIndex.finishSetup();
+
+			const std::wstring query = queries[i].substr(0, j % queries[i].size() + 1);
+			REQUIRE(resultCounts[i][j] == newIndex.search(query, NodeTypeSet::all(), 0).size());
+		}
+	}
+}
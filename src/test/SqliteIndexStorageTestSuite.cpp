@@ -1,6 +1,11 @@
 #include "catch.hpp"
 
+#include <algorithm>
+#include <thread>
+
 #include "FileSystem.h"
+#include "SourceLocation.h"
+#include "SourceLocationFile.h"
 #include "SqliteIndexStorage.h"
 
 TEST_CASE("storage adds node successfully")
@@ -57,6 +62,26 @@ TEST_CASE("storage adds edge successfully")
 	REQUIRE(1 == edgeCount);
 }
 
+TEST_CASE("storage counts rows of its tables")
+{
+	FilePath databasePath(L"data/SQLiteTestSuite/test.sqlite");
+	std::map<std::string, size_t> rowCounts;
+	{
+		SqliteIndexStorage storage(databasePath);
+		storage.setup();
+		storage.beginTransaction();
+		storage.addNode(StorageNodeData(0, L"a"));
+		storage.addNode(StorageNodeData(0, L"b"));
+		storage.commitTransaction();
+		rowCounts = storage.getTableRowCounts();
+	}
+	FileSystem::remove(databasePath);
+
+	REQUIRE(rowCounts.size() > 2);
+	REQUIRE(rowCounts["node"] == 2);
+	REQUIRE(rowCounts["edge"] == 0);
+}
+
 TEST_CASE("storage removes edge successfully")
 {
 	FilePath databasePath(L"data/SQLiteTestSuite/test.sqlite");
@@ -76,3 +101,249 @@ TEST_CASE("storage removes edge successfully")
 
 	REQUIRE(0 == edgeCount);
 }
+
+TEST_CASE("storage in read mode answers queries from multiple threads")
+{
+	FilePath databasePath(L"data/SQLiteTestSuite/test.sqlite");
+	std::vector<int> nodeCounts(4, -1);
+	int nodeCountAfterWrite = -1;
+	{
+		SqliteIndexStorage storage(databasePath);
+		storage.setup();
+		storage.beginTransaction();
+		storage.addNode(StorageNodeData(0, L"a"));
+		storage.addNode(StorageNodeData(0, L"b"));
+		storage.commitTransaction();
+		storage.setMode(SqliteIndexStorage::STORAGE_MODE_READ);
+
+		std::vector<std::thread> threads;
+		for (size_t i = 0; i < nodeCounts.size(); i++)
+		{
+			threads.emplace_back([&storage, &nodeCounts, i]() {
+				nodeCounts[i] = storage.getNodeCount();
+			});
+		}
+		for (std::thread& thread: threads)
+		{
+			thread.join();
+		}
+
+		storage.beginTransaction();
+		storage.addNode(StorageNodeData(0, L"c"));
+		storage.commitTransaction();
+		nodeCountAfterWrite = storage.getNodeCount();
+	}
+	FileSystem::remove(databasePath);
+
+	for (int nodeCount: nodeCounts)
+	{
+		REQUIRE(2 == nodeCount);
+	}
+	REQUIRE(3 == nodeCountAfterWrite);
+}
+
+TEST_CASE("storage returns read connections when their queries end")
+{
+	FilePath databasePath(L"data/SQLiteTestSuite/test.sqlite");
+	std::vector<int> nodeCounts(40, -1);
+	size_t readConnectionCount = 0;
+	{
+		SqliteIndexStorage storage(databasePath);
+		storage.setup();
+		storage.beginTransaction();
+		storage.addNode(StorageNodeData(0, L"a"));
+		storage.commitTransaction();
+		storage.setMode(SqliteIndexStorage::STORAGE_MODE_READ);
+
+		// the main thread keeps running while the other threads query one after another
+		nodeCounts[0] = storage.getNodeCount();
+		for (size_t i = 1; i < nodeCounts.size(); i++)
+		{
+			std::thread([&storage, &nodeCounts, i]() {
+				nodeCounts[i] = storage.getNodeCount();
+			}).join();
+		}
+		readConnectionCount = storage.getReadConnectionCount();
+	}
+	FileSystem::remove(databasePath);
+
+	for (int nodeCount: nodeCounts)
+	{
+		REQUIRE(1 == nodeCount);
+	}
+	REQUIRE(1 == readConnectionCount);
+}
+
+TEST_CASE("storage keeps other threads reading committed data during a transaction")
+{
+	FilePath databasePath(L"data/SQLiteTestSuite/test.sqlite");
+	int otherThreadNodeCount = -1;
+	int transactionThreadNodeCount = -1;
+	{
+		SqliteIndexStorage storage(databasePath);
+		storage.setup();
+		storage.beginTransaction();
+		storage.addNode(StorageNodeData(0, L"a"));
+		storage.commitTransaction();
+		storage.setMode(SqliteIndexStorage::STORAGE_MODE_READ);
+
+		storage.beginTransaction();
+		storage.addNode(StorageNodeData(0, L"b"));
+		std::thread([&storage, &otherThreadNodeCount]() {
+			otherThreadNodeCount = storage.getNodeCount();
+		}).join();
+		transactionThreadNodeCount = storage.getNodeCount();
+		storage.commitTransaction();
+	}
+	FileSystem::remove(databasePath);
+
+	REQUIRE(1 == otherThreadNodeCount);
+	REQUIRE(2 == transactionThreadNodeCount);
+}
+
+TEST_CASE("storage adds equal source locations only once")
+{
+	FilePath databasePath(L"data/SQLiteTestSuite/test.sqlite");
+	std::vector<Id> firstIds;
+	std::vector<Id> secondIds;
+	int sourceLocationCount = -1;
+	{
+		SqliteIndexStorage storage(databasePath);
+		storage.setup();
+		storage.beginTransaction();
+		const Id fileId = storage.addNode(StorageNodeData(0, L"file"));
+		storage.addFile(
+			StorageFile(fileId, L"file.cpp", L"cpp", "2000-01-01 00:00:00", false, true));
+
+		firstIds = storage.addSourceLocations(
+			{StorageSourceLocation(0, fileId, 3, 1, 3, 5, 1),
+			 StorageSourceLocation(0, fileId, 1, 1, 1, 5, 1),
+			 StorageSourceLocation(0, fileId, 3, 1, 3, 5, 1)});
+		secondIds = storage.addSourceLocations(
+			{StorageSourceLocation(0, fileId, 1, 1, 1, 5, 1),
+			 StorageSourceLocation(0, fileId, 2, 1, 2, 5, 1)});
+		storage.commitTransaction();
+		sourceLocationCount = storage.getSourceLocationCount();
+	}
+	FileSystem::remove(databasePath);
+
+	REQUIRE(3 == sourceLocationCount);
+	REQUIRE(firstIds[0] == firstIds[2]);
+	REQUIRE(firstIds[0] != firstIds[1]);
+	REQUIRE(secondIds[0] == firstIds[1]);
+	REQUIRE(secondIds[1] != firstIds[0]);
+	REQUIRE(secondIds[1] != firstIds[1]);
+}
+
+TEST_CASE("storage returns source locations for lines in file")
+{
+	FilePath databasePath(L"data/SQLiteTestSuite/test.sqlite");
+	std::vector<Id> locationIds;
+	std::vector<Id> linesLocationIds;
+	std::vector<Id> fileLocationIds;
+	{
+		SqliteIndexStorage storage(databasePath);
+		storage.setup();
+		storage.beginTransaction();
+		const Id fileId = storage.addNode(StorageNodeData(0, L"file"));
+		storage.addFile(
+			StorageFile(fileId, L"file.cpp", L"cpp", "2000-01-01 00:00:00", false, true));
+
+		locationIds = storage.addSourceLocations(
+			{StorageSourceLocation(0, fileId, 1, 1, 20, 1, 1),
+			 StorageSourceLocation(0, fileId, 5, 1, 5, 5, 1),
+			 StorageSourceLocation(0, fileId, 10, 1, 10, 5, 1),
+			 StorageSourceLocation(0, fileId, 15, 1, 15, 5, 1)});
+		storage.commitTransaction();
+
+		storage.getSourceLocationsForLinesInFile(FilePath(L"file.cpp"), 8, 12)
+			->forEachStartSourceLocation([&linesLocationIds](SourceLocation* location) {
+				linesLocationIds.push_back(location->getLocationId());
+			});
+		storage.getSourceLocationsForFile(FilePath(L"file.cpp"))
+			->forEachStartSourceLocation([&fileLocationIds](SourceLocation* location) {
+				fileLocationIds.push_back(location->getLocationId());
+			});
+	}
+	FileSystem::remove(databasePath);
+
+	REQUIRE(linesLocationIds == std::vector<Id>({locationIds[0], locationIds[2]}));
+	REQUIRE(fileLocationIds == locationIds);
+}
+
+TEST_CASE("storage returns source locations added in many batches")
+{
+	FilePath databasePath(L"data/SQLiteTestSuite/test.sqlite");
+	Id headerLocationId = 0;
+	std::vector<Id> locationIds;
+	std::vector<Id> fileLocationIds;
+	std::vector<StorageSourceLocation> idLocations;
+	{
+		SqliteIndexStorage storage(databasePath);
+		storage.setup();
+		storage.beginTransaction();
+		const Id fileId = storage.addNode(StorageNodeData(0, L"file"));
+		storage.addFile(
+			StorageFile(fileId, L"file.cpp", L"cpp", "2000-01-01 00:00:00", false, true));
+
+		// each batch adds the first location again, like a header included by many files
+		for (size_t line = 20; line > 0; line--)
+		{
+			const std::vector<Id> ids = storage.addSourceLocations(
+				{StorageSourceLocation(0, fileId, 20, 1, 20, 5, 1),
+				 StorageSourceLocation(0, fileId, line, 10, line, 15, 1)});
+			if (headerLocationId == 0)
+			{
+				headerLocationId = ids[0];
+			}
+			REQUIRE(ids[0] == headerLocationId);
+			locationIds.push_back(ids[1]);
+		}
+		storage.commitTransaction();
+
+		storage.getSourceLocationsForFile(FilePath(L"file.cpp"))
+			->forEachStartSourceLocation([&fileLocationIds](SourceLocation* location) {
+				fileLocationIds.push_back(location->getLocationId());
+			});
+		idLocations = storage.getAllByIds<StorageSourceLocation>({locationIds[3], locationIds[17]});
+	}
+	FileSystem::remove(databasePath);
+
+	std::reverse(locationIds.begin(), locationIds.end());
+	locationIds.insert(locationIds.end() - 1, headerLocationId);
+	REQUIRE(fileLocationIds == locationIds);
+
+	REQUIRE(idLocations.size() == 2);
+	std::sort(
+		idLocations.begin(),
+		idLocations.end(),
+		[](const StorageSourceLocation& a, const StorageSourceLocation& b) { return a.id < b.id; });
+	REQUIRE(idLocations[0].startLine == 17);
+	REQUIRE(idLocations[1].startLine == 3);
+}
+
+TEST_CASE("storage removes source locations of removed file")
+{
+	FilePath databasePath(L"data/SQLiteTestSuite/test.sqlite");
+	int sourceLocationCount = -1;
+	size_t fileLocationCount = 1;
+	{
+		SqliteIndexStorage storage(databasePath);
+		storage.setup();
+		storage.beginTransaction();
+		const Id fileId = storage.addNode(StorageNodeData(0, L"file"));
+		storage.addFile(
+			StorageFile(fileId, L"file.cpp", L"cpp", "2000-01-01 00:00:00", false, true));
+		storage.addSourceLocations({StorageSourceLocation(0, fileId, 1, 1, 1, 5, 1)});
+		storage.removeElementsWithLocationInFiles({fileId}, nullptr);
+		storage.commitTransaction();
+
+		sourceLocationCount = storage.getSourceLocationCount();
+		fileLocationCount = storage.getSourceLocationsForFile(FilePath(L"file.cpp"))
+								->getSourceLocationCount();
+	}
+	FileSystem::remove(databasePath);
+
+	REQUIRE(0 == sourceLocationCount);
+	REQUIRE(0 == fileLocationCount);
+}
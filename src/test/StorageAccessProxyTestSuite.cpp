@@ -0,0 +1,81 @@
+#include "catch.hpp"
+
+#include <future>
+#include <memory>
+#include <thread>
+
+#include "CancellationToken.h"
+#include "StorageAccessProxy.h"
+
+TEST_CASE("storage access proxy runs queries with the token as current cancellation token")
+{
+	StorageAccessProxy proxy;
+	const CancellationToken token(101);
+
+	std::future<bool> query = StorageAccessProxy::queryAsync<bool>(
+		&proxy, "test query", token, [](const StorageAccess* storageAccess) {
+			CancellationToken::cancel(101);
+			return CancellationToken::getCurrent().isCanceled();
+		});
+
+	REQUIRE(query.get());
+	REQUIRE(!CancellationToken::getCurrent().isCanceled());
+}
+
+TEST_CASE("storage access proxy returns results of queries that were not canceled")
+{
+	StorageAccessProxy proxy;
+	const CancellationToken token(102);
+	const size_t queryCount =
+		StorageAccessProxy::getQueryLatencies()["not canceled test query"].queryCount;
+
+	std::future<int> query = StorageAccessProxy::queryAsync<int>(
+		&proxy, "not canceled test query", token, [](const StorageAccess* storageAccess) {
+			return 42;
+		});
+
+	int result = 0;
+	size_t waitCount = 0;
+	REQUIRE(StorageAccessProxy::waitForQuery<int>(query, token, result, [&]() { waitCount++; }));
+	REQUIRE(result == 42);
+	REQUIRE(waitCount > 0);
+	REQUIRE(
+		StorageAccessProxy::getQueryLatencies()["not canceled test query"].queryCount ==
+		queryCount + 1);
+}
+
+TEST_CASE("storage access proxy stops waiting for queries when their token gets canceled")
+{
+	std::shared_ptr<StorageAccessProxy> subject = std::make_shared<StorageAccessProxy>();
+	const std::weak_ptr<StorageAccessProxy> weakSubject = subject;
+
+	StorageAccessProxy proxy;
+	proxy.setSubject(subject);
+
+	const CancellationToken token(103);
+	std::promise<void> release;
+	std::shared_future<void> released = release.get_future().share();
+
+	std::future<int> query = StorageAccessProxy::queryAsync<int>(
+		&proxy, "blocking test query", token, [released](const StorageAccess* storageAccess) {
+			released.wait();
+			return 42;
+		});
+	subject.reset();
+
+	std::thread cancelThread([]() {
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		CancellationToken::cancel(103);
+	});
+
+	int result = 0;
+	REQUIRE(!StorageAccessProxy::waitForQuery<int>(query, token, result));
+	REQUIRE(result == 0);
+	cancelThread.join();
+
+	// the subject is kept alive by the query that is still running
+	REQUIRE(!weakSubject.expired());
+
+	release.set_value();
+	REQUIRE(query.get() == 42);
+}
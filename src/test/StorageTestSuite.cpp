@@ -1,10 +1,16 @@
 #include "catch.hpp"
 
+#include <thread>
+
 #include "utilityString.h"
 
+#include "FileSystem.h"
 #include "IntermediateStorage.h"
 #include "ParseLocation.h"
 #include "PersistentStorage.h"
+#include "SourceLocation.h"
+#include "SourceLocationCollection.h"
+#include "SourceLocationFile.h"
 
 namespace
 {
@@ -128,6 +134,161 @@ TEST_CASE("storage saves field as member")
 	REQUIRE(foundEdge);
 }
 
+TEST_CASE("storage saves data loaded from other storage into intermediate storage")
+{
+	NameHierarchy a = createNameHierarchy(L"Struct");
+	NameHierarchy b = createNameHierarchy(L"Struct::m_field");
+
+	const FilePath sourceFilePath(L"data/testSource.sqlite");
+	{
+		PersistentStorage sourceStorage(sourceFilePath, FilePath());
+		sourceStorage.clear();
+
+		IntermediateStorage commandOutput;
+		const Id aId = commandOutput
+							.addNode(StorageNodeData(
+								nodeKindToInt(NODE_STRUCT), NameHierarchy::serialize(a)))
+							.first;
+		const Id bId = commandOutput
+							.addNode(StorageNodeData(
+								nodeKindToInt(NODE_FIELD), NameHierarchy::serialize(b)))
+							.first;
+		commandOutput.addEdge(StorageEdgeData(Edge::typeToInt(Edge::EDGE_MEMBER), aId, bId));
+		sourceStorage.inject(&commandOutput);
+	}
+
+	std::shared_ptr<IntermediateStorage> intermediateStorage =
+		std::make_shared<IntermediateStorage>();
+	{
+		PersistentStorage sourceStorage(sourceFilePath, FilePath());
+		intermediateStorage->inject(&sourceStorage);
+	}
+	FileSystem::remove(sourceFilePath);
+
+	TestStorage storage;
+	storage.inject(intermediateStorage.get());
+
+	const Id sourceId = storage.getNodeIdForNameHierarchy(a);
+	const Id targetId = storage.getNodeIdForNameHierarchy(b);
+	REQUIRE(sourceId != 0);
+	REQUIRE(targetId != 0);
+
+	bool foundEdge = false;
+	for (const StorageEdge& edge: storage.getStorageEdges())
+	{
+		if (edge.sourceNodeId == sourceId && edge.targetNodeId == targetId &&
+			edge.type == Edge::typeToInt(Edge::EDGE_MEMBER))
+		{
+			foundEdge = true;
+		}
+	}
+	REQUIRE(foundEdge);
+}
+
+TEST_CASE("storage finds symbols and files in search index built from caches")
+{
+	TestStorage storage;
+
+	std::shared_ptr<IntermediateStorage> intermediateStorage =
+		std::make_shared<IntermediateStorage>();
+	for (const std::wstring name: {L"Alpha", L"Beta", L"Gamma::Beta"})
+	{
+		const Id id = intermediateStorage
+						  ->addNode(StorageNodeData(
+							  nodeKindToInt(NODE_CLASS),
+							  NameHierarchy::serialize(createNameHierarchy(name))))
+						  .first;
+		intermediateStorage->addSymbol(StorageSymbol(id, DEFINITION_EXPLICIT));
+	}
+
+	const std::wstring filePath = L"path/to/beta.h";
+	const Id fileId = intermediateStorage
+						  ->addNode(StorageNodeData(
+							  nodeKindToInt(NODE_FILE),
+							  NameHierarchy::serialize(
+								  NameHierarchy(filePath, NAME_DELIMITER_FILE))))
+						  .first;
+	intermediateStorage->addFile(StorageFile(fileId, filePath, L"cpp", "someTime", true, true));
+
+	storage.inject(intermediateStorage.get());
+	storage.buildCaches();
+
+	std::set<std::wstring> matchNames;
+	for (const SearchMatch& match:
+		 storage.getAutocompletionMatches(L"beta", NodeTypeSet::all(), false))
+	{
+		matchNames.insert(match.name);
+	}
+
+	REQUIRE(matchNames.size() == 3);
+	REQUIRE(matchNames.find(L"Beta") != matchNames.end());
+	REQUIRE(matchNames.find(L"Gamma::Beta") != matchNames.end());
+	REQUIRE(matchNames.find(filePath) != matchNames.end());
+}
+
+TEST_CASE("storage pages fulltext search results between files")
+{
+	TestStorage storage;
+
+	std::shared_ptr<IntermediateStorage> intermediateStorage = std::make_shared<IntermediateStorage>();
+	for (const std::wstring fileName: {L"a.txt", L"b.txt", L"c.txt"})
+	{
+		const std::wstring filePath = L"data/StorageTestSuite/" + fileName;
+		const Id fileId = intermediateStorage
+							  ->addNode(StorageNodeData(
+								  nodeKindToInt(NODE_FILE),
+								  NameHierarchy::serialize(
+									  NameHierarchy(filePath, NAME_DELIMITER_FILE))))
+							  .first;
+		intermediateStorage->addFile(StorageFile(fileId, filePath, L"txt", "someTime", true, true));
+	}
+
+	storage.inject(intermediateStorage.get());
+	storage.buildCaches();
+
+	const std::thread::id callingThreadId = std::this_thread::get_id();
+	size_t batchLocationCount = 0;
+	bool batchesOnCallingThread = true;
+	FullTextSearchPage firstPage = storage.getFullTextSearchLocations(
+		L"harmless", false, 0, 2, [&](std::shared_ptr<SourceLocationCollection> locations) {
+			batchLocationCount += locations->getSourceLocationCount();
+			batchesOnCallingThread &= std::this_thread::get_id() == callingThreadId;
+		});
+
+	REQUIRE(firstPage.fileCount == 3);
+	REQUIRE(firstPage.nextFileOffset == 1);
+	REQUIRE(firstPage.hasNextPage());
+	REQUIRE(firstPage.locations->getSourceLocationFileCount() == 1);
+	REQUIRE(firstPage.locations->getSourceLocationCount() == 2);
+	REQUIRE(batchLocationCount == 2);
+	REQUIRE(batchesOnCallingThread);
+
+	FullTextSearchPage secondPage = storage.getFullTextSearchLocations(
+		L"harmless", false, firstPage.nextFileOffset, 2, nullptr);
+
+	REQUIRE(secondPage.nextFileOffset == 3);
+	REQUIRE(!secondPage.hasNextPage());
+	REQUIRE(secondPage.locations->getSourceLocationFileCount() == 2);
+	REQUIRE(secondPage.locations->getSourceLocationCount() == 2);
+
+	std::set<Id> locationIds;
+	firstPage.locations->forEachSourceLocation(
+		[&](SourceLocation* location) { locationIds.insert(location->getLocationId()); });
+	secondPage.locations->forEachSourceLocation(
+		[&](SourceLocation* location) { locationIds.insert(location->getLocationId()); });
+	REQUIRE(locationIds.size() == 4);
+
+	std::shared_ptr<SourceLocationFile> file =
+		storage.getFullTextSearchLocations(L"Harmless", true, 0, 0, nullptr)
+			.locations->getSourceLocationFileByPath(FilePath(L"data/StorageTestSuite/a.txt"));
+	REQUIRE(file);
+	REQUIRE(file->getSourceLocationCount() == 1);
+	file->forEachStartSourceLocation([](SourceLocation* location) {
+		REQUIRE(location->getLineNumber() == 2);
+		REQUIRE(location->getColumnNumber() == 1);
+	});
+}
+
 TEST_CASE("storage saves method static")
 {
 	// TestStorage storage;
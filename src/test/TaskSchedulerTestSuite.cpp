@@ -1,5 +1,6 @@
 #include "catch.hpp"
 
+#include <atomic>
 #include <chrono>
 #include <thread>
 
@@ -8,6 +9,7 @@
 #include "TaskGroupSelector.h"
 #include "TaskGroupSequence.h"
 #include "TaskScheduler.h"
+#include "ThreadPool.h"
 
 namespace
 {
@@ -281,3 +283,38 @@ TEST_CASE("task scheduling within task processing")
 	REQUIRE(5 == task->subTask->updateCallOrder);
 	REQUIRE(6 == task->subTask->exitCallOrder);
 }
+
+TEST_CASE("blackboard wait returns when value changes")
+{
+	std::shared_ptr<Blackboard> blackboard = std::make_shared<Blackboard>();
+	const size_t changeCount = blackboard->getChangeCount();
+
+	REQUIRE(!blackboard->waitForChange(changeCount, 1));
+
+	std::thread thread([blackboard]() { blackboard->set<bool>("done", true); });
+	REQUIRE(blackboard->waitForChange(changeCount, 10000));
+	thread.join();
+
+	REQUIRE(blackboard->getChangeCount() == changeCount + 1);
+}
+
+TEST_CASE("thread pool reuses idle threads")
+{
+	std::shared_ptr<ThreadPool> threadPool = ThreadPool::getInstance();
+
+	std::atomic<int> runCount(0);
+	threadPool->run([&runCount]() { runCount++; });
+	while (runCount < 1 || threadPool->getIdleThreadCount() == 0)
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+
+	const size_t threadCount = threadPool->getThreadCount();
+	threadPool->run([&runCount]() { runCount++; });
+	while (runCount < 2)
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+
+	REQUIRE(threadPool->getThreadCount() == threadCount);
+}
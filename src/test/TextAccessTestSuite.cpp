@@ -102,6 +102,40 @@ TEST_CASE("textAccessString all lines")
 	REQUIRE(lines.size() == lineCount);
 }
 
+TEST_CASE("textAccessString text view of lines")
+{
+	std::string text = getTestText();
+
+	std::shared_ptr<TextAccess> textAccess = TextAccess::createFromString(text);
+
+	REQUIRE(textAccess->getLineView(6) == "\"So had the stairs.\"\n");
+	REQUIRE(textAccess->getTextView(3, 4) == "\"That's the display department.\"\n\"With a torch.\"\n");
+	REQUIRE(textAccess->getTextView(1, 8) == text);
+	REQUIRE(textAccess->getTextView(4, 3).empty());
+	REQUIRE(textAccess->getTextView(8, 9).empty());
+}
+
+TEST_CASE("textAccessString last line without line break")
+{
+	std::shared_ptr<TextAccess> textAccess = TextAccess::createFromString("foo\nbar");
+
+	REQUIRE(textAccess->getLineCount() == 2);
+	REQUIRE(textAccess->getLine(1) == "foo\n");
+	REQUIRE(textAccess->getLine(2) == "bar");
+	REQUIRE(textAccess->getText() == "foo\nbar");
+}
+
+TEST_CASE("textAccessLines keeps lines and text")
+{
+	std::shared_ptr<TextAccess> textAccess = TextAccess::createFromLines({"foo\n", "", "bar"});
+
+	REQUIRE(textAccess->getLineCount() == 3);
+	REQUIRE(textAccess->getLine(2) == "");
+	REQUIRE(textAccess->getLine(3) == "bar");
+	REQUIRE(textAccess->getAllLines().size() == 3);
+	REQUIRE(textAccess->getText() == "foo\nbar");
+}
+
 TEST_CASE("textAccessFile constructor")
 {
 	FilePath filePath(L"data/TextAccessTestSuite/text.txt");
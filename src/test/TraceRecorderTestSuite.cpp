@@ -0,0 +1,140 @@
+#include "catch.hpp"
+
+#include <algorithm>
+#include <thread>
+
+#include "TraceRecorder.h"
+#include "tracing.h"
+
+namespace
+{
+void tracedFunction()
+{
+	TRACE("traced function");
+}
+
+size_t countRecords(const std::vector<TraceRecord>& records, const std::string& eventName)
+{
+	return std::count_if(records.begin(), records.end(), [&](const TraceRecord& record) {
+		return record.eventName == eventName;
+	});
+}
+}	 // namespace
+
+TEST_CASE("trace recorder ignores events while disabled")
+{
+	TraceRecorder* traceRecorder = TraceRecorder::getInstance();
+	traceRecorder->collectAllRecords();
+
+	tracedFunction();
+
+	REQUIRE(countRecords(traceRecorder->collectAllRecords(), "traced function") == 0);
+}
+
+TEST_CASE("trace recorder collects events of all threads")
+{
+	TraceRecorder* traceRecorder = TraceRecorder::getInstance();
+	traceRecorder->collectAllRecords();
+	traceRecorder->setEnabled(true);
+
+	tracedFunction();
+	std::thread thread([]() {
+		tracedFunction();
+		tracedFunction();
+	});
+	thread.join();
+
+	traceRecorder->setEnabled(false);
+
+	const std::vector<TraceRecord> records = traceRecorder->collectAllRecords();
+
+	REQUIRE(countRecords(records, "traced function") == 3);
+	REQUIRE(countRecords(traceRecorder->collectAllRecords(), "traced function") == 0);
+}
+
+TEST_CASE("trace recorder keeps latest events when ring buffer overflows")
+{
+	TraceRecorder* traceRecorder = TraceRecorder::getInstance();
+	traceRecorder->collectAllRecords();
+	traceRecorder->setEnabled(true);
+
+	const uint32_t eventNameId = traceRecorder->registerEventName("overflow", "");
+	for (uint64_t i = 1; i <= 100000; i++)
+	{
+		traceRecorder->record(eventNameId, i, i + 1);
+	}
+
+	traceRecorder->setEnabled(false);
+
+	const std::vector<TraceRecord> records = traceRecorder->collectThreadRecords(0);
+
+	REQUIRE(!records.empty());
+	REQUIRE(records.size() < 100000);
+	REQUIRE(records.back().startNS == 100000);
+	REQUIRE(records.back().durationNS == 1);
+}
+
+TEST_CASE("trace recorder collects complete events while the owning thread keeps writing")
+{
+	TraceRecorder* traceRecorder = TraceRecorder::getInstance();
+	traceRecorder->collectAllRecords();
+	traceRecorder->setEnabled(true);
+
+	const uint32_t eventNameId = traceRecorder->registerEventName("concurrent", "");
+	std::thread thread([&]() {
+		for (uint64_t i = 1; i <= 200000; i++)
+		{
+			traceRecorder->record(eventNameId, i, i * 2);
+		}
+	});
+
+	std::vector<TraceRecord> records;
+	for (size_t i = 0; i < 100; i++)
+	{
+		const std::vector<TraceRecord> collectedRecords = traceRecorder->collectRecords(0);
+		records.insert(records.end(), collectedRecords.begin(), collectedRecords.end());
+	}
+	thread.join();
+
+	traceRecorder->setEnabled(false);
+
+	const std::vector<TraceRecord> collectedRecords = traceRecorder->collectRecords(0);
+	records.insert(records.end(), collectedRecords.begin(), collectedRecords.end());
+
+	uint64_t lastStartNS = 0;
+	for (const TraceRecord& record: records)
+	{
+		if (record.eventName == "concurrent")
+		{
+			REQUIRE(record.startNS > lastStartNS);
+			REQUIRE(record.durationNS == record.startNS);
+			lastStartNS = record.startNS;
+		}
+	}
+	REQUIRE(lastStartNS == 200000);
+}
+
+TEST_CASE("trace recorder exports chrome trace events")
+{
+	TraceRecord record;
+	record.eventName = "index \"file\"";
+	record.processId = 2;
+	record.threadIndex = 3;
+	record.startNS = 5000;
+	record.durationNS = 1500;
+
+	TraceRecord mainRecord = record;
+	mainRecord.eventName = "inject";
+	mainRecord.processId = 0;
+	mainRecord.startNS = 4000;
+
+	const std::string json = TraceRecorder::toChromeTraceJson({record, mainRecord});
+
+	REQUIRE(json.find("\"traceEvents\": [") != std::string::npos);
+	REQUIRE(json.find("\"args\": {\"name\": \"indexer 2\"}") != std::string::npos);
+	REQUIRE(json.find("\"args\": {\"name\": \"Sourcetrail\"}") != std::string::npos);
+	REQUIRE(
+		json.find("{\"name\": \"index \\\"file\\\"\", \"cat\": \"sourcetrail\", \"ph\": \"X\", "
+				  "\"pid\": 2, \"tid\": 3, \"ts\": 1.000, \"dur\": 1.500}") != std::string::npos);
+	REQUIRE(json.find("\"ts\": 0.000") != std::string::npos);
+}
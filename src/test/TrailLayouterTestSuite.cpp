@@ -0,0 +1,105 @@
+#include "catch.hpp"
+
+#include "Graph.h"
+#include "TrailLayouter.h"
+
+namespace
+{
+void buildLadderTrail(
+	size_t nodeCount,
+	Graph& graph,
+	std::vector<std::shared_ptr<DummyNode>>& dummyNodes,
+	std::vector<std::shared_ptr<DummyEdge>>& dummyEdges,
+	std::map<Id, Id>& topLevelAncestorIds)
+{
+	for (size_t i = 0; i < nodeCount; i++)
+	{
+		const Id id = i + 1;
+		Node* node = graph.createNode(
+			id,
+			NodeType(NODE_FUNCTION),
+			NameHierarchy(L"f" + std::to_wstring(id), NAME_DELIMITER_CXX),
+			DEFINITION_EXPLICIT);
+
+		std::shared_ptr<DummyNode> dummyNode = std::make_shared<DummyNode>(DummyNode::DUMMY_DATA);
+		dummyNode->tokenId = id;
+		dummyNode->data = node;
+		dummyNode->name = node->getName();
+		dummyNode->visible = true;
+		dummyNode->active = (i == 0);
+		dummyNode->size = Vec2i(100, 30);
+
+		dummyNodes.push_back(dummyNode);
+		topLevelAncestorIds.emplace(id, id);
+	}
+
+	Id edgeId = nodeCount + 1;
+	for (size_t i = 0; i < nodeCount; i++)
+	{
+		for (size_t j = i + 1; j <= i + 2 && j < nodeCount; j++)
+		{
+			Edge* edge = graph.createEdge(
+				edgeId++,
+				Edge::EDGE_CALL,
+				graph.getNodeById(dummyNodes[i]->tokenId),
+				graph.getNodeById(dummyNodes[j]->tokenId));
+
+			std::shared_ptr<DummyEdge> dummyEdge = std::make_shared<DummyEdge>(
+				dummyNodes[i]->tokenId, dummyNodes[j]->tokenId, edge);
+			dummyEdge->visible = true;
+
+			dummyEdges.push_back(dummyEdge);
+		}
+	}
+}
+}	 // namespace
+
+TEST_CASE("trail layouter places nodes of chain in consecutive columns")
+{
+	Graph graph;
+	std::vector<std::shared_ptr<DummyNode>> dummyNodes;
+	std::vector<std::shared_ptr<DummyEdge>> dummyEdges;
+	std::map<Id, Id> topLevelAncestorIds;
+	buildLadderTrail(10, graph, dummyNodes, dummyEdges, topLevelAncestorIds);
+
+	TrailLayouter layouter(TrailLayouter::LAYOUT_LEFT_RIGHT);
+	layouter.layoutGraph(dummyNodes, dummyEdges, topLevelAncestorIds);
+
+	for (size_t i = 1; i < dummyNodes.size(); i++)
+	{
+		REQUIRE(dummyNodes[i]->visible);
+		REQUIRE(dummyNodes[i - 1]->position.x < dummyNodes[i]->position.x);
+	}
+}
+
+TEST_CASE("trail layouter adds virtual nodes to paths of long edges")
+{
+	Graph graph;
+	std::vector<std::shared_ptr<DummyNode>> dummyNodes;
+	std::vector<std::shared_ptr<DummyEdge>> dummyEdges;
+	std::map<Id, Id> topLevelAncestorIds;
+	buildLadderTrail(3, graph, dummyNodes, dummyEdges, topLevelAncestorIds);
+
+	TrailLayouter layouter(TrailLayouter::LAYOUT_TOP_BOTTOM);
+	layouter.layoutGraph(dummyNodes, dummyEdges, topLevelAncestorIds);
+
+	REQUIRE(dummyEdges.size() == 3);
+	REQUIRE(dummyEdges[0]->path.empty());
+	REQUIRE(dummyEdges[1]->path.size() == 1);
+	REQUIRE(dummyEdges[2]->path.empty());
+}
+
+TEST_CASE("trail layouter handles deep trails with many paths")
+{
+	// the number of paths through this graph grows exponentially with its depth
+	Graph graph;
+	std::vector<std::shared_ptr<DummyNode>> dummyNodes;
+	std::vector<std::shared_ptr<DummyEdge>> dummyEdges;
+	std::map<Id, Id> topLevelAncestorIds;
+	buildLadderTrail(2000, graph, dummyNodes, dummyEdges, topLevelAncestorIds);
+
+	TrailLayouter layouter(TrailLayouter::LAYOUT_LEFT_RIGHT);
+	layouter.layoutGraph(dummyNodes, dummyEdges, topLevelAncestorIds);
+
+	REQUIRE(dummyNodes.front()->position.x < dummyNodes.back()->position.x);
+}
@@ -27,7 +27,7 @@ void cleanup()
 TEST_CASE("gradle wrapper detects source directories of simple projects")
 {
 	std::vector<FilePath> result = utility::gradleGetAllSourceDirectories(
-		FilePath(L"data/UtilityGradleTestSuite/simple_gradle_project"), false);
+		FilePath(L"data/UtilityGradleTestSuite/simple_gradle_project"), FilePath(), false);
 
 	REQUIRE(utility::containsElement<FilePath>(
 		result,
@@ -41,7 +41,7 @@ TEST_CASE("gradle wrapper detects source directories of simple projects")
 TEST_CASE("gradle wrapper detects source and test directories of simple projects")
 {
 	std::vector<FilePath> result = utility::gradleGetAllSourceDirectories(
-		FilePath(L"data/UtilityGradleTestSuite/simple_gradle_project"), true);
+		FilePath(L"data/UtilityGradleTestSuite/simple_gradle_project"), FilePath(), true);
 
 	REQUIRE(utility::containsElement<FilePath>(
 		result,
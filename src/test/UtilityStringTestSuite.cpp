@@ -1,7 +1,23 @@
 #include "catch.hpp"
 
+#include <boost/locale/encoding_utf.hpp>
+
+#include "TestTextCorpus.h"
 #include "utilityString.h"
 
+namespace
+{
+std::wstring decodeWithBoost(const std::string& s)
+{
+	return boost::locale::conv::utf_to_utf<wchar_t>(s.c_str(), s.c_str() + s.size());
+}
+
+std::string encodeWithBoost(const std::wstring& s)
+{
+	return boost::locale::conv::utf_to_utf<char>(s.c_str(), s.c_str() + s.size());
+}
+}	 // namespace
+
 TEST_CASE("split with char delimiter")
 {
 	std::deque<std::string> result = utility::split("A,B,C", ',');
@@ -379,3 +395,62 @@ TEST_CASE(
 {
 	REQUIRE_FALSE(utility::caseInsensitiveLess(L"ab_cD!E", L"aB_cd!"));
 }
+
+TEST_CASE("decodeFromUtf8 converts ascii text")
+{
+	REQUIRE(utility::decodeFromUtf8("") == L"");
+	REQUIRE(utility::decodeFromUtf8("a") == L"a");
+	REQUIRE(
+		utility::decodeFromUtf8("void foo(int bar) const; // returns nothing at all") ==
+		L"void foo(int bar) const; // returns nothing at all");
+}
+
+TEST_CASE("decodeFromUtf8 converts multi byte sequences")
+{
+	REQUIRE(utility::decodeFromUtf8("gr\xC3\xB6\xC3\x9F" "er") == L"gr\u00F6\u00DFer");
+	REQUIRE(utility::decodeFromUtf8("\xE6\x97\xA5\xE6\x9C\xAC") == L"\u65E5\u672C");
+	REQUIRE(utility::decodeFromUtf8("a\xF0\x9F\x98\x80z") == L"a\U0001F600z");
+}
+
+TEST_CASE("encodeToUtf8 converts ascii and multi byte text")
+{
+	REQUIRE(utility::encodeToUtf8(L"") == "");
+	REQUIRE(utility::encodeToUtf8(L"int main()") == "int main()");
+	REQUIRE(utility::encodeToUtf8(L"gr\u00F6\u00DFer") == "gr\xC3\xB6\xC3\x9F" "er");
+	REQUIRE(utility::encodeToUtf8(L"\u65E5\u672C") == "\xE6\x97\xA5\xE6\x9C\xAC");
+	REQUIRE(utility::encodeToUtf8(L"a\U0001F600z") == "a\xF0\x9F\x98\x80z");
+}
+
+TEST_CASE("decodeFromUtf8 handles invalid sequences like boost")
+{
+	const std::vector<std::string> invalidTexts = {
+		"abc\x80",
+		"\xC3",
+		"ab\xC3(cdefghijklmnop",
+		"overlong \xC0\xAF and \xE0\x80\xAF",
+		"surrogate \xED\xA0\x80 text",
+		"too large \xF4\x90\x80\x80 text",
+		"truncated \xE6\x97",
+		"\xFF\xFEvalid \xC3\xB6 after invalid"};
+
+	for (const std::string& text: invalidTexts)
+	{
+		REQUIRE(utility::decodeFromUtf8(text) == decodeWithBoost(text));
+	}
+}
+
+TEST_CASE("encodeToUtf8 and decodeFromUtf8 match boost for generated text")
+{
+	for (const std::vector<std::string>& corpus:
+		 {TestTextCorpus::createSourceLines(500, 7),
+		  TestTextCorpus::createSymbolNames(500, 3)})
+	{
+		for (const std::string& text: corpus)
+		{
+			const std::wstring decoded = utility::decodeFromUtf8(text);
+			REQUIRE(decoded == decodeWithBoost(text));
+			REQUIRE(utility::encodeToUtf8(decoded) == encodeWithBoost(decoded));
+			REQUIRE(utility::encodeToUtf8(decoded) == text);
+		}
+	}
+}
@@ -0,0 +1,52 @@
+#ifndef TEST_TEXT_CORPUS_H
+#define TEST_TEXT_CORPUS_H
+
+#include <string>
+#include <vector>
+
+// Generates utf-8 text that looks like the source lines and serialized symbol names Sourcetrail
+// converts most, with a non-ascii line or name at the given interval.
+class TestTextCorpus
+{
+public:
+	static std::vector<std::string> createSourceLines(size_t lineCount, size_t nonAsciiLineInterval)
+	{
+		std::vector<std::string> lines;
+		for (size_t i = 0; i < lineCount; i++)
+		{
+			if (nonAsciiLineInterval && i % nonAsciiLineInterval == 0)
+			{
+				// german and japanese text, escapes are split where a hex digit follows
+				lines.push_back(
+					"\t// gr\xC3\xB6\xC3\x9F" "ere Ma\xC3\x9F" "e, \xE6\x97\xA5\xE6\x9C\xAC " +
+					std::to_string(i));
+			}
+			else
+			{
+				lines.push_back(
+					"\tstd::vector<std::shared_ptr<StorageNode>> nodes = "
+					"storage->getNodesForFile(" +
+					std::to_string(i) + ");");
+			}
+		}
+		return lines;
+	}
+
+	static std::vector<std::string> createSymbolNames(size_t nameCount, size_t nonAsciiNameInterval)
+	{
+		std::vector<std::string> names;
+		for (size_t i = 0; i < nameCount; i++)
+		{
+			std::string name = "::\tmproject\ts\tp\tmdetail\ts\tp\tmTokenComponent" +
+				std::to_string(i % 100) + "\ts\tp\tmgetValue\tsconst std::wstring &\tp(int)";
+			if (nonAsciiNameInterval && i % nonAsciiNameInterval == 0)
+			{
+				name += "\xC3\xA4";
+			}
+			names.push_back(name);
+		}
+		return names;
+	}
+};
+
+#endif	  // TEST_TEXT_CORPUS_H